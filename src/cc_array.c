@@ -19,6 +19,8 @@
  */
 
 #include "cc_array.h"
+#include "cc_list.h"
+#include "cc_slist.h"
 
 #define DEFAULT_CAPACITY 8
 #define DEFAULT_EXPANSION_FACTOR 2
@@ -29,12 +31,20 @@ struct cc_array_s {
     float    exp_factor;
     void   **buffer;
 
+    /* Storage allocated along with the structure, or NULL */
+    void   **inline_buffer;
+    size_t   inline_capacity;
+
     void *(*mem_alloc)  (size_t size);
     void *(*mem_calloc) (size_t blocks, size_t size);
     void  (*mem_free)   (void *block);
 };
 
 static enum cc_stat expand_capacity(CC_Array *ar);
+static enum cc_stat expand_capacity_to(CC_Array *ar, size_t min_capacity);
+static void         free_buffer    (CC_Array *ar);
+static enum cc_stat move_buffer    (CC_ArrayConf const * const conf, size_t size,
+                                    void ***buffer, size_t *capacity);
 
 
 /**
@@ -61,6 +71,11 @@ enum cc_stat cc_array_new(CC_Array **out)
  * fail if the values of exp_factor and capacity in the CC_ArrayConf do not meet
  * the following condition: <code>exp_factor < (CC_MAX_ELEMENTS / capacity)</code>.
  *
+ * If <code>inline_capacity</code> is set, the structure and the first
+ * <code>inline_capacity</code> elements are allocated as a single block, so
+ * small arrays cost a single allocation. The buffer is moved to the heap
+ * once the inline storage is exhausted.
+ *
  * @param[in] conf array configuration structure
  * @param[out] out pointer to where the newly created CC_Array is to be stored
  *
@@ -79,26 +94,118 @@ enum cc_stat cc_array_new_conf(CC_ArrayConf const * const conf, CC_Array **out)
     else
         ex = conf->exp_factor;
 
+    size_t inline_cap = conf->inline_capacity;
+    size_t capacity   = inline_cap ? inline_cap : conf->capacity;
+
     /* Needed to avoid an integer overflow on the first resize and
      * to easily check for any future overflows. */
-    if (!conf->capacity || ex >= CC_MAX_ELEMENTS / conf->capacity)
+    if (!capacity || ex >= CC_MAX_ELEMENTS / capacity)
         return CC_ERR_INVALID_CAPACITY;
 
-    CC_Array *ar = conf->mem_calloc(1, sizeof(CC_Array));
+    if (inline_cap > (CC_MAX_ELEMENTS - sizeof(CC_Array)) / sizeof(void*))
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_Array *ar = conf->mem_calloc(1, sizeof(CC_Array) + inline_cap * sizeof(void*));
 
     if (!ar)
         return CC_ERR_ALLOC;
 
-    void **buff = conf->mem_alloc(conf->capacity * sizeof(void*));
+    void **buff;
 
-    if (!buff) {
-        conf->mem_free(ar);
-        return CC_ERR_ALLOC;
+    if (inline_cap) {
+        /* The inline elements directly follow the structure */
+        buff = (void**) (ar + 1);
+        ar->inline_buffer   = buff;
+        ar->inline_capacity = inline_cap;
+    } else {
+        buff = conf->mem_alloc(capacity * sizeof(void*));
+
+        if (!buff) {
+            conf->mem_free(ar);
+            return CC_ERR_ALLOC;
+        }
     }
 
     ar->buffer     = buff;
     ar->exp_factor = ex;
-    ar->capacity   = conf->capacity;
+    ar->capacity   = capacity;
+    ar->mem_alloc  = conf->mem_alloc;
+    ar->mem_calloc = conf->mem_calloc;
+    ar->mem_free   = conf->mem_free;
+
+    *out = ar;
+    return CC_OK;
+}
+
+/**
+ * Creates a new CC_Array that takes over the specified buffer as its storage
+ * instead of copying it. The first <code>size</code> pointers of the buffer
+ * become the elements of the array.
+ *
+ * @note The buffer must have been allocated with malloc, since the array
+ *       frees it or replaces it once it needs to grow.
+ *
+ * @param[in] buffer the buffer that is being taken over
+ * @param[in] size the number of elements in the buffer
+ * @param[in] capacity the number of elements that fit into the buffer
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is zero or smaller than the size, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_Array structure failed. If an error is
+ * returned, the buffer remains owned by the caller.
+ */
+enum cc_stat cc_array_from_buffer(void **buffer, size_t size, size_t capacity, CC_Array **out)
+{
+    CC_ArrayConf c;
+    cc_array_conf_init(&c);
+    return cc_array_from_buffer_conf(&c, buffer, size, capacity, out);
+}
+
+/**
+ * Creates a new CC_Array based on the specified CC_ArrayConf struct that
+ * takes over the specified buffer as its storage instead of copying it. This
+ * is how the array returned by cc_list_to_array() or cc_slist_to_array(), or
+ * the buffer released by cc_deque_release_buffer(), becomes an array without
+ * copying the elements a second time.
+ *
+ * The buffer must have been allocated with the allocator specified in the
+ * CC_ArrayConf struct. The capacity and inline_capacity fields of the struct
+ * are ignored.
+ *
+ * @param[in] conf array configuration structure
+ * @param[in] buffer the buffer that is being taken over
+ * @param[in] size the number of elements in the buffer
+ * @param[in] capacity the number of elements that fit into the buffer
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is zero or smaller than the size, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_Array structure failed. If an error is
+ * returned, the buffer remains owned by the caller.
+ */
+enum cc_stat cc_array_from_buffer_conf(CC_ArrayConf const * const conf, void **buffer,
+                                       size_t size, size_t capacity, CC_Array **out)
+{
+    float ex;
+
+    if (conf->exp_factor <= 1)
+        ex = DEFAULT_EXPANSION_FACTOR;
+    else
+        ex = conf->exp_factor;
+
+    if (!capacity || size > capacity || ex >= CC_MAX_ELEMENTS / capacity)
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_Array *ar = conf->mem_calloc(1, sizeof(CC_Array));
+
+    if (!ar)
+        return CC_ERR_ALLOC;
+
+    ar->buffer     = buffer;
+    ar->size       = size;
+    ar->capacity   = capacity;
+    ar->exp_factor = ex;
     ar->mem_alloc  = conf->mem_alloc;
     ar->mem_calloc = conf->mem_calloc;
     ar->mem_free   = conf->mem_free;
@@ -107,6 +214,163 @@ enum cc_stat cc_array_new_conf(CC_ArrayConf const * const conf, CC_Array **out)
     return CC_OK;
 }
 
+/**
+ * Moves the elements of the list into a new CC_Array, from the first to the
+ * last, and leaves the list empty. The element pointers are written once into
+ * a new buffer, which the array then takes over as its storage.
+ *
+ * @param[in] list the list whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the elements were moved, or CC_ERR_ALLOC if a memory
+ * allocation failed, in which case the list is left unchanged.
+ */
+enum cc_stat cc_array_from_list(CC_List *list, CC_Array **out)
+{
+    CC_ArrayConf c;
+    cc_array_conf_init(&c);
+    return cc_array_from_list_conf(&c, list, out);
+}
+
+/**
+ * Moves the elements of the list into a new CC_Array based on the specified
+ * CC_ArrayConf struct, from the first to the last, and leaves the list empty.
+ * The buffer of the array holds at least the initial capacity from the struct.
+ * The inline_capacity field of the struct is ignored.
+ *
+ * @param[in] conf array configuration structure
+ * @param[in] list the list whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the elements were moved, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if a memory allocation failed. If
+ * an error is returned, the list is left unchanged.
+ */
+enum cc_stat cc_array_from_list_conf(CC_ArrayConf const * const conf, CC_List *list, CC_Array **out)
+{
+    size_t   size = cc_list_size(list);
+    size_t   capacity;
+    void   **buffer;
+
+    enum cc_stat status = move_buffer(conf, size, &buffer, &capacity);
+
+    if (status != CC_OK)
+        return status;
+
+    size_t i = 0;
+    CC_LIST_FOREACH(e, list, {
+        buffer[i++] = e;
+    })
+
+    status = cc_array_from_buffer_conf(conf, buffer, size, capacity, out);
+
+    if (status != CC_OK) {
+        conf->mem_free(buffer);
+        return status;
+    }
+    cc_list_remove_all(list);
+    return CC_OK;
+}
+
+/**
+ * Moves the elements of the slist into a new CC_Array, from the first to the
+ * last, and leaves the slist empty. The element pointers are written once
+ * into a new buffer, which the array then takes over as its storage.
+ *
+ * @param[in] list the slist whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the elements were moved, or CC_ERR_ALLOC if a memory
+ * allocation failed, in which case the slist is left unchanged.
+ */
+enum cc_stat cc_array_from_slist(CC_SList *list, CC_Array **out)
+{
+    CC_ArrayConf c;
+    cc_array_conf_init(&c);
+    return cc_array_from_slist_conf(&c, list, out);
+}
+
+/**
+ * Moves the elements of the slist into a new CC_Array based on the specified
+ * CC_ArrayConf struct, from the first to the last, and leaves the slist
+ * empty. The buffer of the array holds at least the initial capacity from
+ * the struct. The inline_capacity field of the struct is ignored.
+ *
+ * @param[in] conf array configuration structure
+ * @param[in] list the slist whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Array is to be stored
+ *
+ * @return CC_OK if the elements were moved, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if a memory allocation failed. If
+ * an error is returned, the slist is left unchanged.
+ */
+enum cc_stat cc_array_from_slist_conf(CC_ArrayConf const * const conf, CC_SList *list, CC_Array **out)
+{
+    size_t   size = cc_slist_size(list);
+    size_t   capacity;
+    void   **buffer;
+
+    enum cc_stat status = move_buffer(conf, size, &buffer, &capacity);
+
+    if (status != CC_OK)
+        return status;
+
+    size_t i = 0;
+    CC_SLIST_FOREACH(e, list, {
+        buffer[i++] = e;
+    })
+
+    status = cc_array_from_buffer_conf(conf, buffer, size, capacity, out);
+
+    if (status != CC_OK) {
+        conf->mem_free(buffer);
+        return status;
+    }
+    cc_slist_remove_all(list);
+    return CC_OK;
+}
+
+/**
+ * Destroys the CC_Array structure and hands its buffer over to the caller,
+ * who becomes responsible for freeing it with the array's allocator. The
+ * elements occupy the first <code>size</code> slots of the buffer. If the
+ * elements are stored inline, they are first moved into a new buffer of the
+ * same capacity.
+ *
+ * @param[in] ar the array whose buffer is being released
+ * @param[out] out pointer to where the buffer is stored
+ * @param[out] size pointer to where the number of elements is stored, or NULL
+ * @param[out] capacity pointer to where the capacity of the buffer is
+ *                      stored, or NULL
+ *
+ * @return CC_OK if the buffer was released, or CC_ERR_ALLOC if the elements
+ * were stored inline and the memory allocation for the new buffer failed, in
+ * which case the array is left intact.
+ */
+enum cc_stat cc_array_release_buffer(CC_Array *ar, void ***out, size_t *size, size_t *capacity)
+{
+    void **buffer = ar->buffer;
+
+    if (buffer == ar->inline_buffer) {
+        buffer = ar->mem_alloc(ar->capacity * sizeof(void*));
+
+        if (!buffer)
+            return CC_ERR_ALLOC;
+
+        memcpy(buffer, ar->buffer, ar->size * sizeof(void*));
+    }
+
+    *out = buffer;
+
+    if (size)
+        *size = ar->size;
+    if (capacity)
+        *capacity = ar->capacity;
+
+    ar->mem_free(ar);
+    return CC_OK;
+}
+
 /**
  * Initializes the fields of the CC_ArrayConf struct to default values.
  *
@@ -116,6 +380,7 @@ void cc_array_conf_init(CC_ArrayConf *conf)
 {
     conf->exp_factor = DEFAULT_EXPANSION_FACTOR;
     conf->capacity   = DEFAULT_CAPACITY;
+    conf->inline_capacity = 0;
     conf->mem_alloc  = malloc;
     conf->mem_calloc = calloc;
     conf->mem_free   = free;
@@ -128,7 +393,7 @@ void cc_array_conf_init(CC_ArrayConf *conf)
  */
 void cc_array_destroy(CC_Array *ar)
 {
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
     ar->mem_free(ar);
 }
 
@@ -258,6 +523,176 @@ enum cc_stat cc_array_swap_at(CC_Array *ar, size_t index1, size_t index2)
     return CC_OK;
 }
 
+/**
+ * Appends all elements of the source array to the end of the array. The
+ * buffer is expanded at most once and the elements are copied in a single
+ * block. The source array may be the array itself.
+ *
+ * @param[in] ar  the array to which the elements are being added
+ * @param[in] src the array whose elements are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * array cannot hold all of the elements.
+ */
+enum cc_stat cc_array_add_all(CC_Array *ar, CC_Array *src)
+{
+    if (src->size == 0)
+        return CC_OK;
+
+    return cc_array_add_range(ar, src, 0, src->size - 1);
+}
+
+/**
+ * Appends the elements of the source array ranging from <code>from</code>
+ * index (inclusive) to <code>to</code> index (inclusive) to the end of the
+ * array. The source array may be the array itself.
+ *
+ * @param[in] ar   the array to which the elements are being added
+ * @param[in] src  the array whose elements are being added
+ * @param[in] from the index of the first element that is being added
+ * @param[in] to   the index of the last element that is being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_INVALID_RANGE
+ * if the specified index range is invalid, CC_ERR_ALLOC if the memory
+ * allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the array
+ * cannot hold all of the elements.
+ */
+enum cc_stat cc_array_add_range(CC_Array *ar, CC_Array *src, size_t from, size_t to)
+{
+    if (from > to || to >= src->size)
+        return CC_ERR_INVALID_RANGE;
+
+    size_t n = to - from + 1;
+
+    if (n > CC_MAX_ELEMENTS - ar->size)
+        return CC_ERR_MAX_CAPACITY;
+
+    /* Expand first, since the source might be this very buffer */
+    enum cc_stat status = expand_capacity_to(ar, ar->size + n);
+    if (status != CC_OK)
+        return status;
+
+    memcpy(&(ar->buffer[ar->size]),
+           &(src->buffer[from]),
+           n * sizeof(void*));
+
+    ar->size += n;
+
+    return CC_OK;
+}
+
+/**
+ * Appends <code>n</code> elements from a C array to the end of the array.
+ *
+ * @param[in] ar       the array to which the elements are being added
+ * @param[in] elements the elements that are being added
+ * @param[in] n        the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * array cannot hold all of the elements.
+ */
+enum cc_stat cc_array_append_buffer(CC_Array *ar, void * const *elements, size_t n)
+{
+    return cc_array_insert_range(ar, ar->size, elements, n);
+}
+
+/**
+ * Inserts <code>n</code> elements from a C array at the specified position
+ * by shifting all subsequent elements by <code>n</code> in a single move.
+ * The index must be within the bounds of the array or equal to its size.
+ *
+ * @note The elements must not point into the array's own buffer.
+ *
+ * @param[in] ar       the array to which the elements are being added
+ * @param[in] index    the position at which the first element is inserted
+ * @param[in] elements the elements that are being added
+ * @param[in] n        the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_OUT_OF_RANGE if
+ * the specified index was not in range, CC_ERR_ALLOC if the memory allocation
+ * for the new buffer failed, or CC_ERR_MAX_CAPACITY if the array cannot hold
+ * all of the elements.
+ */
+enum cc_stat cc_array_insert_range(CC_Array *ar, size_t index, void * const *elements, size_t n)
+{
+    if (index > ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (n == 0)
+        return CC_OK;
+
+    if (n > CC_MAX_ELEMENTS - ar->size)
+        return CC_ERR_MAX_CAPACITY;
+
+    enum cc_stat status = expand_capacity_to(ar, ar->size + n);
+    if (status != CC_OK)
+        return status;
+
+    if (index < ar->size) {
+        memmove(&(ar->buffer[index + n]),
+                &(ar->buffer[index]),
+                (ar->size - index) * sizeof(void*));
+    }
+    memcpy(&(ar->buffer[index]), elements, n * sizeof(void*));
+
+    ar->size += n;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the elements ranging from <code>from</code> index (inclusive) to
+ * <code>to</code> index (inclusive) by shifting all subsequent elements in a
+ * single move and optionally copies the removed elements to <code>out</code>.
+ *
+ * @param[in]  ar   the array from which the elements are being removed
+ * @param[in]  from the index of the first element that is being removed
+ * @param[in]  to   the index of the last element that is being removed
+ * @param[out] out  buffer large enough to hold the removed elements, or NULL
+ *                  if they are to be ignored
+ *
+ * @return CC_OK if the elements were successfully removed, or
+ * CC_ERR_INVALID_RANGE if the specified index range is invalid.
+ */
+enum cc_stat cc_array_remove_range(CC_Array *ar, size_t from, size_t to, void **out)
+{
+    if (from > to || to >= ar->size)
+        return CC_ERR_INVALID_RANGE;
+
+    size_t n = to - from + 1;
+
+    if (out)
+        memcpy(out, &(ar->buffer[from]), n * sizeof(void*));
+
+    if (to != ar->size - 1) {
+        memmove(&(ar->buffer[from]),
+                &(ar->buffer[to + 1]),
+                (ar->size - 1 - to) * sizeof(void*));
+    }
+    ar->size -= n;
+
+    return CC_OK;
+}
+
+/**
+ * Expands the array so that it can hold at least <code>capacity</code>
+ * elements without any further allocations. Does nothing if the array
+ * is already large enough.
+ *
+ * @param[in] ar       the array whose capacity is being reserved
+ * @param[in] capacity the minimum capacity of the array
+ *
+ * @return CC_OK if the capacity was reserved, CC_ERR_ALLOC if the memory
+ * allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * requested capacity exceeds the maximum capacity.
+ */
+enum cc_stat cc_array_reserve(CC_Array *ar, size_t capacity)
+{
+    return expand_capacity_to(ar, capacity);
+}
+
 /**
  * Removes the specified element from the CC_Array if such element exists and
  * optionally sets the out parameter to the value of the removed element.
@@ -522,6 +957,8 @@ enum cc_stat cc_array_copy_shallow(CC_Array *ar, CC_Array **out)
     copy->exp_factor = ar->exp_factor;
     copy->size       = ar->size;
     copy->capacity   = ar->capacity;
+    copy->inline_buffer   = NULL;
+    copy->inline_capacity = 0;
     copy->mem_alloc  = ar->mem_alloc;
     copy->mem_calloc = ar->mem_calloc;
     copy->mem_free   = ar->mem_free;
@@ -564,6 +1001,8 @@ enum cc_stat cc_array_copy_deep(CC_Array *ar, void *(*cp) (void *), CC_Array **o
     copy->exp_factor = ar->exp_factor;
     copy->size       = ar->size;
     copy->capacity   = ar->capacity;
+    copy->inline_buffer   = NULL;
+    copy->inline_capacity = 0;
     copy->mem_alloc  = ar->mem_alloc;
     copy->mem_calloc = ar->mem_calloc;
     copy->mem_free   = ar->mem_free;
@@ -659,6 +1098,8 @@ enum cc_stat cc_array_filter(CC_Array *ar, bool (*pred) (const void*), CC_Array
     filtered->exp_factor = ar->exp_factor;
     filtered->size       = 0;
     filtered->capacity   = ar->capacity;
+    filtered->inline_buffer   = NULL;
+    filtered->inline_capacity = 0;
     filtered->mem_alloc  = ar->mem_alloc;
     filtered->mem_calloc = ar->mem_calloc;
     filtered->mem_free   = ar->mem_free;
@@ -706,8 +1147,19 @@ void cc_array_reverse(CC_Array *ar)
  */
 enum cc_stat cc_array_trim_capacity(CC_Array *ar)
 {
-    if (ar->size == ar->capacity)
+    if (ar->size == ar->capacity || ar->buffer == ar->inline_buffer)
+        return CC_OK;
+
+    /* Move the elements back into the inline storage if they fit */
+    if (ar->inline_buffer && ar->size <= ar->inline_capacity) {
+        memcpy(ar->inline_buffer, ar->buffer, ar->size * sizeof(void*));
+        ar->mem_free(ar->buffer);
+
+        ar->buffer   = ar->inline_buffer;
+        ar->capacity = ar->inline_capacity;
+
         return CC_OK;
+    }
 
     void **new_buff = ar->mem_calloc(ar->size, sizeof(void*));
 
@@ -717,7 +1169,7 @@ enum cc_stat cc_array_trim_capacity(CC_Array *ar)
     size_t size = ar->size < 1 ? 1 : ar->size;
 
     memcpy(new_buff, ar->buffer, size * sizeof(void*));
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
 
     ar->buffer   = new_buff;
     ar->capacity = ar->size;
@@ -860,12 +1312,69 @@ static enum cc_stat expand_capacity(CC_Array *ar)
 
     memcpy(new_buff, ar->buffer, ar->size * sizeof(void*));
 
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
     ar->buffer = new_buff;
 
     return CC_OK;
 }
 
+/**
+ * Expands the CC_Array capacity to at least <code>min_capacity</code> with a
+ * single reallocation. The capacity keeps growing by the expansion factor
+ * until it is large enough, so repeated bulk insertions stay amortized.
+ *
+ * @param[in] ar array whose capacity is being expanded
+ * @param[in] min_capacity the number of elements the array must be able to hold
+ *
+ * @return CC_OK if the buffer was expanded successfully, CC_ERR_ALLOC if
+ * the memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY
+ * if the requested capacity exceeds the maximum capacity.
+ */
+static enum cc_stat expand_capacity_to(CC_Array *ar, size_t min_capacity)
+{
+    if (min_capacity <= ar->capacity)
+        return CC_OK;
+
+    size_t max_capacity = CC_MAX_ELEMENTS / sizeof(void*);
+
+    if (min_capacity > max_capacity)
+        return CC_ERR_MAX_CAPACITY;
+
+    size_t new_capacity = ar->capacity ? ar->capacity : 1;
+
+    while (new_capacity < min_capacity) {
+        float  next_f = new_capacity * ar->exp_factor;
+        size_t next   = next_f >= (float) max_capacity ? max_capacity : (size_t) next_f;
+
+        new_capacity = next > new_capacity ? next : new_capacity + 1;
+    }
+
+    void **new_buff = ar->mem_alloc(new_capacity * sizeof(void*));
+
+    if (!new_buff)
+        return CC_ERR_ALLOC;
+
+    memcpy(new_buff, ar->buffer, ar->size * sizeof(void*));
+
+    free_buffer(ar);
+    ar->buffer   = new_buff;
+    ar->capacity = new_capacity;
+
+    return CC_OK;
+}
+
+/**
+ * Frees the CC_Array buffer unless it is the inline storage that was
+ * allocated along with the structure.
+ *
+ * @param[in] ar array whose buffer is being freed
+ */
+static void free_buffer(CC_Array *ar)
+{
+    if (ar->buffer != ar->inline_buffer)
+        ar->mem_free(ar->buffer);
+}
+
 /**
  * Applies the function fn to each element of the CC_Array.
  *
@@ -1158,4 +1667,37 @@ size_t cc_array_zip_iter_index(CC_ArrayZipIter *iter)
 size_t cc_array_struct_size()
 {
     return sizeof(CC_Array);
-}
\ No newline at end of file
+}
+
+/**
+ * Allocates the buffer into which the elements of another container are
+ * moved. The buffer fits the elements and at least the initial capacity
+ * from the configuration struct.
+ *
+ * @param[in] conf array configuration structure
+ * @param[in] size the number of elements that are being moved
+ * @param[out] buffer pointer to where the new buffer is stored
+ * @param[out] capacity pointer to where the capacity of the buffer is stored
+ *
+ * @return CC_OK if the buffer was allocated, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if the memory allocation failed.
+ */
+static enum cc_stat move_buffer(CC_ArrayConf const * const conf, size_t size,
+                                void ***buffer, size_t *capacity)
+{
+    size_t cap = size > conf->capacity ? size : conf->capacity;
+
+    if (!cap)
+        cap = 1;
+
+    if (cap > CC_MAX_ELEMENTS / sizeof(void*))
+        return CC_ERR_INVALID_CAPACITY;
+
+    *buffer = conf->mem_alloc(cap * sizeof(void*));
+
+    if (!*buffer)
+        return CC_ERR_ALLOC;
+
+    *capacity = cap;
+    return CC_OK;
+}
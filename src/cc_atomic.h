@@ -0,0 +1,66 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_ATOMIC_H
+#define COLLECTIONS_C_ATOMIC_H
+
+/*
+ * The few atomic operations on size_t counters that CC_Rbuf needs for its
+ * single producer, single consumer mode. They map onto C11 <stdatomic.h>
+ * when the compiler provides it, and onto the interlocked intrinsics on
+ * MSVC builds without /experimental:c11atomics, so that the ring buffer
+ * builds without C11 atomics. The interlocked fallback is a full barrier,
+ * which is stronger than the acquire and release orders it stands in for.
+ *
+ * This header is private to the library and is not installed.
+ */
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+typedef atomic_size_t cc_atomic_size;
+
+#define cc_atomic_init(p, v)          atomic_init(p, v)
+#define cc_atomic_load_relaxed(p)     atomic_load_explicit(p, memory_order_relaxed)
+#define cc_atomic_load_acquire(p)     atomic_load_explicit(p, memory_order_acquire)
+#define cc_atomic_store_relaxed(p, v) atomic_store_explicit(p, v, memory_order_relaxed)
+#define cc_atomic_store_release(p, v) atomic_store_explicit(p, v, memory_order_release)
+
+#elif defined(_MSC_VER)
+
+#include <intrin.h>
+
+/* size_t has the width of a pointer on every Windows target */
+typedef size_t volatile cc_atomic_size;
+
+#define cc_atomic_init(p, v)          (*(p) = (v))
+#define cc_atomic_load_relaxed(p)     (*(p))
+#define cc_atomic_load_acquire(p) \
+    ((size_t) _InterlockedCompareExchangePointer((void * volatile *) (p), NULL, NULL))
+#define cc_atomic_store_relaxed(p, v) (*(p) = (v))
+#define cc_atomic_store_release(p, v) \
+    ((void) _InterlockedExchangePointer((void * volatile *) (p), (void *) (size_t) (v)))
+
+#else
+#error "Collections-C needs C11 atomics or MSVC interlocked intrinsics"
+#endif
+
+#endif /* COLLECTIONS_C_ATOMIC_H */
@@ -0,0 +1,680 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cc_block_deque.h"
+
+#define DEFAULT_BLOCK_SIZE 256
+#define MIN_MAP_CAPACITY   8
+
+/*
+ * The allocated blocks occupy the map slots [map_first, map_first + blocks).
+ * The first element is at offset head of the first block and element i is
+ * at the global offset (head + i), which is split into a block index and an
+ * offset within that block. Blocks only ever cover the elements that are
+ * in the deque, except for a single spare block that is kept around so that
+ * a deque that keeps crossing a block boundary does not keep allocating and
+ * freeing the same block.
+ */
+struct cc_block_deque_s {
+    size_t    size;
+    size_t    head;
+    size_t    shift;
+    size_t    mask;
+
+    void   ***map;
+    size_t    map_capacity;
+    size_t    map_first;
+    size_t    blocks;
+    void    **spare;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+static enum cc_stat add_block     (CC_BlockDeque *deque, bool front);
+static void         release_block (CC_BlockDeque *deque, void **block);
+static void         release_all   (CC_BlockDeque *deque);
+static enum cc_stat resize_map    (CC_BlockDeque *deque, size_t capacity);
+
+
+/**
+ * Returns the address of the slot at the specified index. The index must
+ * be within the bounds of the deque.
+ */
+static INLINE void **slot(CC_BlockDeque const * const deque, size_t index)
+{
+    size_t pos = deque->head + index;
+    return &(deque->map[deque->map_first + (pos >> deque->shift)][pos & deque->mask]);
+}
+
+/**
+ * Creates a new empty CC_BlockDeque and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_BlockDeque is to be
+ *                 stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_BlockDeque structure failed.
+ */
+enum cc_stat cc_block_deque_new(CC_BlockDeque **out)
+{
+    CC_BlockDequeConf conf;
+    cc_block_deque_conf_init(&conf);
+    return cc_block_deque_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_BlockDeque based on the specified CC_BlockDequeConf
+ * struct and returns a status code.
+ *
+ * The CC_BlockDeque is allocated using the allocators specified in the
+ * CC_BlockDequeConf struct. No blocks are allocated until the first element
+ * is added.
+ *
+ * @param[in] conf deque configuration structure
+ * @param[out] out pointer to where the newly created CC_BlockDeque is to be
+ *                 stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the block size is zero or too large, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_BlockDeque structure failed.
+ */
+enum cc_stat cc_block_deque_new_conf(CC_BlockDequeConf const * const conf, CC_BlockDeque **out)
+{
+    if (!conf->block_size || conf->block_size > (CC_MAX_ELEMENTS >> 2) / sizeof(void*))
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_BlockDeque *deque = conf->mem_calloc(1, sizeof(CC_BlockDeque));
+
+    if (!deque)
+        return CC_ERR_ALLOC;
+
+    void ***map = conf->mem_calloc(MIN_MAP_CAPACITY, sizeof(void**));
+
+    if (!map) {
+        conf->mem_free(deque);
+        return CC_ERR_ALLOC;
+    }
+
+    /* Round the block size up to the closest power of two */
+    size_t shift = 0;
+    while (((size_t) 1 << shift) < conf->block_size)
+        shift++;
+
+    deque->shift        = shift;
+    deque->mask         = ((size_t) 1 << shift) - 1;
+    deque->map          = map;
+    deque->map_capacity = MIN_MAP_CAPACITY;
+    deque->map_first    = MIN_MAP_CAPACITY / 2;
+    deque->mem_alloc    = conf->mem_alloc;
+    deque->mem_calloc   = conf->mem_calloc;
+    deque->mem_free     = conf->mem_free;
+
+    *out = deque;
+    return CC_OK;
+}
+
+/**
+ * Initializes the fields of the CC_BlockDequeConf struct to default values.
+ *
+ * @param[in, out] conf CC_BlockDequeConf structure that is being initialized
+ */
+void cc_block_deque_conf_init(CC_BlockDequeConf *conf)
+{
+    conf->block_size = DEFAULT_BLOCK_SIZE;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Destroys the CC_BlockDeque structure, but leaves the data it used to hold
+ * intact.
+ *
+ * @param[in] deque the deque that is to be destroyed
+ */
+void cc_block_deque_destroy(CC_BlockDeque *deque)
+{
+    release_all(deque);
+
+    if (deque->spare)
+        deque->mem_free(deque->spare);
+
+    deque->mem_free(deque->map);
+    deque->mem_free(deque);
+}
+
+/**
+ * Destroys the CC_BlockDeque structure along with all the data it holds.
+ *
+ * @note This function should not be called on a deque that has some of its
+ *       elements allocated on the stack.
+ *
+ * @param[in] deque the deque that is being destroyed
+ * @param[in] cb the callback that is invoked on each element
+ */
+void cc_block_deque_destroy_cb(CC_BlockDeque *deque, void (*cb) (void*))
+{
+    cc_block_deque_foreach(deque, cb);
+    cc_block_deque_destroy(deque);
+}
+
+/**
+ * Adds a new element to the front of the CC_BlockDeque. If the first block
+ * is full, a new block is added in front of it and none of the existing
+ * elements are moved.
+ *
+ * @param[in] deque the deque to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new block failed, or CC_ERR_MAX_CAPACITY if the
+ * block map is already at maximum capacity.
+ */
+enum cc_stat cc_block_deque_add_first(CC_BlockDeque *deque, void *element)
+{
+    if (deque->blocks == 0)
+        deque->head = 0;
+
+    if (deque->head == 0) {
+        enum cc_stat status = add_block(deque, true);
+        if (status != CC_OK)
+            return status;
+    }
+    deque->head--;
+    deque->size++;
+    *slot(deque, 0) = element;
+
+    return CC_OK;
+}
+
+/**
+ * Adds a new element to the back of the CC_BlockDeque. If the last block
+ * is full, a new block is added after it and none of the existing elements
+ * are moved.
+ *
+ * @param[in] deque the deque to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new block failed, or CC_ERR_MAX_CAPACITY if the
+ * block map is already at maximum capacity.
+ */
+enum cc_stat cc_block_deque_add_last(CC_BlockDeque *deque, void *element)
+{
+    if (deque->blocks == 0)
+        deque->head = 0;
+
+    if (((deque->head + deque->size) >> deque->shift) == deque->blocks) {
+        enum cc_stat status = add_block(deque, false);
+        if (status != CC_OK)
+            return status;
+    }
+    *slot(deque, deque->size) = element;
+    deque->size++;
+
+    return CC_OK;
+}
+
+/**
+ * Replaces a deque element at the specified index and optionally sets the
+ * out parameter to the value of the replaced element.
+ *
+ * @param[in] deque the deque whose element is being replaced
+ * @param[in] element the replacement element
+ * @param[in] index the index of the element being replaced
+ * @param[out] out pointer to where the replaced element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully replaced, or
+ * CC_ERR_OUT_OF_RANGE if the index was out of range.
+ */
+enum cc_stat cc_block_deque_replace_at(CC_BlockDeque *deque, void *element, size_t index, void **out)
+{
+    if (index >= deque->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    void **s = slot(deque, index);
+
+    if (out)
+        *out = *s;
+
+    *s = element;
+    return CC_OK;
+}
+
+/**
+ * Removes the first element of the deque and optionally sets the out
+ * parameter to the value of the removed element. The first block is
+ * released as soon as it no longer holds any elements.
+ *
+ * @param[in] deque the deque whose first element is being removed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_OUT_OF_RANGE if the deque is already empty.
+ */
+enum cc_stat cc_block_deque_remove_first(CC_BlockDeque *deque, void **out)
+{
+    if (deque->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (out)
+        *out = *slot(deque, 0);
+
+    deque->head++;
+    deque->size--;
+
+    if (deque->size == 0) {
+        release_all(deque);
+    } else if (deque->head > deque->mask) {
+        release_block(deque, deque->map[deque->map_first]);
+        deque->map_first++;
+        deque->blocks--;
+        deque->head = 0;
+    }
+    return CC_OK;
+}
+
+/**
+ * Removes the last element of the deque and optionally sets the out
+ * parameter to the value of the removed element. The last block is
+ * released as soon as it no longer holds any elements.
+ *
+ * @param[in] deque the deque whose last element is being removed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_OUT_OF_RANGE if the deque is already empty.
+ */
+enum cc_stat cc_block_deque_remove_last(CC_BlockDeque *deque, void **out)
+{
+    if (deque->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (out)
+        *out = *slot(deque, deque->size - 1);
+
+    deque->size--;
+
+    if (deque->size == 0) {
+        release_all(deque);
+    } else if (((deque->head + deque->size) & deque->mask) == 0) {
+        deque->blocks--;
+        release_block(deque, deque->map[deque->map_first + deque->blocks]);
+    }
+    return CC_OK;
+}
+
+/**
+ * Removes all elements from the deque and releases its blocks.
+ *
+ * @note This function keeps a single spare block. Call
+ *       cc_block_deque_trim_capacity() to release it.
+ *
+ * @param[in] deque the deque from which all elements are being removed
+ */
+void cc_block_deque_remove_all(CC_BlockDeque *deque)
+{
+    release_all(deque);
+}
+
+/**
+ * Gets a deque element from the specified index and sets the out parameter
+ * to its value.
+ *
+ * @param[in] deque the deque from which the element is being retrieved
+ * @param[in] index the index of the deque element
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the
+ * index was out of range.
+ */
+enum cc_stat cc_block_deque_get_at(CC_BlockDeque const * const deque, size_t index, void **out)
+{
+    if (index >= deque->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = *slot(deque, index);
+    return CC_OK;
+}
+
+/**
+ * Gets the first element of the deque and sets the out parameter to its
+ * value.
+ *
+ * @param[in] deque the deque whose first element is being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the
+ * deque is empty.
+ */
+enum cc_stat cc_block_deque_get_first(CC_BlockDeque const * const deque, void **out)
+{
+    return cc_block_deque_get_at(deque, 0, out);
+}
+
+/**
+ * Gets the last element of the deque and sets the out parameter to its
+ * value.
+ *
+ * @param[in] deque the deque whose last element is being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the
+ * deque is empty.
+ */
+enum cc_stat cc_block_deque_get_last(CC_BlockDeque const * const deque, void **out)
+{
+    if (deque->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = *slot(deque, deque->size - 1);
+    return CC_OK;
+}
+
+/**
+ * Sets the out parameter to the address of the slot that holds the element
+ * at the specified index. The address remains valid until the element is
+ * removed from the deque.
+ *
+ * @param[in] deque the deque whose slot is being returned
+ * @param[in] index the index of the deque element
+ * @param[out] out pointer to where the slot address is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the index
+ * was out of range.
+ */
+enum cc_stat cc_block_deque_peek(CC_BlockDeque *deque, size_t index, void ***out)
+{
+    if (index >= deque->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = slot(deque, index);
+    return CC_OK;
+}
+
+/**
+ * Releases the spare block and shrinks the block map to the smallest size
+ * that still fits the allocated blocks.
+ *
+ * @param[in] deque the deque whose capacity is being trimmed
+ *
+ * @return CC_OK if the capacity was trimmed, or CC_ERR_ALLOC if the memory
+ * allocation for the new map failed.
+ */
+enum cc_stat cc_block_deque_trim_capacity(CC_BlockDeque *deque)
+{
+    if (deque->spare) {
+        deque->mem_free(deque->spare);
+        deque->spare = NULL;
+    }
+
+    size_t capacity = MIN_MAP_CAPACITY;
+    while (capacity < deque->blocks * 2)
+        capacity <<= 1;
+
+    if (capacity >= deque->map_capacity)
+        return CC_OK;
+
+    return resize_map(deque, capacity);
+}
+
+/**
+ * Returns the number of elements that are currently stored in the deque.
+ *
+ * @param[in] deque the deque whose size is being returned
+ *
+ * @return the number of elements within the deque.
+ */
+size_t cc_block_deque_size(CC_BlockDeque const * const deque)
+{
+    return deque->size;
+}
+
+/**
+ * Returns the number of element slots in the blocks that are currently
+ * allocated by the deque, not counting the spare block.
+ *
+ * @param[in] deque the deque whose capacity is being returned
+ *
+ * @return the capacity of the deque.
+ */
+size_t cc_block_deque_capacity(CC_BlockDeque const * const deque)
+{
+    return deque->blocks << deque->shift;
+}
+
+/**
+ * Applies the function fn to each element of the deque, from the first to
+ * the last element.
+ *
+ * @param[in] deque the deque on which this operation is performed
+ * @param[in] fn the operation function that is to be invoked on each element
+ */
+void cc_block_deque_foreach(CC_BlockDeque *deque, void (*fn) (void*))
+{
+    size_t remaining = deque->size;
+    size_t offset    = deque->head;
+    size_t b;
+
+    /* Walk the blocks directly instead of resolving every index */
+    for (b = 0; remaining > 0; b++) {
+        void **block = deque->map[deque->map_first + b];
+        size_t n = deque->mask + 1 - offset;
+        size_t i;
+
+        if (n > remaining)
+            n = remaining;
+
+        for (i = 0; i < n; i++)
+            fn(block[offset + i]);
+
+        remaining -= n;
+        offset = 0;
+    }
+}
+
+/**
+ * Adds an empty block to the front or the back of the allocated blocks,
+ * growing or recentering the block map if there is no free map slot on
+ * that side. Only the block pointers are ever moved, never the elements.
+ *
+ * @param[in] deque the deque to which the block is being added
+ * @param[in] front true if the block is added in front of the first block
+ *
+ * @return CC_OK if the block was added, CC_ERR_ALLOC if the memory
+ * allocation for the block or the new map failed, or CC_ERR_MAX_CAPACITY if
+ * the block map is already at maximum capacity.
+ */
+static enum cc_stat add_block(CC_BlockDeque *deque, bool front)
+{
+    bool full = front ? deque->map_first == 0
+                      : deque->map_first + deque->blocks == deque->map_capacity;
+
+    if (full) {
+        if (deque->blocks + 1 > CC_MAX_ELEMENTS / sizeof(void**) / 2)
+            return CC_ERR_MAX_CAPACITY;
+
+        size_t capacity = deque->map_capacity;
+        while (capacity < (deque->blocks + 1) * 2)
+            capacity <<= 1;
+
+        enum cc_stat status = resize_map(deque, capacity);
+        if (status != CC_OK)
+            return status;
+    }
+
+    void **block = deque->spare;
+
+    if (block) {
+        deque->spare = NULL;
+    } else {
+        block = deque->mem_alloc((deque->mask + 1) * sizeof(void*));
+        if (!block)
+            return CC_ERR_ALLOC;
+    }
+
+    if (front) {
+        deque->map_first--;
+        deque->map[deque->map_first] = block;
+        deque->head += deque->mask + 1;
+    } else {
+        deque->map[deque->map_first + deque->blocks] = block;
+    }
+    deque->blocks++;
+
+    return CC_OK;
+}
+
+/**
+ * Moves the allocated blocks to the middle of a block map of the specified
+ * capacity, which must be at least twice the number of blocks. The map is
+ * reused if its capacity does not change.
+ *
+ * @param[in] deque the deque whose map is being resized
+ * @param[in] capacity the new capacity of the map
+ *
+ * @return CC_OK if the map was resized, CC_ERR_ALLOC if the memory
+ * allocation for the new map failed, or CC_ERR_MAX_CAPACITY if the new map
+ * would exceed the maximum capacity.
+ */
+static enum cc_stat resize_map(CC_BlockDeque *deque, size_t capacity)
+{
+    size_t first = (capacity - deque->blocks) / 2;
+
+    if (capacity == deque->map_capacity) {
+        memmove(&(deque->map[first]),
+                &(deque->map[deque->map_first]),
+                deque->blocks * sizeof(void**));
+    } else {
+        if (capacity > CC_MAX_ELEMENTS / sizeof(void**))
+            return CC_ERR_MAX_CAPACITY;
+
+        void ***map = deque->mem_alloc(capacity * sizeof(void**));
+
+        if (!map)
+            return CC_ERR_ALLOC;
+
+        if (deque->blocks) {
+            memcpy(&(map[first]),
+                   &(deque->map[deque->map_first]),
+                   deque->blocks * sizeof(void**));
+        }
+        deque->mem_free(deque->map);
+        deque->map          = map;
+        deque->map_capacity = capacity;
+    }
+    deque->map_first = first;
+
+    return CC_OK;
+}
+
+/**
+ * Releases a block that no longer holds any elements. The block is kept as
+ * the spare block if there isn't one already.
+ */
+static void release_block(CC_BlockDeque *deque, void **block)
+{
+    if (!deque->spare)
+        deque->spare = block;
+    else
+        deque->mem_free(block);
+}
+
+/**
+ * Releases all blocks and recenters the empty map.
+ */
+static void release_all(CC_BlockDeque *deque)
+{
+    size_t b;
+    for (b = 0; b < deque->blocks; b++)
+        release_block(deque, deque->map[deque->map_first + b]);
+
+    deque->blocks    = 0;
+    deque->size      = 0;
+    deque->head      = 0;
+    deque->map_first = deque->map_capacity / 2;
+}
+
+/**
+ * Initializes the iterator.
+ *
+ * @param[in] iter the iterator that is being initialized
+ * @param[in] deque the deque to iterate over
+ */
+void cc_block_deque_iter_init(CC_BlockDequeIter *iter, CC_BlockDeque *deque)
+{
+    iter->deque = deque;
+    iter->index = 0;
+}
+
+/**
+ * Advances the iterator and sets the out parameter to the value of the
+ * next element in the sequence.
+ *
+ * @param[in] iter the iterator that is being advanced
+ * @param[out] out pointer to where the next element is set
+ *
+ * @return CC_OK if the iterator was advanced, or CC_ITER_END if the
+ * end of the CC_BlockDeque has been reached.
+ */
+enum cc_stat cc_block_deque_iter_next(CC_BlockDequeIter *iter, void **out)
+{
+    if (iter->index >= iter->deque->size)
+        return CC_ITER_END;
+
+    *out = *slot(iter->deque, iter->index);
+    iter->index++;
+
+    return CC_OK;
+}
+
+/**
+ * Replaces the last returned element by <code>cc_block_deque_iter_next()</code>
+ * with the specified element and optionally sets the out parameter to
+ * the value of the replaced element.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the replacement element
+ * @param[out] out pointer to where the replaced element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was replaced successfully, or
+ * CC_ERR_OUT_OF_RANGE if the iterator has not returned an element yet.
+ */
+enum cc_stat cc_block_deque_iter_replace(CC_BlockDequeIter *iter, void *element, void **out)
+{
+    if (iter->index == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    return cc_block_deque_replace_at(iter->deque, element, iter->index - 1, out);
+}
+
+/**
+ * Returns the size of the CC_BlockDeque structure.
+ */
+size_t cc_block_deque_struct_size()
+{
+    return sizeof(CC_BlockDeque);
+}
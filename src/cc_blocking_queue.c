@@ -0,0 +1,575 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#include "cc_deque.h"
+#include "cc_blocking_queue.h"
+
+#define WAIT_FOREVER UINT64_MAX
+
+/* Number of attempts at taking the lock before the thread parks. */
+#define LOCK_SPINS 100
+
+/*
+ * The state of the queue is guarded by a futex based lock. Each of the
+ * two conditions a thread can wait for (the queue is not empty, the
+ * queue is not full) is a futex word that is bumped, under the lock,
+ * whenever the condition may have become true while somebody is waiting
+ * for it. A waiter reads the word under the lock and parks only if the
+ * word still holds that value, so no wakeup is lost between releasing
+ * the lock and parking. Since the words are only bumped when the waiter
+ * counts are nonzero, enqueue and poll don't make a system call unless
+ * another thread is actually parked.
+ */
+struct cc_blocking_queue_s {
+    atomic_uint  lock;
+    size_t       poll_waiters;
+    size_t       enqueue_waiters;
+    bool         closed;
+    CC_Deque    *deque;
+    size_t       capacity;
+
+    atomic_uint  not_empty;
+    char         not_empty_pad[CC_CACHE_LINE_SIZE - sizeof(atomic_uint)];
+    atomic_uint  not_full;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static void         lock_queue   (CC_BlockingQueue *queue);
+static void         unlock_queue (CC_BlockingQueue *queue);
+static void         notify       (atomic_uint *word, size_t waiters, bool all);
+static enum cc_stat put          (CC_BlockingQueue *queue, void *element, uint64_t timeout_ms);
+static enum cc_stat take         (CC_BlockingQueue *queue, void **out, uint64_t timeout_ms);
+static uint64_t     now_ms       (void);
+static uint64_t     deadline_of  (uint64_t timeout_ms);
+static void         futex_wait   (atomic_uint *word, unsigned expected, uint64_t timeout_ms);
+static void         futex_wake   (atomic_uint *word, bool all);
+
+
+/**
+ * Initializes the fields of the CC_BlockingQueueConf struct to default values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_blocking_queue_conf_init(CC_BlockingQueueConf *conf)
+{
+    conf->capacity   = 0;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Creates a new empty, unbounded CC_BlockingQueue and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_BlockingQueue is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_BlockingQueue structure failed.
+ */
+enum cc_stat cc_blocking_queue_new(CC_BlockingQueue **out)
+{
+    CC_BlockingQueueConf conf;
+    cc_blocking_queue_conf_init(&conf);
+    return cc_blocking_queue_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_BlockingQueue based on the specified
+ * CC_BlockingQueueConf struct and returns a status code.
+ *
+ * @param[in] conf CC_BlockingQueue configuration struct. All fields must be
+ *                 initialized.
+ * @param[out] out pointer to where the newly created CC_BlockingQueue is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_BlockingQueue structure failed.
+ */
+enum cc_stat cc_blocking_queue_new_conf(CC_BlockingQueueConf const * const conf, CC_BlockingQueue **out)
+{
+    CC_BlockingQueue *queue = conf->mem_calloc(1, sizeof(CC_BlockingQueue));
+
+    if (!queue)
+        return CC_ERR_ALLOC;
+
+    CC_DequeConf dconf;
+    cc_deque_conf_init(&dconf);
+    dconf.mem_alloc  = conf->mem_alloc;
+    dconf.mem_calloc = conf->mem_calloc;
+    dconf.mem_free   = conf->mem_free;
+
+    if (conf->capacity && conf->capacity < dconf.capacity)
+        dconf.capacity = conf->capacity;
+
+    if (cc_deque_new_conf(&dconf, &queue->deque) != CC_OK) {
+        conf->mem_free(queue);
+        return CC_ERR_ALLOC;
+    }
+
+    atomic_init(&queue->lock, 0);
+    atomic_init(&queue->not_empty, 0);
+    atomic_init(&queue->not_full, 0);
+
+    queue->capacity   = conf->capacity;
+    queue->mem_alloc  = conf->mem_alloc;
+    queue->mem_calloc = conf->mem_calloc;
+    queue->mem_free   = conf->mem_free;
+
+    *out = queue;
+    return CC_OK;
+}
+
+/**
+ * Destroys the queue structure, but leaves the data it holds intact. No
+ * thread may be using or waiting on the queue.
+ *
+ * @param[in] queue the queue that is to be destroyed
+ */
+void cc_blocking_queue_destroy(CC_BlockingQueue *queue)
+{
+    cc_deque_destroy(queue->deque);
+    queue->mem_free(queue);
+}
+
+/**
+ * Destroys the queue structure and calls the callback function on each
+ * element that is still in the queue. No thread may be using or waiting
+ * on the queue.
+ *
+ * @param[in] queue the queue that is to be destroyed
+ * @param[in] cb the callback function
+ */
+void cc_blocking_queue_destroy_cb(CC_BlockingQueue *queue, void (*cb) (void*))
+{
+    cc_deque_destroy_cb(queue->deque, cb);
+    queue->mem_free(queue);
+}
+
+/**
+ * Returns the size of the CC_BlockingQueue structure.
+ */
+size_t cc_blocking_queue_struct_size()
+{
+    return sizeof(CC_BlockingQueue);
+}
+
+/**
+ * Adds an element to the back of the queue, waiting for room if the queue
+ * is bounded and full.
+ *
+ * @param[in] queue the queue to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was added, CC_ERR_CLOSED if the queue is
+ * or gets closed, or CC_ERR_ALLOC if the queue storage could not grow.
+ */
+enum cc_stat cc_blocking_queue_enqueue(CC_BlockingQueue *queue, void *element)
+{
+    return put(queue, element, WAIT_FOREVER);
+}
+
+/**
+ * Adds an element to the back of the queue if there is room for it.
+ *
+ * @param[in] queue the queue to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was added, CC_ERR_MAX_CAPACITY if the queue
+ * is full, CC_ERR_CLOSED if the queue is closed, or CC_ERR_ALLOC if the
+ * queue storage could not grow.
+ */
+enum cc_stat cc_blocking_queue_try_enqueue(CC_BlockingQueue *queue, void *element)
+{
+    return put(queue, element, 0);
+}
+
+/**
+ * Adds an element to the back of the queue, waiting at most timeout_ms
+ * milliseconds for room if the queue is full.
+ *
+ * @param[in] queue the queue to which the element is being added
+ * @param[in] element the element that is being added
+ * @param[in] timeout_ms the maximum time to wait, in milliseconds
+ *
+ * @return CC_OK if the element was added, CC_ERR_TIMEOUT if the queue
+ * remained full, CC_ERR_CLOSED if the queue is or gets closed, or
+ * CC_ERR_ALLOC if the queue storage could not grow.
+ */
+enum cc_stat cc_blocking_queue_enqueue_timed(CC_BlockingQueue *queue, void *element, uint64_t timeout_ms)
+{
+    enum cc_stat stat = put(queue, element, timeout_ms);
+    return stat == CC_ERR_MAX_CAPACITY ? CC_ERR_TIMEOUT : stat;
+}
+
+/**
+ * Removes the element at the front of the queue, waiting for one if the
+ * queue is empty.
+ *
+ * @param[in] queue the queue from which the element is being removed
+ * @param[out] out pointer to where the removed element is stored
+ *
+ * @return CC_OK if an element was removed, or CC_ERR_CLOSED if the queue
+ * is closed and has no more elements.
+ */
+enum cc_stat cc_blocking_queue_poll(CC_BlockingQueue *queue, void **out)
+{
+    return take(queue, out, WAIT_FOREVER);
+}
+
+/**
+ * Removes the element at the front of the queue if there is one.
+ *
+ * @param[in] queue the queue from which the element is being removed
+ * @param[out] out pointer to where the removed element is stored
+ *
+ * @return CC_OK if an element was removed, CC_ERR_OUT_OF_RANGE if the
+ * queue is empty, or CC_ERR_CLOSED if the queue is closed and has no more
+ * elements.
+ */
+enum cc_stat cc_blocking_queue_try_poll(CC_BlockingQueue *queue, void **out)
+{
+    return take(queue, out, 0);
+}
+
+/**
+ * Removes the element at the front of the queue, waiting at most
+ * timeout_ms milliseconds for one if the queue is empty.
+ *
+ * @param[in] queue the queue from which the element is being removed
+ * @param[out] out pointer to where the removed element is stored
+ * @param[in] timeout_ms the maximum time to wait, in milliseconds
+ *
+ * @return CC_OK if an element was removed, CC_ERR_TIMEOUT if the queue
+ * remained empty, or CC_ERR_CLOSED if the queue is closed and has no more
+ * elements.
+ */
+enum cc_stat cc_blocking_queue_poll_timed(CC_BlockingQueue *queue, void **out, uint64_t timeout_ms)
+{
+    enum cc_stat stat = take(queue, out, timeout_ms);
+    return stat == CC_ERR_OUT_OF_RANGE ? CC_ERR_TIMEOUT : stat;
+}
+
+/**
+ * Removes up to n elements from the front of the queue without waiting.
+ * Used to empty a closed queue, or to take a batch of work at once.
+ *
+ * @param[in] queue the queue from which the elements are being removed
+ * @param[out] out array of at least n pointers where the removed elements
+ *                 are stored
+ * @param[in] n the maximum number of elements to remove
+ *
+ * @return the number of elements that were removed.
+ */
+size_t cc_blocking_queue_drain(CC_BlockingQueue *queue, void **out, size_t n)
+{
+    lock_queue(queue);
+
+    n = cc_deque_remove_first_n(queue->deque, out, n);
+
+    size_t waiters = n ? queue->enqueue_waiters : 0;
+    if (waiters)
+        atomic_fetch_add_explicit(&queue->not_full, 1, memory_order_relaxed);
+
+    unlock_queue(queue);
+    notify(&queue->not_full, waiters, true);
+
+    return n;
+}
+
+/**
+ * Closes the queue. Enqueuing into a closed queue fails with CC_ERR_CLOSED,
+ * while polling keeps returning the remaining elements and fails with
+ * CC_ERR_CLOSED once the queue is empty. All waiting threads are woken up.
+ *
+ * @param[in] queue the queue that is being closed
+ */
+void cc_blocking_queue_close(CC_BlockingQueue *queue)
+{
+    lock_queue(queue);
+
+    queue->closed = true;
+    atomic_fetch_add_explicit(&queue->not_empty, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&queue->not_full, 1, memory_order_relaxed);
+
+    size_t poll_waiters    = queue->poll_waiters;
+    size_t enqueue_waiters = queue->enqueue_waiters;
+
+    unlock_queue(queue);
+
+    notify(&queue->not_empty, poll_waiters, true);
+    notify(&queue->not_full, enqueue_waiters, true);
+}
+
+/**
+ * Returns true if the queue was closed.
+ */
+bool cc_blocking_queue_is_closed(CC_BlockingQueue *queue)
+{
+    lock_queue(queue);
+    bool closed = queue->closed;
+    unlock_queue(queue);
+
+    return closed;
+}
+
+/**
+ * Returns the number of elements in the queue at the time of the call.
+ */
+size_t cc_blocking_queue_size(CC_BlockingQueue *queue)
+{
+    lock_queue(queue);
+    size_t size = cc_deque_size(queue->deque);
+    unlock_queue(queue);
+
+    return size;
+}
+
+/**
+ * Returns the maximum number of elements the queue can hold, or 0 if the
+ * queue is unbounded.
+ */
+size_t cc_blocking_queue_capacity(CC_BlockingQueue *queue)
+{
+    return queue->capacity;
+}
+
+/**
+ * Enqueues the element, waiting at most timeout_ms milliseconds for room.
+ * A timeout of 0 doesn't wait at all.
+ */
+static enum cc_stat put(CC_BlockingQueue *queue, void *element, uint64_t timeout_ms)
+{
+    uint64_t deadline = deadline_of(timeout_ms);
+
+    lock_queue(queue);
+
+    for (;;) {
+        if (queue->closed) {
+            unlock_queue(queue);
+            return CC_ERR_CLOSED;
+        }
+        if (!queue->capacity || cc_deque_size(queue->deque) < queue->capacity)
+            break;
+
+        uint64_t now = deadline == WAIT_FOREVER ? 0 : now_ms();
+        if (deadline != WAIT_FOREVER && now >= deadline) {
+            unlock_queue(queue);
+            return CC_ERR_MAX_CAPACITY;
+        }
+        unsigned seq = atomic_load_explicit(&queue->not_full, memory_order_relaxed);
+        queue->enqueue_waiters++;
+        unlock_queue(queue);
+
+        futex_wait(&queue->not_full, seq,
+                   deadline == WAIT_FOREVER ? WAIT_FOREVER : deadline - now);
+
+        lock_queue(queue);
+        queue->enqueue_waiters--;
+    }
+
+    enum cc_stat stat = cc_deque_add_last(queue->deque, element);
+
+    size_t waiters = stat == CC_OK ? queue->poll_waiters : 0;
+    if (waiters)
+        atomic_fetch_add_explicit(&queue->not_empty, 1, memory_order_relaxed);
+
+    unlock_queue(queue);
+    notify(&queue->not_empty, waiters, false);
+
+    return stat;
+}
+
+/**
+ * Polls an element, waiting at most timeout_ms milliseconds for one. A
+ * timeout of 0 doesn't wait at all.
+ */
+static enum cc_stat take(CC_BlockingQueue *queue, void **out, uint64_t timeout_ms)
+{
+    uint64_t deadline = deadline_of(timeout_ms);
+
+    lock_queue(queue);
+
+    for (;;) {
+        if (cc_deque_size(queue->deque) > 0)
+            break;
+
+        if (queue->closed) {
+            unlock_queue(queue);
+            return CC_ERR_CLOSED;
+        }
+        uint64_t now = deadline == WAIT_FOREVER ? 0 : now_ms();
+        if (deadline != WAIT_FOREVER && now >= deadline) {
+            unlock_queue(queue);
+            return CC_ERR_OUT_OF_RANGE;
+        }
+        unsigned seq = atomic_load_explicit(&queue->not_empty, memory_order_relaxed);
+        queue->poll_waiters++;
+        unlock_queue(queue);
+
+        futex_wait(&queue->not_empty, seq,
+                   deadline == WAIT_FOREVER ? WAIT_FOREVER : deadline - now);
+
+        lock_queue(queue);
+        queue->poll_waiters--;
+    }
+
+    cc_deque_remove_first(queue->deque, out);
+
+    size_t waiters = queue->enqueue_waiters;
+    if (waiters)
+        atomic_fetch_add_explicit(&queue->not_full, 1, memory_order_relaxed);
+
+    unlock_queue(queue);
+    notify(&queue->not_full, waiters, false);
+
+    return CC_OK;
+}
+
+/**
+ * Wakes up one or all of the threads parked on a condition word if there
+ * are any.
+ */
+static void notify(atomic_uint *word, size_t waiters, bool all)
+{
+    if (waiters)
+        futex_wake(word, all);
+}
+
+/*
+ * The lock word is 0 when the lock is free, 1 when it is taken and 2
+ * when it is taken and other threads may be parked on it.
+ */
+static void lock_queue(CC_BlockingQueue *queue)
+{
+    unsigned c = 0;
+
+    for (int i = 0; i < LOCK_SPINS; i++) {
+        c = 0;
+        if (atomic_compare_exchange_weak_explicit(&queue->lock, &c, 1,
+                                                  memory_order_acquire,
+                                                  memory_order_relaxed))
+            return;
+    }
+    if (c != 2)
+        c = atomic_exchange_explicit(&queue->lock, 2, memory_order_acquire);
+
+    while (c != 0) {
+        futex_wait(&queue->lock, 2, WAIT_FOREVER);
+        c = atomic_exchange_explicit(&queue->lock, 2, memory_order_acquire);
+    }
+}
+
+static void unlock_queue(CC_BlockingQueue *queue)
+{
+    if (atomic_exchange_explicit(&queue->lock, 0, memory_order_release) == 2)
+        futex_wake(&queue->lock, false);
+}
+
+/**
+ * Returns a monotonic timestamp in milliseconds.
+ */
+static uint64_t now_ms(void)
+{
+#if defined(_WIN32)
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000 + (uint64_t) ts.tv_nsec / 1000000;
+#endif
+}
+
+/**
+ * Returns the time at which a wait of timeout_ms milliseconds that starts
+ * now ends.
+ */
+static uint64_t deadline_of(uint64_t timeout_ms)
+{
+    if (timeout_ms == WAIT_FOREVER)
+        return WAIT_FOREVER;
+
+    uint64_t now = now_ms();
+    return timeout_ms >= WAIT_FOREVER - now ? WAIT_FOREVER : now + timeout_ms;
+}
+
+/**
+ * Parks the calling thread while the word holds the expected value, for
+ * at most timeout_ms milliseconds. May return early; callers recheck
+ * their condition.
+ */
+static void futex_wait(atomic_uint *word, unsigned expected, uint64_t timeout_ms)
+{
+#if defined(__linux__)
+    struct timespec ts;
+    struct timespec *timeout = NULL;
+
+    if (timeout_ms != WAIT_FOREVER) {
+        ts.tv_sec  = (time_t) (timeout_ms / 1000);
+        ts.tv_nsec = (long) (timeout_ms % 1000) * 1000000;
+        timeout    = &ts;
+    }
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+#elif defined(_WIN32)
+    DWORD ms = timeout_ms >= INFINITE ? INFINITE : (DWORD) timeout_ms;
+    WaitOnAddress(word, &expected, sizeof(expected), ms);
+#else
+    /* No address based wait; poll the word with short sleeps. */
+    struct timespec ts = {0, 100000};
+    uint64_t deadline = deadline_of(timeout_ms);
+
+    while (atomic_load_explicit(word, memory_order_relaxed) == expected &&
+           (deadline == WAIT_FOREVER || now_ms() < deadline))
+        nanosleep(&ts, NULL);
+#endif
+}
+
+/**
+ * Wakes up one or all of the threads parked on the word.
+ */
+static void futex_wake(atomic_uint *word, bool all)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1, NULL, NULL, 0);
+#elif defined(_WIN32)
+    if (all)
+        WakeByAddressAll(word);
+    else
+        WakeByAddressSingle(word);
+#else
+    (void) word;
+    (void) all;
+#endif
+}
@@ -0,0 +1,477 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdatomic.h>
+
+#include "cc_byte_ring_buffer.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define CC_MIRROR_AVAILABLE
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#define CC_MIRROR_AVAILABLE
+#endif
+
+#define DEFAULT_CAPACITY 65536
+
+/* Number of attempts at finding an address range for both views on
+ * systems that can't map over a reservation. */
+#define MAP_ATTEMPTS 16
+
+/*
+ * head and tail are free running byte counters, laid out like the
+ * counters of CC_Rbuf: the consumer's fields and the producer's fields
+ * live on separate cache lines and each side caches the other side's
+ * counter.
+ */
+struct cc_byte_rbuf_s {
+    atomic_size_t tail;
+    size_t        head_cache;
+    char          tail_pad[CC_CACHE_LINE_SIZE - sizeof(atomic_size_t) - sizeof(size_t)];
+
+    atomic_size_t head;
+    size_t        tail_cache;
+    char          head_pad[CC_CACHE_LINE_SIZE - sizeof(atomic_size_t) - sizeof(size_t)];
+
+    size_t   capacity;
+    size_t   mask;
+    uint8_t *buf;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static size_t   map_granularity (void);
+static uint8_t *map_mirrored    (size_t bytes);
+static void     unmap_mirrored  (uint8_t *addr, size_t bytes);
+
+
+/**
+ * Initializes the fields of the CC_ByteRbufConf struct to default values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_byte_rbuf_conf_init(CC_ByteRbufConf *conf)
+{
+    conf->capacity   = DEFAULT_CAPACITY;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Creates a new empty CC_ByteRbuf and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_ByteRbuf is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * buffer could not be allocated or mapped.
+ */
+enum cc_stat cc_byte_rbuf_new(CC_ByteRbuf **out)
+{
+    CC_ByteRbufConf conf;
+    cc_byte_rbuf_conf_init(&conf);
+    return cc_byte_rbuf_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_ByteRbuf based on the specified CC_ByteRbufConf
+ * struct and returns a status code.
+ *
+ * @param[in] conf CC_ByteRbuf configuration struct. All fields must be
+ *                 initialized.
+ * @param[out] out pointer to where the newly created CC_ByteRbuf is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is 0 or too large to be mapped twice, or CC_ERR_ALLOC if
+ * the buffer could not be allocated or mapped.
+ */
+enum cc_stat cc_byte_rbuf_new_conf(CC_ByteRbufConf const * const conf, CC_ByteRbuf **out)
+{
+    if (conf->capacity == 0 || conf->capacity > MAX_POW_TWO / 2)
+        return CC_ERR_INVALID_CAPACITY;
+
+    size_t capacity = map_granularity();
+    while (capacity < conf->capacity)
+        capacity <<= 1;
+
+    CC_ByteRbuf *rbuf = conf->mem_calloc(1, sizeof(CC_ByteRbuf));
+
+    if (!rbuf)
+        return CC_ERR_ALLOC;
+
+    rbuf->buf = map_mirrored(capacity);
+
+    if (!rbuf->buf) {
+        conf->mem_free(rbuf);
+        return CC_ERR_ALLOC;
+    }
+
+    atomic_init(&rbuf->head, 0);
+    atomic_init(&rbuf->tail, 0);
+
+    rbuf->head_cache = 0;
+    rbuf->tail_cache = 0;
+    rbuf->capacity   = capacity;
+    rbuf->mask       = capacity - 1;
+    rbuf->mem_alloc  = conf->mem_alloc;
+    rbuf->mem_calloc = conf->mem_calloc;
+    rbuf->mem_free   = conf->mem_free;
+
+    *out = rbuf;
+    return CC_OK;
+}
+
+/**
+ * Destroys the buffer and unmaps its storage.
+ *
+ * @param[in] rbuf the buffer that is to be destroyed
+ */
+void cc_byte_rbuf_destroy(CC_ByteRbuf *rbuf)
+{
+    unmap_mirrored(rbuf->buf, rbuf->capacity);
+    rbuf->mem_free(rbuf);
+}
+
+/**
+ * Returns the size of the CC_ByteRbuf structure.
+ */
+size_t cc_byte_rbuf_struct_size()
+{
+    return sizeof(CC_ByteRbuf);
+}
+
+/**
+ * Returns a pointer to n contiguous free bytes at the write position of
+ * the buffer. The bytes become readable only once they are committed with
+ * cc_byte_rbuf_commit(). Producer side.
+ *
+ * @param[in] rbuf the buffer in which the bytes are being reserved
+ * @param[in] n the number of bytes to reserve
+ * @param[out] out pointer to where the address of the reserved bytes is
+ *                 stored
+ *
+ * @return CC_OK if the bytes were reserved, or CC_ERR_MAX_CAPACITY if the
+ * buffer has less than n free bytes.
+ */
+enum cc_stat cc_byte_rbuf_reserve(CC_ByteRbuf *rbuf, size_t n, void **out)
+{
+    size_t head = atomic_load_explicit(&rbuf->head, memory_order_relaxed);
+
+    if (n > rbuf->capacity - (head - rbuf->tail_cache)) {
+        rbuf->tail_cache = atomic_load_explicit(&rbuf->tail, memory_order_acquire);
+        if (n > rbuf->capacity - (head - rbuf->tail_cache))
+            return CC_ERR_MAX_CAPACITY;
+    }
+    *out = rbuf->buf + (head & rbuf->mask);
+    return CC_OK;
+}
+
+/**
+ * Makes the first n bytes at the write position readable. Producer side.
+ *
+ * @param[in] rbuf the buffer whose bytes are being committed
+ * @param[in] n the number of bytes to commit
+ *
+ * @return CC_OK if the bytes were committed, or CC_ERR_OUT_OF_RANGE if the
+ * buffer has less than n free bytes.
+ */
+enum cc_stat cc_byte_rbuf_commit(CC_ByteRbuf *rbuf, size_t n)
+{
+    void *ptr;
+
+    if (cc_byte_rbuf_reserve(rbuf, n, &ptr) != CC_OK)
+        return CC_ERR_OUT_OF_RANGE;
+
+    size_t head = atomic_load_explicit(&rbuf->head, memory_order_relaxed);
+    atomic_store_explicit(&rbuf->head, head + n, memory_order_release);
+
+    return CC_OK;
+}
+
+/**
+ * Returns all the readable bytes of the buffer as a single contiguous
+ * region. The bytes remain in the buffer until they are consumed with
+ * cc_byte_rbuf_consume(). Consumer side.
+ *
+ * @param[in] rbuf the buffer whose bytes are being read
+ * @param[out] out pointer to where the address of the readable bytes is
+ *                 stored
+ *
+ * @return the number of readable bytes.
+ */
+size_t cc_byte_rbuf_peek(CC_ByteRbuf *rbuf, void **out)
+{
+    size_t tail = atomic_load_explicit(&rbuf->tail, memory_order_relaxed);
+
+    rbuf->head_cache = atomic_load_explicit(&rbuf->head, memory_order_acquire);
+
+    *out = rbuf->buf + (tail & rbuf->mask);
+    return rbuf->head_cache - tail;
+}
+
+/**
+ * Removes the first n readable bytes from the buffer. Consumer side.
+ *
+ * @param[in] rbuf the buffer whose bytes are being consumed
+ * @param[in] n the number of bytes to consume
+ *
+ * @return CC_OK if the bytes were consumed, or CC_ERR_OUT_OF_RANGE if the
+ * buffer holds less than n bytes.
+ */
+enum cc_stat cc_byte_rbuf_consume(CC_ByteRbuf *rbuf, size_t n)
+{
+    size_t tail = atomic_load_explicit(&rbuf->tail, memory_order_relaxed);
+
+    if (n > rbuf->head_cache - tail) {
+        rbuf->head_cache = atomic_load_explicit(&rbuf->head, memory_order_acquire);
+        if (n > rbuf->head_cache - tail)
+            return CC_ERR_OUT_OF_RANGE;
+    }
+    atomic_store_explicit(&rbuf->tail, tail + n, memory_order_release);
+
+    return CC_OK;
+}
+
+/**
+ * Copies up to n bytes into the buffer. Producer side.
+ *
+ * @param[in] rbuf the buffer to which the bytes are being written
+ * @param[in] data the bytes that are being written
+ * @param[in] n the number of bytes to write
+ *
+ * @return the number of bytes written, which is less than n if the
+ * buffer didn't have enough free space.
+ */
+size_t cc_byte_rbuf_write(CC_ByteRbuf *rbuf, const void *data, size_t n)
+{
+    size_t free_space = cc_byte_rbuf_free_space(rbuf);
+    void *ptr;
+
+    if (n > free_space)
+        n = free_space;
+
+    if (n == 0)
+        return 0;
+
+    cc_byte_rbuf_reserve(rbuf, n, &ptr);
+    memcpy(ptr, data, n);
+    cc_byte_rbuf_commit(rbuf, n);
+
+    return n;
+}
+
+/**
+ * Copies up to n bytes out of the buffer and consumes them. Consumer side.
+ *
+ * @param[in] rbuf the buffer from which the bytes are being read
+ * @param[out] out array of at least n bytes where the bytes are stored
+ * @param[in] n the maximum number of bytes to read
+ *
+ * @return the number of bytes read.
+ */
+size_t cc_byte_rbuf_read(CC_ByteRbuf *rbuf, void *out, size_t n)
+{
+    void *ptr;
+    size_t size = cc_byte_rbuf_peek(rbuf, &ptr);
+
+    if (n > size)
+        n = size;
+
+    if (n == 0)
+        return 0;
+
+    memcpy(out, ptr, n);
+    cc_byte_rbuf_consume(rbuf, n);
+
+    return n;
+}
+
+/**
+ * Returns the number of readable bytes in the buffer. While the other
+ * side is using the buffer, the value is only a snapshot.
+ */
+size_t cc_byte_rbuf_size(CC_ByteRbuf *rbuf)
+{
+    size_t tail = atomic_load_explicit(&rbuf->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&rbuf->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+/**
+ * Returns the number of bytes that can be written into the buffer.
+ * Producer side.
+ */
+size_t cc_byte_rbuf_free_space(CC_ByteRbuf *rbuf)
+{
+    size_t head = atomic_load_explicit(&rbuf->head, memory_order_relaxed);
+
+    rbuf->tail_cache = atomic_load_explicit(&rbuf->tail, memory_order_acquire);
+
+    return rbuf->capacity - (head - rbuf->tail_cache);
+}
+
+/**
+ * Returns the capacity of the buffer in bytes.
+ */
+size_t cc_byte_rbuf_capacity(CC_ByteRbuf *rbuf)
+{
+    return rbuf->capacity;
+}
+
+/**
+ * Returns the granularity in which views of a memory object can be
+ * mapped.
+ */
+static size_t map_granularity(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#elif defined(CC_MIRROR_AVAILABLE)
+    return (size_t) sysconf(_SC_PAGESIZE);
+#else
+    return 1;
+#endif
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * Returns a file descriptor of an anonymous shared memory object.
+ */
+static int anonymous_fd(void)
+{
+#if defined(__linux__)
+    return memfd_create("cc_byte_rbuf", MFD_CLOEXEC);
+#else
+    static atomic_uint counter;
+    char name[64];
+
+    snprintf(name, sizeof(name), "/cc_byte_rbuf.%ld.%u", (long) getpid(),
+             atomic_fetch_add(&counter, 1));
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+        shm_unlink(name);
+    return fd;
+#endif
+}
+#endif
+
+/**
+ * Maps the same bytes long memory object into two adjacent address
+ * ranges and returns the start of the first one.
+ *
+ * @return the start of the mapping, or NULL if it could not be created.
+ */
+static uint8_t *map_mirrored(size_t bytes)
+{
+#if defined(_WIN32)
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                        (DWORD) ((uint64_t) bytes >> 32),
+                                        (DWORD) bytes, NULL);
+    if (!mapping)
+        return NULL;
+
+    uint8_t *addr = NULL;
+
+    /* Find a free range, release it and try to map both views into it
+     * before another thread claims it. */
+    for (int i = 0; i < MAP_ATTEMPTS && !addr; i++) {
+        uint8_t *range = VirtualAlloc(NULL, 2 * bytes, MEM_RESERVE, PAGE_NOACCESS);
+        if (!range)
+            break;
+        VirtualFree(range, 0, MEM_RELEASE);
+
+        void *lower = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes, range);
+        if (!lower)
+            continue;
+
+        void *upper = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes, range + bytes);
+        if (!upper) {
+            UnmapViewOfFile(lower);
+            continue;
+        }
+        addr = range;
+    }
+    /* The views keep the mapping object alive */
+    CloseHandle(mapping);
+    return addr;
+#elif defined(CC_MIRROR_AVAILABLE)
+    int fd = anonymous_fd();
+    if (fd < 0)
+        return NULL;
+
+    if (ftruncate(fd, (off_t) bytes) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    /* Reserve both ranges at once and replace them with the two views */
+    uint8_t *addr = mmap(NULL, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    void *lower = mmap(addr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void *upper = mmap(addr + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+
+    close(fd);
+
+    if (lower == MAP_FAILED || upper == MAP_FAILED) {
+        munmap(addr, 2 * bytes);
+        return NULL;
+    }
+    return addr;
+#else
+    (void) bytes;
+    return NULL;
+#endif
+}
+
+/**
+ * Unmaps both views created by <code>map_mirrored()</code>.
+ */
+static void unmap_mirrored(uint8_t *addr, size_t bytes)
+{
+#if defined(_WIN32)
+    UnmapViewOfFile(addr + bytes);
+    UnmapViewOfFile(addr);
+#elif defined(CC_MIRROR_AVAILABLE)
+    munmap(addr, 2 * bytes);
+#else
+    (void) addr;
+    (void) bytes;
+#endif
+}
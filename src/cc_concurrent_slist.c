@@ -0,0 +1,602 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+
+#include "cc_concurrent_slist.h"
+
+/* The lowest bit of a next pointer marks its node as removed. A marked
+ * next pointer never changes again. */
+#define MARK        ((uintptr_t) 1)
+#define MARKED(p)   ((p) & MARK)
+#define PTR(p)      ((struct csl_node*) ((p) & ~MARK))
+
+struct csl_node {
+    _Atomic uintptr_t  next;
+    void              *data;
+    struct csl_node   *retired;
+};
+
+/*
+ * Every operation increments the counter of the epoch parity it runs in,
+ * and decrements it once it is done. A reclamation takes the nodes that
+ * were unlinked so far and advances the epoch, after which no operation
+ * can reach them anymore. They are freed by a later reclamation that sees
+ * that all operations of the previous epoch have finished.
+ */
+struct epoch_count {
+    _Atomic size_t  count;
+    char            pad[CC_CACHE_LINE_SIZE - sizeof(size_t)];
+};
+
+struct cc_concurrent_slist_s {
+    struct csl_node     head;
+    char                head_pad[CC_CACHE_LINE_SIZE - sizeof(struct csl_node)];
+
+    _Atomic unsigned    epoch;
+    _Atomic size_t      size;
+    char                epoch_pad[CC_CACHE_LINE_SIZE - sizeof(unsigned) - sizeof(size_t)];
+    struct epoch_count  active[2];
+
+    _Atomic(struct csl_node*)  retired;
+    _Atomic size_t             limbo;
+    atomic_flag                reclaiming;
+    struct csl_node           *pending[2];
+
+    int (*cmp) (const void *e1, const void *e2);
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static unsigned epoch_enter  (CC_ConcurrentSList *list);
+static void     epoch_leave  (CC_ConcurrentSList *list, unsigned epoch);
+static void     retire       (CC_ConcurrentSList *list, struct csl_node *node);
+static void     reclaim      (CC_ConcurrentSList *list);
+static void     free_chain   (CC_ConcurrentSList *list, struct csl_node *node);
+static bool     find         (CC_ConcurrentSList *list, void *element,
+                              struct csl_node **prev, struct csl_node **cur);
+static struct csl_node *find_live (CC_ConcurrentSList *list, void *element);
+
+
+/**
+ * Initializes the fields of the CC_ConcurrentSListConf struct to default
+ * values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_concurrent_slist_conf_init(CC_ConcurrentSListConf *conf)
+{
+    conf->cmp        = NULL;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Creates a new empty CC_ConcurrentSList ordered by the specified
+ * comparator and returns a status code.
+ *
+ * @param[in] cmp the comparator that orders the elements
+ * @param[out] out pointer to where the newly created CC_ConcurrentSList is
+ *                 to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_ConcurrentSList structure failed.
+ */
+enum cc_stat cc_concurrent_slist_new(int (*cmp) (const void*, const void*), CC_ConcurrentSList **out)
+{
+    CC_ConcurrentSListConf conf;
+    cc_concurrent_slist_conf_init(&conf);
+    conf.cmp = cmp;
+    return cc_concurrent_slist_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_ConcurrentSList based on the specified
+ * CC_ConcurrentSListConf struct and returns a status code.
+ *
+ * @param[in] conf CC_ConcurrentSList configuration struct. All fields must
+ *                 be initialized.
+ * @param[out] out pointer to where the newly created CC_ConcurrentSList is
+ *                 to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_ConcurrentSList structure failed.
+ */
+enum cc_stat cc_concurrent_slist_new_conf(CC_ConcurrentSListConf const * const conf,
+                                          CC_ConcurrentSList **out)
+{
+    CC_ConcurrentSList *list = conf->mem_calloc(1, sizeof(CC_ConcurrentSList));
+
+    if (!list)
+        return CC_ERR_ALLOC;
+
+    atomic_init(&list->head.next, (uintptr_t) 0);
+    atomic_init(&list->epoch, 0u);
+    atomic_init(&list->size, (size_t) 0);
+    atomic_init(&list->active[0].count, (size_t) 0);
+    atomic_init(&list->active[1].count, (size_t) 0);
+    atomic_init(&list->retired, NULL);
+    atomic_init(&list->limbo, (size_t) 0);
+    atomic_flag_clear(&list->reclaiming);
+
+    list->cmp        = conf->cmp;
+    list->mem_alloc  = conf->mem_alloc;
+    list->mem_calloc = conf->mem_calloc;
+    list->mem_free   = conf->mem_free;
+
+    *out = list;
+    return CC_OK;
+}
+
+/**
+ * Destroys the list and all of its nodes, leaving the elements intact. No
+ * thread may be using the list.
+ *
+ * @param[in] list the list that is to be destroyed
+ */
+void cc_concurrent_slist_destroy(CC_ConcurrentSList *list)
+{
+    cc_concurrent_slist_destroy_cb(list, NULL);
+}
+
+/**
+ * Destroys the list and all of its nodes, and calls the callback function
+ * on every element that is still in the list. No thread may be using the
+ * list.
+ *
+ * @param[in] list the list that is to be destroyed
+ * @param[in] cb the callback function that is called on each element, or
+ *               NULL
+ */
+void cc_concurrent_slist_destroy_cb(CC_ConcurrentSList *list, void (*cb) (void*))
+{
+    uintptr_t next = atomic_load_explicit(&list->head.next, memory_order_acquire);
+
+    while (PTR(next)) {
+        struct csl_node *node = PTR(next);
+        next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+        if (cb && !MARKED(next))
+            cb(node->data);
+        list->mem_free(node);
+    }
+    free_chain(list, atomic_load_explicit(&list->retired, memory_order_acquire));
+    free_chain(list, list->pending[0]);
+    free_chain(list, list->pending[1]);
+
+    list->mem_free(list);
+}
+
+/**
+ * Returns the size of the CC_ConcurrentSList structure.
+ */
+size_t cc_concurrent_slist_struct_size()
+{
+    return sizeof(CC_ConcurrentSList);
+}
+
+/**
+ * Adds the element to the list at the position given by the comparator,
+ * unless an equal element is already in the list.
+ *
+ * @param[in] list the list to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was added, CC_ERR_DUPLICATE if an equal
+ * element is already in the list, or CC_ERR_ALLOC if a node could not be
+ * allocated.
+ */
+enum cc_stat cc_concurrent_slist_add(CC_ConcurrentSList *list, void *element)
+{
+    struct csl_node *node = list->mem_alloc(sizeof(struct csl_node));
+
+    if (!node)
+        return CC_ERR_ALLOC;
+
+    node->data    = element;
+    node->retired = NULL;
+
+    enum cc_stat     status = CC_OK;
+    unsigned         epoch  = epoch_enter(list);
+    struct csl_node *prev;
+    struct csl_node *cur;
+
+    for (;;) {
+        if (find(list, element, &prev, &cur)) {
+            status = CC_ERR_DUPLICATE;
+            break;
+        }
+        uintptr_t expected = (uintptr_t) cur;
+        atomic_store_explicit(&node->next, expected, memory_order_relaxed);
+
+        if (atomic_compare_exchange_strong_explicit(&prev->next, &expected, (uintptr_t) node,
+                                                    memory_order_release,
+                                                    memory_order_relaxed)) {
+            atomic_fetch_add_explicit(&list->size, 1, memory_order_relaxed);
+            break;
+        }
+    }
+    epoch_leave(list, epoch);
+
+    /* The node was never published */
+    if (status != CC_OK)
+        list->mem_free(node);
+
+    return status;
+}
+
+/**
+ * Removes the element that is equal to the specified element from the list
+ * and optionally sets the out parameter to the removed element.
+ *
+ * @param[in] list the list from which the element is being removed
+ * @param[in] element the element that is being removed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was removed, or CC_ERR_VALUE_NOT_FOUND if
+ * no equal element is in the list.
+ */
+enum cc_stat cc_concurrent_slist_remove(CC_ConcurrentSList *list, void *element, void **out)
+{
+    enum cc_stat     status = CC_ERR_VALUE_NOT_FOUND;
+    unsigned         epoch  = epoch_enter(list);
+    struct csl_node *prev;
+    struct csl_node *cur;
+
+    while (find(list, element, &prev, &cur)) {
+        uintptr_t next = atomic_load_explicit(&cur->next, memory_order_acquire);
+
+        if (MARKED(next))
+            continue;
+
+        /* Marking the node is what removes the element */
+        if (!atomic_compare_exchange_strong_explicit(&cur->next, &next, next | MARK,
+                                                     memory_order_acq_rel,
+                                                     memory_order_relaxed))
+            continue;
+
+        atomic_fetch_sub_explicit(&list->size, 1, memory_order_relaxed);
+        if (out)
+            *out = cur->data;
+
+        uintptr_t expected = (uintptr_t) cur;
+        if (atomic_compare_exchange_strong_explicit(&prev->next, &expected, next,
+                                                    memory_order_release,
+                                                    memory_order_relaxed))
+            retire(list, cur);
+        else
+            find(list, element, &prev, &cur);
+
+        status = CC_OK;
+        break;
+    }
+    epoch_leave(list, epoch);
+
+    return status;
+}
+
+/**
+ * Checks whether an element that is equal to the specified element is in
+ * the list. The lookup never writes to the list.
+ *
+ * @param[in] list the list that is being searched
+ * @param[in] element the element that is being searched for
+ *
+ * @return true if an equal element is in the list.
+ */
+bool cc_concurrent_slist_contains(CC_ConcurrentSList *list, void *element)
+{
+    unsigned epoch = epoch_enter(list);
+    bool     found = find_live(list, element) != NULL;
+    epoch_leave(list, epoch);
+
+    return found;
+}
+
+/**
+ * Gets the element of the list that is equal to the specified element and
+ * sets the out parameter to its value.
+ *
+ * @param[in] list the list that is being searched
+ * @param[in] element the element that is being searched for
+ * @param[out] out pointer to where the found element is stored
+ *
+ * @return CC_OK if an equal element was found, or CC_ERR_VALUE_NOT_FOUND if
+ * not.
+ */
+enum cc_stat cc_concurrent_slist_get(CC_ConcurrentSList *list, void *element, void **out)
+{
+    unsigned         epoch = epoch_enter(list);
+    struct csl_node *node  = find_live(list, element);
+
+    if (node)
+        *out = node->data;
+
+    epoch_leave(list, epoch);
+
+    return node ? CC_OK : CC_ERR_VALUE_NOT_FOUND;
+}
+
+/**
+ * Returns the number of elements in the list. While other threads modify
+ * the list the result is only a snapshot.
+ *
+ * @param[in] list the list whose size is being returned
+ *
+ * @return the number of elements in the list.
+ */
+size_t cc_concurrent_slist_size(CC_ConcurrentSList *list)
+{
+    return atomic_load_explicit(&list->size, memory_order_relaxed);
+}
+
+/**
+ * Applies the function op to each element of the list in ascending order.
+ * The iteration is weakly consistent, as with CC_ConcurrentSListIter.
+ *
+ * @param[in] list the list on which this operation is performed
+ * @param[in] op the operation function that is to be invoked on each
+ *               element
+ */
+void cc_concurrent_slist_foreach(CC_ConcurrentSList *list, void (*op) (void*))
+{
+    CC_ConcurrentSListIter iter;
+    void *e;
+
+    cc_concurrent_slist_iter_init(&iter, list);
+    while (cc_concurrent_slist_iter_next(&iter, &e) != CC_ITER_END)
+        op(e);
+}
+
+/**
+ * Initializes the iterator and makes it active. Nodes that are removed
+ * while the iterator is active are not freed until it is done.
+ *
+ * @param[in] iter the iterator that is being initialized
+ * @param[in] list the list on which this iterator will operate
+ */
+void cc_concurrent_slist_iter_init(CC_ConcurrentSListIter *iter, CC_ConcurrentSList *list)
+{
+    iter->list  = list;
+    iter->node  = &list->head;
+    iter->epoch = epoch_enter(list);
+    iter->done  = false;
+}
+
+/**
+ * Advances the iterator and sets the out parameter to the value of the
+ * next element in the sequence. The iterator is finished once the end of
+ * the list is reached.
+ *
+ * @param[in] iter the iterator that is being advanced
+ * @param[out] out pointer to where the next element is set
+ *
+ * @return CC_OK if the iterator was advanced, or CC_ITER_END if the end of
+ * the list has been reached.
+ */
+enum cc_stat cc_concurrent_slist_iter_next(CC_ConcurrentSListIter *iter, void **out)
+{
+    if (iter->done)
+        return CC_ITER_END;
+
+    struct csl_node *node = iter->node;
+    struct csl_node *cur  = PTR(atomic_load_explicit(&node->next, memory_order_acquire));
+
+    while (cur) {
+        uintptr_t next = atomic_load_explicit(&cur->next, memory_order_acquire);
+
+        if (!MARKED(next)) {
+            iter->node = cur;
+            *out = cur->data;
+            return CC_OK;
+        }
+        cur = PTR(next);
+    }
+    cc_concurrent_slist_iter_done(iter);
+
+    return CC_ITER_END;
+}
+
+/**
+ * Finishes the iteration so that the nodes removed in the meantime can be
+ * freed. Calling it on an iterator that has already reached the end of the
+ * list has no effect.
+ *
+ * @param[in] iter the iterator that is being finished
+ */
+void cc_concurrent_slist_iter_done(CC_ConcurrentSListIter *iter)
+{
+    if (iter->done)
+        return;
+
+    iter->done = true;
+    epoch_leave(iter->list, iter->epoch);
+}
+
+/**
+ * Announces an operation in the current epoch and returns the epoch. The
+ * epoch is read again after the announcement, since a reclamation that
+ * advanced the epoch in the meantime may not have seen it.
+ */
+static unsigned epoch_enter(CC_ConcurrentSList *list)
+{
+    for (;;) {
+        unsigned epoch = atomic_load(&list->epoch);
+
+        atomic_fetch_add(&list->active[epoch & 1].count, 1);
+
+        if (atomic_load(&list->epoch) == epoch)
+            return epoch;
+
+        atomic_fetch_sub(&list->active[epoch & 1].count, 1);
+    }
+}
+
+/**
+ * Ends an operation that was announced in the epoch and tries to reclaim
+ * the unlinked nodes, if there are any.
+ */
+static void epoch_leave(CC_ConcurrentSList *list, unsigned epoch)
+{
+    atomic_fetch_sub(&list->active[epoch & 1].count, 1);
+
+    if (atomic_load_explicit(&list->limbo, memory_order_relaxed))
+        reclaim(list);
+}
+
+/**
+ * Hands a node that was unlinked by the calling thread over to the
+ * reclamation.
+ */
+static void retire(CC_ConcurrentSList *list, struct csl_node *node)
+{
+    atomic_fetch_add_explicit(&list->limbo, 1, memory_order_relaxed);
+
+    struct csl_node *top = atomic_load_explicit(&list->retired, memory_order_relaxed);
+
+    do {
+        node->retired = top;
+    } while (!atomic_compare_exchange_weak_explicit(&list->retired, &top, node,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+/**
+ * Frees the nodes of the previous epoch if all of its operations have
+ * finished, and then moves the nodes retired so far into the current
+ * epoch and advances it. Only one thread reclaims at a time; the others
+ * skip the reclamation instead of waiting.
+ */
+static void reclaim(CC_ConcurrentSList *list)
+{
+    if (atomic_flag_test_and_set_explicit(&list->reclaiming, memory_order_acquire))
+        return;
+
+    unsigned epoch    = atomic_load(&list->epoch);
+    unsigned previous = (epoch + 1) & 1;
+
+    if (atomic_load(&list->active[previous].count) == 0) {
+        free_chain(list, list->pending[previous]);
+        list->pending[previous] = NULL;
+
+        struct csl_node *batch = atomic_exchange(&list->retired, NULL);
+
+        if (batch) {
+            list->pending[epoch & 1] = batch;
+            atomic_store(&list->epoch, epoch + 1);
+        }
+    }
+    atomic_flag_clear_explicit(&list->reclaiming, memory_order_release);
+}
+
+/**
+ * Frees a chain of retired nodes.
+ */
+static void free_chain(CC_ConcurrentSList *list, struct csl_node *node)
+{
+    while (node) {
+        struct csl_node *next = node->retired;
+        list->mem_free(node);
+        atomic_fetch_sub_explicit(&list->limbo, 1, memory_order_relaxed);
+        node = next;
+    }
+}
+
+/**
+ * Finds the first node whose element is not less than the specified
+ * element, along with its predecessor, and unlinks the removed nodes it
+ * passes on the way. Both nodes were unmarked and adjacent when they were
+ * read. Must be called within an epoch.
+ *
+ * @param[in] list the list that is being searched
+ * @param[in] element the element that is being searched for
+ * @param[out] prev the predecessor of the found node
+ * @param[out] cur the found node, or NULL if all elements are less than
+ *                 the specified element
+ *
+ * @return true if the found node holds an element equal to the specified
+ * element.
+ */
+static bool find(CC_ConcurrentSList *list, void *element,
+                 struct csl_node **prev, struct csl_node **cur)
+{
+retry:
+    *prev = &list->head;
+    *cur  = PTR(atomic_load_explicit(&list->head.next, memory_order_acquire));
+
+    while (*cur) {
+        uintptr_t next = atomic_load_explicit(&(*cur)->next, memory_order_acquire);
+
+        if (MARKED(next)) {
+            uintptr_t expected = (uintptr_t) *cur;
+
+            if (!atomic_compare_exchange_strong_explicit(&(*prev)->next, &expected,
+                                                         (uintptr_t) PTR(next),
+                                                         memory_order_acq_rel,
+                                                         memory_order_acquire))
+                goto retry;
+
+            retire(list, *cur);
+            *cur = PTR(next);
+            continue;
+        }
+
+        int c = list->cmp((*cur)->data, element);
+
+        if (c >= 0)
+            return c == 0;
+
+        *prev = *cur;
+        *cur  = PTR(next);
+    }
+    return false;
+}
+
+/**
+ * Finds the unmarked node that holds an element equal to the specified
+ * element without unlinking the removed nodes it passes. Must be called
+ * within an epoch.
+ *
+ * @return the found node, or NULL if there is none.
+ */
+static struct csl_node *find_live(CC_ConcurrentSList *list, void *element)
+{
+    struct csl_node *cur = PTR(atomic_load_explicit(&list->head.next, memory_order_acquire));
+
+    while (cur) {
+        uintptr_t next = atomic_load_explicit(&cur->next, memory_order_acquire);
+
+        if (!MARKED(next)) {
+            int c = list->cmp(cur->data, element);
+
+            if (c == 0)
+                return cur;
+            if (c > 0)
+                return NULL;
+        }
+        cur = PTR(next);
+    }
+    return NULL;
+}
@@ -0,0 +1,492 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+
+#include "cc_concurrent_stack.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define CPU_RELAX() ((void) 0)
+#endif
+
+/* Capacity of the first node segment is 1 << BASE_SHIFT, and every
+ * following segment is twice the size of the previous one. */
+#define BASE_SHIFT   6
+#define MAX_SEGMENTS (33 - BASE_SHIFT)
+
+/* Index 0 is the null node. The largest index marks a taken
+ * elimination slot. */
+#define NIL_INDEX    0
+#define TAKEN        UINT32_MAX
+#define MAX_INDEX    (UINT32_MAX - 1)
+
+/* How long a push waits in the elimination array for a pop. */
+#define ELIMINATION_SPINS 128
+
+#define PACK(tag, index) (((uint64_t) (tag) << 32) | (uint32_t) (index))
+#define INDEX(word)      ((uint32_t) (word))
+#define TAG(word)        ((uint32_t) ((word) >> 32))
+
+struct cs_node {
+    _Atomic(void*)    data;
+    _Atomic uint32_t  next;
+};
+
+/*
+ * Both heads and the elimination slots are 64 bit words holding a node
+ * index in the low half and a version tag in the high half. Every
+ * successful update of a head increments its tag, so a compare-and-swap
+ * fails if the head was popped and pushed back in the meantime.
+ */
+struct cc_concurrent_stack_s {
+    _Atomic uint64_t  top;
+    char              top_pad[CC_CACHE_LINE_SIZE - sizeof(uint64_t)];
+
+    _Atomic uint64_t  free;
+    _Atomic uint32_t  fresh;
+    char              free_pad[CC_CACHE_LINE_SIZE - sizeof(uint64_t) - sizeof(uint32_t)];
+
+    _Atomic(struct cs_node*)  segments[MAX_SEGMENTS];
+
+    size_t             elimination_slots;
+    _Atomic uint64_t  *elimination;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static uint32_t node_alloc      (CC_ConcurrentStack *stack);
+static void     node_free       (CC_ConcurrentStack *stack, uint32_t first, uint32_t last);
+static bool     eliminate_push  (CC_ConcurrentStack *stack, uint32_t node);
+static bool     eliminate_pop   (CC_ConcurrentStack *stack, uint32_t hint, void **out);
+static size_t   highest_bit     (size_t n);
+
+
+/**
+ * Returns the node at the specified index. The segment of the node must
+ * already be allocated.
+ */
+static INLINE struct cs_node *node_at(CC_ConcurrentStack *stack, uint32_t index)
+{
+    size_t j = (size_t) index - 1 + ((size_t) 1 << BASE_SHIFT);
+    size_t h = highest_bit(j);
+
+    struct cs_node *segment =
+        atomic_load_explicit(&stack->segments[h - BASE_SHIFT], memory_order_acquire);
+
+    return &segment[j - ((size_t) 1 << h)];
+}
+
+/**
+ * Initializes the fields of the CC_ConcurrentStackConf struct to default values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_concurrent_stack_conf_init(CC_ConcurrentStackConf *conf)
+{
+    conf->elimination_slots = 0;
+    conf->mem_alloc         = malloc;
+    conf->mem_calloc        = calloc;
+    conf->mem_free          = free;
+}
+
+/**
+ * Creates a new empty CC_ConcurrentStack and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_ConcurrentStack is
+ *                 to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_ConcurrentStack structure failed.
+ */
+enum cc_stat cc_concurrent_stack_new(CC_ConcurrentStack **out)
+{
+    CC_ConcurrentStackConf conf;
+    cc_concurrent_stack_conf_init(&conf);
+    return cc_concurrent_stack_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_ConcurrentStack based on the specified
+ * CC_ConcurrentStackConf struct and returns a status code.
+ *
+ * @param[in] conf CC_ConcurrentStack configuration struct. All fields must
+ *                 be initialized.
+ * @param[out] out pointer to where the newly created CC_ConcurrentStack is
+ *                 to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_ConcurrentStack structure failed.
+ */
+enum cc_stat cc_concurrent_stack_new_conf(CC_ConcurrentStackConf const * const conf,
+                                          CC_ConcurrentStack **out)
+{
+    CC_ConcurrentStack *stack = conf->mem_calloc(1, sizeof(CC_ConcurrentStack));
+
+    if (!stack)
+        return CC_ERR_ALLOC;
+
+    if (conf->elimination_slots) {
+        stack->elimination = conf->mem_calloc(conf->elimination_slots, sizeof(uint64_t));
+        if (!stack->elimination) {
+            conf->mem_free(stack);
+            return CC_ERR_ALLOC;
+        }
+        for (size_t i = 0; i < conf->elimination_slots; i++)
+            atomic_init(&stack->elimination[i], PACK(0, NIL_INDEX));
+    }
+
+    atomic_init(&stack->top, PACK(0, NIL_INDEX));
+    atomic_init(&stack->free, PACK(0, NIL_INDEX));
+    atomic_init(&stack->fresh, 0);
+
+    for (size_t i = 0; i < MAX_SEGMENTS; i++)
+        atomic_init(&stack->segments[i], NULL);
+
+    stack->elimination_slots = conf->elimination_slots;
+    stack->mem_alloc         = conf->mem_alloc;
+    stack->mem_calloc        = conf->mem_calloc;
+    stack->mem_free          = conf->mem_free;
+
+    *out = stack;
+    return CC_OK;
+}
+
+/**
+ * Destroys the stack and all of its nodes, but leaves the data it holds
+ * intact. No thread may be using the stack.
+ *
+ * @param[in] stack the stack that is to be destroyed
+ */
+void cc_concurrent_stack_destroy(CC_ConcurrentStack *stack)
+{
+    for (size_t i = 0; i < MAX_SEGMENTS; i++) {
+        struct cs_node *segment = atomic_load_explicit(&stack->segments[i], memory_order_relaxed);
+        if (segment)
+            stack->mem_free(segment);
+    }
+    if (stack->elimination)
+        stack->mem_free(stack->elimination);
+
+    stack->mem_free(stack);
+}
+
+/**
+ * Returns the size of the CC_ConcurrentStack structure.
+ */
+size_t cc_concurrent_stack_struct_size()
+{
+    return sizeof(CC_ConcurrentStack);
+}
+
+/**
+ * Pushes a new element onto the stack.
+ *
+ * @param[in] stack the stack onto which the element is being pushed
+ * @param[in] element the element that is being pushed
+ *
+ * @return CC_OK if the element was pushed, or CC_ERR_ALLOC if a node could
+ * not be allocated.
+ */
+enum cc_stat cc_concurrent_stack_push(CC_ConcurrentStack *stack, void *element)
+{
+    uint32_t index = node_alloc(stack);
+
+    if (index == NIL_INDEX)
+        return CC_ERR_ALLOC;
+
+    struct cs_node *node = node_at(stack, index);
+    atomic_store_explicit(&node->data, element, memory_order_relaxed);
+
+    uint64_t top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+
+    for (;;) {
+        atomic_store_explicit(&node->next, INDEX(top), memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->top, &top,
+                                                  PACK(TAG(top) + 1, index),
+                                                  memory_order_release,
+                                                  memory_order_relaxed))
+            return CC_OK;
+
+        if (stack->elimination_slots && eliminate_push(stack, index)) {
+            node_free(stack, index, index);
+            return CC_OK;
+        }
+        top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+    }
+}
+
+/**
+ * Pushes n elements onto the stack with a single update of the top of the
+ * stack. The last element of the array ends up on top, as if the elements
+ * were pushed one by one, and no other thread's element is placed between
+ * them.
+ *
+ * @param[in] stack the stack onto which the elements are being pushed
+ * @param[in] elements the elements that are being pushed
+ * @param[in] n the number of elements in the elements array
+ *
+ * @return CC_OK if the elements were pushed, or CC_ERR_ALLOC if the nodes
+ * could not be allocated, in which case none of the elements are pushed.
+ */
+enum cc_stat cc_concurrent_stack_push_n(CC_ConcurrentStack *stack, void * const *elements, size_t n)
+{
+    if (n == 0)
+        return CC_OK;
+
+    /* Link the nodes into a private chain whose bottom is the first
+     * element, then splice the whole chain onto the stack. */
+    uint32_t bottom = NIL_INDEX;
+    uint32_t chain  = NIL_INDEX;
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t index = node_alloc(stack);
+
+        if (index == NIL_INDEX) {
+            if (chain != NIL_INDEX)
+                node_free(stack, chain, bottom);
+            return CC_ERR_ALLOC;
+        }
+        struct cs_node *node = node_at(stack, index);
+        atomic_store_explicit(&node->data, elements[i], memory_order_relaxed);
+        atomic_store_explicit(&node->next, chain, memory_order_relaxed);
+
+        if (bottom == NIL_INDEX)
+            bottom = index;
+        chain = index;
+    }
+
+    struct cs_node *last = node_at(stack, bottom);
+    uint64_t top = atomic_load_explicit(&stack->top, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&last->next, INDEX(top), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->top, &top,
+                                                    PACK(TAG(top) + 1, chain),
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    return CC_OK;
+}
+
+/**
+ * Pops the element on top of the stack.
+ *
+ * @param[in] stack the stack from which the element is being popped
+ * @param[out] out pointer to where the popped element is stored
+ *
+ * @return CC_OK if an element was popped, or CC_ERR_OUT_OF_RANGE if the
+ * stack is empty.
+ */
+enum cc_stat cc_concurrent_stack_pop(CC_ConcurrentStack *stack, void **out)
+{
+    uint64_t top = atomic_load_explicit(&stack->top, memory_order_acquire);
+
+    for (;;) {
+        if (INDEX(top) == NIL_INDEX)
+            return CC_ERR_OUT_OF_RANGE;
+
+        /* The node may be popped and recycled by another thread before
+         * the compare-and-swap, in which case next is garbage, but the
+         * tag makes the compare-and-swap fail. Nodes are never freed
+         * while the stack exists, so the read itself is safe. */
+        struct cs_node *node = node_at(stack, INDEX(top));
+        uint32_t next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->top, &top,
+                                                  PACK(TAG(top) + 1, next),
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            *out = atomic_load_explicit(&node->data, memory_order_relaxed);
+            node_free(stack, INDEX(top), INDEX(top));
+            return CC_OK;
+        }
+
+        if (stack->elimination_slots && eliminate_pop(stack, TAG(top), out))
+            return CC_OK;
+
+        top = atomic_load_explicit(&stack->top, memory_order_acquire);
+    }
+}
+
+/**
+ * Returns true if the stack was empty at the time of the call.
+ */
+bool cc_concurrent_stack_is_empty(CC_ConcurrentStack *stack)
+{
+    return INDEX(atomic_load_explicit(&stack->top, memory_order_acquire)) == NIL_INDEX;
+}
+
+/**
+ * Takes a node from the free list, or a fresh one if the free list is
+ * empty. Returns NIL_INDEX if no node could be allocated.
+ */
+static uint32_t node_alloc(CC_ConcurrentStack *stack)
+{
+    uint64_t head = atomic_load_explicit(&stack->free, memory_order_acquire);
+
+    while (INDEX(head) != NIL_INDEX) {
+        uint32_t next = atomic_load_explicit(&node_at(stack, INDEX(head))->next,
+                                             memory_order_relaxed);
+
+        if (atomic_compare_exchange_weak_explicit(&stack->free, &head,
+                                                  PACK(TAG(head) + 1, next),
+                                                  memory_order_acquire,
+                                                  memory_order_acquire))
+            return INDEX(head);
+    }
+
+    uint32_t fresh = atomic_load_explicit(&stack->fresh, memory_order_relaxed);
+
+    /* The index is only claimed once its segment exists, so that a failed
+     * segment allocation doesn't lose it */
+    for (;;) {
+        if (fresh >= MAX_INDEX)
+            return NIL_INDEX;
+
+        size_t j = (size_t) fresh + ((size_t) 1 << BASE_SHIFT);
+        size_t h = highest_bit(j);
+
+        if (!atomic_load_explicit(&stack->segments[h - BASE_SHIFT], memory_order_acquire)) {
+            struct cs_node *segment = stack->mem_calloc((size_t) 1 << h, sizeof(struct cs_node));
+            struct cs_node *expected = NULL;
+
+            if (!segment)
+                return NIL_INDEX;
+
+            /* Another thread may have installed the segment first */
+            if (!atomic_compare_exchange_strong_explicit(&stack->segments[h - BASE_SHIFT],
+                                                         &expected, segment,
+                                                         memory_order_acq_rel,
+                                                         memory_order_acquire))
+                stack->mem_free(segment);
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&stack->fresh, &fresh, fresh + 1,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+            return fresh + 1;
+    }
+}
+
+/**
+ * Returns a chain of nodes, linked from first to last through their next
+ * fields, to the free list.
+ */
+static void node_free(CC_ConcurrentStack *stack, uint32_t first, uint32_t last)
+{
+    struct cs_node *node = node_at(stack, last);
+    uint64_t head = atomic_load_explicit(&stack->free, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&node->next, INDEX(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&stack->free, &head,
+                                                    PACK(TAG(head) + 1, first),
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+/*
+ * An elimination slot is empty (index NIL_INDEX), holds the node of a
+ * waiting push, or is TAKEN by a pop. Only the pushing thread moves a
+ * slot back to empty, and it increments the tag when it does, so a pop
+ * can't take an offer that was withdrawn and made again in the meantime.
+ */
+
+/**
+ * Offers the node in a random elimination slot and waits a little for a
+ * pop to take its element. Returns true if the element was taken.
+ */
+static bool eliminate_push(CC_ConcurrentStack *stack, uint32_t node)
+{
+    _Atomic uint64_t *slot = &stack->elimination[(node * 2654435761u) % stack->elimination_slots];
+    uint64_t word = atomic_load_explicit(slot, memory_order_relaxed);
+
+    if (INDEX(word) != NIL_INDEX)
+        return false;
+
+    uint64_t offer = PACK(TAG(word), node);
+
+    if (!atomic_compare_exchange_strong_explicit(slot, &word, offer,
+                                                 memory_order_release,
+                                                 memory_order_relaxed))
+        return false;
+
+    for (int i = 0; i < ELIMINATION_SPINS; i++) {
+        if (atomic_load_explicit(slot, memory_order_relaxed) != offer)
+            break;
+        CPU_RELAX();
+    }
+
+    uint64_t empty = PACK(TAG(offer) + 1, NIL_INDEX);
+
+    if (atomic_compare_exchange_strong_explicit(slot, &offer, empty,
+                                                memory_order_acquire,
+                                                memory_order_acquire))
+        return false;
+
+    /* A pop took the element */
+    atomic_store_explicit(slot, empty, memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Takes the element of a push waiting in a random elimination slot.
+ * Returns true if an element was taken.
+ */
+static bool eliminate_pop(CC_ConcurrentStack *stack, uint32_t hint, void **out)
+{
+    _Atomic uint64_t *slot = &stack->elimination[(hint * 2654435761u) % stack->elimination_slots];
+    uint64_t word = atomic_load_explicit(slot, memory_order_acquire);
+
+    if (INDEX(word) == NIL_INDEX || INDEX(word) == TAKEN)
+        return false;
+
+    void *element = atomic_load_explicit(&node_at(stack, INDEX(word))->data, memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(slot, &word, PACK(TAG(word), TAKEN),
+                                                 memory_order_acq_rel,
+                                                 memory_order_relaxed))
+        return false;
+
+    *out = element;
+    return true;
+}
+
+/**
+ * Returns the position of the highest set bit of a non zero integer.
+ */
+static INLINE size_t highest_bit(size_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(unsigned long long) * 8 - 1) - (size_t) __builtin_clzll((unsigned long long) n);
+#else
+    size_t h = 0;
+    while (n >>= 1)
+        h++;
+    return h;
+#endif
+}
@@ -19,6 +19,8 @@
  */
 
 #include "cc_deque.h"
+#include "cc_list.h"
+#include "cc_slist.h"
 
 #define DEFAULT_CAPACITY 8
 #define DEFAULT_EXPANSION_FACTOR 2
@@ -37,8 +39,15 @@ struct cc_deque_s {
 
 static size_t upper_pow_two (size_t);
 static void   copy_buffer   (CC_Deque const * const deque, void **buff, void *(*cp) (void*));
+static void   reverse_slots (void **buff, size_t from, size_t to);
+static enum cc_stat move_buffer (CC_DequeConf const * const conf, size_t size,
+                                 void ***buffer, size_t *capacity);
 
 static enum cc_stat expand_capacity (CC_Deque *deque);
+static enum cc_stat ensure_capacity (CC_Deque *deque, size_t n);
+
+static void   copy_in       (CC_Deque *deque, size_t at, void * const *elements, size_t n, bool reversed);
+static void   copy_out      (CC_Deque const * const deque, size_t at, void **out, size_t n, bool reversed);
 
 /**
  * Creates a new empty deque and returns a status code.
@@ -94,6 +103,194 @@ enum cc_stat cc_deque_new_conf(CC_DequeConf const * const conf, CC_Deque **d)
     return CC_OK;
 }
 
+/**
+ * Creates a new CC_Deque that takes over the specified buffer as its storage
+ * instead of copying it. The first <code>size</code> pointers of the buffer
+ * become the elements of the deque, from the first to the last.
+ *
+ * @note The buffer must have been allocated with malloc, since the deque
+ *       frees it or replaces it once it needs to grow.
+ *
+ * @param[in] buffer the buffer that is being taken over
+ * @param[in] size the number of elements in the buffer
+ * @param[in] capacity the number of elements that fit into the buffer. Must
+ *                     be a power of two.
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is not a power of two or smaller than the size, or
+ * CC_ERR_ALLOC if the memory allocation for the new CC_Deque structure
+ * failed. If an error is returned, the buffer remains owned by the caller.
+ */
+enum cc_stat cc_deque_from_buffer(void **buffer, size_t size, size_t capacity, CC_Deque **out)
+{
+    CC_DequeConf conf;
+    cc_deque_conf_init(&conf);
+    return cc_deque_from_buffer_conf(&conf, buffer, size, capacity, out);
+}
+
+/**
+ * Creates a new CC_Deque based on the specified CC_DequeConf struct that
+ * takes over the specified buffer as its storage instead of copying it. This
+ * is how the buffer released by cc_array_release_buffer() becomes a deque
+ * without copying the elements.
+ *
+ * The buffer must have been allocated with the allocator specified in the
+ * CC_DequeConf struct. The capacity field of the struct is ignored.
+ *
+ * @param[in] conf CC_Deque configuration structure
+ * @param[in] buffer the buffer that is being taken over
+ * @param[in] size the number of elements in the buffer
+ * @param[in] capacity the number of elements that fit into the buffer. Must
+ *                     be a power of two.
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is not a power of two or smaller than the size, or
+ * CC_ERR_ALLOC if the memory allocation for the new CC_Deque structure
+ * failed. If an error is returned, the buffer remains owned by the caller.
+ */
+enum cc_stat cc_deque_from_buffer_conf(CC_DequeConf const * const conf, void **buffer,
+                                       size_t size, size_t capacity, CC_Deque **out)
+{
+    /* The indices wrap around with a mask */
+    if (!capacity || (capacity & (capacity - 1)) || size > capacity)
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_Deque *deque = conf->mem_calloc(1, sizeof(CC_Deque));
+
+    if (!deque)
+        return CC_ERR_ALLOC;
+
+    deque->mem_alloc  = conf->mem_alloc;
+    deque->mem_calloc = conf->mem_calloc;
+    deque->mem_free   = conf->mem_free;
+    deque->buffer     = buffer;
+    deque->capacity   = capacity;
+    deque->size       = size;
+    deque->first      = 0;
+    deque->last       = size & (capacity - 1);
+
+    *out = deque;
+    return CC_OK;
+}
+
+/**
+ * Moves the elements of the list into a new CC_Deque, from the first to the
+ * last, and leaves the list empty. The element pointers are written once into
+ * a new buffer, which the deque then takes over as its storage.
+ *
+ * @param[in] list the list whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the elements were moved, or CC_ERR_ALLOC if a memory
+ * allocation failed, in which case the list is left unchanged.
+ */
+enum cc_stat cc_deque_from_list(CC_List *list, CC_Deque **out)
+{
+    CC_DequeConf conf;
+    cc_deque_conf_init(&conf);
+    return cc_deque_from_list_conf(&conf, list, out);
+}
+
+/**
+ * Moves the elements of the list into a new CC_Deque based on the specified
+ * CC_DequeConf struct, from the first to the last, and leaves the list
+ * empty. The buffer of the deque holds at least the initial capacity from
+ * the struct.
+ *
+ * @param[in] conf CC_Deque configuration structure
+ * @param[in] list the list whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the elements were moved, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if a memory allocation failed. If
+ * an error is returned, the list is left unchanged.
+ */
+enum cc_stat cc_deque_from_list_conf(CC_DequeConf const * const conf, CC_List *list, CC_Deque **out)
+{
+    size_t   size = cc_list_size(list);
+    size_t   capacity;
+    void   **buffer;
+
+    enum cc_stat status = move_buffer(conf, size, &buffer, &capacity);
+
+    if (status != CC_OK)
+        return status;
+
+    size_t i = 0;
+    CC_LIST_FOREACH(e, list, {
+        buffer[i++] = e;
+    })
+
+    status = cc_deque_from_buffer_conf(conf, buffer, size, capacity, out);
+
+    if (status != CC_OK) {
+        conf->mem_free(buffer);
+        return status;
+    }
+    cc_list_remove_all(list);
+    return CC_OK;
+}
+
+/**
+ * Moves the elements of the slist into a new CC_Deque, from the first to the
+ * last, and leaves the slist empty. The element pointers are written once
+ * into a new buffer, which the deque then takes over as its storage.
+ *
+ * @param[in] list the slist whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the elements were moved, or CC_ERR_ALLOC if a memory
+ * allocation failed, in which case the slist is left unchanged.
+ */
+enum cc_stat cc_deque_from_slist(CC_SList *list, CC_Deque **out)
+{
+    CC_DequeConf conf;
+    cc_deque_conf_init(&conf);
+    return cc_deque_from_slist_conf(&conf, list, out);
+}
+
+/**
+ * Moves the elements of the slist into a new CC_Deque based on the specified
+ * CC_DequeConf struct, from the first to the last, and leaves the slist
+ * empty. The buffer of the deque holds at least the initial capacity from
+ * the struct.
+ *
+ * @param[in] conf CC_Deque configuration structure
+ * @param[in] list the slist whose elements are being moved
+ * @param[out] out pointer to where the newly created CC_Deque is to be stored
+ *
+ * @return CC_OK if the elements were moved, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if a memory allocation failed. If
+ * an error is returned, the slist is left unchanged.
+ */
+enum cc_stat cc_deque_from_slist_conf(CC_DequeConf const * const conf, CC_SList *list, CC_Deque **out)
+{
+    size_t   size = cc_slist_size(list);
+    size_t   capacity;
+    void   **buffer;
+
+    enum cc_stat status = move_buffer(conf, size, &buffer, &capacity);
+
+    if (status != CC_OK)
+        return status;
+
+    size_t i = 0;
+    CC_SLIST_FOREACH(e, list, {
+        buffer[i++] = e;
+    })
+
+    status = cc_deque_from_buffer_conf(conf, buffer, size, capacity, out);
+
+    if (status != CC_OK) {
+        conf->mem_free(buffer);
+        return status;
+    }
+    cc_slist_remove_all(list);
+    return CC_OK;
+}
+
 /**
  * Initializes the fields of the CC_DequeConf struct to default values.
  *
@@ -118,6 +315,40 @@ void cc_deque_destroy(CC_Deque *deque)
     deque->mem_free(deque);
 }
 
+/**
+ * Destroys the CC_Deque structure and hands its buffer over to the caller,
+ * who becomes responsible for freeing it with the deque's allocator. The
+ * elements are first rotated in place, so that they occupy the first
+ * <code>size</code> slots of the buffer in order, which lets
+ * cc_array_from_buffer() take the buffer over as is.
+ *
+ * @param[in] deque the CC_Deque whose buffer is being released
+ * @param[out] out pointer to where the buffer is stored
+ * @param[out] size pointer to where the number of elements is stored, or NULL
+ * @param[out] capacity pointer to where the capacity of the buffer is
+ *                      stored, or NULL
+ */
+void cc_deque_release_buffer(CC_Deque *deque, void ***out, size_t *size, size_t *capacity)
+{
+    void **buff = deque->buffer;
+
+    /* Rotating the whole ring to the left by first takes three reversals */
+    if (deque->first != 0) {
+        reverse_slots(buff, 0, deque->first);
+        reverse_slots(buff, deque->first, deque->capacity);
+        reverse_slots(buff, 0, deque->capacity);
+    }
+
+    *out = buff;
+
+    if (size)
+        *size = deque->size;
+    if (capacity)
+        *capacity = deque->capacity;
+
+    deque->mem_free(deque);
+}
+
 /**
  * Destroys the CC_Deque structure along with all the data it holds.
  *
@@ -190,6 +421,62 @@ enum cc_stat cc_deque_add_last(CC_Deque *deque, void *element)
     return CC_OK;
 }
 
+/**
+ * Adds <code>n</code> elements to the back of the CC_Deque, as if
+ * cc_deque_add_last() was called for each element in order. The elements
+ * are copied with at most two memcpy calls after a single capacity check.
+ *
+ * @param[in] deque the CC_Deque to which the elements are being added
+ * @param[in] elements the elements that are being added
+ * @param[in] n the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * CC_Deque cannot hold all of the elements. If an error is returned, none of
+ * the elements are added.
+ */
+enum cc_stat cc_deque_add_all(CC_Deque *deque, void * const *elements, size_t n)
+{
+    enum cc_stat status = ensure_capacity(deque, n);
+
+    if (status != CC_OK)
+        return status;
+
+    copy_in(deque, deque->last, elements, n, false);
+    deque->last = (deque->last + n) & (deque->capacity - 1);
+    deque->size += n;
+
+    return CC_OK;
+}
+
+/**
+ * Adds <code>n</code> elements to the front of the CC_Deque, as if
+ * cc_deque_add_first() was called for each element in order, so that the
+ * last element of the array becomes the first element of the deque.
+ *
+ * @param[in] deque the CC_Deque to which the elements are being added
+ * @param[in] elements the elements that are being added
+ * @param[in] n the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * CC_Deque cannot hold all of the elements. If an error is returned, none of
+ * the elements are added.
+ */
+enum cc_stat cc_deque_add_all_first(CC_Deque *deque, void * const *elements, size_t n)
+{
+    enum cc_stat status = ensure_capacity(deque, n);
+
+    if (status != CC_OK)
+        return status;
+
+    deque->first = (deque->first - n) & (deque->capacity - 1);
+    copy_in(deque, deque->first, elements, n, true);
+    deque->size += n;
+
+    return CC_OK;
+}
+
 /**
  * Inserts a new element at the specified index within the deque. The index
  * must be within the range of the CC_Deque.
@@ -472,6 +759,89 @@ enum cc_stat cc_deque_remove_last(CC_Deque *deque, void **out)
     return CC_OK;
 }
 
+/**
+ * Removes up to <code>n</code> elements from the front of the CC_Deque, as
+ * if cc_deque_remove_first() was called repeatedly, and optionally copies
+ * them to <code>out</code> in the same order. The elements are copied with
+ * at most two memcpy calls.
+ *
+ * @param[in] deque the CC_Deque from which the elements are being removed
+ * @param[out] out buffer large enough to hold <code>n</code> elements, or
+ *                 NULL if the removed elements are to be ignored
+ * @param[in] n the maximum number of elements that are being removed
+ *
+ * @return the number of removed elements, which is less than
+ * <code>n</code> only if the CC_Deque held fewer elements.
+ */
+size_t cc_deque_remove_first_n(CC_Deque *deque, void **out, size_t n)
+{
+    if (n > deque->size)
+        n = deque->size;
+
+    if (out)
+        copy_out(deque, deque->first, out, n, false);
+
+    deque->first = (deque->first + n) & (deque->capacity - 1);
+    deque->size -= n;
+
+    return n;
+}
+
+/**
+ * Removes up to <code>n</code> elements from the back of the CC_Deque, as
+ * if cc_deque_remove_last() was called repeatedly, and optionally copies
+ * them to <code>out</code> in the same order, starting with the last element.
+ *
+ * @param[in] deque the CC_Deque from which the elements are being removed
+ * @param[out] out buffer large enough to hold <code>n</code> elements, or
+ *                 NULL if the removed elements are to be ignored
+ * @param[in] n the maximum number of elements that are being removed
+ *
+ * @return the number of removed elements, which is less than
+ * <code>n</code> only if the CC_Deque held fewer elements.
+ */
+size_t cc_deque_remove_last_n(CC_Deque *deque, void **out, size_t n)
+{
+    if (n > deque->size)
+        n = deque->size;
+
+    deque->last = (deque->last - n) & (deque->capacity - 1);
+    deque->size -= n;
+
+    if (out)
+        copy_out(deque, deque->last, out, n, true);
+
+    return n;
+}
+
+/**
+ * Removes all elements from the CC_Deque and returns them in a newly
+ * allocated array, ordered from the first to the last element. The array
+ * is allocated with the deque's allocator and must be freed by the caller.
+ *
+ * @param[in] deque the CC_Deque that is being drained
+ * @param[out] out pointer to where the newly created array is stored
+ *
+ * @return CC_OK if the array was successfully created, CC_ERR_OUT_OF_RANGE
+ * if the CC_Deque is empty, or CC_ERR_ALLOC if the memory allocation for
+ * the new array failed.
+ */
+enum cc_stat cc_deque_drain_to_array(CC_Deque *deque, void ***out)
+{
+    if (deque->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    void **array = deque->mem_alloc(deque->size * sizeof(void*));
+
+    if (!array)
+        return CC_ERR_ALLOC;
+
+    cc_deque_remove_first_n(deque, array, deque->size);
+    *out = array;
+
+    return CC_OK;
+}
+
 /**
  * Removes all elements from the CC_Deque.
  *
@@ -934,6 +1304,22 @@ static void copy_buffer(CC_Deque const * const deque, void **buff, void *(*cp) (
     }
 }
 
+/**
+ * Reverses the order of the buffer slots in the range [from, to).
+ *
+ * @param[in] buff the buffer whose slots are being reversed
+ * @param[in] from the first slot of the range
+ * @param[in] to the slot after the last slot of the range
+ */
+static void reverse_slots(void **buff, size_t from, size_t to)
+{
+    while (from + 1 < to) {
+        void *tmp    = buff[from];
+        buff[from++] = buff[--to];
+        buff[to]     = tmp;
+    }
+}
+
 /**
  * Expands the deque capacity. This operation might fail if the new buffer
  * cannot be allocated. If the capacity is already the maximum capacity,
@@ -967,6 +1353,129 @@ static enum cc_stat expand_capacity(CC_Deque *deque)
     return CC_OK;
 }
 
+/**
+ * Makes sure that the deque can hold <code>n</code> more elements without
+ * expanding, growing the buffer at most once.
+ *
+ * @param[in] deque the deque whose capacity is being ensured
+ * @param[in] n the number of elements that are about to be added
+ *
+ * @return CC_OK if the deque can hold the elements, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if
+ * the deque would grow past the maximum capacity.
+ */
+static enum cc_stat ensure_capacity(CC_Deque *deque, size_t n)
+{
+    if (n <= deque->capacity - deque->size)
+        return CC_OK;
+
+    if (n > MAX_POW_TWO - deque->size)
+        return CC_ERR_MAX_CAPACITY;
+
+    size_t new_capacity = upper_pow_two(deque->size + n);
+    void **new_buffer = deque->mem_calloc(new_capacity, sizeof(void*));
+
+    if (!new_buffer)
+        return CC_ERR_ALLOC;
+
+    copy_buffer(deque, new_buffer, NULL);
+    deque->mem_free(deque->buffer);
+
+    deque->first    = 0;
+    deque->last     = deque->size;
+    deque->capacity = new_capacity;
+    deque->buffer   = new_buffer;
+
+    return CC_OK;
+}
+
+/**
+ * Copies <code>n</code> elements into the circular buffer starting at the
+ * buffer position <code>at</code>. The slots must be free. The copy is split
+ * into at most two contiguous spans because of the wraparound.
+ *
+ * @param[in] deque the deque into whose buffer the elements are copied
+ * @param[in] at the buffer position of the first slot
+ * @param[in] elements the elements that are being copied
+ * @param[in] n the number of elements
+ * @param[in] reversed if true, the last element is copied to the first slot
+ */
+static void copy_in(CC_Deque *deque, size_t at, void * const *elements, size_t n, bool reversed)
+{
+    size_t span = deque->capacity - at < n ? deque->capacity - at : n;
+
+    if (!reversed) {
+        if (span)
+            memcpy(&(deque->buffer[at]), elements, span * sizeof(void*));
+        if (n > span)
+            memcpy(deque->buffer, &(elements[span]), (n - span) * sizeof(void*));
+        return;
+    }
+    size_t i;
+    for (i = 0; i < span; i++)
+        deque->buffer[at + i] = elements[n - 1 - i];
+    for (; i < n; i++)
+        deque->buffer[i - span] = elements[n - 1 - i];
+}
+
+/**
+ * Copies <code>n</code> elements out of the circular buffer starting at the
+ * buffer position <code>at</code>, in at most two contiguous spans.
+ *
+ * @param[in] deque the deque from whose buffer the elements are copied
+ * @param[in] at the buffer position of the first slot
+ * @param[out] out the buffer to which the elements are copied
+ * @param[in] n the number of elements
+ * @param[in] reversed if true, the first slot is copied to the end of out
+ */
+static void copy_out(CC_Deque const * const deque, size_t at, void **out, size_t n, bool reversed)
+{
+    size_t span = deque->capacity - at < n ? deque->capacity - at : n;
+
+    if (!reversed) {
+        if (span)
+            memcpy(out, &(deque->buffer[at]), span * sizeof(void*));
+        if (n > span)
+            memcpy(&(out[span]), deque->buffer, (n - span) * sizeof(void*));
+        return;
+    }
+    size_t i;
+    for (i = 0; i < span; i++)
+        out[n - 1 - i] = deque->buffer[at + i];
+    for (; i < n; i++)
+        out[n - 1 - i] = deque->buffer[i - span];
+}
+
+/**
+ * Allocates the buffer into which the elements of another container are
+ * moved. The buffer fits the elements and at least the initial capacity
+ * from the configuration struct, rounded up to a power of two.
+ *
+ * @param[in] conf CC_Deque configuration structure
+ * @param[in] size the number of elements that are being moved
+ * @param[out] buffer pointer to where the new buffer is stored
+ * @param[out] capacity pointer to where the capacity of the buffer is stored
+ *
+ * @return CC_OK if the buffer was allocated, CC_ERR_INVALID_CAPACITY if the
+ * capacity is too large, or CC_ERR_ALLOC if the memory allocation failed.
+ */
+static enum cc_stat move_buffer(CC_DequeConf const * const conf, size_t size,
+                                void ***buffer, size_t *capacity)
+{
+    size_t cap = upper_pow_two(size > conf->capacity ? size : conf->capacity);
+
+    if (cap < size || cap > CC_MAX_ELEMENTS / sizeof(void*))
+        return CC_ERR_INVALID_CAPACITY;
+
+    *buffer = conf->mem_alloc(cap * sizeof(void*));
+
+    if (!*buffer)
+        return CC_ERR_ALLOC;
+
+    *capacity = cap;
+    return CC_OK;
+}
+
 /**
  * Rounds the integer to the nearest upper power of two.
  *
@@ -0,0 +1,930 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cc_islist.h"
+
+/*
+ * The root link embedded in the list structure precedes the first element
+ * and the last element links back to it, so an element whose link has a
+ * NULL next pointer is not linked. The tail is the root itself when the
+ * list is empty.
+ */
+struct cc_islist_s {
+    size_t         size;
+    size_t         offset;
+    CC_ISListLink  root;
+    CC_ISListLink *tail;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+#define TO_LINK(l, e) ((CC_ISListLink*) ((char*) (e) + (l)->offset))
+#define TO_ELEM(l, k) ((void*) ((char*) (k) - (l)->offset))
+
+static void           link_after   (CC_ISList *list, CC_ISListLink *base, CC_ISListLink *link);
+static CC_ISListLink *unlink_after (CC_ISList *list, CC_ISListLink *base);
+static CC_ISListLink *pred_at      (CC_ISList *list, size_t index);
+static void           unlink_all   (CC_ISList *list, void (*cb) (void*));
+
+
+/**
+ * Creates a new empty CC_ISList whose elements embed a CC_ISListLink at the
+ * specified offset and returns a status code.
+ *
+ * @param[in] link_offset offset of the CC_ISListLink within the elements
+ * @param[out] out pointer to where the newly created CC_ISList is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_ISList structure failed.
+ */
+enum cc_stat cc_islist_new(size_t link_offset, CC_ISList **out)
+{
+    CC_ISListConf conf;
+    cc_islist_conf_init(&conf);
+    conf.link_offset = link_offset;
+    return cc_islist_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_ISList based on the specified CC_ISListConf struct
+ * and returns a status code.
+ *
+ * The CC_ISList is allocated using the allocators specified in the
+ * CC_ISListConf struct. The allocation may fail if the underlying allocator
+ * fails. The allocators are only used for the list structure itself.
+ *
+ * @param[in] conf list configuration structure
+ * @param[out] out pointer to where the newly created CC_ISList is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_ISList structure failed.
+ */
+enum cc_stat cc_islist_new_conf(CC_ISListConf const * const conf, CC_ISList **out)
+{
+    CC_ISList *list = conf->mem_calloc(1, sizeof(CC_ISList));
+
+    if (!list)
+        return CC_ERR_ALLOC;
+
+    list->offset     = conf->link_offset;
+    list->root.next  = &list->root;
+    list->tail       = &list->root;
+    list->mem_alloc  = conf->mem_alloc;
+    list->mem_calloc = conf->mem_calloc;
+    list->mem_free   = conf->mem_free;
+
+    *out = list;
+    return CC_OK;
+}
+
+/**
+ * Initializes the fields of the CC_ISListConf struct to default values.
+ *
+ * @param[in, out] conf CC_ISListConf structure that is being initialized
+ */
+void cc_islist_conf_init(CC_ISListConf *conf)
+{
+    conf->link_offset = 0;
+    conf->mem_alloc   = malloc;
+    conf->mem_calloc  = calloc;
+    conf->mem_free    = free;
+}
+
+/**
+ * Returns the size of the CC_ISList structure.
+ *
+ * @return the size of the CC_ISList structure
+ */
+size_t cc_islist_struct_size()
+{
+    return sizeof(CC_ISList);
+}
+
+/**
+ * Destroys the specified CC_ISList structure without destroying the elements
+ * it holds. The elements are unlinked from the list so that they can be
+ * added to another list afterwards.
+ *
+ * @param[in] list the list that is being destroyed
+ */
+void cc_islist_destroy(CC_ISList *list)
+{
+    unlink_all(list, NULL);
+    list->mem_free(list);
+}
+
+/**
+ * Destroys the specified CC_ISList structure and calls the provided callback
+ * function on every element it holds after the element has been unlinked.
+ * The callback is free to release the memory of the element.
+ *
+ * @param[in] list the list that is being destroyed
+ * @param[in] cb the callback function that is called on each element
+ */
+void cc_islist_destroy_cb(CC_ISList *list, void (*cb) (void*))
+{
+    unlink_all(list, cb);
+    list->mem_free(list);
+}
+
+/**
+ * Appends an element to the end of the list. The link of the element must
+ * not be linked into a list.
+ *
+ * @param[in] list the list to which the element is being appended
+ * @param[in] element the element that is being appended
+ *
+ * @return CC_OK if the element was added, or CC_ERR_INVALID_RANGE if the
+ * element is already linked.
+ */
+enum cc_stat cc_islist_add(CC_ISList *list, void *element)
+{
+    return cc_islist_add_last(list, element);
+}
+
+/**
+ * Prepends an element to the beginning of the list. The link of the element
+ * must not be linked into a list.
+ *
+ * @param[in] list the list to which the element is being prepended
+ * @param[in] element the element that is being prepended
+ *
+ * @return CC_OK if the element was added, or CC_ERR_INVALID_RANGE if the
+ * element is already linked.
+ */
+enum cc_stat cc_islist_add_first(CC_ISList *list, void *element)
+{
+    CC_ISListLink *link = TO_LINK(list, element);
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link_after(list, &list->root, link);
+    return CC_OK;
+}
+
+/**
+ * Appends an element to the end of the list. The link of the element must
+ * not be linked into a list.
+ *
+ * @param[in] list the list to which the element is being appended
+ * @param[in] element the element that is being appended
+ *
+ * @return CC_OK if the element was added, or CC_ERR_INVALID_RANGE if the
+ * element is already linked.
+ */
+enum cc_stat cc_islist_add_last(CC_ISList *list, void *element)
+{
+    CC_ISListLink *link = TO_LINK(list, element);
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link_after(list, list->tail, link);
+    return CC_OK;
+}
+
+/**
+ * Adds a new element at the specified index. The index must be within the
+ * range [0, size]. The link of the element must not be linked into a list.
+ *
+ * @param[in] list the list to which this new element is being added
+ * @param[in] element the element that is being added
+ * @param[in] index the position in the list at which the new element is
+ *                  being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_OUT_OF_RANGE
+ * if the specified index was not in range, or CC_ERR_INVALID_RANGE if the
+ * element is already linked.
+ */
+enum cc_stat cc_islist_add_at(CC_ISList *list, void *element, size_t index)
+{
+    if (index > list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    CC_ISListLink *link = TO_LINK(list, element);
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link_after(list, pred_at(list, index), link);
+    return CC_OK;
+}
+
+/**
+ * Adds a new element directly after the base element in constant time. The
+ * base element must be in this list.
+ *
+ * @param[in] list the list to which the element is being added
+ * @param[in] base the element after which the new element is added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_VALUE_NOT_FOUND
+ * if the base element is not linked, or CC_ERR_INVALID_RANGE if the element
+ * is already linked.
+ */
+enum cc_stat cc_islist_add_after(CC_ISList *list, void *base, void *element)
+{
+    CC_ISListLink *b = TO_LINK(list, base);
+
+    CC_ISListLink *link = TO_LINK(list, element);
+
+    if (!b->next)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link_after(list, b, link);
+    return CC_OK;
+}
+
+/**
+ * Moves all elements from the second list to the end of the first list in
+ * constant time. Both lists must use the same link offset. After this
+ * operation the second list is empty.
+ *
+ * @param[in] list1 the list to which the elements are being moved
+ * @param[in] list2 the list from which the elements are being moved
+ *
+ * @return CC_OK once the elements have been moved.
+ */
+enum cc_stat cc_islist_splice(CC_ISList *list1, CC_ISList *list2)
+{
+    return cc_islist_splice_at(list1, list2, list1->size);
+}
+
+/**
+ * Moves all elements from the second list to the first list at the specified
+ * position. Both lists must use the same link offset. After this operation
+ * the second list is empty. Splicing at either end of the first list takes
+ * constant time.
+ *
+ * @param[in] list1 the list to which the elements are being moved
+ * @param[in] list2 the list from which the elements are being moved
+ * @param[in] index the position in the first list at which the elements of
+ *                  the second list are inserted
+ *
+ * @return CC_OK if the elements were successfully moved, or
+ * CC_ERR_OUT_OF_RANGE if the index was not in range.
+ */
+enum cc_stat cc_islist_splice_at(CC_ISList *list1, CC_ISList *list2, size_t index)
+{
+    if (index > list1->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (list2->size == 0 || list1 == list2)
+        return CC_OK;
+
+    CC_ISListLink *base = pred_at(list1, index);
+
+    list2->tail->next = base->next;
+    base->next        = list2->root.next;
+
+    if (base == list1->tail)
+        list1->tail = list2->tail;
+
+    list1->size += list2->size;
+
+    list2->root.next = &list2->root;
+    list2->tail      = &list2->root;
+    list2->size      = 0;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the specified element from the list. Finding the predecessor of
+ * the element takes linear time.
+ *
+ * @param[in] list the list from which the element is being removed
+ * @param[in] element the element that is being removed
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the element is not in the list.
+ */
+enum cc_stat cc_islist_remove(CC_ISList *list, void *element)
+{
+    CC_ISListLink *target = TO_LINK(list, element);
+    CC_ISListLink *prev;
+
+    if (!target->next)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    for (prev = &list->root; prev->next != &list->root; prev = prev->next) {
+        if (prev->next == target) {
+            unlink_after(list, prev);
+            return CC_OK;
+        }
+    }
+    return CC_ERR_VALUE_NOT_FOUND;
+}
+
+/**
+ * Removes the first element from the list in constant time and optionally
+ * sets the out parameter to the value of the removed element.
+ *
+ * @param[in] list the list from which the first element is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it
+ *                 is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list is empty.
+ */
+enum cc_stat cc_islist_remove_first(CC_ISList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    CC_ISListLink *link = unlink_after(list, &list->root);
+
+    if (out)
+        *out = TO_ELEM(list, link);
+
+    return CC_OK;
+}
+
+/**
+ * Removes the last element from the list and optionally sets the out
+ * parameter to the value of the removed element. Finding the predecessor
+ * of the last element takes linear time.
+ *
+ * @param[in] list the list from which the last element is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it
+ *                 is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list is empty.
+ */
+enum cc_stat cc_islist_remove_last(CC_ISList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    CC_ISListLink *link = unlink_after(list, pred_at(list, list->size - 1));
+
+    if (out)
+        *out = TO_ELEM(list, link);
+
+    return CC_OK;
+}
+
+/**
+ * Removes the element at the specified index and optionally sets the out
+ * parameter to the value of the removed element.
+ *
+ * @param[in] list the list from which the element is being removed
+ * @param[in] index index of the element that is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it
+ *                 is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_OUT_OF_RANGE if the index was out of range.
+ */
+enum cc_stat cc_islist_remove_at(CC_ISList *list, size_t index, void **out)
+{
+    if (index >= list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    CC_ISListLink *link = unlink_after(list, pred_at(list, index));
+
+    if (out)
+        *out = TO_ELEM(list, link);
+
+    return CC_OK;
+}
+
+/**
+ * Unlinks all elements from the specified list.
+ *
+ * @param[in] list the list from which all elements are being removed
+ *
+ * @return CC_OK if the elements were successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list was already empty.
+ */
+enum cc_stat cc_islist_remove_all(CC_ISList *list)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    unlink_all(list, NULL);
+    return CC_OK;
+}
+
+/**
+ * Unlinks all elements from the specified list and calls the callback
+ * function on each of them after it has been unlinked.
+ *
+ * @param[in] list the list from which all elements are being removed
+ * @param[in] cb the callback function that is called on each element
+ *
+ * @return CC_OK if the elements were successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list was already empty.
+ */
+enum cc_stat cc_islist_remove_all_cb(CC_ISList *list, void (*cb) (void*))
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    unlink_all(list, cb);
+    return CC_OK;
+}
+
+/**
+ * Gets the first element from the specified list and sets the out parameter
+ * to its value.
+ *
+ * @param[in] list the list whose first element is being returned
+ * @param[out] out pointer to where the returned value is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * list is empty.
+ */
+enum cc_stat cc_islist_get_first(CC_ISList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    *out = TO_ELEM(list, list->root.next);
+    return CC_OK;
+}
+
+/**
+ * Gets the last element from the specified list and sets the out parameter
+ * to its value.
+ *
+ * @param[in] list the list whose last element is being returned
+ * @param[out] out pointer to where the returned value is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * list is empty.
+ */
+enum cc_stat cc_islist_get_last(CC_ISList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    *out = TO_ELEM(list, list->tail);
+    return CC_OK;
+}
+
+/**
+ * Gets the list element from the specified index and sets the out parameter
+ * to its value.
+ *
+ * @param[in] list the list from which the element is being returned
+ * @param[in] index the index of the list element being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the index
+ * was out of range.
+ */
+enum cc_stat cc_islist_get_at(CC_ISList *list, size_t index, void **out)
+{
+    if (index >= list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = TO_ELEM(list, pred_at(list, index)->next);
+    return CC_OK;
+}
+
+/**
+ * Gets the element that follows the specified element in constant time.
+ *
+ * @param[in] list the list that holds the element
+ * @param[in] element the element whose successor is being returned
+ * @param[out] out pointer to where the successor is stored
+ *
+ * @return CC_OK if the successor was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * element is the last element or is not linked.
+ */
+enum cc_stat cc_islist_get_next(CC_ISList *list, void *element, void **out)
+{
+    CC_ISListLink *link = TO_LINK(list, element);
+
+    if (!link->next || link->next == &list->root)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    *out = TO_ELEM(list, link->next);
+    return CC_OK;
+}
+
+/**
+ * Checks in constant time whether the link of the specified element is
+ * linked. This does not tell which list the element is linked into.
+ *
+ * @param[in] list the list that is being checked
+ * @param[in] element the element that is being checked
+ *
+ * @return true if the element is linked into a list.
+ */
+bool cc_islist_is_linked(CC_ISList *list, void *element)
+{
+    return TO_LINK(list, element)->next != NULL;
+}
+
+/**
+ * Returns the number of occurrences of the element within the specified list.
+ * Since an element can only be linked once through the same link, this is
+ * either 0 or 1.
+ *
+ * @param[in] list the list that is being searched
+ * @param[in] element the element that is being searched for
+ *
+ * @return the number of found matches.
+ */
+size_t cc_islist_contains(CC_ISList *list, void *element)
+{
+    size_t index;
+    return cc_islist_index_of(list, element, &index) == CC_OK ? 1 : 0;
+}
+
+/**
+ * Gets the index of the specified element.
+ *
+ * @param[in] list the list on which this operation is being performed
+ * @param[in] element the element whose index is being looked up
+ * @param[out] index pointer to where the index is stored
+ *
+ * @return CC_OK if the index was found, or CC_ERR_VALUE_NOT_FOUND if not.
+ */
+enum cc_stat cc_islist_index_of(CC_ISList *list, void *element, size_t *index)
+{
+    CC_ISListLink *target = TO_LINK(list, element);
+    CC_ISListLink *link;
+    size_t         i = 0;
+
+    if (!target->next)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    for (link = list->root.next; link != &list->root; link = link->next, i++) {
+        if (link == target) {
+            *index = i;
+            return CC_OK;
+        }
+    }
+    return CC_ERR_VALUE_NOT_FOUND;
+}
+
+/**
+ * Returns the number of elements in the specified list.
+ *
+ * @param[in] list the list whose size is being returned
+ *
+ * @return the number of elements in the list.
+ */
+size_t cc_islist_size(CC_ISList *list)
+{
+    return list->size;
+}
+
+/**
+ * Reverses the order of elements in the specified list.
+ *
+ * @param[in] list the list that is being reversed
+ */
+void cc_islist_reverse(CC_ISList *list)
+{
+    CC_ISListLink *prev = &list->root;
+    CC_ISListLink *link = list->root.next;
+
+    list->tail = link;
+
+    while (link != &list->root) {
+        CC_ISListLink *next = link->next;
+        link->next = prev;
+        prev = link;
+        link = next;
+    }
+    list->root.next = prev;
+}
+
+/**
+ * Applies the function fn to each element of the list.
+ *
+ * @param[in] list the list on which this operation is performed
+ * @param[in] op the operation function that is to be invoked on each list
+ *               element
+ */
+void cc_islist_foreach(CC_ISList *list, void (*op) (void *))
+{
+    CC_ISListLink *link = list->root.next;
+
+    while (link != &list->root) {
+        CC_ISListLink *next = link->next;
+        op(TO_ELEM(list, link));
+        link = next;
+    }
+}
+
+/**
+ * Filters the list by unlinking all elements that do not return true on
+ * the supplied predicate function.
+ *
+ * @param[in] list the list that is to be filtered
+ * @param[in] pred predicate function which returns true if the element
+ *                 should be kept in the list
+ *
+ * @return CC_OK if the list was filtered successfully, or CC_ERR_OUT_OF_RANGE
+ * if the list is empty.
+ */
+enum cc_stat cc_islist_filter_mut(CC_ISList *list, bool (*pred) (const void*))
+{
+    return cc_islist_filter_mut_cb(list, pred, NULL);
+}
+
+/**
+ * Filters the list by unlinking all elements that do not return true on
+ * the supplied predicate function, and calls the callback function on each
+ * unlinked element so that it can be released.
+ *
+ * @param[in] list the list that is to be filtered
+ * @param[in] pred predicate function which returns true if the element
+ *                 should be kept in the list
+ * @param[in] cb the callback function that is called on each unlinked
+ *               element, or NULL
+ *
+ * @return CC_OK if the list was filtered successfully, or CC_ERR_OUT_OF_RANGE
+ * if the list is empty.
+ */
+enum cc_stat cc_islist_filter_mut_cb(CC_ISList *list, bool (*pred) (const void*),
+                                     void (*cb) (void*))
+{
+    if (list->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    CC_ISListLink *prev = &list->root;
+
+    while (prev->next != &list->root) {
+        void *e = TO_ELEM(list, prev->next);
+
+        if (pred(e)) {
+            prev = prev->next;
+        } else {
+            unlink_after(list, prev);
+            if (cb)
+                cb(e);
+        }
+    }
+    return CC_OK;
+}
+
+/**
+ * Initializes the iterator.
+ *
+ * @param[in] iter the iterator that is being initialized
+ * @param[in] list the list on which this iterator will operate
+ */
+void cc_islist_iter_init(CC_ISListIter *iter, CC_ISList *list)
+{
+    iter->list      = list;
+    iter->last      = NULL;
+    iter->last_prev = NULL;
+    iter->prev      = &list->root;
+    iter->next      = list->root.next;
+    iter->index     = 0;
+}
+
+/**
+ * Advances the iterator and sets the out parameter to the value of the
+ * next element in the sequence.
+ *
+ * @param[in] iter the iterator that is being advanced
+ * @param[out] out pointer to where the next element is set
+ *
+ * @return CC_OK if the iterator was advanced, or CC_ITER_END if the
+ * end of the list has been reached.
+ */
+enum cc_stat cc_islist_iter_next(CC_ISListIter *iter, void **out)
+{
+    if (iter->next == &iter->list->root)
+        return CC_ITER_END;
+
+    iter->last_prev = iter->prev;
+    iter->last      = iter->next;
+    iter->prev      = iter->next;
+    iter->next      = iter->next->next;
+    iter->index++;
+
+    *out = TO_ELEM(iter->list, iter->last);
+    return CC_OK;
+}
+
+/**
+ * Removes the last returned element from the list without invalidating the
+ * iterator and optionally sets the out parameter to the value of the
+ * removed element.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if there is no last returned element.
+ */
+enum cc_stat cc_islist_iter_remove(CC_ISListIter *iter, void **out)
+{
+    if (!iter->last)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    if (iter->prev == iter->last)
+        iter->prev = iter->last_prev;
+
+    unlink_after(iter->list, iter->last_prev);
+
+    if (out)
+        *out = TO_ELEM(iter->list, iter->last);
+
+    iter->last = NULL;
+    iter->index--;
+
+    return CC_OK;
+}
+
+/**
+ * Adds a new element to the list after the last returned element, in front
+ * of the element that is returned next. The added element is not returned
+ * by the iterator.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the element being added
+ *
+ * @return CC_OK if the element was added, or CC_ERR_INVALID_RANGE if the
+ * element is already linked.
+ */
+enum cc_stat cc_islist_iter_add(CC_ISListIter *iter, void *element)
+{
+    CC_ISListLink *link = TO_LINK(iter->list, element);
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link_after(iter->list, iter->prev, link);
+    iter->prev = link;
+    iter->index++;
+
+    return CC_OK;
+}
+
+/**
+ * Replaces the last returned element with the specified element and
+ * optionally sets the out parameter to the value of the replaced element.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the replacement element
+ * @param[out] out pointer to where the replaced element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was replaced successfully,
+ * CC_ERR_VALUE_NOT_FOUND if there is no last returned element, or
+ * CC_ERR_INVALID_RANGE if the replacement element is already linked.
+ */
+enum cc_stat cc_islist_iter_replace(CC_ISListIter *iter, void *element, void **out)
+{
+    if (!iter->last)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    CC_ISListLink *old  = iter->last;
+    CC_ISListLink *link = TO_LINK(iter->list, element);
+
+    if (link->next)
+        return CC_ERR_INVALID_RANGE;
+
+    link->next            = old->next;
+    iter->last_prev->next = link;
+    old->next             = NULL;
+
+    if (iter->list->tail == old)
+        iter->list->tail = link;
+    if (iter->prev == old)
+        iter->prev = link;
+
+    iter->last = link;
+
+    if (out)
+        *out = TO_ELEM(iter->list, old);
+
+    return CC_OK;
+}
+
+/**
+ * Returns the index of the last returned element by <code>cc_islist_iter_next()
+ * </code>.
+ *
+ * @note
+ * The index is only valid until the list is modified by anything other than
+ * the iterator itself.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ *
+ * @return current iterator index.
+ */
+size_t cc_islist_iter_index(CC_ISListIter *iter)
+{
+    return iter->index - 1;
+}
+
+/**
+ * Links the link after the base link.
+ *
+ * @param[in] list the list into which the link is being linked
+ * @param[in] base the link after which the new link is placed
+ * @param[in] link the link that is being linked
+ */
+static void link_after(CC_ISList *list, CC_ISListLink *base, CC_ISListLink *link)
+{
+    link->next = base->next;
+    base->next = link;
+
+    if (base == list->tail)
+        list->tail = link;
+
+    list->size++;
+}
+
+/**
+ * Unlinks the link that follows the base link and clears it.
+ *
+ * @param[in] list the list from which the link is being unlinked
+ * @param[in] base the link that precedes the link that is being unlinked
+ *
+ * @return the unlinked link.
+ */
+static CC_ISListLink *unlink_after(CC_ISList *list, CC_ISListLink *base)
+{
+    CC_ISListLink *link = base->next;
+
+    base->next = link->next;
+    link->next = NULL;
+
+    if (link == list->tail)
+        list->tail = base;
+
+    list->size--;
+    return link;
+}
+
+/**
+ * Returns the link that precedes the specified position, which is the root
+ * for the first position and the tail for the position past the end.
+ *
+ * @param[in] list the list that is being walked
+ * @param[in] index the position within the range [0, size]
+ *
+ * @return the link that precedes the position.
+ */
+static CC_ISListLink *pred_at(CC_ISList *list, size_t index)
+{
+    if (index == list->size)
+        return list->tail;
+
+    CC_ISListLink *link = &list->root;
+    size_t         i;
+
+    for (i = 0; i < index; i++)
+        link = link->next;
+
+    return link;
+}
+
+/**
+ * Unlinks every element of the list and optionally calls the callback on
+ * each of them once it has been unlinked.
+ *
+ * @param[in] list the list that is being cleared
+ * @param[in] cb the callback function, or NULL
+ */
+static void unlink_all(CC_ISList *list, void (*cb) (void*))
+{
+    CC_ISListLink *link = list->root.next;
+
+    while (link != &list->root) {
+        CC_ISListLink *next = link->next;
+        link->next = NULL;
+        if (cb)
+            cb(TO_ELEM(list, link));
+        link = next;
+    }
+    list->root.next = &list->root;
+    list->tail      = &list->root;
+    list->size      = 0;
+}
@@ -18,14 +18,102 @@
  * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "cc_list.h"
+#include "memory/cc_dynamic_pool.h"
+
+
+/*
+ * A pooled list carves its nodes out of chunks of pool_chunk_size nodes.
+ * Free nodes are kept on a free list linked through their next pointers
+ * and reused by the following insertions. The chunks are linked together
+ * so that they can all be released at once when the list is destroyed.
+ */
+struct node_chunk {
+    struct node_chunk *next;
+    Node               nodes[];
+};
+
+/*
+ * A list without a node pool allocates the nodes it needs for a bulk
+ * operation, such as a copy, in a single block, so that they are laid out
+ * in traversal order. Every block counts its nodes that are still in use
+ * and is freed along with the last of them. The blocks are kept in tables
+ * sorted by address, where the block of a node is found by a binary search
+ * when the node is freed. New blocks go into the first table of the list.
+ * A splice moves the entries of the other list into that table, or chains
+ * its tables behind it if the first table can't grow, so that a splice
+ * never fails; a chained table is freed once it empties. A block that was
+ * carved out of a CC_DynamicPool by a compaction isn't owned by the list
+ * and is left to the pool.
+ */
+struct node_block {
+    Node   *nodes;
+    size_t  count;
+    size_t  live;
+    bool    owned;
+};
 
+struct block_table {
+    struct block_table *next;
+    size_t              count;
+    size_t              capacity;
+    struct node_block   blocks[];
+};
+
+/*
+ * An indexed list keeps a rank index next to its links: a treap with one
+ * entry per node, ordered by the position of the nodes in the list, where
+ * every entry also stores the size of its subtree. Both the node at a given
+ * position and the position of a given node are found in O(log n). Single
+ * node insertions and removals update the index in O(log n), while the
+ * operations that rearrange the whole list drop the index and leave it to
+ * be rebuilt in O(n) by the next positional lookup.
+ */
+typedef struct cc_list_rank_s {
+    struct cc_list_rank_s *left;
+    struct cc_list_rank_s *right;
+    struct cc_list_rank_s *parent;
+    size_t                 size;
+    uint32_t               priority;
+    Node                  *node;
+} Rank;
+
+/*
+ * The nodes of an indexed list carry a pointer to their rank entry past the
+ * end of the public node structure. Nodes are only ever allocated by the
+ * list itself, which sizes them by whether it is indexed.
+ */
+typedef struct ranked_node_s {
+    Node  node;
+    Rank *rank;
+} RankedNode;
+
+#define NODE_RANK(n) (((RankedNode*) (n))->rank)
 
 struct cc_list_s {
     size_t  size;
     Node   *head;
     Node   *tail;
 
+    size_t             pool_chunk_size;
+    struct node_chunk *pool_chunks;
+    struct node_chunk *pool_chunks_tail;
+    Node              *pool_free;
+    Node              *pool_free_tail;
+
+    struct block_table *blocks;
+
+    bool      indexed;
+    bool      rank_valid;
+    Rank     *rank_root;
+    uint32_t  rank_seed;
+
     void  *(*mem_alloc)  (size_t size);
     void  *(*mem_calloc) (size_t blocks, size_t size);
     void   (*mem_free)   (void *block);
@@ -39,10 +127,29 @@ static void  link_after          (Node *base, Node *inserted);
 static void  swap                (Node *n1, Node *n2);
 static void  swap_adjacent       (Node *n1, Node *n2);
 static void  splice_between      (CC_List *list1, CC_List *list2, Node *left, Node *right);
-static bool  link_all_externally (CC_List *l, Node **h, Node **t);
+static bool  link_all_externally (CC_List *list, Node *first, size_t n, void *(*cp) (void*),
+                                  Node **h, Node **t);
 static Node *get_node            (CC_List *list, void *element);
 static enum cc_stat get_node_at  (CC_List *list, size_t index, Node **out);
-static enum cc_stat add_all_to_empty    (CC_List *l1, CC_List *l2);
+static enum cc_stat copy_range   (CC_List *list, Node *first, size_t n, void *(*cp) (void*),
+                                  CC_List **out);
+static size_t node_size          (bool indexed);
+static Node *node_offset         (CC_List *list, Node *base, size_t i);
+static Node *node_alloc          (CC_List *list);
+static Node *node_alloc_n        (CC_List *list, size_t n);
+static void  node_free           (CC_List *list, Node *node);
+static bool  block_reserve       (CC_List *list, size_t n);
+static void  block_insert        (CC_List *list, struct node_block block);
+static void  block_merge         (CC_List *list1, CC_List *list2);
+static void  pool_merge          (CC_List *list1, CC_List *list2);
+static void  pool_release        (CC_List *list);
+static void  index_insert        (CC_List *list, Node *node);
+static void  index_insert_range  (CC_List *list, Node *head, size_t count, size_t index);
+static void  index_splice        (CC_List *list1, CC_List *list2, size_t index);
+static void  index_remove        (CC_List *list, Node *node);
+static void  index_drop          (CC_List *list);
+static void  index_rebuild       (CC_List *list);
+static void  sort_nodes          (CC_List *list, int (*cmp) (void const*, void const*), bool by_ref);
 
 
 /**
@@ -52,6 +159,8 @@ static enum cc_stat add_all_to_empty    (CC_List *l1, CC_List *l2);
  */
 void cc_list_conf_init(CC_ListConf *conf)
 {
+    conf->pool_chunk_size = 0;
+    conf->indexed    = false;
     conf->mem_alloc  = malloc;
     conf->mem_calloc = calloc;
     conf->mem_free   = free;
@@ -83,16 +192,23 @@ enum cc_stat cc_list_new(CC_List **out)
  *                 initialized to appropriate values.
  * @param[out] out Pointer to where the newly created CC_List is stored
  *
- * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
- * memory allocation for the new CC_List structure failed.
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the node pool chunk size is too large, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_List structure failed.
  */
 enum cc_stat cc_list_new_conf(CC_ListConf const * const conf, CC_List **out)
 {
+    if (conf->pool_chunk_size > (CC_MAX_ELEMENTS - sizeof(struct node_chunk)) / node_size(conf->indexed))
+        return CC_ERR_INVALID_CAPACITY;
+
     CC_List *list = conf->mem_calloc(1, sizeof(CC_List));
 
     if (!list)
         return CC_ERR_ALLOC;
 
+    list->pool_chunk_size = conf->pool_chunk_size;
+    list->indexed    = conf->indexed;
+    list->rank_seed  = 0x9E3779B9u;
     list->mem_alloc  = conf->mem_alloc;
     list->mem_calloc = conf->mem_calloc;
     list->mem_free   = conf->mem_free;
@@ -108,9 +224,12 @@ enum cc_stat cc_list_new_conf(CC_ListConf const * const conf, CC_List **out)
  */
 void cc_list_destroy(CC_List *list)
 {
-    if (list->size > 0)
+    /* Pooled nodes are released along with their chunks */
+    if (list->size > 0 && !list->pool_chunk_size)
         cc_list_remove_all(list);
 
+    index_drop(list);
+    pool_release(list);
     list->mem_free(list);
 }
 
@@ -126,6 +245,7 @@ void cc_list_destroy(CC_List *list)
 void cc_list_destroy_cb(CC_List *list, void (*cb) (void*))
 {
     cc_list_remove_all_cb(list, cb);
+    pool_release(list);
     list->mem_free(list);
 }
 
@@ -156,7 +276,7 @@ enum cc_stat cc_list_add(CC_List *list, void *element)
  */
 enum cc_stat cc_list_add_first(CC_List *list, void *element)
 {
-    Node *node = list->mem_calloc(1, sizeof(Node));
+    Node *node = node_alloc(list);
 
     if (node == NULL)
         return CC_ERR_ALLOC;
@@ -172,6 +292,7 @@ enum cc_stat cc_list_add_first(CC_List *list, void *element)
         list->head = node;
     }
     list->size++;
+    index_insert(list, node);
     return CC_OK;
 }
 
@@ -187,7 +308,7 @@ enum cc_stat cc_list_add_first(CC_List *list, void *element)
  */
 enum cc_stat cc_list_add_last(CC_List *list, void *element)
 {
-    Node *node = list->mem_calloc(1, sizeof(Node));
+    Node *node = node_alloc(list);
 
     if (node == NULL)
         return CC_ERR_ALLOC;
@@ -203,6 +324,7 @@ enum cc_stat cc_list_add_last(CC_List *list, void *element)
         list->tail = node;
     }
     list->size++;
+    index_insert(list, node);
     return CC_OK;
 }
 
@@ -229,7 +351,7 @@ enum cc_stat cc_list_add_at(CC_List *list, void *element, size_t index)
     if (stat != CC_OK)
         return stat;
 
-    Node *new = list->mem_calloc(1, sizeof(Node));
+    Node *new = node_alloc(list);
 
     if (!new)
         return CC_ERR_ALLOC;
@@ -241,6 +363,7 @@ enum cc_stat cc_list_add_at(CC_List *list, void *element, size_t index)
         list->head = new;
 
     list->size++;
+    index_insert(list, new);
 
     return CC_OK;
 }
@@ -257,38 +380,9 @@ enum cc_stat cc_list_add_at(CC_List *list, void *element, size_t index)
  */
 enum cc_stat cc_list_add_all(CC_List *list1, CC_List *list2)
 {
-    if (list1->size == 0)
-        return add_all_to_empty(list1, list2);
-
     return cc_list_add_all_at(list1, list2, list1->size);
 }
 
-/**
- * Adds all elements from the second list to the first list which is empty.
- *
- * @param[in] list1 list to which the elements are being added
- * @param[in] list2 list from which the elements are being taken
- *
- * @return CC_OK if the element were successfully added, or CC_ERR_ALLOC if
- * the memory allocation for the new elements failed.
- */
-static enum cc_stat add_all_to_empty(CC_List *list1, CC_List *list2)
-{
-    if (list2->size == 0)
-        return CC_OK;
-
-    Node *head = NULL;
-    Node *tail = NULL;
-
-    if (!link_all_externally(list2, &head, &tail))
-        return CC_ERR_ALLOC;
-
-    list1->head = head;
-    list1->tail = tail;
-    list1->size = list2->size;
-    return CC_OK;
-}
-
 /**
  * Adds all elements from the second list to the first at the specified position
  * by shifting all subsequent elements by the size of the second list. The index
@@ -317,10 +411,19 @@ enum cc_stat cc_list_add_all_at(CC_List *list1, CC_List *list2, size_t index)
     Node *head = NULL;
     Node *tail = NULL;
 
-    if (!link_all_externally(list2, &head, &tail))
+    if (!link_all_externally(list1, list2->head, list2->size, NULL, &head, &tail))
         return CC_ERR_ALLOC;
 
     /* Now we can safely attach the new nodes. */
+    if (list1->size == 0) {
+        list1->head = head;
+        list1->tail = tail;
+        list1->size = list2->size;
+
+        index_insert_range(list1, head, list2->size, 0);
+        return CC_OK;
+    }
+
     Node *end = NULL;
     get_node_at(list1, index, &end);
 
@@ -346,51 +449,45 @@ enum cc_stat cc_list_add_all_at(CC_List *list1, CC_List *list2, size_t index)
     }
 
     list1->size += list2->size;
+    index_insert_range(list1, head, list2->size, index);
 
     return CC_OK;
 }
 
 /**
- * Duplicates the structure of the list without directly attaching it to a
- * specific list. If the operation fails, the mess is cleaned up and false
- * is returned to indicate failure.
+ * Duplicates a run of n nodes without attaching the copies to any list. The
+ * new nodes are allocated by the list at once and linked in order. If the
+ * allocation fails, nothing is allocated and false is returned.
  *
- * @param[in] list the list whose structure is being duplicated
- * @param[in, out] h the pointer to which the new head will be attached
- * @param[in, out] t the pointer to which the new tail will be attached
+ * @param[in] list the list that allocates the new nodes
+ * @param[in] first the first node of the run that is being duplicated
+ * @param[in] n the number of nodes in the run, at least 1
+ * @param[in] cp the function that copies the elements, or NULL if the
+ *               elements are shared
+ * @param[out] h the pointer to which the new head will be attached
+ * @param[out] t the pointer to which the new tail will be attached
  *
  * @return true if the operation was successful, false otherwise.
  */
-static bool link_all_externally(CC_List *list, Node **h, Node **t)
+static bool link_all_externally(CC_List *list, Node *first, size_t n, void *(*cp) (void*),
+                                Node **h, Node **t)
 {
-    Node *insert = list->head;
-
-    size_t i;
-    for (i = 0; i < list->size; i++) {
-        Node *new = list->mem_calloc(1, sizeof(Node));
+    Node *head = node_alloc_n(list, n);
 
-        if (!new) {
-            while (*h) {
-                Node *tmp = (*h)->next;
-                list->mem_free(*h);
-                *h = tmp;
-            }
-            return false;
-        }
-
-        new->data = insert->data;
+    if (!head)
+        return false;
 
-        if (!*h) {
-            *h = new;
-            *t = new;
-        } else {
-            (*t)->next = new;
-            new->prev  = *t;
-            *t         = new;
-        }
+    Node *node = head;
+    Node *tail = head;
 
-        insert = insert->next;
+    while (node) {
+        node->data = cp ? cp(first->data) : first->data;
+        tail  = node;
+        node  = node->next;
+        first = first->next;
     }
+    *h = head;
+    *t = tail;
     return true;
 }
 
@@ -421,8 +518,15 @@ enum cc_stat cc_list_splice(CC_List *list1, CC_List *list2)
  * @param[in] index the index in the first list after which the elements from the
  *                  second list should be inserted
  *
- * @return CC_OK if the elements were successfully moved, or CC_ERR_OUT_OF_RANGE
- * if the index was not in range.
+ * @note If both lists use a node pool, the node chunks of the second list are
+ *       handed over to the first list, and if neither does, so are the node
+ *       blocks of its bulk operations. If only one of them does, or if only
+ *       one of them is indexed, the elements are copied into new nodes of the
+ *       first list instead of being moved.
+ *
+ * @return CC_OK if the elements were successfully moved, CC_ERR_OUT_OF_RANGE
+ * if the index was not in range, or CC_ERR_ALLOC if the memory allocation for
+ * the copied nodes failed.
  */
 enum cc_stat cc_list_splice_at(CC_List *list1, CC_List *list2, size_t index)
 {
@@ -432,7 +536,21 @@ enum cc_stat cc_list_splice_at(CC_List *list1, CC_List *list2, size_t index)
     if (index > list1->size)
         return CC_ERR_OUT_OF_RANGE;
 
+    if (!list1->pool_chunk_size != !list2->pool_chunk_size || list1->indexed != list2->indexed) {
+        enum cc_stat status = cc_list_add_all_at(list1, list2, index);
+
+        if (status == CC_OK)
+            cc_list_remove_all(list2);
+
+        return status;
+    }
+    block_merge(list1, list2);
+
+    pool_merge(list1, list2);
+
     if (list1->size == 0) {
+        index_splice(list1, list2, 0);
+
         // TODO move to splice_between
         list1->head = list2->head;
         list1->tail = list2->tail;
@@ -453,6 +571,7 @@ enum cc_stat cc_list_splice_at(CC_List *list1, CC_List *list2, size_t index)
     else
         get_node_at(list1, index - 1, &base);
 
+    index_splice(list1, list2, index);
     splice_between(list1, list2, base, end);
 
     return CC_OK;
@@ -737,6 +856,8 @@ void cc_list_reverse(CC_List *list)
     if (list->size == 0 || list->size == 1)
         return;
 
+    index_drop(list);
+
     Node *head_old = list->head;
     Node *tail_old = list->tail;
 
@@ -784,37 +905,10 @@ enum cc_stat cc_list_sublist(CC_List *list, size_t b, size_t e, CC_List **out)
     if (b > e || e >= list->size)
         return CC_ERR_INVALID_RANGE;
 
-    CC_ListConf conf;
-
-    conf.mem_alloc  = list->mem_alloc;
-    conf.mem_calloc = list->mem_calloc;
-    conf.mem_free   = list->mem_free;
-
-    CC_List *sub;
-    enum cc_stat status = cc_list_new_conf(&conf, &sub);
-
-    if (status != CC_OK)
-        return status;
-
     Node *node;
-    status = get_node_at(list, b, &node);
-
-    if (status != CC_OK) {
-        list->mem_free(sub);
-        return status;
-    }
+    get_node_at(list, b, &node);
 
-    size_t i;
-    for (i = b; i <= e; i++) {
-        status = cc_list_add(sub, node->data);
-        if (status != CC_OK) {
-            cc_list_destroy(sub);
-            return status;
-        }
-        node = node->next;
-    }
-    *out = sub;
-    return CC_OK;
+    return copy_range(list, node, e - b + 1, NULL, out);
 }
 
 /**
@@ -833,34 +927,7 @@ enum cc_stat cc_list_sublist(CC_List *list, size_t b, size_t e, CC_List **out)
  */
 enum cc_stat cc_list_copy_shallow(CC_List *list, CC_List **out)
 {
-    CC_ListConf conf;
-
-    conf.mem_alloc  = list->mem_alloc;
-    conf.mem_calloc = list->mem_calloc;
-    conf.mem_free   = list->mem_free;
-
-    CC_List *copy;
-    enum cc_stat status = cc_list_new_conf(&conf, &copy);
-
-    if (status != CC_OK)
-        return status;
-
-    Node *node = list->head;
-
-    if (!node) {
-        *out = copy;
-        return CC_OK;
-    }
-    while (node) {
-        status = cc_list_add(copy, node->data);
-        if (status != CC_OK) {
-            cc_list_destroy(copy);
-            return status;
-        }
-        node = node->next;
-    }
-    *out = copy;
-    return CC_OK;
+    return copy_range(list, list->head, list->size, NULL, out);
 }
 
 /**
@@ -878,9 +945,32 @@ enum cc_stat cc_list_copy_shallow(CC_List *list, CC_List **out)
  * memory allocation for the copy failed.
  */
 enum cc_stat cc_list_copy_deep(CC_List *list, void *(*cp) (void *e1), CC_List **out)
+{
+    return copy_range(list, list->head, list->size, cp, out);
+}
+
+/**
+ * Creates a new list with the configuration of the specified list that holds
+ * the elements of a run of its nodes. All nodes of the new list are allocated
+ * at once, so they are laid out in traversal order.
+ *
+ * @param[in] list the list whose configuration the new list inherits
+ * @param[in] first the first node of the run that is being copied
+ * @param[in] n the number of nodes in the run
+ * @param[in] cp the function that copies the elements, or NULL if the
+ *               elements are shared
+ * @param[out] out pointer to where the new list is stored
+ *
+ * @return CC_OK if the copy was successfully created, or CC_ERR_ALLOC if the
+ * memory allocation for the copy failed.
+ */
+static enum cc_stat copy_range(CC_List *list, Node *first, size_t n, void *(*cp) (void*),
+                               CC_List **out)
 {
     CC_ListConf conf;
 
+    conf.pool_chunk_size = list->pool_chunk_size;
+    conf.indexed    = list->indexed;
     conf.mem_alloc  = list->mem_alloc;
     conf.mem_calloc = list->mem_calloc;
     conf.mem_free   = list->mem_free;
@@ -891,22 +981,120 @@ enum cc_stat cc_list_copy_deep(CC_List *list, void *(*cp) (void *e1), CC_List **
     if (status != CC_OK)
         return status;
 
-    Node *node = list->head;
+    if (n > 0 && !link_all_externally(copy, first, n, cp, &copy->head, &copy->tail)) {
+        cc_list_destroy(copy);
+        return CC_ERR_ALLOC;
+    }
+    copy->size = n;
+
+    *out = copy;
+    return CC_OK;
+}
+
+/**
+ * Moves all nodes of the list into a single contiguous run of memory in
+ * traversal order, so that walking the list afterwards walks through memory
+ * sequentially. The elements keep their order. A pooled list replaces all of
+ * its chunks with a single chunk that holds exactly the nodes in use, which
+ * releases the spare nodes of the pool.
+ *
+ * The nodes are allocated with the list allocator, or from the specified
+ * CC_DynamicPool if one is given. The list never frees nodes that come from
+ * a pool, so the pool must outlive the list and any list that the nodes are
+ * later spliced into.
+ *
+ * @note This operation invalidates any iterators over the list.
+ *
+ * @param[in] list the list that is being compacted
+ * @param[in] pool the pool from which the nodes are allocated, or NULL if
+ *                 they are allocated with the list allocator
+ *
+ * @return CC_OK if the list was compacted, or CC_ERR_ALLOC if the memory
+ * allocation for the nodes failed, in which case the list is left unchanged.
+ */
+enum cc_stat cc_list_compact(CC_List *list, CC_DynamicPool *pool)
+{
+    size_t n = list->size;
 
-    if (!node) {
-        *out = copy;
+    if (n == 0) {
+        pool_release(list);
         return CC_OK;
     }
 
-    while (node) {
-        status = cc_list_add(copy, cp(node->data));
-        if (status != CC_OK) {
-            cc_list_destroy(copy);
-            return status;
+    size_t size = node_size(list->indexed);
+
+    if (n > (CC_MAX_ELEMENTS - sizeof(struct node_chunk) - sizeof(void*)) / size)
+        return CC_ERR_ALLOC;
+
+    if (!list->pool_chunk_size && !block_reserve(list, 1))
+        return CC_ERR_ALLOC;
+
+    struct node_chunk *chunk = NULL;
+    Node *nodes;
+
+    if (pool) {
+        /* The pool may hand out unaligned memory */
+        uintptr_t addr = (uintptr_t) cc_dynamic_pool_malloc(n * size + sizeof(void*) - 1, pool);
+
+        if (!addr)
+            return CC_ERR_ALLOC;
+
+        nodes = (Node*) ((addr + sizeof(void*) - 1) & ~(uintptr_t) (sizeof(void*) - 1));
+    } else if (list->pool_chunk_size) {
+        chunk = list->mem_alloc(sizeof(struct node_chunk) + n * size);
+
+        if (!chunk)
+            return CC_ERR_ALLOC;
+
+        nodes = chunk->nodes;
+    } else {
+        nodes = list->mem_alloc(n * size);
+
+        if (!nodes)
+            return CC_ERR_ALLOC;
+    }
+
+    Node  *node = list->head;
+    Node  *prev = NULL;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        Node *next = node->next;
+        Node *copy = node_offset(list, nodes, i);
+
+        copy->data = node->data;
+        copy->prev = prev;
+        copy->next = i + 1 < n ? node_offset(list, nodes, i + 1) : NULL;
+
+        if (list->indexed) {
+            NODE_RANK(copy) = NODE_RANK(node);
+
+            if (NODE_RANK(node))
+                NODE_RANK(node)->node = copy;
         }
-        node = node->next;
+
+        /* Pooled nodes are released along with their chunks */
+        if (!list->pool_chunk_size)
+            node_free(list, node);
+
+        prev = copy;
+        node = next;
+    }
+    list->head = nodes;
+    list->tail = prev;
+
+    if (list->pool_chunk_size) {
+        pool_release(list);
+
+        if (chunk) {
+            chunk->next            = NULL;
+            list->pool_chunks      = chunk;
+            list->pool_chunks_tail = chunk;
+        }
+    } else {
+        struct node_block block = { nodes, n, n, !pool };
+        block_insert(list, block);
     }
-    *out = copy;
     return CC_OK;
 }
 
@@ -1032,7 +1220,10 @@ size_t cc_list_size(CC_List *list)
 
 /**
  * Sorts the specified list. This function makes no guaranties that the
- * sort will be performed in place or in a stable way.
+ * sort will be performed in place or in a stable way. The elements are
+ * sorted in a temporary array, and only if the array can't be allocated
+ * are the nodes relinked by the merge sort of <code>cc_list_sort_in_place()
+ * </code> instead.
  *
  * @note Pointers passed to the comparator function will be pointers to
  *       the list elements that are of type (void*), i.e. void**. So an
@@ -1047,14 +1238,18 @@ size_t cc_list_size(CC_List *list)
  *                0 if the elements are equal and > 0 if the second goes
  *                before the first
  *
- * @return CC_OK if the sort was performed successfully, or CC_ERR_ALLOC
- * if it could not allocate enough memory to perform the sort.
+ * @return CC_OK if the sort was performed successfully, or
+ * CC_ERR_INVALID_RANGE if the list is empty.
  */
 enum cc_stat cc_list_sort(CC_List *list, int (*cmp) (void const *e1, void const *e2))
 {
     void **elements;
     enum cc_stat status = cc_list_to_array(list, &elements);
 
+    if (status == CC_ERR_ALLOC) {
+        sort_nodes(list, cmp, true);
+        return CC_OK;
+    }
     if (status != CC_OK)
         return status;
 
@@ -1071,16 +1266,13 @@ enum cc_stat cc_list_sort(CC_List *list, int (*cmp) (void const *e1, void const
     return CC_OK;
 }
 
-static Node *split(CC_List *, Node *b, size_t l, int (*cmp) (void const *e1, void const *e2));
-static void  merge(Node**, Node**, size_t, size_t, int (*cmp) (void const *e1, void const *e2));
-
 /**
- * Sorts the specified list in place in a stable way.
+ * Sorts the specified list in place in a stable way. The nodes are relinked
+ * by a natural merge sort that takes advantage of the already ordered runs
+ * in the list and doesn't allocate any memory.
  *
- * @note Pointers passed to the comparator function will be pointers to the list
- *       elements that are of type (void*), i.e. void**. So an extra step of
- *       dereferencing will be required before the data can be used for comparison:
- *       e.g. <code>my_type e = *(*((my_type**) ptr));</code>.
+ * @note Unlike with <code>cc_list_sort()</code>, the comparator function is
+ *       passed the list elements themselves.
  *
  * @param[in] list list to be sorted
  * @param[in] cmp the comparator function that must be of type <code>
@@ -1091,188 +1283,415 @@ static void  merge(Node**, Node**, size_t, size_t, int (*cmp) (void const *e1, v
  */
 void cc_list_sort_in_place(CC_List *list, int (*cmp) (void const *e1, void const *e2))
 {
-    split(list, list->head, list->size, cmp);
+    sort_nodes(list, cmp, false);
+}
+
+/**
+ * Compares the elements of two nodes. The comparator is either passed the
+ * elements or pointers to them, depending on the by_ref flag.
+ */
+static INLINE int sort_cmp(Node *a, Node *b, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    return by_ref ? cmp(&a->data, &b->data) : cmp(a->data, b->data);
 }
 
 /**
- * Splits the list section into two partitions.
+ * Detaches the run at the front of the node chain. A run is the longest
+ * non descending sequence of nodes. A strictly descending sequence also
+ * counts as a run and is reversed while it is detached, which keeps the
+ * sort stable since such a sequence holds no equal elements.
  *
- * @param[in] list the sublist
- * @param[in] b    the head node of the sublist
- * @param[in] size number of nodes in the sublist
- * @param[in] cmp  comparator function
+ * @param[in, out] rest the chain from which the run is detached and the
+ *                      remainder of the chain as the output
+ * @param[in] cmp the comparator function
+ * @param[in] by_ref whether the comparator is passed pointers to elements
  *
- * @return
+ * @return the first node of the detached run.
  */
-static Node *split(CC_List *list, Node *b, size_t size, int (*cmp) (void const*, void const*))
+static Node *take_run(Node **rest, int (*cmp) (void const*, void const*), bool by_ref)
 {
-    if (size < 2)
-        return b;
+    Node *head = *rest;
+    Node *node = head;
+    Node *next = head->next;
 
-    size_t l_size = size / 2;
-    size_t r_size = size / 2 + (size % 2);
+    if (next && sort_cmp(next, head, cmp, by_ref) < 0) {
+        head->next = NULL;
 
-    Node *center = b;
+        while (next && sort_cmp(next, node, cmp, by_ref) < 0) {
+            Node *after = next->next;
+            next->next = head;
+            head       = next;
+            node       = next;
+            next       = after;
+        }
+        *rest = next;
+        return head;
+    }
 
-    size_t i;
-    for (i = 0; i < l_size; i++)
-        center = center->next;
+    while (next && sort_cmp(node, next, cmp, by_ref) <= 0) {
+        node = next;
+        next = next->next;
+    }
+    node->next = NULL;
 
-    Node *l_head = split(list, b, l_size, cmp);
-    Node *r_head = split(list, center, r_size, cmp);
+    *rest = next;
+    return head;
+}
 
-    merge(&l_head, &r_head, l_size, r_size, cmp);
+/**
+ * Merges two sorted node chains into one. On equal elements the node from
+ * the first chain goes first, so the first chain must hold the nodes that
+ * came earlier in the list.
+ *
+ * @return the first node of the merged chain.
+ */
+static Node *merge_runs(Node *a, Node *b, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    Node  head;
+    Node *tail = &head;
 
-    list->head = l_head;
-    list->tail = r_head;
+    while (a && b) {
+        if (sort_cmp(b, a, cmp, by_ref) < 0) {
+            tail->next = b;
+            b          = b->next;
+        } else {
+            tail->next = a;
+            a          = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
 
-    return l_head;
+    return head.next;
 }
 
 /**
- * Merges the two partitions together in place in a stable way. The left
- * partition starts at the "left" node and ends "l_size" nodes to the right of it.
- * Similarly the right partition starts at the "right" and ends "r_size" nodes
- * to the right. Both "left" and "right" parameters are used for input and
- * output. As an output parameter the "left" parameter will be assigned as the
- * head node of the newly merged section, while the "right" parameter will be
- * assigned the tail after the merge. The result of this function is a sorted
- * section of the list in an ascending order.
+ * Sorts a NULL terminated node chain with a bottom-up natural merge sort.
+ * The chain is cut into its already ordered runs, which are merged like the
+ * digits of a binary counter: bin i holds a sorted chain of about 2^i runs,
+ * and every new run is merged with the occupied bins from the bottom up
+ * until it finds an empty one. Chains are merged while they are still warm
+ * in the cache, the sort needs no memory beyond the fixed bins, and an
+ * already sorted chain is handled in a single pass. Only the next links of
+ * the sorted chain are valid.
  *
- *@param[in, out] left   the beginning of the left partition as input and the
- *                       the head node of the merged section as the output
- *@param[in, out] right  the beginning of the right partition as input and the
- *                       the tail node of the merged section as the output
- *@param[in]      l_size size of the the left partition
- *@param[in]      r_size size of the right partition
- *@param[in]      cmp    the comparator function
+ * @param[in] head the first node of the chain that is being sorted
+ * @param[in] cmp the comparator function
+ * @param[in] by_ref whether the comparator is passed pointers to elements
+ *
+ * @return the first node of the sorted chain.
  */
-static INLINE void merge(Node **left, Node **right, size_t l_size,
-                        size_t r_size, int (*cmp) (void const*, void const*))
+static Node *sort_chain(Node *head, int (*cmp) (void const*, void const*), bool by_ref)
 {
-    size_t size = r_size + l_size;
-    size_t l    = 0; /* Number of processed elements from the left partition */
-    size_t r    = 0; /* NUmber of processed elements from the right partition. */
-
-    Node *l_part = *left;
-    Node *r_part = *right;
+    Node   *bins[sizeof(size_t) * 8] = { NULL };
+    Node   *rest = head;
+    size_t  i;
 
-    size_t i;
-    for (i = 0; i < size; i++) {
-        int c = cmp(l_part->data, r_part->data);
+    while (rest) {
+        Node *run = take_run(&rest, cmp, by_ref);
 
-        if ((c < 0 || c == 0)) {
-            /* The two partitions are already sorted. */
-            if (i == 0 && size == 2) {
-                break;
-            }
-            /* If all the elements on the left side are in place,
-               all the elements on the right must be as well. */
-            if (l == l_size) {
-                /* Quickly advance the right pointer to the end for
-                 * the remainder of r and exit.*/
-                for (;r < r_size - 1; r++)
-                    r_part = r_part->next;
-                *right = r_part;
-                break;
-            }
-            l_part = l_part->next;
-            l++;
-        } else {
-            Node *tmp = (r_part)->next;
-            link_behind(l_part, r_part);
-            /* The elements are swapped. Now set head and tail and
-             * exit the loop. */
-            if (i == 0 && size == 2) {
-                *right = l_part;
-                *left  = r_part;
-                break;
-            }
-            r++;
-            /* All right partition elements are now behind the left
-             * partition elements.*/
-            if (r == r_size) {
-                /* Quickly advance the left partition pointer and set
-                 * the rightmost element as the new head. */
-                for (;l < l_size - 1; l++)
-                    l_part = l_part->next;
-                *right = l_part;
-                break;
-            }
-            if (i == 0) {
-                *left = r_part;
-            }
-            r_part = tmp;
+        for (i = 0; bins[i]; i++) {
+            run     = merge_runs(bins[i], run, cmp, by_ref);
+            bins[i] = NULL;
         }
+        bins[i] = run;
+    }
+
+    head = NULL;
+    for (i = 0; i < sizeof(size_t) * 8; i++) {
+        if (bins[i])
+            head = merge_runs(bins[i], head, cmp, by_ref);
     }
+    return head;
 }
 
 /**
- * A 'foreach loop' function that invokes the specified function on each element
- * in the list.
+ * Makes the sorted chain the content of the list by restoring the prev
+ * links and the tail.
  *
- * @param[in] list list on which this operation is being performed
- * @param[in] op the operation function that is to be invoked on each list
- *               element
+ * @param[in] list the list that was sorted
+ * @param[in] head the first node of the sorted chain
  */
-void cc_list_foreach(CC_List *list, void (*op) (void *e))
+static void relink_sorted(CC_List *list, Node *head)
 {
-    Node *n = list->head;
+    Node *prev = NULL;
+    Node *node;
 
-    while (n) {
-        op(n->data);
-        n = n->next;
+    for (node = head; node; node = node->next) {
+        node->prev = prev;
+        prev       = node;
     }
+    list->head = head;
+    list->tail = prev;
 }
 
 /**
- * A fold/reduce function that collects all of the elements in the list
- * together.
+ * Sorts the nodes of the list on the calling thread.
  *
- * @param[in] list the list on which this operation is performed
- * @param[in] fn the operation function that is to be invoked on list array
- *               element
- * @param[in] result the pointer which will collect the end result
+ * @param[in] list the list that is being sorted
+ * @param[in] cmp the comparator function
+ * @param[in] by_ref whether the comparator is passed pointers to elements
  */
-
-enum cc_stat cc_list_reduce(CC_List *list, void (*fn)(void *, void *, void *), void *result)
+static void sort_nodes(CC_List *list, int (*cmp) (void const*, void const*), bool by_ref)
 {
-    size_t list_size = cc_list_size(list);
+    if (list->size < 2)
+        return;
 
-    if (list_size == 0)
-        return CC_ERR_OUT_OF_RANGE;
+    index_drop(list);
+    relink_sorted(list, sort_chain(list->head, cmp, by_ref));
+}
 
-    if (list_size == 1)
-    {
-        fn(list->head->data, NULL, result);
-        return CC_OK;
-    }
+#if defined(_WIN32)
+typedef HANDLE SortThread;
+#else
+typedef pthread_t SortThread;
+#endif
 
-    fn(list->head->data, list->head->next->data, result);
+/*
+ * A unit of work of the parallel sort: the chain a is either sorted on its
+ * own, or merged with the chain b that followed it in the list. The result
+ * is stored back into a.
+ */
+struct sort_task {
+    Node        *a;
+    Node        *b;
+    int        (*cmp) (void const*, void const*);
+    SortThread   thread;
+    bool         started;
+};
 
-    // the current start will be the second element of list
-    Node *curr = list->head->next->next;
-    Node *next = NULL;
+static void run_sort_task(struct sort_task *task)
+{
+    if (task->b)
+        task->a = merge_runs(task->a, task->b, task->cmp, false);
+    else
+        task->a = sort_chain(task->a, task->cmp, false);
+}
 
-    while (curr)
-    {
-        next = curr->next;
+#if defined(_WIN32)
+static DWORD WINAPI sort_thread(LPVOID arg)
+{
+    run_sort_task(arg);
+    return 0;
+}
 
-        fn(result, curr->data, result);
+static bool sort_thread_start(SortThread *thread, struct sort_task *task)
+{
+    *thread = CreateThread(NULL, 0, sort_thread, task, 0, NULL);
+    return *thread != NULL;
+}
 
-        curr = next;
-    }
+static void sort_thread_join(SortThread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+static void *sort_thread(void *arg)
+{
+    run_sort_task(arg);
+    return NULL;
+}
 
-    return CC_OK;
+static bool sort_thread_start(SortThread *thread, struct sort_task *task)
+{
+    return pthread_create(thread, NULL, sort_thread, task) == 0;
 }
 
+static void sort_thread_join(SortThread thread)
+{
+    pthread_join(thread, NULL);
+}
+#endif
+
 /**
- * Filters the CC_List by modifying it. It removes all elements that don't
- * return true on pred(element).
+ * Runs the tasks concurrently. The first task runs on the calling thread
+ * and every other task on a thread of its own. A task whose thread cannot
+ * be started runs on the calling thread instead, so the tasks always
+ * complete.
  *
- * @param[in] list list that is to be filtered
- * @param[in] pred predicate function which returns true if the element should
- *                 be kept in the CC_List
+ * @param[in] tasks the tasks that are being run
+ * @param[in] n the number of tasks
+ */
+static void run_sort_tasks(struct sort_task *tasks, size_t n)
+{
+    size_t i;
+
+    for (i = 1; i < n; i++)
+        tasks[i].started = sort_thread_start(&tasks[i].thread, &tasks[i]);
+
+    run_sort_task(&tasks[0]);
+
+    for (i = 1; i < n; i++) {
+        if (tasks[i].started)
+            sort_thread_join(tasks[i].thread);
+        else
+            run_sort_task(&tasks[i]);
+    }
+}
+
+/**
+ * Sorts the specified list in place in a stable way using several threads.
+ * The list is cut into one contiguous sublist per thread, the sublists are
+ * sorted concurrently by relinking their nodes, and the sorted sublists are
+ * then merged pairwise, with every merge of a round running on its own
+ * thread. No elements are copied, and apart from a small array of per thread
+ * tasks no memory is allocated.
+ *
+ * The number of threads is lowered so that every thread sorts at least
+ * <code>cutoff</code> nodes, and the list is sorted on the calling thread
+ * when that leaves fewer than two threads. Starting a thread costs more
+ * than sorting a short list, so the cutoff should be in the thousands.
+ *
+ * @note Like with <code>cc_list_sort_in_place()</code>, the comparator
+ *       function is passed the list elements themselves. It is called from
+ *       several threads at once and must therefore be thread safe.
+ *
+ * @param[in] list list to be sorted
+ * @param[in] cmp the comparator function that must be of type <code>
+ *                int cmp(const void e1*, const void e2*)</code> that
+ *                returns < 0 if the first element goes before the second,
+ *                0 if the elements are equal and > 0 if the second goes
+ *                before the first
+ * @param[in] threads the maximum number of threads that sort the list,
+ *                    including the calling thread
+ * @param[in] cutoff the minimum number of nodes sorted by each thread
+ *
+ * @return CC_OK if the sort was performed successfully, or CC_ERR_ALLOC if
+ * the memory allocation for the per thread tasks failed, in which case the
+ * list is left unchanged.
+ */
+enum cc_stat cc_list_sort_in_place_parallel(CC_List *list, int (*cmp) (void const *e1, void const *e2),
+                                            size_t threads, size_t cutoff)
+{
+    size_t parts = threads;
+
+    if (cutoff < 2)
+        cutoff = 2;
+    if (parts > list->size / cutoff)
+        parts = list->size / cutoff;
+
+    if (parts < 2) {
+        sort_nodes(list, cmp, false);
+        return CC_OK;
+    }
+
+    struct sort_task *tasks = list->mem_alloc(parts * sizeof(struct sort_task));
+
+    if (!tasks)
+        return CC_ERR_ALLOC;
+
+    index_drop(list);
+
+    size_t  len   = list->size / parts;
+    size_t  extra = list->size % parts;
+    Node   *node  = list->head;
+    size_t  i, j;
+
+    for (i = 0; i < parts; i++) {
+        tasks[i].a   = node;
+        tasks[i].b   = NULL;
+        tasks[i].cmp = cmp;
+
+        for (j = i < extra ? 0 : 1; j < len; j++)
+            node = node->next;
+
+        Node *next = node->next;
+        node->next = NULL;
+        node       = next;
+    }
+    run_sort_tasks(tasks, parts);
+
+    /* Merging neighbours keeps equal elements in their original order */
+    while (parts > 1) {
+        size_t pairs = parts / 2;
+
+        for (i = 0; i < pairs; i++) {
+            tasks[i].a = tasks[2 * i].a;
+            tasks[i].b = tasks[2 * i + 1].a;
+        }
+        run_sort_tasks(tasks, pairs);
+
+        if (parts % 2) {
+            tasks[pairs].a = tasks[parts - 1].a;
+            tasks[pairs].b = NULL;
+            pairs++;
+        }
+        parts = pairs;
+    }
+
+    relink_sorted(list, tasks[0].a);
+
+    list->mem_free(tasks);
+    return CC_OK;
+}
+
+/**
+ * A 'foreach loop' function that invokes the specified function on each element
+ * in the list.
+ *
+ * @param[in] list list on which this operation is being performed
+ * @param[in] op the operation function that is to be invoked on each list
+ *               element
+ */
+void cc_list_foreach(CC_List *list, void (*op) (void *e))
+{
+    Node *n = list->head;
+
+    while (n) {
+        op(n->data);
+        n = n->next;
+    }
+}
+
+/**
+ * A fold/reduce function that collects all of the elements in the list
+ * together.
+ *
+ * @param[in] list the list on which this operation is performed
+ * @param[in] fn the operation function that is to be invoked on list array
+ *               element
+ * @param[in] result the pointer which will collect the end result
+ */
+
+enum cc_stat cc_list_reduce(CC_List *list, void (*fn)(void *, void *, void *), void *result)
+{
+    size_t list_size = cc_list_size(list);
+
+    if (list_size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (list_size == 1)
+    {
+        fn(list->head->data, NULL, result);
+        return CC_OK;
+    }
+
+    fn(list->head->data, list->head->next->data, result);
+
+    // the current start will be the second element of list
+    Node *curr = list->head->next->next;
+    Node *next = NULL;
+
+    while (curr)
+    {
+        next = curr->next;
+
+        fn(result, curr->data, result);
+
+        curr = next;
+    }
+
+    return CC_OK;
+}
+
+/**
+ * Filters the CC_List by modifying it. It removes all elements that don't
+ * return true on pred(element).
+ *
+ * @param[in] list list that is to be filtered
+ * @param[in] pred predicate function which returns true if the element should
+ *                 be kept in the CC_List
  *
  * @return CC_OK if the list was filtered successfully, or CC_ERR_OUT_OF_RANGE
  * if the CC_List is empty.
@@ -1395,7 +1814,7 @@ enum cc_stat cc_list_iter_remove(CC_ListIter *iter, void **out)
  */
 enum cc_stat cc_list_iter_add(CC_ListIter *iter, void *element)
 {
-    Node *new_node = iter->list->mem_calloc(1, sizeof(Node));
+    Node *new_node = node_alloc(iter->list);
 
     if (!new_node)
         return CC_ERR_ALLOC;
@@ -1404,11 +1823,12 @@ enum cc_stat cc_list_iter_add(CC_ListIter *iter, void *element)
 
     link_after(iter->last, new_node);
 
-    if (iter->index == iter->list->size)
+    if (!new_node->next)
         iter->list->tail = new_node;
 
     iter->list->size++;
     iter->index++;
+    index_insert(iter->list, new_node);
 
     return CC_OK;
 }
@@ -1511,7 +1931,7 @@ void cc_list_diter_init(CC_ListIter *iter, CC_List *list)
  */
 enum cc_stat cc_list_diter_add(CC_ListIter *iter, void *element)
 {
-    Node *new_node = iter->list->mem_calloc(1, sizeof(Node));
+    Node *new_node = node_alloc(iter->list);
 
     if (!new_node)
         return CC_ERR_ALLOC;
@@ -1525,6 +1945,7 @@ enum cc_stat cc_list_diter_add(CC_ListIter *iter, void *element)
 
     iter->list->size++;
     iter->last = new_node;
+    index_insert(iter->list, new_node);
     return CC_OK;
 }
 
@@ -1690,15 +2111,15 @@ enum cc_stat cc_list_zip_iter_next(CC_ListZipIter *iter, void **out1, void **out
  */
 enum cc_stat cc_list_zip_iter_add(CC_ListZipIter *iter, void *e1, void *e2)
 {
-    Node *new_node1 = iter->l1->mem_calloc(1, sizeof(Node));
+    Node *new_node1 = node_alloc(iter->l1);
 
     if (!new_node1)
         return CC_ERR_ALLOC;
 
-    Node *new_node2 = iter->l2->mem_calloc(1, sizeof(Node));
+    Node *new_node2 = node_alloc(iter->l2);
 
     if (!new_node2) {
-        iter->l1->mem_free(new_node1);
+        node_free(iter->l1, new_node1);
         return CC_ERR_ALLOC;
     }
 
@@ -1708,16 +2129,19 @@ enum cc_stat cc_list_zip_iter_add(CC_ListZipIter *iter, void *e1, void *e2)
     link_after(iter->l1_last, new_node1);
     link_after(iter->l2_last, new_node2);
 
-    if (iter->index == iter->l1->size)
+    if (!new_node1->next)
         iter->l1->tail = new_node1;
 
-    if (iter->index == iter->l2->size)
+    if (!new_node2->next)
         iter->l2->tail = new_node2;
 
     iter->l1->size++;
     iter->l2->size++;
     iter->index++;
 
+    index_insert(iter->l1, new_node1);
+    index_insert(iter->l2, new_node2);
+
     return CC_OK;
 }
 
@@ -1966,7 +2390,8 @@ static void *unlinkn(CC_List *list, Node *node)
     if (node->next != NULL)
         node->next->prev = node->prev;
 
-    list->mem_free(node);
+    index_remove(list, node);
+    node_free(list, node);
     list->size--;
 
     return data;
@@ -1986,6 +2411,8 @@ static bool unlinkn_all(CC_List *list, void (*cb) (void*))
     if (list->size == 0)
         return false;
 
+    index_drop(list);
+
     Node *node = list->head;
 
     while (node) {
@@ -2000,6 +2427,754 @@ static bool unlinkn_all(CC_List *list, void (*cb) (void*))
     return true;
 }
 
+/**
+ * Returns the size of a single node of a list.
+ *
+ * @param[in] indexed whether the list is indexed
+ *
+ * @return the size of the nodes of the list.
+ */
+static size_t node_size(bool indexed)
+{
+    return indexed ? sizeof(RankedNode) : sizeof(Node);
+}
+
+/**
+ * Returns the node at the specified offset from the first node of a run of
+ * contiguously allocated nodes of the list.
+ *
+ * @param[in] list the list that allocated the nodes
+ * @param[in] base the first node of the run
+ * @param[in] i the offset of the node in the run
+ *
+ * @return the node at the offset.
+ */
+static Node *node_offset(CC_List *list, Node *base, size_t i)
+{
+    return (Node*) ((uint8_t*) base + i * node_size(list->indexed));
+}
+
+/**
+ * Allocates a new zeroed node, either from the node pool of the list or
+ * directly from the list allocator if the list isn't pooled.
+ *
+ * @param[in] list the list for which the node is being allocated
+ *
+ * @return the new node, or NULL if the allocation failed.
+ */
+static Node *node_alloc(CC_List *list)
+{
+    size_t size = node_size(list->indexed);
+
+    if (!list->pool_chunk_size)
+        return list->mem_calloc(1, size);
+
+    if (!list->pool_free) {
+        struct node_chunk *chunk =
+            list->mem_alloc(sizeof(struct node_chunk) + list->pool_chunk_size * size);
+
+        if (!chunk)
+            return NULL;
+
+        size_t i;
+        for (i = 0; i < list->pool_chunk_size - 1; i++)
+            node_offset(list, chunk->nodes, i)->next = node_offset(list, chunk->nodes, i + 1);
+        node_offset(list, chunk->nodes, i)->next = NULL;
+
+        if (!list->pool_chunks)
+            list->pool_chunks_tail = chunk;
+
+        chunk->next          = list->pool_chunks;
+        list->pool_chunks    = chunk;
+        list->pool_free      = chunk->nodes;
+        list->pool_free_tail = node_offset(list, chunk->nodes, i);
+    }
+    Node *node = list->pool_free;
+    list->pool_free = node->next;
+
+    node->data = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+
+    if (list->indexed)
+        NODE_RANK(node) = NULL;
+
+    return node;
+}
+
+/**
+ * Allocates n zeroed nodes at once and links them in order through both
+ * their next and prev pointers. A pooled list takes the nodes from its free
+ * list and allocates the missing ones in a single chunk, while a list
+ * without a pool allocates all of them in a single block. Either all nodes
+ * are allocated or none are.
+ *
+ * @param[in] list the list for which the nodes are being allocated
+ * @param[in] n the number of nodes, at least 1
+ *
+ * @return the first of the new nodes, or NULL if the allocation failed.
+ */
+static Node *node_alloc_n(CC_List *list, size_t n)
+{
+    if (n == 1)
+        return node_alloc(list);
+
+    Node   *fresh = NULL;
+    size_t  size  = node_size(list->indexed);
+    size_t  taken = 0;
+    size_t  i;
+
+    if (list->pool_chunk_size) {
+        Node *node = list->pool_free;
+
+        while (node && taken < n) {
+            node = node->next;
+            taken++;
+        }
+
+        if (taken < n) {
+            if (n - taken > (CC_MAX_ELEMENTS - sizeof(struct node_chunk)) / size)
+                return NULL;
+
+            struct node_chunk *chunk =
+                list->mem_alloc(sizeof(struct node_chunk) + (n - taken) * size);
+
+            if (!chunk)
+                return NULL;
+
+            if (!list->pool_chunks)
+                list->pool_chunks_tail = chunk;
+
+            chunk->next       = list->pool_chunks;
+            list->pool_chunks = chunk;
+            fresh             = chunk->nodes;
+        }
+    } else {
+        if (n > CC_MAX_ELEMENTS / size)
+            return NULL;
+
+        fresh = list->mem_alloc(n * size);
+
+        if (!fresh)
+            return NULL;
+
+        if (!block_reserve(list, 1)) {
+            list->mem_free(fresh);
+            return NULL;
+        }
+        struct node_block block = { fresh, n, n, true };
+        block_insert(list, block);
+    }
+
+    Node *head = NULL;
+    Node *tail = NULL;
+
+    /* Reused nodes go first, followed by the contiguous fresh ones */
+    for (i = 0; i < n; i++) {
+        Node *node;
+
+        if (i < taken) {
+            node = list->pool_free;
+            list->pool_free = node->next;
+        } else {
+            node = node_offset(list, fresh, i - taken);
+        }
+        node->data = NULL;
+        node->next = NULL;
+        node->prev = tail;
+
+        if (list->indexed)
+            NODE_RANK(node) = NULL;
+
+        if (tail)
+            tail->next = node;
+        else
+            head = node;
+
+        tail = node;
+    }
+    return head;
+}
+
+/**
+ * Returns a node to the node pool of the list, or frees it if the list
+ * isn't pooled. A node that belongs to a block is only freed with the last
+ * node of its block.
+ *
+ * @param[in] list the list that allocated the node
+ * @param[in] node the node that is being freed
+ */
+static void node_free(CC_List *list, Node *node)
+{
+    if (list->pool_chunk_size) {
+        if (!list->pool_free)
+            list->pool_free_tail = node;
+
+        node->next = list->pool_free;
+        list->pool_free = node;
+        return;
+    }
+
+    struct block_table **link = &list->blocks;
+
+    for (; *link; link = &(*link)->next) {
+        struct block_table *table = *link;
+
+        size_t lo = 0;
+        size_t hi = table->count;
+
+        /* Find the last block that starts at or before the node */
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+
+            if ((uintptr_t) table->blocks[mid].nodes <= (uintptr_t) node)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if (lo == 0)
+            continue;
+
+        struct node_block *block = &table->blocks[lo - 1];
+
+        if ((uintptr_t) node >= (uintptr_t) node_offset(list, block->nodes, block->count))
+            continue;
+
+        if (--block->live == 0) {
+            if (block->owned)
+                list->mem_free(block->nodes);
+
+            memmove(block, block + 1, (table->count - lo) * sizeof(struct node_block));
+            table->count--;
+
+            if (table->count == 0 && table != list->blocks) {
+                *link = table->next;
+                list->mem_free(table);
+            }
+        }
+        return;
+    }
+    list->mem_free(node);
+}
+
+/**
+ * Makes room for n more entries in the first block table of the list.
+ *
+ * @param[in] list the list whose block table is being grown
+ * @param[in] n the number of entries to make room for
+ *
+ * @return true if the table has room, or false if it could not be grown.
+ */
+static bool block_reserve(CC_List *list, size_t n)
+{
+    struct block_table *table = list->blocks;
+
+    size_t count    = table ? table->count : 0;
+    size_t capacity = table ? table->capacity : 0;
+
+    if (count + n <= capacity)
+        return true;
+
+    if (!capacity)
+        capacity = 4;
+
+    while (capacity < count + n)
+        capacity *= 2;
+
+    struct block_table *grown =
+        list->mem_alloc(sizeof(struct block_table) + capacity * sizeof(struct node_block));
+
+    if (!grown)
+        return false;
+
+    grown->next     = table ? table->next : NULL;
+    grown->count    = count;
+    grown->capacity = capacity;
+
+    if (table) {
+        memcpy(grown->blocks, table->blocks, count * sizeof(struct node_block));
+        list->mem_free(table);
+    }
+    list->blocks = grown;
+    return true;
+}
+
+/**
+ * Inserts a block into the first block table of the list, keeping the table
+ * sorted by address. The table must have room for the block.
+ *
+ * @param[in] list the list that takes the block
+ * @param[in] block the block that is being inserted
+ */
+static void block_insert(CC_List *list, struct node_block block)
+{
+    struct block_table *table = list->blocks;
+    size_t i = table->count;
+
+    while (i > 0 && (uintptr_t) table->blocks[i - 1].nodes > (uintptr_t) block.nodes) {
+        table->blocks[i] = table->blocks[i - 1];
+        i--;
+    }
+    table->blocks[i] = block;
+    table->count++;
+}
+
+/**
+ * Hands over the block tables of the second list to the first list, so that
+ * nodes can be moved from the second list to the first. The entries of each
+ * table are moved into the first table of the first list if it can grow to
+ * hold them, and otherwise the whole table is chained behind it, so that
+ * the hand over never fails.
+ *
+ * @param[in] list1 the list that takes over the blocks
+ * @param[in] list2 the list whose blocks are being taken over
+ */
+static void block_merge(CC_List *list1, CC_List *list2)
+{
+    struct block_table *table = list2->blocks;
+    list2->blocks = NULL;
+
+    while (table) {
+        struct block_table *next = table->next;
+
+        if (block_reserve(list1, table->count)) {
+            size_t i;
+            for (i = 0; i < table->count; i++)
+                block_insert(list1, table->blocks[i]);
+
+            list2->mem_free(table);
+        } else if (list1->blocks) {
+            table->next         = list1->blocks->next;
+            list1->blocks->next = table;
+        } else {
+            table->next   = NULL;
+            list1->blocks = table;
+        }
+        table = next;
+    }
+}
+
+/**
+ * Hands over the node chunks and the free nodes of the second list to the
+ * first list, so that nodes can be moved from the second list to the first.
+ * Both lists are linked in through their tail pointers, so the hand over
+ * takes constant time.
+ *
+ * @param[in] list1 the list that takes over the node pool
+ * @param[in] list2 the list whose node pool is being taken over
+ */
+static void pool_merge(CC_List *list1, CC_List *list2)
+{
+    if (!list2->pool_chunks)
+        return;
+
+    if (!list1->pool_chunks)
+        list1->pool_chunks_tail = list2->pool_chunks_tail;
+
+    list2->pool_chunks_tail->next = list1->pool_chunks;
+    list1->pool_chunks            = list2->pool_chunks;
+    list2->pool_chunks            = NULL;
+    list2->pool_chunks_tail       = NULL;
+
+    if (list2->pool_free) {
+        if (!list1->pool_free)
+            list1->pool_free_tail = list2->pool_free_tail;
+
+        list2->pool_free_tail->next = list1->pool_free;
+        list1->pool_free            = list2->pool_free;
+        list2->pool_free            = NULL;
+        list2->pool_free_tail       = NULL;
+    }
+}
+
+/**
+ * Frees all node chunks of the list. Any node still linked into the list
+ * becomes invalid.
+ *
+ * @param[in] list the list whose node pool is being released
+ */
+static void pool_release(CC_List *list)
+{
+    struct node_chunk *chunk = list->pool_chunks;
+
+    while (chunk) {
+        struct node_chunk *next = chunk->next;
+        list->mem_free(chunk);
+        chunk = next;
+    }
+    list->pool_chunks      = NULL;
+    list->pool_chunks_tail = NULL;
+    list->pool_free        = NULL;
+    list->pool_free_tail   = NULL;
+
+    struct block_table *table = list->blocks;
+
+    while (table) {
+        struct block_table *next = table->next;
+
+        size_t i;
+        for (i = 0; i < table->count; i++) {
+            if (table->blocks[i].owned)
+                list->mem_free(table->blocks[i].nodes);
+        }
+        list->mem_free(table);
+        table = next;
+    }
+    list->blocks = NULL;
+}
+
+/**
+ * Returns the number of entries in the rank subtree, or 0 for an empty
+ * subtree.
+ */
+static INLINE size_t rank_size(Rank *r)
+{
+    return r ? r->size : 0;
+}
+
+/**
+ * Recomputes the subtree size of the rank entry after its children have
+ * changed and points the children back at it.
+ */
+static INLINE void rank_update(Rank *r)
+{
+    r->size = 1 + rank_size(r->left) + rank_size(r->right);
+
+    if (r->left)
+        r->left->parent = r;
+    if (r->right)
+        r->right->parent = r;
+}
+
+/**
+ * Joins two rank subtrees, placing all entries of the first subtree in
+ * front of the entries of the second one.
+ *
+ * @return the root of the joined subtree.
+ */
+static Rank *rank_merge(Rank *a, Rank *b)
+{
+    if (!a)
+        return b;
+    if (!b)
+        return a;
+
+    if (a->priority > b->priority) {
+        a->right = rank_merge(a->right, b);
+        rank_update(a);
+        return a;
+    }
+    b->left = rank_merge(a, b->left);
+    rank_update(b);
+    return b;
+}
+
+/**
+ * Splits the rank subtree so that the first k entries end up in the left
+ * subtree and the rest in the right one.
+ */
+static void rank_split(Rank *r, size_t k, Rank **left, Rank **right)
+{
+    if (!r) {
+        *left  = NULL;
+        *right = NULL;
+        return;
+    }
+    if (rank_size(r->left) < k) {
+        rank_split(r->right, k - rank_size(r->left) - 1, &r->right, right);
+        rank_update(r);
+        *left = r;
+    } else {
+        rank_split(r->left, k, left, &r->left);
+        rank_update(r);
+        *right = r;
+    }
+}
+
+/**
+ * Returns the position of the node that owns the rank entry.
+ */
+static size_t rank_position(Rank *r)
+{
+    size_t pos = rank_size(r->left);
+
+    while (r->parent) {
+        if (r == r->parent->right)
+            pos += rank_size(r->parent->left) + 1;
+        r = r->parent;
+    }
+    return pos;
+}
+
+/**
+ * Inserts a rank subtree into the index of the list so that its first
+ * entry ends up at the specified position.
+ */
+static void rank_insert_at(CC_List *list, Rank *sub, size_t index)
+{
+    Rank *left;
+    Rank *right;
+
+    rank_split(list->rank_root, index, &left, &right);
+
+    list->rank_root = rank_merge(rank_merge(left, sub), right);
+    list->rank_root->parent = NULL;
+}
+
+/**
+ * Allocates a rank entry for the node with a fresh random priority.
+ *
+ * @return the new entry, or NULL if the allocation failed.
+ */
+static Rank *rank_new(CC_List *list, Node *node)
+{
+    Rank *r = list->mem_alloc(sizeof(Rank));
+
+    if (!r)
+        return NULL;
+
+    list->rank_seed ^= list->rank_seed << 13;
+    list->rank_seed ^= list->rank_seed >> 17;
+    list->rank_seed ^= list->rank_seed << 5;
+
+    r->left     = NULL;
+    r->right    = NULL;
+    r->parent   = NULL;
+    r->size     = 1;
+    r->priority = list->rank_seed;
+    r->node     = node;
+    NODE_RANK(node) = r;
+
+    return r;
+}
+
+/**
+ * Builds a rank subtree over count consecutive nodes starting with head.
+ * The entries get random priorities and the subtree is assembled as a
+ * Cartesian tree in a single pass, keeping the rightmost path on a stack.
+ * Every entry on the stack temporarily stores the position of its first
+ * node in place of its size, which becomes known once the entry is popped.
+ *
+ * @param[in] list the list that allocates the entries
+ * @param[in] head the first node
+ * @param[in] count the number of nodes
+ * @param[out] out pointer to where the root of the subtree is stored
+ *
+ * @return true if the subtree was built, or false if a memory allocation
+ * failed, in which case the nodes are left without entries.
+ */
+static bool rank_build(CC_List *list, Node *head, size_t count, Rank **out)
+{
+    *out = NULL;
+
+    if (count == 0)
+        return true;
+
+    Rank **stack = list->mem_alloc(count * sizeof(Rank*));
+
+    if (!stack)
+        return false;
+
+    size_t  top  = 0;
+    size_t  i;
+    Node   *node = head;
+
+    for (i = 0; i < count; i++, node = node->next) {
+        Rank *r = rank_new(list, node);
+
+        if (!r) {
+            Node *n = head;
+            for (; n != node; n = n->next) {
+                list->mem_free(NODE_RANK(n));
+                NODE_RANK(n) = NULL;
+            }
+            list->mem_free(stack);
+            return false;
+        }
+        size_t first = i;
+        Rank  *last  = NULL;
+
+        while (top > 0 && stack[top - 1]->priority < r->priority) {
+            last       = stack[--top];
+            first      = last->size;
+            last->size = i - last->size;
+        }
+        r->size = first;
+        r->left = last;
+
+        if (last)
+            last->parent = r;
+
+        if (top > 0) {
+            stack[top - 1]->right = r;
+            r->parent = stack[top - 1];
+        }
+        stack[top++] = r;
+    }
+    while (top > 0) {
+        Rank *r = stack[--top];
+        r->size = count - r->size;
+    }
+    *out = stack[0];
+    list->mem_free(stack);
+    return true;
+}
+
+/**
+ * Adds a rank entry for the node that was just linked into the list. If
+ * the entry can't be allocated, the index is dropped and rebuilt later.
+ *
+ * @param[in] list the list into which the node was linked
+ * @param[in] node the new node
+ */
+static void index_insert(CC_List *list, Node *node)
+{
+    if (!list->rank_valid)
+        return;
+
+    Rank *r = rank_new(list, node);
+
+    if (!r) {
+        index_drop(list);
+        return;
+    }
+    size_t index = node->prev ? rank_position(NODE_RANK(node->prev)) + 1 : 0;
+    rank_insert_at(list, r, index);
+}
+
+/**
+ * Adds rank entries for count consecutive nodes that were just linked into
+ * the list at the specified index.
+ *
+ * @param[in] list the list into which the nodes were linked
+ * @param[in] head the first of the new nodes
+ * @param[in] count the number of new nodes
+ * @param[in] index the position of the first new node
+ */
+static void index_insert_range(CC_List *list, Node *head, size_t count, size_t index)
+{
+    if (!list->rank_valid)
+        return;
+
+    Rank *sub;
+    if (!rank_build(list, head, count, &sub)) {
+        index_drop(list);
+        return;
+    }
+    if (sub)
+        rank_insert_at(list, sub, index);
+}
+
+/**
+ * Moves the rank entries of the second list into the index of the first
+ * list ahead of a splice at the specified index. If the second list has no
+ * valid index, entries are built for its nodes instead.
+ *
+ * @param[in] list1 the list into which the nodes are being spliced
+ * @param[in] list2 the list whose nodes are being spliced
+ * @param[in] index the position at which the nodes are being spliced
+ */
+static void index_splice(CC_List *list1, CC_List *list2, size_t index)
+{
+    if (!list1->rank_valid || !list2->rank_valid) {
+        index_drop(list2);
+        index_insert_range(list1, list2->head, list2->size, index);
+        return;
+    }
+    Rank *sub = list2->rank_root;
+    list2->rank_root = NULL;
+
+    if (sub)
+        rank_insert_at(list1, sub, index);
+}
+
+/**
+ * Removes the rank entry of the node that is about to be unlinked. The
+ * entry is replaced by the merge of its subtrees and the sizes of all of
+ * its ancestors are decremented.
+ *
+ * @param[in] list the list from which the node is being unlinked
+ * @param[in] node the node that is being unlinked
+ */
+static void index_remove(CC_List *list, Node *node)
+{
+    if (!list->rank_valid)
+        return;
+
+    Rank *r = NODE_RANK(node);
+
+    if (!r)
+        return;
+
+    Rank *p = r->parent;
+    Rank *c = rank_merge(r->left, r->right);
+
+    if (c)
+        c->parent = p;
+
+    if (!p)
+        list->rank_root = c;
+    else if (p->left == r)
+        p->left = c;
+    else
+        p->right = c;
+
+    for (; p; p = p->parent)
+        p->size--;
+
+    NODE_RANK(node) = NULL;
+    list->mem_free(r);
+}
+
+/**
+ * Frees all the rank entries of the list and marks its index as invalid.
+ * An indexed list rebuilds the index on the next positional lookup.
+ *
+ * @param[in] list the list whose index is being dropped
+ */
+static void index_drop(CC_List *list)
+{
+    Rank *r = list->rank_root;
+
+    while (r) {
+        if (r->left) {
+            r = r->left;
+        } else if (r->right) {
+            r = r->right;
+        } else {
+            Rank *p = r->parent;
+
+            if (p && p->left == r)
+                p->left = NULL;
+            else if (p)
+                p->right = NULL;
+
+            NODE_RANK(r->node) = NULL;
+            list->mem_free(r);
+            r = p;
+        }
+    }
+    list->rank_root  = NULL;
+    list->rank_valid = false;
+}
+
+/**
+ * Builds the rank index of the list from scratch. If the memory allocation
+ * fails, the list stays unindexed until the next attempt.
+ *
+ * @param[in] list the list whose index is being built
+ */
+static void index_rebuild(CC_List *list)
+{
+    Rank *root;
+
+    if (rank_build(list, list->head, list->size, &root)) {
+        list->rank_root  = root;
+        list->rank_valid = true;
+    }
+}
+
 /**
  * Returns the node at the specified index.
  *
@@ -2013,6 +3188,24 @@ static enum cc_stat get_node_at(CC_List *list, size_t index, Node **out)
     if (!list || index >= list->size)
         return CC_ERR_OUT_OF_RANGE;
 
+    if (list->indexed && !list->rank_valid)
+        index_rebuild(list);
+
+    if (list->rank_valid) {
+        Rank *r = list->rank_root;
+
+        while (index != rank_size(r->left)) {
+            if (index < rank_size(r->left)) {
+                r = r->left;
+            } else {
+                index -= rank_size(r->left) + 1;
+                r = r->right;
+            }
+        }
+        *out = r->node;
+        return CC_OK;
+    }
+
     size_t i;
     Node *node = NULL;
 
@@ -0,0 +1,457 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+#include "cc_mpmc_queue.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield")
+#elif defined(_MSC_VER)
+#define CPU_RELAX() YieldProcessor()
+#else
+#define CPU_RELAX() ((void) 0)
+#endif
+
+/* Number of busy wait iterations before a blocking operation starts
+ * yielding the processor. */
+#define SPIN_LIMIT 64
+
+/*
+ * A slot is free for the producer that claims position p when its
+ * sequence number equals p, and holds an element for the consumer that
+ * claims position p when its sequence number equals p + 1. Releasing a
+ * slot moves its sequence number one lap ahead, to p + capacity.
+ */
+struct mpmc_slot {
+    atomic_size_t  seq;
+    void          *data;
+};
+
+struct cc_mpmc_queue_s {
+    atomic_size_t     enqueue_pos;
+    char              enqueue_pad[CC_CACHE_LINE_SIZE - sizeof(atomic_size_t)];
+
+    atomic_size_t     dequeue_pos;
+    char              dequeue_pad[CC_CACHE_LINE_SIZE - sizeof(atomic_size_t)];
+
+    size_t            capacity;
+    size_t            mask;
+    struct mpmc_slot *slots;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static size_t upper_pow_two (size_t n);
+static void   backoff       (unsigned *spins);
+
+
+/**
+ * Initializes the fields of the CC_MPMCQueueConf struct to default values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_mpmc_queue_conf_init(CC_MPMCQueueConf *conf)
+{
+    conf->capacity   = DEFAULT_CC_MPMC_QUEUE_CAPACITY;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Creates a new empty CC_MPMCQueue and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_MPMCQueue is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_MPMCQueue structure failed.
+ */
+enum cc_stat cc_mpmc_queue_new(CC_MPMCQueue **out)
+{
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    return cc_mpmc_queue_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_MPMCQueue based on the specified CC_MPMCQueueConf
+ * struct and returns a status code.
+ *
+ * @param[in] conf CC_MPMCQueue configuration struct. All fields must be
+ *                 initialized.
+ * @param[out] out pointer to where the newly created CC_MPMCQueue is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the conf capacity is 0 or larger than the largest power of two, or
+ * CC_ERR_ALLOC if the memory allocation for the new CC_MPMCQueue structure
+ * failed.
+ */
+enum cc_stat cc_mpmc_queue_new_conf(CC_MPMCQueueConf const * const conf, CC_MPMCQueue **out)
+{
+    if (conf->capacity == 0 || conf->capacity > MAX_POW_TWO)
+        return CC_ERR_INVALID_CAPACITY;
+
+    /* With a single slot a free slot and a full slot of the next lap
+     * would have the same sequence number. */
+    size_t capacity = upper_pow_two(conf->capacity < 2 ? 2 : conf->capacity);
+
+    CC_MPMCQueue *queue = conf->mem_calloc(1, sizeof(CC_MPMCQueue));
+
+    if (!queue)
+        return CC_ERR_ALLOC;
+
+    queue->slots = conf->mem_calloc(capacity, sizeof(struct mpmc_slot));
+
+    if (!queue->slots) {
+        conf->mem_free(queue);
+        return CC_ERR_ALLOC;
+    }
+
+    for (size_t i = 0; i < capacity; i++)
+        atomic_init(&queue->slots[i].seq, i);
+
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+
+    queue->capacity   = capacity;
+    queue->mask       = capacity - 1;
+    queue->mem_alloc  = conf->mem_alloc;
+    queue->mem_calloc = conf->mem_calloc;
+    queue->mem_free   = conf->mem_free;
+
+    *out = queue;
+    return CC_OK;
+}
+
+/**
+ * Destroys the specified CC_MPMCQueue structure, while leaving the data
+ * it holds intact. No other thread may be using the queue.
+ *
+ * @param[in] queue the queue that is to be destroyed
+ */
+void cc_mpmc_queue_destroy(CC_MPMCQueue *queue)
+{
+    queue->mem_free(queue->slots);
+    queue->mem_free(queue);
+}
+
+/**
+ * Returns the size of the CC_MPMCQueue structure.
+ */
+size_t cc_mpmc_queue_struct_size()
+{
+    return sizeof(CC_MPMCQueue);
+}
+
+/**
+ * Adds a new element to the back of the queue if there is room for it.
+ *
+ * @param[in] queue the queue to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was added, or CC_ERR_MAX_CAPACITY if the
+ * queue is full.
+ */
+enum cc_stat cc_mpmc_queue_try_enqueue(CC_MPMCQueue *queue, void *element)
+{
+    return cc_mpmc_queue_try_enqueue_n(queue, &element, 1) ? CC_OK : CC_ERR_MAX_CAPACITY;
+}
+
+/**
+ * Removes the element at the front of the queue if the queue is not empty.
+ *
+ * @param[in] queue the queue from which the element is being removed
+ * @param[out] out pointer to where the removed element is stored
+ *
+ * @return CC_OK if an element was removed, or CC_ERR_OUT_OF_RANGE if the
+ * queue is empty.
+ */
+enum cc_stat cc_mpmc_queue_try_dequeue(CC_MPMCQueue *queue, void **out)
+{
+    return cc_mpmc_queue_try_dequeue_n(queue, out, 1) ? CC_OK : CC_ERR_OUT_OF_RANGE;
+}
+
+/**
+ * Adds a new element to the back of the queue, waiting for room if the
+ * queue is full. The calling thread spins for a short while and then
+ * starts yielding the processor until a consumer frees a slot.
+ *
+ * @param[in] queue the queue to which the element is being added
+ * @param[in] element the element that is being added
+ */
+void cc_mpmc_queue_enqueue(CC_MPMCQueue *queue, void *element)
+{
+    cc_mpmc_queue_enqueue_n(queue, &element, 1);
+}
+
+/**
+ * Removes the element at the front of the queue, waiting for an element
+ * if the queue is empty.
+ *
+ * @param[in] queue the queue from which the element is being removed
+ * @param[out] out pointer to where the removed element is stored
+ */
+void cc_mpmc_queue_dequeue(CC_MPMCQueue *queue, void **out)
+{
+    cc_mpmc_queue_dequeue_n(queue, out, 1);
+}
+
+/**
+ * Adds up to n elements to the back of the queue. The elements are
+ * claimed with a single compare-and-swap, so they are enqueued in order
+ * and without elements of other producers between them.
+ *
+ * @param[in] queue the queue to which the elements are being added
+ * @param[in] elements the elements that are being added
+ * @param[in] n the number of elements in the elements array
+ *
+ * @return the number of elements that were added, which is 0 if the
+ * queue is full.
+ */
+size_t cc_mpmc_queue_try_enqueue_n(CC_MPMCQueue *queue, void * const *elements, size_t n)
+{
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    size_t k;
+
+    if (n > queue->capacity)
+        n = queue->capacity;
+
+    for (;;) {
+        for (k = 0; k < n; k++) {
+            struct mpmc_slot *slot = &queue->slots[(pos + k) & queue->mask];
+            size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+            if (seq != pos + k)
+                break;
+        }
+        if (k == 0) {
+            struct mpmc_slot *slot = &queue->slots[pos & queue->mask];
+            size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+            intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+            if (diff < 0)
+                return 0;
+            if (diff > 0)
+                pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + k,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+            break;
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        struct mpmc_slot *slot = &queue->slots[(pos + i) & queue->mask];
+        slot->data = elements[i];
+        atomic_store_explicit(&slot->seq, pos + i + 1, memory_order_release);
+    }
+    return k;
+}
+
+/**
+ * Removes up to n elements from the front of the queue. The elements are
+ * claimed with a single compare-and-swap and are stored into out in the
+ * order in which they were enqueued.
+ *
+ * @param[in] queue the queue from which the elements are being removed
+ * @param[out] out array of at least n pointers where the removed elements
+ *                 are stored
+ * @param[in] n the maximum number of elements to remove
+ *
+ * @return the number of elements that were removed, which is 0 if the
+ * queue is empty.
+ */
+size_t cc_mpmc_queue_try_dequeue_n(CC_MPMCQueue *queue, void **out, size_t n)
+{
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    size_t k;
+
+    if (n > queue->capacity)
+        n = queue->capacity;
+
+    for (;;) {
+        for (k = 0; k < n; k++) {
+            struct mpmc_slot *slot = &queue->slots[(pos + k) & queue->mask];
+            size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+            if (seq != pos + k + 1)
+                break;
+        }
+        if (k == 0) {
+            struct mpmc_slot *slot = &queue->slots[pos & queue->mask];
+            size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+            intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+            if (diff < 0)
+                return 0;
+            if (diff > 0)
+                pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + k,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+            break;
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        struct mpmc_slot *slot = &queue->slots[(pos + i) & queue->mask];
+        out[i] = slot->data;
+        atomic_store_explicit(&slot->seq, pos + i + queue->capacity, memory_order_release);
+    }
+    return k;
+}
+
+/**
+ * Adds all n elements to the back of the queue, waiting for room while
+ * the queue is full. Elements are enqueued in order, but if the queue
+ * fills up, elements of other producers may end up between them.
+ *
+ * @param[in] queue the queue to which the elements are being added
+ * @param[in] elements the elements that are being added
+ * @param[in] n the number of elements in the elements array
+ */
+void cc_mpmc_queue_enqueue_n(CC_MPMCQueue *queue, void * const *elements, size_t n)
+{
+    unsigned spins = 0;
+
+    while (n > 0) {
+        size_t k = cc_mpmc_queue_try_enqueue_n(queue, elements, n);
+
+        if (k == 0) {
+            backoff(&spins);
+            continue;
+        }
+        elements += k;
+        n -= k;
+        spins = 0;
+    }
+}
+
+/**
+ * Removes n elements from the front of the queue, waiting for elements
+ * while the queue is empty.
+ *
+ * @param[in] queue the queue from which the elements are being removed
+ * @param[out] out array of at least n pointers where the removed elements
+ *                 are stored
+ * @param[in] n the number of elements to remove
+ */
+void cc_mpmc_queue_dequeue_n(CC_MPMCQueue *queue, void **out, size_t n)
+{
+    unsigned spins = 0;
+
+    while (n > 0) {
+        size_t k = cc_mpmc_queue_try_dequeue_n(queue, out, n);
+
+        if (k == 0) {
+            backoff(&spins);
+            continue;
+        }
+        out += k;
+        n -= k;
+        spins = 0;
+    }
+}
+
+/**
+ * Returns the number of elements in the queue. While other threads are
+ * using the queue, the value is only an approximation.
+ *
+ * @param[in] queue the queue whose size is being returned
+ *
+ * @return the number of elements in the queue
+ */
+size_t cc_mpmc_queue_size(CC_MPMCQueue *queue)
+{
+    size_t dequeue_pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    size_t enqueue_pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+    size_t size        = enqueue_pos - dequeue_pos;
+
+    return size > queue->capacity ? queue->capacity : size;
+}
+
+/**
+ * Returns the maximum number of elements the queue can hold.
+ *
+ * @param[in] queue the queue whose capacity is being returned
+ *
+ * @return the capacity of the queue
+ */
+size_t cc_mpmc_queue_capacity(CC_MPMCQueue *queue)
+{
+    return queue->capacity;
+}
+
+/**
+ * Waits a little before a failed operation is retried. The first few
+ * retries busy wait, after which the thread yields the processor.
+ */
+static void backoff(unsigned *spins)
+{
+    if (*spins < SPIN_LIMIT) {
+        CPU_RELAX();
+        (*spins)++;
+        return;
+    }
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/**
+ * Rounds the integer to the nearest upper power of two.
+ */
+static size_t upper_pow_two(size_t n)
+{
+    if (n >= MAX_POW_TWO)
+        return MAX_POW_TWO;
+
+    if (n == 0)
+        return 1;
+
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+#ifdef ARCH_64
+    n |= n >> 32;
+#endif
+    n++;
+
+    return n;
+}
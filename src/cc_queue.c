@@ -147,6 +147,54 @@ enum cc_stat cc_queue_poll(CC_Queue *queue, void **out)
     return cc_deque_remove_last(queue->d, out);
 }
 
+/**
+ * Polls up to <code>n</code> elements from the front of the queue, as if
+ * cc_queue_poll() was called repeatedly, and optionally copies them to
+ * <code>out</code> in the order in which they were enqueued.
+ *
+ * @param[in] queue the queue on which this operation is performed
+ * @param[out] out buffer large enough to hold <code>n</code> elements, or
+ *                 NULL if the polled elements are to be ignored
+ * @param[in] n the maximum number of elements that are being polled
+ *
+ * @return the number of polled elements, which is less than <code>n</code>
+ * only if the queue held fewer elements.
+ */
+size_t cc_queue_poll_n(CC_Queue *queue, void **out, size_t n)
+{
+    return cc_deque_remove_last_n(queue->d, out, n);
+}
+
+/**
+ * Removes all elements from the queue and returns them in a newly allocated
+ * array, in the order in which they would have been polled. The array is
+ * allocated with the queue's allocator and must be freed by the caller.
+ *
+ * @param[in] queue the queue that is being drained
+ * @param[out] out pointer to where the newly created array is stored
+ *
+ * @return CC_OK if the array was successfully created, CC_ERR_OUT_OF_RANGE
+ * if the queue is empty, or CC_ERR_ALLOC if the memory allocation for the
+ * new array failed.
+ */
+enum cc_stat cc_queue_drain_to_array(CC_Queue *queue, void ***out)
+{
+    size_t size = cc_deque_size(queue->d);
+
+    if (size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    void **array = queue->mem_alloc(size * sizeof(void*));
+
+    if (!array)
+        return CC_ERR_ALLOC;
+
+    cc_deque_remove_last_n(queue->d, array, size);
+    *out = array;
+
+    return CC_OK;
+}
+
 /**
  * Appends an element to the back of the queue. This operation may
  * fail if the memory allocation for the new element fails.
@@ -162,6 +210,24 @@ enum cc_stat cc_queue_enqueue(CC_Queue *queue, void *element)
     return cc_deque_add_first(queue->d, element);
 }
 
+/**
+ * Appends <code>n</code> elements to the back of the queue, as if
+ * cc_queue_enqueue() was called for each element in order.
+ *
+ * @param[in] queue the queue on which this operation is performed
+ * @param[in] elements the elements being enqueued
+ * @param[in] n the number of elements being enqueued
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if
+ * the memory allocation for the new elements failed, or CC_ERR_MAX_CAPACITY
+ * if the queue cannot hold all of the elements. If an error is returned,
+ * none of the elements are added.
+ */
+enum cc_stat cc_queue_enqueue_all(CC_Queue *queue, void * const *elements, size_t n)
+{
+    return cc_deque_add_all_first(queue->d, elements, n);
+}
+
 /**
  * Returns the size of the specified queue. The size of the queue is
  * the number of elements contained within the queue.
@@ -6,12 +6,34 @@
  * @Last modified time: 2019-03-09T15:23:25-06:00
  */
 
-
 #include "include/cc_ring_buffer.h"
+#include "cc_atomic.h"
+
 
+/*
+ * head and tail are free running counters; the slot of a counter is
+ * obtained with rbuf_slot(). The fields written by the consumer and the
+ * fields written by the producer are kept on separate cache lines so
+ * that, in the SPSC mode, the two threads don't keep invalidating each
+ * other's lines. Each side also keeps a cached copy of the other side's
+ * counter and only reloads the shared one when the cached value says
+ * the buffer is full (or empty).
+ */
+struct ring_buffer {
+    cc_atomic_size tail;
+    size_t         head_cache;
+    char           tail_pad[CC_CACHE_LINE_SIZE - sizeof(cc_atomic_size) - sizeof(size_t)];
 
-struct ring_buffer_conf {
-    size_t capacity;
+    cc_atomic_size head;
+    size_t         tail_cache;
+    char           head_pad[CC_CACHE_LINE_SIZE - sizeof(cc_atomic_size) - sizeof(size_t)];
+
+    size_t    capacity;
+    size_t    mask;
+    size_t    element_size;
+    bool      overwrite;
+    bool      spsc;
+    uint8_t  *buf;
 
     void *(*mem_alloc)  (size_t size);
     void *(*mem_calloc) (size_t blocks, size_t size);
@@ -19,15 +41,16 @@ struct ring_buffer_conf {
 };
 
 
-struct ring_buffer {
-    size_t size, capacity;
-    size_t head, tail;
-    uint64_t    *buf;
+static size_t upper_pow_two(size_t n);
 
-    void *(*mem_alloc)  (size_t size);
-    void *(*mem_calloc) (size_t blocks, size_t size);
-    void  (*mem_free)   (void *block);
-};
+static enum cc_stat spsc_enqueue(CC_Rbuf *rbuf, uint64_t item);
+static enum cc_stat spsc_dequeue(CC_Rbuf *rbuf, uint64_t *out);
+static void         copy_in     (CC_Rbuf *rbuf, size_t counter, const uint8_t *src, size_t n);
+static void         copy_out    (CC_Rbuf *rbuf, size_t counter, uint8_t *dst, size_t n);
+static size_t       free_items  (CC_Rbuf *rbuf, size_t head, size_t n);
+static size_t       used_items  (CC_Rbuf *rbuf, size_t tail, size_t n);
+static void         make_spans  (CC_Rbuf *rbuf, size_t counter, size_t n,
+                                 CC_RbufSpan *first, CC_RbufSpan *second);
 
 
 enum cc_stat cc_rbuf_new(CC_Rbuf **rbuf)
@@ -40,12 +63,26 @@ enum cc_stat cc_rbuf_new(CC_Rbuf **rbuf)
 
 enum cc_stat cc_rbuf_conf_new(CC_RbufConf *rconf, CC_Rbuf **rbuf)
 {
+    size_t capacity = rconf->capacity;
+
+    if (capacity == 0 || rconf->element_size == 0)
+        return CC_ERR_INVALID_CAPACITY;
+
+    if (capacity > CC_MAX_ELEMENTS / rconf->element_size)
+        return CC_ERR_INVALID_CAPACITY;
+
+    if (rconf->spsc) {
+        if (capacity > MAX_POW_TWO)
+            return CC_ERR_INVALID_CAPACITY;
+        capacity = upper_pow_two(capacity);
+    }
+
     CC_Rbuf *ringbuf = rconf->mem_calloc(1, sizeof(CC_Rbuf));
 
     if (!ringbuf)
         return CC_ERR_ALLOC;
 
-    if (!(ringbuf->buf = rconf->mem_calloc(rconf->capacity, sizeof(uint64_t)))) {
+    if (!(ringbuf->buf = rconf->mem_calloc(capacity, rconf->element_size))) {
         rconf->mem_free(ringbuf);
         return CC_ERR_ALLOC;
     }
@@ -53,10 +90,16 @@ enum cc_stat cc_rbuf_conf_new(CC_RbufConf *rconf, CC_Rbuf **rbuf)
     ringbuf->mem_alloc   = rconf->mem_alloc;
     ringbuf->mem_calloc  = rconf->mem_calloc;
     ringbuf->mem_free    = rconf->mem_free;
-    ringbuf->capacity    = rconf->capacity;
-    ringbuf->size        = 0;
-    ringbuf->head        = 0;
-    ringbuf->tail        = 0;
+    ringbuf->capacity    = capacity;
+    ringbuf->mask        = (capacity & (capacity - 1)) == 0 ? capacity - 1 : 0;
+    ringbuf->element_size = rconf->element_size;
+    ringbuf->overwrite   = rconf->overwrite && !rconf->spsc;
+    ringbuf->spsc        = rconf->spsc;
+    ringbuf->head_cache  = 0;
+    ringbuf->tail_cache  = 0;
+
+    cc_atomic_init(&ringbuf->head, 0);
+    cc_atomic_init(&ringbuf->tail, 0);
 
     *rbuf = ringbuf;
     return CC_OK;
@@ -66,6 +109,9 @@ enum cc_stat cc_rbuf_conf_new(CC_RbufConf *rconf, CC_Rbuf **rbuf)
 void cc_rbuf_conf_init(CC_RbufConf *rconf)
 {
     rconf->capacity = DEFAULT_CC_RBUF_CAPACITY;
+    rconf->element_size = sizeof(uint64_t);
+    rconf->overwrite = true;
+    rconf->spsc = false;
     rconf->mem_alloc = malloc;
     rconf->mem_calloc = calloc;
     rconf->mem_free = free;
@@ -81,50 +127,535 @@ void cc_rbuf_destroy(CC_Rbuf *rbuf)
 
 bool cc_rbuf_is_empty(CC_Rbuf *rbuf)
 {
-    return (rbuf->size == 0);
+    return cc_rbuf_size(rbuf) == 0;
 }
 
 
+/**
+ * Returns the number of items in the buffer. In the SPSC mode the value
+ * is only a snapshot, since the other thread may change it at any time.
+ */
 size_t cc_rbuf_size(CC_Rbuf *rbuf)
 {
-    return rbuf->size;
+    size_t tail = cc_atomic_load_acquire(&rbuf->tail);
+    size_t head = cc_atomic_load_acquire(&rbuf->head);
+
+    return head - tail;
 }
 
 
-void cc_rbuf_enqueue(CC_Rbuf *rbuf, uint64_t item)
+/**
+ * Returns the number of items the buffer can hold.
+ */
+size_t cc_rbuf_capacity(CC_Rbuf *rbuf)
 {
-    if (rbuf->head == rbuf->tail)
-        rbuf->tail = (rbuf->tail + 1) % rbuf->capacity;
+    return rbuf->capacity;
+}
 
-    rbuf->buf[rbuf->head] = item;
 
-    rbuf->head = (rbuf->head + 1) % rbuf->capacity;
+/**
+ * Returns the size of a single item in bytes.
+ */
+size_t cc_rbuf_element_size(CC_Rbuf *rbuf)
+{
+    return rbuf->element_size;
+}
 
-    if (rbuf->size < rbuf->capacity)
-        ++rbuf->size;
+
+/**
+ * Returns the buffer slot of a head or tail counter.
+ */
+static INLINE size_t rbuf_slot(CC_Rbuf const * const rbuf, size_t counter)
+{
+    if (rbuf->mask)
+        return counter & rbuf->mask;
+    return counter % rbuf->capacity;
 }
 
 
+/**
+ * Returns the address of the item at a head or tail counter.
+ */
+static INLINE uint8_t *rbuf_item(CC_Rbuf const * const rbuf, size_t counter)
+{
+    return rbuf->buf + rbuf_slot(rbuf, counter) * rbuf->element_size;
+}
+
+
+/**
+ * Moves both counters back by a multiple of the capacity once the tail
+ * passes the end of the buffer. Keeping the counters small means the
+ * modulo mapping of a non power of two capacity never sees a counter
+ * wrap around. Only used outside of the SPSC mode.
+ */
+static INLINE void rbuf_rebase(CC_Rbuf const * const rbuf, size_t *head, size_t *tail)
+{
+    if (*tail >= rbuf->capacity) {
+        size_t base = *tail - *tail % rbuf->capacity;
+        *tail -= base;
+        *head -= base;
+    }
+}
+
+
+/**
+ * Adds a new item to the buffer. If the buffer is full, the oldest item
+ * is overwritten, unless the buffer was created without the overwrite
+ * flag or in the SPSC mode, in which case the item is not added. The
+ * buffer must hold items of sizeof(uint64_t) bytes.
+ *
+ * @param[in] rbuf the buffer to which the item is being added
+ * @param[in] item the item that is being added
+ *
+ * @return CC_OK if the item was added, CC_ERR_MAX_CAPACITY if the buffer
+ * is full and may not be overwritten, or CC_ERR_INVALID_RANGE if the
+ * buffer holds items of a different size.
+ */
+enum cc_stat cc_rbuf_enqueue(CC_Rbuf *rbuf, uint64_t item)
+{
+    if (rbuf->element_size != sizeof(uint64_t))
+        return CC_ERR_INVALID_RANGE;
+
+    if (rbuf->spsc)
+        return spsc_enqueue(rbuf, item);
+
+    size_t head = cc_atomic_load_relaxed(&rbuf->head);
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+
+    if (head - tail == rbuf->capacity) {
+        if (!rbuf->overwrite)
+            return CC_ERR_MAX_CAPACITY;
+        tail++;
+    }
+    memcpy(rbuf_item(rbuf, head), &item, sizeof(uint64_t));
+    head++;
+
+    rbuf_rebase(rbuf, &head, &tail);
+    cc_atomic_store_relaxed(&rbuf->head, head);
+    cc_atomic_store_relaxed(&rbuf->tail, tail);
+
+    return CC_OK;
+}
+
+
+/**
+ * Removes the oldest item from the buffer. The buffer must hold items of
+ * sizeof(uint64_t) bytes.
+ *
+ * @param[in] rbuf the buffer from which the item is being removed
+ * @param[out] out pointer to where the removed item is stored
+ *
+ * @return CC_OK if the item was removed, CC_ERR_OUT_OF_RANGE if the
+ * buffer is empty, or CC_ERR_INVALID_RANGE if the buffer holds items of a
+ * different size.
+ */
 enum cc_stat cc_rbuf_dequeue(CC_Rbuf *rbuf, uint64_t *out)
 {
-    if (cc_rbuf_is_empty(rbuf))
+    if (rbuf->element_size != sizeof(uint64_t))
+        return CC_ERR_INVALID_RANGE;
+
+    if (rbuf->spsc)
+        return spsc_dequeue(rbuf, out);
+
+    size_t head = cc_atomic_load_relaxed(&rbuf->head);
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+
+    if (head == tail)
         return CC_ERR_OUT_OF_RANGE;
 
-    *out = rbuf->buf[rbuf->tail];
+    memcpy(out, rbuf_item(rbuf, tail), sizeof(uint64_t));
+    cc_atomic_store_relaxed(&rbuf->tail, tail + 1);
+
+    return CC_OK;
+}
+
+
+/**
+ * Producer side of the SPSC buffer. Only the producer writes head and
+ * tail_cache, so both can be read without synchronization. The release
+ * store of head publishes the item to the consumer.
+ */
+static enum cc_stat spsc_enqueue(CC_Rbuf *rbuf, uint64_t item)
+{
+    size_t head = cc_atomic_load_relaxed(&rbuf->head);
+
+    if (head - rbuf->tail_cache == rbuf->capacity) {
+        rbuf->tail_cache = cc_atomic_load_acquire(&rbuf->tail);
+        if (head - rbuf->tail_cache == rbuf->capacity)
+            return CC_ERR_MAX_CAPACITY;
+    }
+    memcpy(rbuf_item(rbuf, head), &item, rbuf->element_size);
+    cc_atomic_store_release(&rbuf->head, head + 1);
+
+    return CC_OK;
+}
+
+
+/**
+ * Consumer side of the SPSC buffer. The release store of tail hands the
+ * slot back to the producer.
+ */
+static enum cc_stat spsc_dequeue(CC_Rbuf *rbuf, uint64_t *out)
+{
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+
+    if (tail == rbuf->head_cache) {
+        rbuf->head_cache = cc_atomic_load_acquire(&rbuf->head);
+        if (tail == rbuf->head_cache)
+            return CC_ERR_OUT_OF_RANGE;
+    }
+    memcpy(out, rbuf_item(rbuf, tail), rbuf->element_size);
+    cc_atomic_store_release(&rbuf->tail, tail + 1);
 
-    rbuf->tail = (rbuf->tail + 1) % rbuf->capacity;
-    --rbuf->size;
     return CC_OK;
 }
 
 
+/**
+ * Adds up to n items to the buffer. The items are copied in at most two
+ * contiguous runs, one up to the end of the buffer and one from its
+ * start.
+ *
+ * If the buffer may be overwritten, all n items are added and the oldest
+ * items are dropped to make room for them; if n exceeds the capacity,
+ * only the last capacity items remain. Otherwise only as many items as
+ * there is free room for are added.
+ *
+ * @param[in] rbuf the buffer to which the items are being added
+ * @param[in] items array of n items of the buffer's element size
+ * @param[in] n the number of items to add
+ *
+ * @return the number of items that were added.
+ */
+size_t cc_rbuf_enqueue_n(CC_Rbuf *rbuf, const void *items, size_t n)
+{
+    const uint8_t *src = items;
+    size_t head  = cc_atomic_load_relaxed(&rbuf->head);
+    size_t room  = free_items(rbuf, head, n);
+    size_t added = n;
+    size_t drop  = 0;
+
+    if (n > room && rbuf->overwrite) {
+        if (n > rbuf->capacity) {
+            src += (n - rbuf->capacity) * rbuf->element_size;
+            n = rbuf->capacity;
+        }
+        drop = n - room;
+    } else if (n > room) {
+        n = added = room;
+    }
+    copy_in(rbuf, head, src, n);
+    head += n;
+
+    if (rbuf->spsc) {
+        cc_atomic_store_release(&rbuf->head, head);
+    } else {
+        size_t tail = cc_atomic_load_relaxed(&rbuf->tail) + drop;
+        rbuf_rebase(rbuf, &head, &tail);
+        cc_atomic_store_relaxed(&rbuf->head, head);
+        cc_atomic_store_relaxed(&rbuf->tail, tail);
+    }
+    return added;
+}
+
+
+/**
+ * Removes up to n of the oldest items from the buffer. The items are
+ * copied out in at most two contiguous runs.
+ *
+ * @param[in] rbuf the buffer from which the items are being removed
+ * @param[out] out array with room for n items of the buffer's element size
+ * @param[in] n the maximum number of items to remove
+ *
+ * @return the number of items that were removed.
+ */
+size_t cc_rbuf_dequeue_n(CC_Rbuf *rbuf, void *out, size_t n)
+{
+    size_t tail  = cc_atomic_load_relaxed(&rbuf->tail);
+    size_t avail = used_items(rbuf, tail, n);
+
+    if (n > avail)
+        n = avail;
+
+    copy_out(rbuf, tail, out, n);
+
+    if (rbuf->spsc)
+        cc_atomic_store_release(&rbuf->tail, tail + n);
+    else
+        cc_atomic_store_relaxed(&rbuf->tail, tail + n);
+    return n;
+}
+
+
+/**
+ * Copies n items into the buffer, starting at the slot of the counter.
+ */
+static void copy_in(CC_Rbuf *rbuf, size_t counter, const uint8_t *src, size_t n)
+{
+    if (n == 0)
+        return;
+
+    size_t slot  = rbuf_slot(rbuf, counter);
+    size_t first = rbuf->capacity - slot;
+
+    if (first > n)
+        first = n;
+
+    memcpy(rbuf->buf + slot * rbuf->element_size, src, first * rbuf->element_size);
+
+    if (n > first)
+        memcpy(rbuf->buf, src + first * rbuf->element_size, (n - first) * rbuf->element_size);
+}
+
+
+/**
+ * Copies n items out of the buffer, starting at the slot of the counter.
+ */
+static void copy_out(CC_Rbuf *rbuf, size_t counter, uint8_t *dst, size_t n)
+{
+    if (n == 0)
+        return;
+
+    size_t slot  = rbuf_slot(rbuf, counter);
+    size_t first = rbuf->capacity - slot;
+
+    if (first > n)
+        first = n;
+
+    memcpy(dst, rbuf->buf + slot * rbuf->element_size, first * rbuf->element_size);
+
+    if (n > first)
+        memcpy(dst + first * rbuf->element_size, rbuf->buf, (n - first) * rbuf->element_size);
+}
+
+
+/**
+ * Returns the item stored in the slot at the specified position of the
+ * backing array. The position is not relative to the oldest item; use
+ * cc_rbuf_peek_at() to look at items in the order in which they were
+ * enqueued. Returns 0 if the buffer holds items of a size other than
+ * sizeof(uint64_t).
+ */
 uint64_t cc_rbuf_peek(CC_Rbuf *rbuf, int index)
 {
-    return rbuf->buf[index];
+    uint64_t item = 0;
+
+    if (rbuf->element_size == sizeof(uint64_t))
+        memcpy(&item, rbuf->buf + index * rbuf->element_size, sizeof(uint64_t));
+
+    return item;
+}
+
+
+/**
+ * Gets a pointer to the item at the specified offset from the oldest item
+ * in the buffer, without removing it. Offset 0 is the item that would be
+ * dequeued next. Consumer side.
+ *
+ * @param[in] rbuf the buffer whose item is being returned
+ * @param[in] offset the logical position of the item
+ * @param[out] out pointer to where the address of the item is stored
+ *
+ * @return CC_OK if the item was found, or CC_ERR_OUT_OF_RANGE if the
+ * offset is not less than the number of items in the buffer.
+ */
+enum cc_stat cc_rbuf_peek_at(CC_Rbuf *rbuf, size_t offset, void **out)
+{
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+
+    if (used_items(rbuf, tail, offset + 1) <= offset)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = rbuf_item(rbuf, tail + offset);
+    return CC_OK;
+}
+
+
+/**
+ * Reserves n free slots at the back of the buffer so that they can be
+ * filled in place. Since the slots may wrap around the end of the
+ * buffer, they are described by two spans, the second of which is empty
+ * if no wrapping occurs. The items become visible to the consumer only
+ * after they are committed with cc_rbuf_commit(). Reserving never
+ * overwrites old items. Producer side.
+ *
+ * @param[in] rbuf the buffer in which the slots are being reserved
+ * @param[in] n the number of slots to reserve
+ * @param[out] first span of the slots up to the end of the buffer
+ * @param[out] second span of the slots that wrap around to the start
+ *
+ * @return CC_OK if the slots were reserved, or CC_ERR_MAX_CAPACITY if the
+ * buffer has fewer than n free slots.
+ */
+enum cc_stat cc_rbuf_reserve(CC_Rbuf *rbuf, size_t n, CC_RbufSpan *first, CC_RbufSpan *second)
+{
+    size_t head = cc_atomic_load_relaxed(&rbuf->head);
+
+    if (free_items(rbuf, head, n) < n)
+        return CC_ERR_MAX_CAPACITY;
+
+    make_spans(rbuf, head, n, first, second);
+    return CC_OK;
+}
+
+
+/**
+ * Enqueues the first n slots at the back of the buffer, which should have
+ * been filled through the spans returned by cc_rbuf_reserve(). Producer
+ * side.
+ *
+ * @param[in] rbuf the buffer whose slots are being committed
+ * @param[in] n the number of slots to commit
+ *
+ * @return CC_OK if the slots were committed, or CC_ERR_OUT_OF_RANGE if the
+ * buffer has fewer than n free slots.
+ */
+enum cc_stat cc_rbuf_commit(CC_Rbuf *rbuf, size_t n)
+{
+    size_t head = cc_atomic_load_relaxed(&rbuf->head);
+
+    if (free_items(rbuf, head, n) < n)
+        return CC_ERR_OUT_OF_RANGE;
+
+    head += n;
+
+    if (rbuf->spsc) {
+        cc_atomic_store_release(&rbuf->head, head);
+    } else {
+        size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+        rbuf_rebase(rbuf, &head, &tail);
+        cc_atomic_store_relaxed(&rbuf->head, head);
+        cc_atomic_store_relaxed(&rbuf->tail, tail);
+    }
+    return CC_OK;
+}
+
+
+/**
+ * Returns all the items in the buffer, oldest first, as up to two spans
+ * that point directly into the buffer. The items stay in the buffer until
+ * they are released with cc_rbuf_release(). Consumer side.
+ *
+ * @param[in] rbuf the buffer whose items are being read
+ * @param[out] first span of the items up to the end of the buffer
+ * @param[out] second span of the items that wrap around to the start
+ *
+ * @return the total number of items in both spans.
+ */
+size_t cc_rbuf_read_span(CC_Rbuf *rbuf, CC_RbufSpan *first, CC_RbufSpan *second)
+{
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+    size_t n    = used_items(rbuf, tail, rbuf->capacity);
+
+    make_spans(rbuf, tail, n, first, second);
+    return n;
+}
+
+
+/**
+ * Dequeues the n oldest items without copying them out. Consumer side.
+ *
+ * @param[in] rbuf the buffer whose items are being released
+ * @param[in] n the number of items to release
+ *
+ * @return CC_OK if the items were released, or CC_ERR_OUT_OF_RANGE if the
+ * buffer holds fewer than n items.
+ */
+enum cc_stat cc_rbuf_release(CC_Rbuf *rbuf, size_t n)
+{
+    size_t tail = cc_atomic_load_relaxed(&rbuf->tail);
+
+    if (used_items(rbuf, tail, n) < n)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (rbuf->spsc)
+        cc_atomic_store_release(&rbuf->tail, tail + n);
+    else
+        cc_atomic_store_relaxed(&rbuf->tail, tail + n);
+    return CC_OK;
+}
+
+
+/**
+ * Returns the number of free slots after the head counter. In the SPSC
+ * mode the consumer's counter is only reloaded if the cached one shows
+ * fewer than n free slots.
+ */
+static size_t free_items(CC_Rbuf *rbuf, size_t head, size_t n)
+{
+    if (!rbuf->spsc)
+        return rbuf->capacity - (head - cc_atomic_load_relaxed(&rbuf->tail));
+
+    if (n > rbuf->capacity - (head - rbuf->tail_cache))
+        rbuf->tail_cache = cc_atomic_load_acquire(&rbuf->tail);
+
+    return rbuf->capacity - (head - rbuf->tail_cache);
+}
+
+
+/**
+ * Returns the number of items after the tail counter. In the SPSC mode
+ * the producer's counter is only reloaded if the cached one shows fewer
+ * than n items.
+ */
+static size_t used_items(CC_Rbuf *rbuf, size_t tail, size_t n)
+{
+    if (!rbuf->spsc)
+        return cc_atomic_load_relaxed(&rbuf->head) - tail;
+
+    if (n > rbuf->head_cache - tail)
+        rbuf->head_cache = cc_atomic_load_acquire(&rbuf->head);
+
+    return rbuf->head_cache - tail;
+}
+
+
+/**
+ * Describes n slots starting at the slot of the counter as two spans.
+ */
+static void make_spans(CC_Rbuf *rbuf, size_t counter, size_t n,
+                       CC_RbufSpan *first, CC_RbufSpan *second)
+{
+    size_t slot = rbuf_slot(rbuf, counter);
+    size_t run  = rbuf->capacity - slot;
+
+    if (run > n)
+        run = n;
+
+    first->data   = rbuf->buf + slot * rbuf->element_size;
+    first->count  = run;
+    second->data  = rbuf->buf;
+    second->count = n - run;
 }
 
 
 size_t cc_rbuf_struct_size()
 {
     return sizeof(CC_Rbuf);
-}
\ No newline at end of file
+}
+
+
+/**
+ * Rounds the integer to the nearest upper power of two.
+ */
+static size_t upper_pow_two(size_t n)
+{
+    if (n >= MAX_POW_TWO)
+        return MAX_POW_TWO;
+
+    if (n == 0)
+        return 1;
+
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+#ifdef ARCH_64
+    n |= n >> 32;
+#endif
+    n++;
+
+    return n;
+}
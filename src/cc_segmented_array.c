@@ -0,0 +1,678 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cc_segmented_array.h"
+
+#define DEFAULT_SEGMENT_CAPACITY 8
+#define MAX_SEGMENTS (sizeof(size_t) * 8)
+
+/*
+ * Segment k holds (B << k) elements, where B is the capacity of the first
+ * segment. The first k segments therefore hold B * (2^k - 1) elements, which
+ * means that for an index i, the value (i + B) has its highest bit at
+ * position log2(B) + k, where k is the segment containing i. The remaining
+ * bits of (i + B) are the offset of the element within that segment.
+ */
+struct cc_segmented_array_s {
+    size_t   size;
+    size_t   capacity;
+    size_t   n_segments;
+    size_t   base_shift;
+    void   **segments[MAX_SEGMENTS];
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+static enum cc_stat add_segment (CC_SegmentedArray *ar);
+static size_t       highest_bit (size_t n);
+
+
+/**
+ * Returns the address of the slot at the specified index. The index must
+ * be within the capacity of the array.
+ */
+static INLINE void **slot(CC_SegmentedArray const * const ar, size_t index)
+{
+    size_t j = index + ((size_t) 1 << ar->base_shift);
+    size_t h = highest_bit(j);
+
+    return &(ar->segments[h - ar->base_shift][j - ((size_t) 1 << h)]);
+}
+
+/**
+ * Creates a new empty CC_SegmentedArray and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_SegmentedArray is to
+ *                 be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_SegmentedArray structure failed.
+ */
+enum cc_stat cc_segmented_array_new(CC_SegmentedArray **out)
+{
+    CC_SegmentedArrayConf c;
+    cc_segmented_array_conf_init(&c);
+    return cc_segmented_array_new_conf(&c, out);
+}
+
+/**
+ * Creates a new empty CC_SegmentedArray based on the specified
+ * CC_SegmentedArrayConf struct and returns a status code.
+ *
+ * The CC_SegmentedArray is allocated using the allocators specified in the
+ * CC_SegmentedArrayConf struct. The allocation may fail if the underlying
+ * allocator fails.
+ *
+ * @param[in] conf array configuration structure
+ * @param[out] out pointer to where the newly created CC_SegmentedArray is to
+ *                 be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the segment capacity is zero or too large, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_SegmentedArray structure failed.
+ */
+enum cc_stat cc_segmented_array_new_conf(CC_SegmentedArrayConf const * const conf,
+                                         CC_SegmentedArray **out)
+{
+    if (!conf->segment_capacity || conf->segment_capacity > (CC_MAX_ELEMENTS >> 2))
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_SegmentedArray *ar = conf->mem_calloc(1, sizeof(CC_SegmentedArray));
+
+    if (!ar)
+        return CC_ERR_ALLOC;
+
+    /* Round the first segment up to the closest power of two */
+    size_t shift = highest_bit(conf->segment_capacity);
+    if (((size_t) 1 << shift) < conf->segment_capacity)
+        shift++;
+
+    ar->base_shift = shift;
+    ar->mem_alloc  = conf->mem_alloc;
+    ar->mem_calloc = conf->mem_calloc;
+    ar->mem_free   = conf->mem_free;
+
+    enum cc_stat status = add_segment(ar);
+
+    if (status != CC_OK) {
+        conf->mem_free(ar);
+        return status;
+    }
+
+    *out = ar;
+    return CC_OK;
+}
+
+/**
+ * Initializes the fields of the CC_SegmentedArrayConf struct to default values.
+ *
+ * @param[in, out] conf CC_SegmentedArrayConf structure that is being initialized
+ */
+void cc_segmented_array_conf_init(CC_SegmentedArrayConf *conf)
+{
+    conf->segment_capacity = DEFAULT_SEGMENT_CAPACITY;
+    conf->mem_alloc        = malloc;
+    conf->mem_calloc       = calloc;
+    conf->mem_free         = free;
+}
+
+/**
+ * Destroys the CC_SegmentedArray structure, but leaves the data it used to
+ * hold intact.
+ *
+ * @param[in] ar the array that is to be destroyed
+ */
+void cc_segmented_array_destroy(CC_SegmentedArray *ar)
+{
+    size_t i;
+    for (i = 0; i < ar->n_segments; i++)
+        ar->mem_free(ar->segments[i]);
+
+    ar->mem_free(ar);
+}
+
+/**
+ * Destroys the CC_SegmentedArray structure along with all the data it holds.
+ *
+ * @note
+ * This function should not be called on an array that has some of its
+ * elements allocated on the stack.
+ *
+ * @param[in] ar the array that is being destroyed
+ * @param[in] cb callback that is invoked on each element
+ */
+void cc_segmented_array_destroy_cb(CC_SegmentedArray *ar, void (*cb) (void*))
+{
+    cc_segmented_array_map(ar, cb);
+    cc_segmented_array_destroy(ar);
+}
+
+/**
+ * Adds a new element to the end of the CC_SegmentedArray. If the array is
+ * full, a new segment is allocated and none of the existing elements are
+ * moved.
+ *
+ * @param[in] ar the array to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new segment failed, or CC_ERR_MAX_CAPACITY if the
+ * array is already at maximum capacity.
+ */
+enum cc_stat cc_segmented_array_add(CC_SegmentedArray *ar, void *element)
+{
+    if (ar->size >= ar->capacity) {
+        enum cc_stat status = add_segment(ar);
+        if (status != CC_OK)
+            return status;
+    }
+
+    *slot(ar, ar->size) = element;
+    ar->size++;
+
+    return CC_OK;
+}
+
+/**
+ * Adds a new element to the array at the specified position by shifting all
+ * subsequent elements by one. The specified index must be within the bounds
+ * of the array.
+ *
+ * @param[in] ar the array to which the element is being added
+ * @param[in] element the element that is being added
+ * @param[in] index the position in the array at which the element is being
+ *            added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_OUT_OF_RANGE if
+ * the specified index was not in range, CC_ERR_ALLOC if the memory
+ * allocation for the new segment failed, or CC_ERR_MAX_CAPACITY if the
+ * array is already at maximum capacity.
+ */
+enum cc_stat cc_segmented_array_add_at(CC_SegmentedArray *ar, void *element, size_t index)
+{
+    if (index == ar->size)
+        return cc_segmented_array_add(ar, element);
+
+    if (index > ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (ar->size >= ar->capacity) {
+        enum cc_stat status = add_segment(ar);
+        if (status != CC_OK)
+            return status;
+    }
+
+    size_t i;
+    for (i = ar->size; i > index; i--)
+        *slot(ar, i) = *slot(ar, i - 1);
+
+    *slot(ar, index) = element;
+    ar->size++;
+
+    return CC_OK;
+}
+
+/**
+ * Replaces an array element at the specified index and optionally sets the
+ * out parameter to the value of the replaced element. The specified index
+ * must be within the bounds of the CC_SegmentedArray.
+ *
+ * @param[in]  ar      array whose element is being replaced
+ * @param[in]  element replacement element
+ * @param[in]  index   index at which the replacement element should be inserted
+ * @param[out] out     pointer to where the replaced element is stored, or NULL
+ *                     if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully replaced, or CC_ERR_OUT_OF_RANGE
+ *         if the index was out of range.
+ */
+enum cc_stat cc_segmented_array_replace_at(CC_SegmentedArray *ar, void *element, size_t index, void **out)
+{
+    if (index >= ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    void **s = slot(ar, index);
+
+    if (out)
+        *out = *s;
+
+    *s = element;
+
+    return CC_OK;
+}
+
+/**
+ * Removes an element from the specified index by shifting all subsequent
+ * elements by one and optionally sets the out parameter to the value of the
+ * removed element. The index must be within the bounds of the array.
+ *
+ * @param[in] ar the array from which the element is being removed
+ * @param[in] index the index of the element being removed.
+ * @param[out] out  pointer to where the removed value is stored,
+ *                  or NULL if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or CC_ERR_OUT_OF_RANGE
+ * if the index was out of range.
+ */
+enum cc_stat cc_segmented_array_remove_at(CC_SegmentedArray *ar, size_t index, void **out)
+{
+    if (index >= ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (out)
+        *out = *slot(ar, index);
+
+    size_t i;
+    for (i = index; i < ar->size - 1; i++)
+        *slot(ar, i) = *slot(ar, i + 1);
+
+    ar->size--;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the last element of the array and optionally sets the out
+ * parameter to the value of the removed element.
+ *
+ * @param[in] ar the array whose last element is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it is
+ *                 to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or CC_ERR_OUT_OF_RANGE
+ * if the array is already empty.
+ */
+enum cc_stat cc_segmented_array_remove_last(CC_SegmentedArray *ar, void **out)
+{
+    if (ar->size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    return cc_segmented_array_remove_at(ar, ar->size - 1, out);
+}
+
+/**
+ * Removes all elements from the specified array. This function does not
+ * release any of the segments.
+ *
+ * @param[in] ar array from which all elements are to be removed
+ */
+void cc_segmented_array_remove_all(CC_SegmentedArray *ar)
+{
+    ar->size = 0;
+}
+
+/**
+ * Gets the element at the specified index and sets the out parameter to
+ * its value. The specified index must be within the bounds of the array.
+ *
+ * @param[in] ar the array from which the element is being retrieved
+ * @param[in] index the index of the array element
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the index
+ * was out of range.
+ */
+enum cc_stat cc_segmented_array_get_at(CC_SegmentedArray *ar, size_t index, void **out)
+{
+    if (index >= ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = *slot(ar, index);
+    return CC_OK;
+}
+
+/**
+ * Gets the last element of the array and sets the out parameter to its value.
+ *
+ * @param[in] ar the array whose last element is being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * array is empty.
+ */
+enum cc_stat cc_segmented_array_get_last(CC_SegmentedArray *ar, void **out)
+{
+    if (ar->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    return cc_segmented_array_get_at(ar, ar->size - 1, out);
+}
+
+/**
+ * Sets the out parameter to the address of the slot that holds the element
+ * at the specified index. The address remains valid until the element is
+ * removed or moved by an insertion or removal at a lower index.
+ *
+ * @param[in] ar the array whose slot is being returned
+ * @param[in] index the index of the array element
+ * @param[out] out pointer to where the slot address is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the index
+ * was out of range.
+ */
+enum cc_stat cc_segmented_array_peek(CC_SegmentedArray *ar, size_t index, void ***out)
+{
+    if (index >= ar->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    *out = slot(ar, index);
+    return CC_OK;
+}
+
+/**
+ * Releases the segments that are not needed to hold the current elements.
+ * The first segment is never released.
+ *
+ * @param[in] ar array whose capacity is being trimmed
+ *
+ * @return CC_OK.
+ */
+enum cc_stat cc_segmented_array_trim_capacity(CC_SegmentedArray *ar)
+{
+    size_t needed = 1;
+
+    if (ar->size > 0) {
+        size_t j = (ar->size - 1) + ((size_t) 1 << ar->base_shift);
+        needed = highest_bit(j) - ar->base_shift + 1;
+    }
+
+    while (ar->n_segments > needed) {
+        ar->n_segments--;
+        ar->capacity -= (size_t) 1 << (ar->base_shift + ar->n_segments);
+        ar->mem_free(ar->segments[ar->n_segments]);
+        ar->segments[ar->n_segments] = NULL;
+    }
+    return CC_OK;
+}
+
+/**
+ * Returns the number of occurrences of the element within the specified
+ * CC_SegmentedArray.
+ *
+ * @param[in] ar array that is being searched
+ * @param[in] element the element that is being searched for
+ *
+ * @return the number of occurrences of the element.
+ */
+size_t cc_segmented_array_contains(CC_SegmentedArray *ar, void *element)
+{
+    size_t o = 0;
+    size_t i;
+    for (i = 0; i < ar->size; i++) {
+        if (*slot(ar, i) == element)
+            o++;
+    }
+    return o;
+}
+
+/**
+ * Returns the number of elements in the specified CC_SegmentedArray.
+ *
+ * @param[in] ar array whose size is being returned
+ *
+ * @return the the number of element within the CC_SegmentedArray.
+ */
+size_t cc_segmented_array_size(CC_SegmentedArray *ar)
+{
+    return ar->size;
+}
+
+/**
+ * Returns the combined capacity of all the allocated segments.
+ *
+ * @param[in] ar array whose capacity is being returned
+ *
+ * @return the capacity of the CC_SegmentedArray.
+ */
+size_t cc_segmented_array_capacity(CC_SegmentedArray *ar)
+{
+    return ar->capacity;
+}
+
+/**
+ * Gets the index of the first occurrence of the specified element.
+ *
+ * @param[in] ar array being searched
+ * @param[in] element the element whose index is being looked up
+ * @param[out] index  pointer to where the index is stored
+ *
+ * @return CC_OK if the index was found, or CC_ERR_OUT_OF_RANGE if not.
+ */
+enum cc_stat cc_segmented_array_index_of(CC_SegmentedArray *ar, void *element, size_t *index)
+{
+    size_t i;
+    for (i = 0; i < ar->size; i++) {
+        if (*slot(ar, i) == element) {
+            *index = i;
+            return CC_OK;
+        }
+    }
+    return CC_ERR_OUT_OF_RANGE;
+}
+
+/**
+ * Applies the function fn to each element of the CC_SegmentedArray.
+ *
+ * @param[in] ar array on which this operation is performed
+ * @param[in] fn operation function that is to be invoked on each element
+ */
+void cc_segmented_array_map(CC_SegmentedArray *ar, void (*fn) (void*))
+{
+    size_t remaining = ar->size;
+    size_t k;
+
+    /* Walk the segments directly instead of resolving every index */
+    for (k = 0; remaining > 0; k++) {
+        size_t seg_cap = (size_t) 1 << (ar->base_shift + k);
+        size_t n = remaining < seg_cap ? remaining : seg_cap;
+        size_t i;
+
+        for (i = 0; i < n; i++)
+            fn(ar->segments[k][i]);
+
+        remaining -= n;
+    }
+}
+
+/**
+ * Allocates the next segment. The new segment is twice the size of the
+ * previous one.
+ *
+ * @param[in] ar array that is being expanded
+ *
+ * @return CC_OK if the segment was allocated, CC_ERR_ALLOC if the memory
+ * allocation failed, or CC_ERR_MAX_CAPACITY if the array cannot grow any
+ * further.
+ */
+static enum cc_stat add_segment(CC_SegmentedArray *ar)
+{
+    size_t shift = ar->base_shift + ar->n_segments;
+
+    /* Keeps (index + first segment capacity) from overflowing in slot() */
+    if (shift + 1 >= MAX_SEGMENTS)
+        return CC_ERR_MAX_CAPACITY;
+
+    size_t seg_cap = (size_t) 1 << shift;
+
+    if (seg_cap > CC_MAX_ELEMENTS / sizeof(void*))
+        return CC_ERR_MAX_CAPACITY;
+
+    void **segment = ar->mem_alloc(seg_cap * sizeof(void*));
+
+    if (!segment)
+        return CC_ERR_ALLOC;
+
+    ar->segments[ar->n_segments] = segment;
+    ar->n_segments++;
+    ar->capacity += seg_cap;
+
+    return CC_OK;
+}
+
+/**
+ * Returns the position of the highest set bit of a non zero integer.
+ */
+static INLINE size_t highest_bit(size_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(unsigned long long) * 8 - 1) - (size_t) __builtin_clzll((unsigned long long) n);
+#else
+    size_t h = 0;
+    while (n >>= 1)
+        h++;
+    return h;
+#endif
+}
+
+/**
+ * Initializes the iterator.
+ *
+ * @param[in] iter the iterator that is being initialized
+ * @param[in] ar the array to iterate over
+ */
+void cc_segmented_array_iter_init(CC_SegmentedArrayIter *iter, CC_SegmentedArray *ar)
+{
+    iter->ar           = ar;
+    iter->index        = 0;
+    iter->last_removed = false;
+}
+
+/**
+ * Advances the iterator and sets the out parameter to the value of the
+ * next element in the sequence.
+ *
+ * @param[in] iter the iterator that is being advanced
+ * @param[out] out pointer to where the next element is set
+ *
+ * @return CC_OK if the iterator was advanced, or CC_ITER_END if the
+ * end of the CC_SegmentedArray has been reached.
+ */
+enum cc_stat cc_segmented_array_iter_next(CC_SegmentedArrayIter *iter, void **out)
+{
+    if (iter->index >= iter->ar->size)
+        return CC_ITER_END;
+
+    *out = *slot(iter->ar, iter->index);
+
+    iter->index++;
+    iter->last_removed = false;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the last returned element by <code>cc_segmented_array_iter_next()
+ * </code> function without invalidating the iterator and optionally sets the
+ * out parameter to the value of the removed element.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_segmented_array_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND.
+ */
+enum cc_stat cc_segmented_array_iter_remove(CC_SegmentedArrayIter *iter, void **out)
+{
+    enum cc_stat status = CC_ERR_VALUE_NOT_FOUND;
+
+    if (!iter->last_removed) {
+        status = cc_segmented_array_remove_at(iter->ar, iter->index - 1, out);
+        if (status == CC_OK) {
+            iter->index--;
+            iter->last_removed = true;
+        }
+    }
+    return status;
+}
+
+/**
+ * Adds a new element to the CC_SegmentedArray after the last returned element
+ * by <code>cc_segmented_array_iter_next()</code> function without invalidating
+ * the iterator.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_segmented_array_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the element being added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new segment failed, or CC_ERR_MAX_CAPACITY if
+ * the array is already at maximum capacity.
+ */
+enum cc_stat cc_segmented_array_iter_add(CC_SegmentedArrayIter *iter, void *element)
+{
+    enum cc_stat status = cc_segmented_array_add_at(iter->ar, element, iter->index);
+
+    if (status == CC_OK)
+        iter->index++;
+
+    return status;
+}
+
+/**
+ * Replaces the last returned element by <code>cc_segmented_array_iter_next()
+ * </code> with the specified element and optionally sets the out parameter to
+ * the value of the replaced element.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_segmented_array_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the replacement element
+ * @param[out] out pointer to where the replaced element is stored, or NULL
+ *                if it is to be ignored
+ *
+ * @return CC_OK if the element was replaced successfully, or
+ * CC_ERR_OUT_OF_RANGE.
+ */
+enum cc_stat cc_segmented_array_iter_replace(CC_SegmentedArrayIter *iter, void *element, void **out)
+{
+    return cc_segmented_array_replace_at(iter->ar, element, iter->index - 1, out);
+}
+
+/**
+ * Returns the index of the last returned element by <code>
+ * cc_segmented_array_iter_next()</code>.
+ *
+ * @note
+ * This function should not be called before a call to <code>
+ * cc_segmented_array_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ *
+ * @return the index.
+ */
+size_t cc_segmented_array_iter_index(CC_SegmentedArrayIter *iter)
+{
+    return iter->index - 1;
+}
+
+
+size_t cc_segmented_array_struct_size()
+{
+    return sizeof(CC_SegmentedArray);
+}
@@ -19,13 +19,60 @@
  */
 
 #include "cc_slist.h"
+#include "memory/cc_dynamic_pool.h"
 
 
+/*
+ * A pooled list carves its nodes out of chunks of pool_chunk_size nodes.
+ * Free nodes are kept on a free list linked through their next pointers
+ * and reused by the following insertions. The chunks are linked together
+ * so that they can all be released at once when the list is destroyed.
+ */
+struct snode_chunk {
+    struct snode_chunk *next;
+    SNode               nodes[];
+};
+
+/*
+ * A list without a node pool allocates the nodes it needs for a bulk
+ * operation, such as a copy, in a single block, so that they are laid out
+ * in traversal order. Every block counts its nodes that are still in use
+ * and is freed along with the last of them. The blocks are kept in tables
+ * sorted by address, where the block of a node is found by a binary search
+ * when the node is freed. New blocks go into the first table of the list.
+ * A splice moves the entries of the other list into that table, or chains
+ * its tables behind it if the first table can't grow, so that a splice
+ * never fails; a chained table is freed once it empties. A block that was
+ * carved out of a CC_DynamicPool by a compaction isn't owned by the list
+ * and is left to the pool.
+ */
+struct snode_block {
+    SNode  *nodes;
+    size_t  count;
+    size_t  live;
+    bool    owned;
+};
+
+struct sblock_table {
+    struct sblock_table *next;
+    size_t               count;
+    size_t               capacity;
+    struct snode_block   blocks[];
+};
+
 struct cc_slist_s {
     size_t  size;
     SNode   *head;
     SNode   *tail;
 
+    size_t              pool_chunk_size;
+    struct snode_chunk *pool_chunks;
+    struct snode_chunk *pool_chunks_tail;
+    SNode              *pool_free;
+    SNode              *pool_free_tail;
+
+    struct sblock_table *blocks;
+
     void  *(*mem_alloc)  (size_t size);
     void  *(*mem_calloc) (size_t blocks, size_t size);
     void   (*mem_free)   (void *block);
@@ -35,9 +82,21 @@ struct cc_slist_s {
 static void* unlinkn             (CC_SList *list, SNode *node, SNode *prev);
 static bool  unlinkn_all         (CC_SList *list, void (*cb) (void*));
 static void  splice_between      (CC_SList *list1, CC_SList *list2, SNode *base, SNode *end);
-static bool  link_all_externally (CC_SList *list, SNode **h, SNode **t);
+static bool  link_all_externally (CC_SList *list, SNode *first, size_t n, void *(*cp) (void*),
+                                  SNode **h, SNode **t);
+static enum cc_stat copy_range   (CC_SList *list, SNode *first, size_t n, void *(*cp) (void*),
+                                  CC_SList **out);
 static enum cc_stat get_node_at  (CC_SList *list, size_t index, SNode **node, SNode **prev);
 static enum cc_stat get_node     (CC_SList *list, void *element, SNode **node, SNode **prev);
+static SNode *node_alloc         (CC_SList *list);
+static SNode *node_alloc_n       (CC_SList *list, size_t n);
+static void  node_free           (CC_SList *list, SNode *node);
+static bool  block_reserve       (CC_SList *list, size_t n);
+static void  block_insert        (CC_SList *list, struct snode_block block);
+static void  block_merge         (CC_SList *list1, CC_SList *list2);
+static void  pool_merge          (CC_SList *list1, CC_SList *list2);
+static void  pool_release        (CC_SList *list);
+static void  sort_nodes          (CC_SList *list, int (*cmp) (void const*, void const*), bool by_ref);
 
 
 /**
@@ -47,6 +106,7 @@ static enum cc_stat get_node     (CC_SList *list, void *element, SNode **node, S
  */
 void cc_slist_conf_init(CC_SListConf *conf)
 {
+    conf->pool_chunk_size = 0;
     conf->mem_alloc  = malloc;
     conf->mem_calloc = calloc;
     conf->mem_free   = free;
@@ -79,16 +139,21 @@ enum cc_stat cc_slist_new(CC_SList **out)
  *
  * @param[out] out Pointer to a CC_SList that is being createdo
  *
- * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
- * memory allocation for the new CC_SList structure failed.
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the node pool chunk size is too large, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_SList structure failed.
  */
 enum cc_stat cc_slist_new_conf(CC_SListConf const * const conf, CC_SList **out)
 {
+    if (conf->pool_chunk_size > (CC_MAX_ELEMENTS - sizeof(struct snode_chunk)) / sizeof(SNode))
+        return CC_ERR_INVALID_CAPACITY;
+
     CC_SList *list = conf->mem_calloc(1, sizeof(CC_SList));
 
     if (!list)
         return CC_ERR_ALLOC;
 
+    list->pool_chunk_size = conf->pool_chunk_size;
     list->mem_alloc  = conf->mem_alloc;
     list->mem_calloc = conf->mem_calloc;
     list->mem_free   = conf->mem_free;
@@ -104,7 +169,11 @@ enum cc_stat cc_slist_new_conf(CC_SListConf const * const conf, CC_SList **out)
  */
 void cc_slist_destroy(CC_SList *list)
 {
-    cc_slist_remove_all(list);
+    /* Pooled nodes are released along with their chunks */
+    if (!list->pool_chunk_size)
+        cc_slist_remove_all(list);
+
+    pool_release(list);
     list->mem_free(list);
 }
 
@@ -120,6 +189,7 @@ void cc_slist_destroy(CC_SList *list)
 void cc_slist_destroy_cb(CC_SList *list, void (*cb) (void*))
 {
     cc_slist_remove_all_cb(list, cb);
+    pool_release(list);
     list->mem_free(list);
 }
 
@@ -150,7 +220,7 @@ enum cc_stat cc_slist_add(CC_SList *list, void *element)
  */
 enum cc_stat cc_slist_add_first(CC_SList *list, void *element)
 {
-    SNode *node = list->mem_calloc(1, sizeof(SNode));
+    SNode *node = node_alloc(list);
 
     if (!node)
         return CC_ERR_ALLOC;
@@ -180,7 +250,7 @@ enum cc_stat cc_slist_add_first(CC_SList *list, void *element)
  */
 enum cc_stat cc_slist_add_last(CC_SList *list, void *element)
 {
-    SNode *node = list->mem_calloc(1, sizeof(SNode));
+    SNode *node = node_alloc(list);
 
     if (!node)
         return CC_ERR_ALLOC;
@@ -224,7 +294,7 @@ enum cc_stat cc_slist_add_at(CC_SList *list, void *element, size_t index)
     if (status != CC_OK)
         return status;
 
-    SNode *new = list->mem_calloc(1, sizeof(SNode));
+    SNode *new = node_alloc(list);
 
     if (!new)
         return CC_ERR_ALLOC;
@@ -262,7 +332,7 @@ enum cc_stat cc_slist_add_all(CC_SList *list1, CC_SList *list2)
     SNode *head = NULL;
     SNode *tail = NULL;
 
-    if (!link_all_externally(list2, &head, &tail))
+    if (!link_all_externally(list1, list2->head, list2->size, NULL, &head, &tail))
         return CC_ERR_ALLOC;
 
     if (list1->size == 0) {
@@ -307,7 +377,7 @@ enum cc_stat cc_slist_add_all_at(CC_SList *list1, CC_SList *list2, size_t index)
     SNode *head = NULL;
     SNode *tail = NULL;
 
-    if (!link_all_externally(list2, &head, &tail))
+    if (!link_all_externally(list1, list2->head, list2->size, NULL, &head, &tail))
         return CC_ERR_ALLOC;
 
     if (!prev) {
@@ -324,45 +394,39 @@ enum cc_stat cc_slist_add_all_at(CC_SList *list1, CC_SList *list2, size_t index)
 }
 
 /**
- * Duplicates the structure of the list without directly attaching it to a
- * specific list. If the operation fails, everything is cleaned up and false
- * is returned to indicate the failure.
- *
- * @param[in] list the list whose structure is being duplicated
- * @param[in, out] h the pointer to which the new head will be attached
- * @param[in, out] t the pointer to which the new tail will be attached
+ * Duplicates a run of n nodes without attaching the copies to any list. The
+ * new nodes are allocated by the list at once and linked in order. If the
+ * allocation fails, nothing is allocated and false is returned.
+ *
+ * @param[in] list the list that allocates the new nodes
+ * @param[in] first the first node of the run that is being duplicated
+ * @param[in] n the number of nodes in the run, at least 1
+ * @param[in] cp the function that copies the elements, or NULL if the
+ *               elements are shared
+ * @param[out] h the pointer to which the new head will be attached
+ * @param[out] t the pointer to which the new tail will be attached
  *
  * @return true if the operation was successful
  */
-static bool link_all_externally(CC_SList *list, SNode **h, SNode **t)
+static bool link_all_externally(CC_SList *list, SNode *first, size_t n, void *(*cp) (void*),
+                                SNode **h, SNode **t)
 {
-    SNode *ins = list->head;
-
-    size_t i;
-    for (i = 0; i < list->size; i++) {
-        SNode *new = list->mem_calloc(1, sizeof(SNode));
+    SNode *head = node_alloc_n(list, n);
 
-        if (!new) {
-            while (*h) {
-                SNode *tmp = (*h)->next;
-                list->mem_free(*h);
-                *h = tmp;
-            }
-            return false;
-        }
-
-        new->data = ins->data;
+    if (!head)
+        return false;
 
-        if (!*h) {
-            *h = new;
-            *t = new;
-        } else {
-            (*t)->next = new;
-            *t = new;
-        }
+    SNode *node = head;
+    SNode *tail = head;
 
-        ins = ins->next;
+    while (node) {
+        node->data = cp ? cp(first->data) : first->data;
+        tail  = node;
+        node  = node->next;
+        first = first->next;
     }
+    *h = head;
+    *t = tail;
     return true;
 }
 
@@ -371,16 +435,35 @@ static bool link_all_externally(CC_SList *list, SNode **h, SNode **t)
  * first. This function moves all the elements from the second list into
  * the first list, leaving the second list empty.
  *
+ * @note If both lists use a node pool, the node chunks of the second list are
+ *       handed over to the first list, and if neither does, so are the node
+ *       blocks of its bulk operations. If only one of them does, the
+ *       elements are copied into new nodes of the first list instead of
+ *       being moved.
+ *
  * @param[in] list1 The consumer list to which the elements are moved.
  * @param[in] list2 The producer list from which the elements are moved.
  *
- * @return CC_OK if the elements were successfully moved
+ * @return CC_OK if the elements were successfully moved, or CC_ERR_ALLOC if
+ * the memory allocation for the copied nodes failed.
  */
 enum cc_stat cc_slist_splice(CC_SList *list1, CC_SList *list2)
 {
     if (list2->size == 0)
         return CC_OK;
 
+    if (!list1->pool_chunk_size != !list2->pool_chunk_size) {
+        enum cc_stat status = cc_slist_add_all(list1, list2);
+
+        if (status == CC_OK)
+            cc_slist_remove_all(list2);
+
+        return status;
+    }
+    block_merge(list1, list2);
+
+    pool_merge(list1, list2);
+
     if (list1->size == 0) {
         list1->head = list2->head;
         list1->tail = list2->tail;
@@ -408,8 +491,15 @@ enum cc_stat cc_slist_splice(CC_SList *list1, CC_SList *list2)
  * @param[in] index the index in the first list after which the elements
  *                   from the second list should be inserted
  *
+ * @note If both lists use a node pool, the node chunks of the second list are
+ *       handed over to the first list, and if neither does, so are the node
+ *       blocks of its bulk operations. If only one of them does, the
+ *       elements are copied into new nodes of the first list instead of
+ *       being moved.
+ *
  * @return CC_OK if the elements were successfully moved, CC_ERR_OUT_OF_RANGE if
- * the index was not in range,
+ * the index was not in range, or CC_ERR_ALLOC if the memory allocation for the
+ * copied nodes failed.
  */
 enum cc_stat cc_slist_splice_at(CC_SList *list1, CC_SList *list2, size_t index)
 {
@@ -419,6 +509,15 @@ enum cc_stat cc_slist_splice_at(CC_SList *list1, CC_SList *list2, size_t index)
     if (index >= list1->size)
         return CC_ERR_OUT_OF_RANGE;
 
+    if (!list1->pool_chunk_size != !list2->pool_chunk_size) {
+        enum cc_stat status = cc_slist_add_all_at(list1, list2, index);
+
+        if (status == CC_OK)
+            cc_slist_remove_all(list2);
+
+        return status;
+    }
+
     SNode *prev = NULL;
     SNode *node = NULL;
 
@@ -427,6 +526,9 @@ enum cc_stat cc_slist_splice_at(CC_SList *list1, CC_SList *list2, size_t index)
     if (status != CC_OK)
         return status;
 
+    block_merge(list1, list2);
+
+    pool_merge(list1, list2);
     splice_between(list1, list2, prev, node);
 
     return CC_OK;
@@ -791,30 +893,9 @@ enum cc_stat cc_slist_sublist(CC_SList *list, size_t from, size_t to, CC_SList *
     SNode *base = NULL;
     SNode *node = NULL;
 
-    CC_SList *sub;
-    enum cc_stat status = cc_slist_new(&sub);
-
-    if (status != CC_OK)
-        return status;
-
-    status = get_node_at(list, from, &node, &base);
+    get_node_at(list, from, &node, &base);
 
-    if (status != CC_OK) {
-        cc_slist_destroy(sub);
-        return status;
-    }
-
-    size_t i;
-    for (i = from; i <= to; i++) {
-        status = cc_slist_add(sub, node->data);
-        if (status != CC_OK) {
-            cc_slist_destroy(sub);
-            return status;
-        }
-        node = node->next;
-    }
-    *out = sub;
-    return CC_OK;
+    return copy_range(list, node, to - from + 1, NULL, out);
 }
 
 /**
@@ -833,24 +914,7 @@ enum cc_stat cc_slist_sublist(CC_SList *list, size_t from, size_t to, CC_SList *
  */
 enum cc_stat cc_slist_copy_shallow(CC_SList *list, CC_SList **out)
 {
-    CC_SList *copy;
-    enum cc_stat status = cc_slist_new(&copy);
-
-    if (status != CC_OK)
-        return status;
-
-    SNode *node = list->head;
-
-    while (node) {
-        status = cc_slist_add(copy, node->data);
-        if (status != CC_OK) {
-            cc_slist_destroy(copy);
-            return status;
-        }
-        node = node->next;
-    }
-    *out = copy;
-    return CC_OK;
+    return copy_range(list, list->head, list->size, NULL, out);
 }
 
 /**
@@ -872,23 +936,141 @@ enum cc_stat cc_slist_copy_shallow(CC_SList *list, CC_SList **out)
  */
 enum cc_stat cc_slist_copy_deep(CC_SList *list, void *(*cp) (void*), CC_SList **out)
 {
+    return copy_range(list, list->head, list->size, cp, out);
+}
+
+/**
+ * Creates a new list with the configuration of the specified list that holds
+ * the elements of a run of its nodes. All nodes of the new list are allocated
+ * at once, so they are laid out in traversal order.
+ *
+ * @param[in] list the list whose configuration the new list inherits
+ * @param[in] first the first node of the run that is being copied
+ * @param[in] n the number of nodes in the run
+ * @param[in] cp the function that copies the elements, or NULL if the
+ *               elements are shared
+ * @param[out] out pointer to where the new list is stored
+ *
+ * @return CC_OK if the copy was successfully created, or CC_ERR_ALLOC if the
+ * memory allocation for the copy failed.
+ */
+static enum cc_stat copy_range(CC_SList *list, SNode *first, size_t n, void *(*cp) (void*),
+                               CC_SList **out)
+{
+    CC_SListConf conf;
+
+    conf.pool_chunk_size = list->pool_chunk_size;
+    conf.mem_alloc  = list->mem_alloc;
+    conf.mem_calloc = list->mem_calloc;
+    conf.mem_free   = list->mem_free;
+
     CC_SList *copy;
-    enum cc_stat status = cc_slist_new(&copy);
+    enum cc_stat status = cc_slist_new_conf(&conf, &copy);
 
     if (status != CC_OK)
         return status;
 
+    if (n > 0 && !link_all_externally(copy, first, n, cp, &copy->head, &copy->tail)) {
+        cc_slist_destroy(copy);
+        return CC_ERR_ALLOC;
+    }
+    copy->size = n;
+
+    *out = copy;
+    return CC_OK;
+}
+
+/**
+ * Moves all nodes of the list into a single contiguous run of memory in
+ * traversal order, so that walking the list afterwards walks through memory
+ * sequentially. The elements keep their order. A pooled list replaces all of
+ * its chunks with a single chunk that holds exactly the nodes in use, which
+ * releases the spare nodes of the pool.
+ *
+ * The nodes are allocated with the list allocator, or from the specified
+ * CC_DynamicPool if one is given. The list never frees nodes that come from
+ * a pool, so the pool must outlive the list and any list that the nodes are
+ * later spliced into.
+ *
+ * @note This operation invalidates any iterators over the list.
+ *
+ * @param[in] list the list that is being compacted
+ * @param[in] pool the pool from which the nodes are allocated, or NULL if
+ *                 they are allocated with the list allocator
+ *
+ * @return CC_OK if the list was compacted, or CC_ERR_ALLOC if the memory
+ * allocation for the nodes failed, in which case the list is left unchanged.
+ */
+enum cc_stat cc_slist_compact(CC_SList *list, CC_DynamicPool *pool)
+{
+    size_t n = list->size;
+
+    if (n == 0) {
+        pool_release(list);
+        return CC_OK;
+    }
+
+    if (n > (CC_MAX_ELEMENTS - sizeof(struct snode_chunk) - sizeof(void*)) / sizeof(SNode))
+        return CC_ERR_ALLOC;
+
+    if (!list->pool_chunk_size && !block_reserve(list, 1))
+        return CC_ERR_ALLOC;
+
+    struct snode_chunk *chunk = NULL;
+    SNode *nodes;
+
+    if (pool) {
+        /* The pool may hand out unaligned memory */
+        uintptr_t addr = (uintptr_t) cc_dynamic_pool_malloc(n * sizeof(SNode) + sizeof(void*) - 1, pool);
+
+        if (!addr)
+            return CC_ERR_ALLOC;
+
+        nodes = (SNode*) ((addr + sizeof(void*) - 1) & ~(uintptr_t) (sizeof(void*) - 1));
+    } else if (list->pool_chunk_size) {
+        chunk = list->mem_alloc(sizeof(struct snode_chunk) + n * sizeof(SNode));
+
+        if (!chunk)
+            return CC_ERR_ALLOC;
+
+        nodes = chunk->nodes;
+    } else {
+        nodes = list->mem_alloc(n * sizeof(SNode));
+
+        if (!nodes)
+            return CC_ERR_ALLOC;
+    }
+
     SNode *node = list->head;
+    size_t i;
 
-    while (node) {
-        status = cc_slist_add(copy, cp(node->data));
-        if (status != CC_OK) {
-            cc_slist_destroy(copy);
-            return status;
+    for (i = 0; i < n; i++) {
+        SNode *next = node->next;
+
+        nodes[i].data = node->data;
+        nodes[i].next = i + 1 < n ? &nodes[i + 1] : NULL;
+
+        /* Pooled nodes are released along with their chunks */
+        if (!list->pool_chunk_size)
+            node_free(list, node);
+
+        node = next;
+    }
+    list->head = &nodes[0];
+    list->tail = &nodes[n - 1];
+
+    if (list->pool_chunk_size) {
+        pool_release(list);
+
+        if (chunk) {
+            chunk->next            = NULL;
+            list->pool_chunks      = chunk;
+            list->pool_chunks_tail = chunk;
         }
-        node = node->next;
+    } else {
+        struct snode_block block = { nodes, n, n, !pool };
+        block_insert(list, block);
     }
-    *out = copy;
     return CC_OK;
 }
 
@@ -995,7 +1177,10 @@ enum cc_stat cc_slist_to_array(CC_SList *list, void ***out)
 
 /**
  * Sorts the specified list. This function makes no guaranties that the
- * sort will be performed in place or in a stable way.
+ * sort will be performed in place or in a stable way. The elements are
+ * sorted in a temporary array, and only if the array can't be allocated
+ * are the nodes relinked by the merge sort of <code>cc_slist_sort_in_place()
+ * </code> instead.
  *
  * @note
  * Pointers passed to the comparator function will be pointers to the list
@@ -1010,8 +1195,8 @@ enum cc_stat cc_slist_to_array(CC_SList *list, void ***out)
  *                0 if the elements are equal and > 0 if the second goes
  *                before the first.
  *
- * @return CC_OK if the sort was performed successfully, or CC_ERR_ALLOC
- * if the sort could not allocate enough memory to performed the sort.
+ * @return CC_OK if the sort was performed successfully, or
+ * CC_ERR_INVALID_RANGE if the list is empty.
  */
 enum cc_stat cc_slist_sort(CC_SList *list, int (*cmp) (void const *e1, void const *e2))
 {
@@ -1021,6 +1206,10 @@ enum cc_stat cc_slist_sort(CC_SList *list, int (*cmp) (void const *e1, void cons
     void **elements;
     enum cc_stat status = cc_slist_to_array(list, &elements);
 
+    if (status == CC_ERR_ALLOC) {
+        sort_nodes(list, cmp, true);
+        return CC_OK;
+    }
     if (status != CC_OK)
         return status;
 
@@ -1037,6 +1226,151 @@ enum cc_stat cc_slist_sort(CC_SList *list, int (*cmp) (void const *e1, void cons
     return CC_OK;
 }
 
+/**
+ * Sorts the specified list in place in a stable way. The nodes are relinked
+ * by a natural merge sort that takes advantage of the already ordered runs
+ * in the list and doesn't allocate any memory.
+ *
+ * @note Unlike with <code>cc_slist_sort()</code>, the comparator function
+ *       is passed the list elements themselves.
+ *
+ * @param[in] list CC_SList to be sorted
+ * @param[in] cmp the comparator function that must be of type <code>
+ *                int cmp(const void e1*, const void e2*)</code> that
+ *                returns < 0 if the first element goes before the second,
+ *                0 if the elements are equal and > 0 if the second goes
+ *                before the first.
+ */
+void cc_slist_sort_in_place(CC_SList *list, int (*cmp) (void const *e1, void const *e2))
+{
+    sort_nodes(list, cmp, false);
+}
+
+/**
+ * Compares the elements of two nodes. The comparator is either passed the
+ * elements or pointers to them, depending on the by_ref flag.
+ */
+static INLINE int sort_cmp(SNode *a, SNode *b, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    return by_ref ? cmp(&a->data, &b->data) : cmp(a->data, b->data);
+}
+
+/**
+ * Detaches the run at the front of the node chain. A run is the longest
+ * non descending sequence of nodes. A strictly descending sequence also
+ * counts as a run and is reversed while it is detached, which keeps the
+ * sort stable since such a sequence holds no equal elements.
+ *
+ * @param[in, out] rest the chain from which the run is detached and the
+ *                      remainder of the chain as the output
+ * @param[in] cmp the comparator function
+ * @param[in] by_ref whether the comparator is passed pointers to elements
+ *
+ * @return the first node of the detached run.
+ */
+static SNode *take_run(SNode **rest, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    SNode *head = *rest;
+    SNode *node = head;
+    SNode *next = head->next;
+
+    if (next && sort_cmp(next, head, cmp, by_ref) < 0) {
+        head->next = NULL;
+
+        while (next && sort_cmp(next, node, cmp, by_ref) < 0) {
+            SNode *after = next->next;
+            next->next = head;
+            head       = next;
+            node       = next;
+            next       = after;
+        }
+        *rest = next;
+        return head;
+    }
+
+    while (next && sort_cmp(node, next, cmp, by_ref) <= 0) {
+        node = next;
+        next = next->next;
+    }
+    node->next = NULL;
+
+    *rest = next;
+    return head;
+}
+
+/**
+ * Merges two sorted node chains into one. On equal elements the node from
+ * the first chain goes first, so the first chain must hold the nodes that
+ * came earlier in the list.
+ *
+ * @return the first node of the merged chain.
+ */
+static SNode *merge_runs(SNode *a, SNode *b, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    SNode  head;
+    SNode *tail = &head;
+
+    while (a && b) {
+        if (sort_cmp(b, a, cmp, by_ref) < 0) {
+            tail->next = b;
+            b          = b->next;
+        } else {
+            tail->next = a;
+            a          = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+
+    return head.next;
+}
+
+/**
+ * Sorts the nodes of the list with a bottom-up natural merge sort. The list
+ * is cut into its already ordered runs, which are merged like the digits of
+ * a binary counter: bin i holds a sorted chain of about 2^i runs, and every
+ * new run is merged with the occupied bins from the bottom up until it
+ * finds an empty one. Chains are merged while they are still warm in the
+ * cache, the sort needs no memory beyond the fixed bins, and an already
+ * sorted list is handled in a single pass.
+ *
+ * @param[in] list the list that is being sorted
+ * @param[in] cmp the comparator function
+ * @param[in] by_ref whether the comparator is passed pointers to elements
+ */
+static void sort_nodes(CC_SList *list, int (*cmp) (void const*, void const*), bool by_ref)
+{
+    if (list->size < 2)
+        return;
+
+    SNode  *bins[sizeof(size_t) * 8] = { NULL };
+    SNode  *rest = list->head;
+    size_t  i;
+
+    while (rest) {
+        SNode *run = take_run(&rest, cmp, by_ref);
+
+        for (i = 0; bins[i]; i++) {
+            run     = merge_runs(bins[i], run, cmp, by_ref);
+            bins[i] = NULL;
+        }
+        bins[i] = run;
+    }
+
+    SNode *head = NULL;
+    for (i = 0; i < sizeof(size_t) * 8; i++) {
+        if (bins[i])
+            head = merge_runs(bins[i], head, cmp, by_ref);
+    }
+
+    SNode *tail = head;
+    while (tail->next)
+        tail = tail->next;
+
+    list->head = head;
+    list->tail = tail;
+}
+
 /**
  * A 'foreach loop' function that invokes the specified function on each element
  * in the list.
@@ -1190,7 +1524,7 @@ enum cc_stat cc_slist_iter_remove(CC_SListIter *iter, void **out)
  */
 enum cc_stat cc_slist_iter_add(CC_SListIter *iter, void *element)
 {
-    SNode *new_node = iter->list->mem_calloc(1, sizeof(SNode));
+    SNode *new_node = node_alloc(iter->list);
 
     if (!new_node)
         return CC_ERR_ALLOC;
@@ -1355,15 +1689,15 @@ enum cc_stat cc_slist_zip_iter_next(CC_SListZipIter *iter, void **out1, void **o
  */
 enum cc_stat cc_slist_zip_iter_add(CC_SListZipIter *iter, void *e1, void *e2)
 {
-    SNode *new_node1 = iter->l1->mem_calloc(1, sizeof(SNode));
+    SNode *new_node1 = node_alloc(iter->l1);
 
     if (!new_node1)
         return CC_ERR_ALLOC;
 
-    SNode *new_node2 = iter->l2->mem_calloc(1, sizeof(SNode));
+    SNode *new_node2 = node_alloc(iter->l2);
 
     if (!new_node2) {
-        iter->l1->mem_free(new_node1);
+        node_free(iter->l1, new_node1);
         return CC_ERR_ALLOC;
     }
 
@@ -1493,7 +1827,7 @@ static void *unlinkn(CC_SList *list, SNode *node, SNode *prev)
     if (!node->next)
         list->tail = prev;
 
-    list->mem_free(node);
+    node_free(list, node);
     list->size--;
 
     return data;
@@ -1521,13 +1855,371 @@ static bool unlinkn_all(CC_SList *list, void (*cb) (void*))
         if (cb)
             cb(n->data);
 
-        list->mem_free(n);
+        node_free(list, n);
         n = tmp;
         list->size--;
     }
     return true;
 }
 
+/**
+ * Allocates a new zeroed node, either from the node pool of the list or
+ * directly from the list allocator if the list isn't pooled.
+ *
+ * @param[in] list the list for which the node is being allocated
+ *
+ * @return the new node, or NULL if the allocation failed.
+ */
+static SNode *node_alloc(CC_SList *list)
+{
+    if (!list->pool_chunk_size)
+        return list->mem_calloc(1, sizeof(SNode));
+
+    if (!list->pool_free) {
+        struct snode_chunk *chunk =
+            list->mem_alloc(sizeof(struct snode_chunk) + list->pool_chunk_size * sizeof(SNode));
+
+        if (!chunk)
+            return NULL;
+
+        size_t i;
+        for (i = 0; i < list->pool_chunk_size - 1; i++)
+            chunk->nodes[i].next = &(chunk->nodes[i + 1]);
+        chunk->nodes[i].next = NULL;
+
+        if (!list->pool_chunks)
+            list->pool_chunks_tail = chunk;
+
+        chunk->next          = list->pool_chunks;
+        list->pool_chunks    = chunk;
+        list->pool_free      = chunk->nodes;
+        list->pool_free_tail = &(chunk->nodes[i]);
+    }
+    SNode *node = list->pool_free;
+    list->pool_free = node->next;
+
+    node->data = NULL;
+    node->next = NULL;
+
+    return node;
+}
+
+/**
+ * Allocates n zeroed nodes at once and links them in order. A pooled list
+ * takes the nodes from its free list and allocates the missing ones in a
+ * single chunk, while a list without a pool allocates all of them in a
+ * single block. Either all nodes are allocated or none are.
+ *
+ * @param[in] list the list for which the nodes are being allocated
+ * @param[in] n the number of nodes, at least 1
+ *
+ * @return the first of the new nodes, or NULL if the allocation failed.
+ */
+static SNode *node_alloc_n(CC_SList *list, size_t n)
+{
+    if (n == 1)
+        return node_alloc(list);
+
+    SNode  *fresh = NULL;
+    size_t  taken = 0;
+    size_t  i;
+
+    if (list->pool_chunk_size) {
+        SNode *node = list->pool_free;
+
+        while (node && taken < n) {
+            node = node->next;
+            taken++;
+        }
+
+        if (taken < n) {
+            if (n - taken > (CC_MAX_ELEMENTS - sizeof(struct snode_chunk)) / sizeof(SNode))
+                return NULL;
+
+            struct snode_chunk *chunk =
+                list->mem_alloc(sizeof(struct snode_chunk) + (n - taken) * sizeof(SNode));
+
+            if (!chunk)
+                return NULL;
+
+            if (!list->pool_chunks)
+                list->pool_chunks_tail = chunk;
+
+            chunk->next       = list->pool_chunks;
+            list->pool_chunks = chunk;
+            fresh             = chunk->nodes;
+        }
+    } else {
+        if (n > CC_MAX_ELEMENTS / sizeof(SNode))
+            return NULL;
+
+        fresh = list->mem_alloc(n * sizeof(SNode));
+
+        if (!fresh)
+            return NULL;
+
+        if (!block_reserve(list, 1)) {
+            list->mem_free(fresh);
+            return NULL;
+        }
+        struct snode_block block = { fresh, n, n, true };
+        block_insert(list, block);
+    }
+
+    SNode *head = NULL;
+    SNode *tail = NULL;
+
+    /* Reused nodes go first, followed by the contiguous fresh ones */
+    for (i = 0; i < n; i++) {
+        SNode *node;
+
+        if (i < taken) {
+            node = list->pool_free;
+            list->pool_free = node->next;
+        } else {
+            node = &fresh[i - taken];
+        }
+        node->data = NULL;
+        node->next = NULL;
+
+        if (tail)
+            tail->next = node;
+        else
+            head = node;
+
+        tail = node;
+    }
+    return head;
+}
+
+/**
+ * Returns a node to the node pool of the list, or frees it if the list
+ * isn't pooled. A node that belongs to a block is only freed with the last
+ * node of its block.
+ *
+ * @param[in] list the list that allocated the node
+ * @param[in] node the node that is being freed
+ */
+static void node_free(CC_SList *list, SNode *node)
+{
+    if (list->pool_chunk_size) {
+        if (!list->pool_free)
+            list->pool_free_tail = node;
+
+        node->next = list->pool_free;
+        list->pool_free = node;
+        return;
+    }
+
+    struct sblock_table **link = &list->blocks;
+
+    for (; *link; link = &(*link)->next) {
+        struct sblock_table *table = *link;
+
+        size_t lo = 0;
+        size_t hi = table->count;
+
+        /* Find the last block that starts at or before the node */
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+
+            if ((uintptr_t) table->blocks[mid].nodes <= (uintptr_t) node)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if (lo == 0)
+            continue;
+
+        struct snode_block *block = &table->blocks[lo - 1];
+
+        if ((uintptr_t) node >= (uintptr_t) (block->nodes + block->count))
+            continue;
+
+        if (--block->live == 0) {
+            if (block->owned)
+                list->mem_free(block->nodes);
+
+            memmove(block, block + 1, (table->count - lo) * sizeof(struct snode_block));
+            table->count--;
+
+            if (table->count == 0 && table != list->blocks) {
+                *link = table->next;
+                list->mem_free(table);
+            }
+        }
+        return;
+    }
+    list->mem_free(node);
+}
+
+/**
+ * Makes room for n more entries in the first block table of the list.
+ *
+ * @param[in] list the list whose block table is being grown
+ * @param[in] n the number of entries to make room for
+ *
+ * @return true if the table has room, or false if it could not be grown.
+ */
+static bool block_reserve(CC_SList *list, size_t n)
+{
+    struct sblock_table *table = list->blocks;
+
+    size_t count    = table ? table->count : 0;
+    size_t capacity = table ? table->capacity : 0;
+
+    if (count + n <= capacity)
+        return true;
+
+    if (!capacity)
+        capacity = 4;
+
+    while (capacity < count + n)
+        capacity *= 2;
+
+    struct sblock_table *grown =
+        list->mem_alloc(sizeof(struct sblock_table) + capacity * sizeof(struct snode_block));
+
+    if (!grown)
+        return false;
+
+    grown->next     = table ? table->next : NULL;
+    grown->count    = count;
+    grown->capacity = capacity;
+
+    if (table) {
+        memcpy(grown->blocks, table->blocks, count * sizeof(struct snode_block));
+        list->mem_free(table);
+    }
+    list->blocks = grown;
+    return true;
+}
+
+/**
+ * Inserts a block into the first block table of the list, keeping the table
+ * sorted by address. The table must have room for the block.
+ *
+ * @param[in] list the list that takes the block
+ * @param[in] block the block that is being inserted
+ */
+static void block_insert(CC_SList *list, struct snode_block block)
+{
+    struct sblock_table *table = list->blocks;
+    size_t i = table->count;
+
+    while (i > 0 && (uintptr_t) table->blocks[i - 1].nodes > (uintptr_t) block.nodes) {
+        table->blocks[i] = table->blocks[i - 1];
+        i--;
+    }
+    table->blocks[i] = block;
+    table->count++;
+}
+
+/**
+ * Hands over the block tables of the second list to the first list, so that
+ * nodes can be moved from the second list to the first. The entries of each
+ * table are moved into the first table of the first list if it can grow to
+ * hold them, and otherwise the whole table is chained behind it, so that
+ * the hand over never fails.
+ *
+ * @param[in] list1 the list that takes over the blocks
+ * @param[in] list2 the list whose blocks are being taken over
+ */
+static void block_merge(CC_SList *list1, CC_SList *list2)
+{
+    struct sblock_table *table = list2->blocks;
+    list2->blocks = NULL;
+
+    while (table) {
+        struct sblock_table *next = table->next;
+
+        if (block_reserve(list1, table->count)) {
+            size_t i;
+            for (i = 0; i < table->count; i++)
+                block_insert(list1, table->blocks[i]);
+
+            list2->mem_free(table);
+        } else if (list1->blocks) {
+            table->next         = list1->blocks->next;
+            list1->blocks->next = table;
+        } else {
+            table->next   = NULL;
+            list1->blocks = table;
+        }
+        table = next;
+    }
+}
+
+/**
+ * Hands over the node chunks and the free nodes of the second list to the
+ * first list, so that nodes can be moved from the second list to the first.
+ * Both lists are linked in through their tail pointers, so the hand over
+ * takes constant time.
+ *
+ * @param[in] list1 the list that takes over the node pool
+ * @param[in] list2 the list whose node pool is being taken over
+ */
+static void pool_merge(CC_SList *list1, CC_SList *list2)
+{
+    if (!list2->pool_chunks)
+        return;
+
+    if (!list1->pool_chunks)
+        list1->pool_chunks_tail = list2->pool_chunks_tail;
+
+    list2->pool_chunks_tail->next = list1->pool_chunks;
+    list1->pool_chunks            = list2->pool_chunks;
+    list2->pool_chunks            = NULL;
+    list2->pool_chunks_tail       = NULL;
+
+    if (list2->pool_free) {
+        if (!list1->pool_free)
+            list1->pool_free_tail = list2->pool_free_tail;
+
+        list2->pool_free_tail->next = list1->pool_free;
+        list1->pool_free            = list2->pool_free;
+        list2->pool_free            = NULL;
+        list2->pool_free_tail       = NULL;
+    }
+}
+
+/**
+ * Frees all node chunks of the list. Any node still linked into the list
+ * becomes invalid.
+ *
+ * @param[in] list the list whose node pool is being released
+ */
+static void pool_release(CC_SList *list)
+{
+    struct snode_chunk *chunk = list->pool_chunks;
+
+    while (chunk) {
+        struct snode_chunk *next = chunk->next;
+        list->mem_free(chunk);
+        chunk = next;
+    }
+    list->pool_chunks      = NULL;
+    list->pool_chunks_tail = NULL;
+    list->pool_free        = NULL;
+    list->pool_free_tail   = NULL;
+
+    struct sblock_table *table = list->blocks;
+
+    while (table) {
+        struct sblock_table *next = table->next;
+
+        size_t i;
+        for (i = 0; i < table->count; i++) {
+            if (table->blocks[i].owned)
+                list->mem_free(table->blocks[i].nodes);
+        }
+        list->mem_free(table);
+        table = next;
+    }
+    list->blocks = NULL;
+}
+
 /**
  * Finds the node at the specified index. If the index is not in the bounds
  * of the list, NULL is returned instead.
@@ -135,6 +135,25 @@ enum cc_stat cc_stack_push(CC_Stack *stack, void *element)
     return cc_array_add(stack->v, element);
 }
 
+/**
+ * Pushes <code>n</code> elements onto the stack, as if cc_stack_push() was
+ * called for each element in order, so that the last element of the array
+ * ends up on top.
+ *
+ * @param[in] stack the stack on which the elements are being pushed onto
+ * @param[in] elements the elements being pushed onto the stack
+ * @param[in] n the number of elements being pushed
+ *
+ * @return CC_OK if the elements were successfully pushed, CC_ERR_ALLOC if
+ * the memory allocation for the new elements failed, or CC_ERR_MAX_CAPACITY
+ * if the stack cannot hold all of the elements. If an error is returned,
+ * none of the elements are pushed.
+ */
+enum cc_stat cc_stack_push_all(CC_Stack *stack, void * const *elements, size_t n)
+{
+    return cc_array_append_buffer(stack->v, elements, n);
+}
+
 /**
  * Gets the top element of the CC_Stack without removing it and sets the out
  * parameter to its value.
@@ -166,6 +185,69 @@ enum cc_stat cc_stack_pop(CC_Stack *stack, void **out)
     return cc_array_remove_last(stack->v, out);
 }
 
+/**
+ * Pops up to <code>n</code> elements off the stack, as if cc_stack_pop() was
+ * called repeatedly, and optionally copies them to <code>out</code> in the
+ * order in which they were popped, starting with the top element.
+ *
+ * @param[in] stack the stack whose top elements are being popped
+ * @param[out] out buffer large enough to hold <code>n</code> elements, or
+ *                 NULL if the popped elements are to be ignored
+ * @param[in] n the maximum number of elements that are being popped
+ *
+ * @return the number of popped elements, which is less than <code>n</code>
+ * only if the stack held fewer elements.
+ */
+size_t cc_stack_pop_n(CC_Stack *stack, void **out, size_t n)
+{
+    size_t size = cc_array_size(stack->v);
+
+    if (n > size)
+        n = size;
+    if (n == 0)
+        return 0;
+
+    if (out) {
+        const void * const *buff = cc_array_get_buffer(stack->v);
+        size_t i;
+        for (i = 0; i < n; i++)
+            out[i] = (void*) buff[size - 1 - i];
+    }
+    cc_array_remove_range(stack->v, size - n, size - 1, NULL);
+
+    return n;
+}
+
+/**
+ * Removes all elements from the stack and returns them in a newly allocated
+ * array, in the order in which they would have been popped. The array is
+ * allocated with the stack's allocator and must be freed by the caller.
+ *
+ * @param[in] stack the stack that is being drained
+ * @param[out] out pointer to where the newly created array is stored
+ *
+ * @return CC_OK if the array was successfully created, CC_ERR_OUT_OF_RANGE
+ * if the stack is empty, or CC_ERR_ALLOC if the memory allocation for the
+ * new array failed.
+ */
+enum cc_stat cc_stack_drain_to_array(CC_Stack *stack, void ***out)
+{
+    size_t size = cc_array_size(stack->v);
+
+    if (size == 0)
+        return CC_ERR_OUT_OF_RANGE;
+
+    void **array = stack->mem_alloc(size * sizeof(void*));
+
+    if (!array)
+        return CC_ERR_ALLOC;
+
+    cc_stack_pop_n(stack, array, size);
+    *out = array;
+
+    return CC_OK;
+}
+
 /**
  * Returns the number of CC_Stack elements.
  *
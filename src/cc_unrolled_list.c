@@ -0,0 +1,1141 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cc_unrolled_list.h"
+
+#define DEFAULT_NODE_CAPACITY 32
+
+/*
+ * Every node holds between one and node_capacity elements in the slots
+ * [0, count). Empty nodes are released immediately, so a node that is in
+ * the list is never empty.
+ */
+typedef struct unode_s {
+    struct unode_s *next;
+    struct unode_s *prev;
+    size_t          count;
+    void           *data[];
+} UNode;
+
+struct cc_unrolled_list_s {
+    size_t  size;
+    size_t  nodes;
+    size_t  node_capacity;
+    UNode  *head;
+    UNode  *tail;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+static UNode       *node_new     (CC_UnrolledList *list);
+static void         link_after   (CC_UnrolledList *list, UNode *base, UNode *node);
+static void         unlink_node  (CC_UnrolledList *list, UNode *node);
+static UNode       *locate       (CC_UnrolledList *list, size_t index, size_t *pos);
+static enum cc_stat insert_slot  (CC_UnrolledList *list, UNode *node, size_t pos, void *element,
+                                  UNode **in_node, size_t *in_pos);
+static void         remove_slot  (CC_UnrolledList *list, UNode *node, size_t pos,
+                                  UNode **it_node, size_t *it_pos);
+static void         free_nodes   (CC_UnrolledList *list, void (*cb) (void*));
+
+
+/**
+ * Creates a new empty CC_UnrolledList and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_UnrolledList is to be
+ *                 stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the memory
+ * allocation for the new CC_UnrolledList structure failed.
+ */
+enum cc_stat cc_unrolled_list_new(CC_UnrolledList **out)
+{
+    CC_UnrolledListConf conf;
+    cc_unrolled_list_conf_init(&conf);
+    return cc_unrolled_list_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_UnrolledList based on the specified
+ * CC_UnrolledListConf struct and returns a status code.
+ *
+ * The CC_UnrolledList is allocated using the allocators specified in the
+ * CC_UnrolledListConf struct. The allocation may fail if the underlying
+ * allocator fails.
+ *
+ * @param[in] conf list configuration structure
+ * @param[out] out pointer to where the newly created CC_UnrolledList is to be
+ *                 stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the node capacity is smaller than 2 or too large, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_UnrolledList structure failed.
+ */
+enum cc_stat cc_unrolled_list_new_conf(CC_UnrolledListConf const * const conf, CC_UnrolledList **out)
+{
+    if (conf->node_capacity < 2 || conf->node_capacity > (CC_MAX_ELEMENTS / sizeof(void*)) - 1)
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_UnrolledList *list = conf->mem_calloc(1, sizeof(CC_UnrolledList));
+
+    if (!list)
+        return CC_ERR_ALLOC;
+
+    list->node_capacity = conf->node_capacity;
+    list->mem_alloc     = conf->mem_alloc;
+    list->mem_calloc    = conf->mem_calloc;
+    list->mem_free      = conf->mem_free;
+
+    *out = list;
+    return CC_OK;
+}
+
+/**
+ * Initializes the fields of the CC_UnrolledListConf struct to default values.
+ *
+ * @param[in, out] conf CC_UnrolledListConf structure that is being initialized
+ */
+void cc_unrolled_list_conf_init(CC_UnrolledListConf *conf)
+{
+    conf->node_capacity = DEFAULT_NODE_CAPACITY;
+    conf->mem_alloc     = malloc;
+    conf->mem_calloc    = calloc;
+    conf->mem_free      = free;
+}
+
+/**
+ * Destroys the specified CC_UnrolledList structure without destroying the
+ * data it holds.
+ *
+ * @param[in] list the list that is being destroyed
+ */
+void cc_unrolled_list_destroy(CC_UnrolledList *list)
+{
+    free_nodes(list, NULL);
+    list->mem_free(list);
+}
+
+/**
+ * Destroys the specified CC_UnrolledList structure along with all the data
+ * it holds.
+ *
+ * @param[in] list the list that is being destroyed
+ * @param[in] cb the destructor function invoked on each element
+ */
+void cc_unrolled_list_destroy_cb(CC_UnrolledList *list, void (*cb) (void*))
+{
+    free_nodes(list, cb);
+    list->mem_free(list);
+}
+
+/**
+ * Adds a new element to the end of the list. This function is equivalent to
+ * <code>cc_unrolled_list_add_last()</code>.
+ *
+ * @param[in] list the list to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, or CC_ERR_ALLOC if
+ * the memory allocation for the new node failed.
+ */
+enum cc_stat cc_unrolled_list_add(CC_UnrolledList *list, void *element)
+{
+    return cc_unrolled_list_add_last(list, element);
+}
+
+/**
+ * Prepends a new element to the list (adds a new "head") making it the
+ * first element of the list.
+ *
+ * @param[in] list the list to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, or CC_ERR_ALLOC if
+ * the memory allocation for the new node failed.
+ */
+enum cc_stat cc_unrolled_list_add_first(CC_UnrolledList *list, void *element)
+{
+    return insert_slot(list, list->head, 0, element, NULL, NULL);
+}
+
+/**
+ * Appends a new element to the list (adds a new "tail") making it the last
+ * element of the list.
+ *
+ * @param[in] list the list to which the element is being added
+ * @param[in] element the element that is being added
+ *
+ * @return CC_OK if the element was successfully added, or CC_ERR_ALLOC if
+ * the memory allocation for the new node failed.
+ */
+enum cc_stat cc_unrolled_list_add_last(CC_UnrolledList *list, void *element)
+{
+    size_t pos = list->tail ? list->tail->count : 0;
+    return insert_slot(list, list->tail, pos, element, NULL, NULL);
+}
+
+/**
+ * Adds a new element at the specified location in the CC_UnrolledList and
+ * shifts all subsequent elements by one. The index at which the new element
+ * is being added must be within the bounds of the list.
+ *
+ * @param[in] list the list to which this element is being added
+ * @param[in] element the element that is being added
+ * @param[in] index the position in the list at which the new element is being
+ *                  added
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_OUT_OF_RANGE
+ * if the specified index was not in range, or CC_ERR_ALLOC if the memory
+ * allocation for the new node failed.
+ */
+enum cc_stat cc_unrolled_list_add_at(CC_UnrolledList *list, void *element, size_t index)
+{
+    if (index > list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (index == list->size)
+        return cc_unrolled_list_add_last(list, element);
+
+    size_t pos;
+    UNode *node = locate(list, index, &pos);
+
+    /* Prefer the free space at the end of the previous node over
+     * shifting the elements of this one. */
+    if (pos == 0 && node->prev && node->prev->count < list->node_capacity) {
+        node = node->prev;
+        pos  = node->count;
+    }
+    return insert_slot(list, node, pos, element, NULL, NULL);
+}
+
+/**
+ * Replaces an element at the specified location and optionally sets the out
+ * parameter to the value of the replaced element.
+ *
+ * @param[in] list list on which this operation is performed
+ * @param[in] element the replacement element
+ * @param[in] index index of the element being replaced
+ * @param[out] out pointer to where the replaced element is stored, or NULL if
+ *                 it is to be ignored
+ *
+ * @return CC_OK if the element was successfully replaced, or
+ * CC_ERR_OUT_OF_RANGE if the index was out of range.
+ */
+enum cc_stat cc_unrolled_list_replace_at(CC_UnrolledList *list, void *element, size_t index, void **out)
+{
+    if (index >= list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    size_t pos;
+    UNode *node = locate(list, index, &pos);
+
+    if (out)
+        *out = node->data[pos];
+
+    node->data[pos] = element;
+    return CC_OK;
+}
+
+/**
+ * Splices the two CC_UnrolledLists together by appending the second list to
+ * the first. This function moves all the nodes from the second list into
+ * the first list, leaving the second list empty.
+ *
+ * @param[in] list1 the consumer list to which the elements are moved
+ * @param[in] list2 the producer list from which the elements are moved
+ *
+ * @return CC_OK if the elements were successfully moved, or CC_ERR_ALLOC if
+ * the lists use different node capacities and a memory allocation failed
+ * while the elements were being copied over, in which case neither list is
+ * changed.
+ */
+enum cc_stat cc_unrolled_list_splice(CC_UnrolledList *list1, CC_UnrolledList *list2)
+{
+    return cc_unrolled_list_splice_at(list1, list2, list1->size);
+}
+
+/**
+ * Splices the two CC_UnrolledLists together at the specified index of the
+ * first list. The nodes of the second list are linked into the first list
+ * as they are, so at most one node of the first list is split. If the two
+ * lists were created with different node capacities the elements are copied
+ * into the first list instead. The second list is left empty.
+ *
+ * @param[in] list1 the consumer list to which the elements are moved
+ * @param[in] list2 the producer list from which the elements are moved
+ * @param[in] index the index in the consumer list after which the elements
+ *                  are inserted
+ *
+ * @return CC_OK if the elements were successfully moved, CC_ERR_OUT_OF_RANGE
+ * if the index was not in range, or CC_ERR_ALLOC if a memory allocation
+ * failed, in which case neither list is changed.
+ */
+enum cc_stat cc_unrolled_list_splice_at(CC_UnrolledList *list1, CC_UnrolledList *list2, size_t index)
+{
+    if (index > list1->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    if (list2->size == 0)
+        return CC_OK;
+
+    if (list1->node_capacity != list2->node_capacity) {
+        /* The elements are copied into a list shaped like the first one
+         * and spliced in only once all of them are copied, so that a
+         * failed allocation leaves both lists as they were. */
+        CC_UnrolledListConf conf;
+
+        conf.node_capacity = list1->node_capacity;
+        conf.mem_alloc     = list1->mem_alloc;
+        conf.mem_calloc    = list1->mem_calloc;
+        conf.mem_free      = list1->mem_free;
+
+        CC_UnrolledList *copy;
+        enum cc_stat status = cc_unrolled_list_new_conf(&conf, &copy);
+
+        if (status != CC_OK)
+            return status;
+
+        UNode *n;
+        size_t i;
+        for (n = list2->head; n && status == CC_OK; n = n->next) {
+            for (i = 0; i < n->count && status == CC_OK; i++)
+                status = cc_unrolled_list_add(copy, n->data[i]);
+        }
+
+        if (status == CC_OK)
+            status = cc_unrolled_list_splice_at(list1, copy, index);
+
+        if (status == CC_OK)
+            cc_unrolled_list_remove_all(list2);
+
+        cc_unrolled_list_destroy(copy);
+        return status;
+    }
+
+    UNode *before;
+    UNode *after;
+
+    if (index == list1->size) {
+        before = list1->tail;
+        after  = NULL;
+    } else {
+        size_t pos;
+        UNode *node = locate(list1, index, &pos);
+
+        if (pos == 0) {
+            before = node->prev;
+            after  = node;
+        } else {
+            UNode *right = node_new(list1);
+            if (!right)
+                return CC_ERR_ALLOC;
+
+            right->count = node->count - pos;
+            memcpy(right->data, &node->data[pos], right->count * sizeof(void*));
+            node->count = pos;
+            link_after(list1, node, right);
+
+            before = node;
+            after  = right;
+        }
+    }
+
+    list2->head->prev = before;
+    list2->tail->next = after;
+
+    if (before)
+        before->next = list2->head;
+    else
+        list1->head = list2->head;
+
+    if (after)
+        after->prev = list2->tail;
+    else
+        list1->tail = list2->tail;
+
+    list1->size  += list2->size;
+    list1->nodes += list2->nodes;
+
+    list2->head  = NULL;
+    list2->tail  = NULL;
+    list2->size  = 0;
+    list2->nodes = 0;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the first occurrence of the element from the specified
+ * CC_UnrolledList and optionally sets the out parameter to the value of the
+ * removed element.
+ *
+ * @param[in] list list from which the element is being removed
+ * @param[in] element element that is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the element was not found.
+ */
+enum cc_stat cc_unrolled_list_remove(CC_UnrolledList *list, void *element, void **out)
+{
+    UNode *node;
+    size_t i;
+
+    for (node = list->head; node; node = node->next) {
+        for (i = 0; i < node->count; i++) {
+            if (node->data[i] == element) {
+                if (out)
+                    *out = element;
+                remove_slot(list, node, i, NULL, NULL);
+                return CC_OK;
+            }
+        }
+    }
+    return CC_ERR_VALUE_NOT_FOUND;
+}
+
+/**
+ * Removes the first element from the specified list and optionally sets the
+ * out parameter to the value of the removed element.
+ *
+ * @param[in] list list from which the first element is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it
+ *                 is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list is empty.
+ */
+enum cc_stat cc_unrolled_list_remove_first(CC_UnrolledList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    if (out)
+        *out = list->head->data[0];
+
+    remove_slot(list, list->head, 0, NULL, NULL);
+    return CC_OK;
+}
+
+/**
+ * Removes the last element from the specified list and optionally sets the
+ * out parameter to the value of the removed element.
+ *
+ * @param[in] list list from which the last element is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if it
+ *                 is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND if the list is empty.
+ */
+enum cc_stat cc_unrolled_list_remove_last(CC_UnrolledList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    UNode *tail = list->tail;
+
+    if (out)
+        *out = tail->data[tail->count - 1];
+
+    remove_slot(list, tail, tail->count - 1, NULL, NULL);
+    return CC_OK;
+}
+
+/**
+ * Removes the element at the specified index and optionally sets the out
+ * parameter to the value of the removed element.
+ *
+ * @param[in] list list from which the element is being removed
+ * @param[in] index index of the element that is being removed
+ * @param[out] out pointer to where the removed value is stored, or NULL if
+ *                 it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_OUT_OF_RANGE if the index was out of range.
+ */
+enum cc_stat cc_unrolled_list_remove_at(CC_UnrolledList *list, size_t index, void **out)
+{
+    if (index >= list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    size_t pos;
+    UNode *node = locate(list, index, &pos);
+
+    if (out)
+        *out = node->data[pos];
+
+    remove_slot(list, node, pos, NULL, NULL);
+    return CC_OK;
+}
+
+/**
+ * Removes all elements from the specified list and releases all of its
+ * nodes.
+ *
+ * @param[in] list list from which all elements are being removed
+ */
+void cc_unrolled_list_remove_all(CC_UnrolledList *list)
+{
+    free_nodes(list, NULL);
+}
+
+/**
+ * Removes all elements from the specified list and invokes the destructor
+ * function on each of them.
+ *
+ * @param[in] list list from which all elements are being removed
+ * @param[in] cb the destructor function invoked on each element
+ */
+void cc_unrolled_list_remove_all_cb(CC_UnrolledList *list, void (*cb) (void*))
+{
+    free_nodes(list, cb);
+}
+
+/**
+ * Gets the list element from the specified index and sets the out parameter to
+ * its value.
+ *
+ * @param[in] list list from which the element is being returned
+ * @param[in] index the index of a list element being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_OUT_OF_RANGE if the index
+ * was out of range.
+ */
+enum cc_stat cc_unrolled_list_get_at(CC_UnrolledList *list, size_t index, void **out)
+{
+    if (index >= list->size)
+        return CC_ERR_OUT_OF_RANGE;
+
+    size_t pos;
+    UNode *node = locate(list, index, &pos);
+
+    *out = node->data[pos];
+    return CC_OK;
+}
+
+/**
+ * Gets the first element from the specified list and sets the out parameter to
+ * its value.
+ *
+ * @param[in] list list whose first element is being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * list is empty.
+ */
+enum cc_stat cc_unrolled_list_get_first(CC_UnrolledList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    *out = list->head->data[0];
+    return CC_OK;
+}
+
+/**
+ * Gets the last element from the specified list and sets the out parameter to
+ * its value.
+ *
+ * @param[in] list list whose last element is being returned
+ * @param[out] out pointer to where the element is stored
+ *
+ * @return CC_OK if the element was found, or CC_ERR_VALUE_NOT_FOUND if the
+ * list is empty.
+ */
+enum cc_stat cc_unrolled_list_get_last(CC_UnrolledList *list, void **out)
+{
+    if (list->size == 0)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    *out = list->tail->data[list->tail->count - 1];
+    return CC_OK;
+}
+
+/**
+ * Returns the number of occurrences of the element within the specified
+ * CC_UnrolledList.
+ *
+ * @param[in] list list that is being searched
+ * @param[in] element the element that is being searched for
+ *
+ * @return the number of occurrences of the element.
+ */
+size_t cc_unrolled_list_contains(CC_UnrolledList *list, void *element)
+{
+    UNode  *node;
+    size_t  i;
+    size_t  e_count = 0;
+
+    for (node = list->head; node; node = node->next) {
+        for (i = 0; i < node->count; i++) {
+            if (node->data[i] == element)
+                e_count++;
+        }
+    }
+    return e_count;
+}
+
+/**
+ * Gets the index of the specified element. The returned index is the index
+ * of the first occurrence of the element starting from the beginning of the
+ * list.
+ *
+ * @param[in] list the list on which this operation is performed
+ * @param[in] element the element whose index is being looked up
+ * @param[in] cmp comparator function which returns 0 if the values passed to it
+ *                are equal
+ * @param[out] index pointer to where the index is stored
+ *
+ * @return CC_OK if the index was found, or CC_ERR_OUT_OF_RANGE if not.
+ */
+enum cc_stat cc_unrolled_list_index_of(CC_UnrolledList *list, void *element,
+                                       int (*cmp) (const void*, const void*), size_t *index)
+{
+    UNode  *node;
+    size_t  i;
+    size_t  base = 0;
+
+    for (node = list->head; node; node = node->next) {
+        for (i = 0; i < node->count; i++) {
+            if (cmp(node->data[i], element) == 0) {
+                *index = base + i;
+                return CC_OK;
+            }
+        }
+        base += node->count;
+    }
+    return CC_ERR_OUT_OF_RANGE;
+}
+
+/**
+ * Creates an array representation of the specified list. None of the elements
+ * are copied into the array and thus any modification of the elements within
+ * the array will affect the list elements as well.
+ *
+ * @param[in] list list on which this operation is being performed
+ * @param[out] out pointer to where the newly created array is stored
+ *
+ * @return CC_OK if the array was successfully created, CC_ERR_INVALID_RANGE if
+ * the list is empty, or CC_ERR_ALLOC if the memory allocation for the new array
+ * failed.
+ */
+enum cc_stat cc_unrolled_list_to_array(CC_UnrolledList *list, void ***out)
+{
+    if (list->size == 0)
+        return CC_ERR_INVALID_RANGE;
+
+    void **array = list->mem_alloc(list->size * sizeof(void*));
+
+    if (!array)
+        return CC_ERR_ALLOC;
+
+    UNode  *node;
+    size_t  i = 0;
+
+    for (node = list->head; node; node = node->next) {
+        memcpy(&array[i], node->data, node->count * sizeof(void*));
+        i += node->count;
+    }
+    *out = array;
+    return CC_OK;
+}
+
+/**
+ * Returns the number of elements in the specified CC_UnrolledList.
+ *
+ * @param[in] list the list whose size is being returned
+ *
+ * @return the number of elements in the list.
+ */
+size_t cc_unrolled_list_size(CC_UnrolledList *list)
+{
+    return list->size;
+}
+
+/**
+ * Returns the number of nodes that currently make up the specified
+ * CC_UnrolledList.
+ *
+ * @param[in] list the list whose node count is being returned
+ *
+ * @return the number of nodes in the list.
+ */
+size_t cc_unrolled_list_node_count(CC_UnrolledList *list)
+{
+    return list->nodes;
+}
+
+/**
+ * Applies the function fn to each element of the CC_UnrolledList.
+ *
+ * @param[in] list the list on which this operation is performed
+ * @param[in] op the operation function that is to be invoked on each list
+ *               element
+ */
+void cc_unrolled_list_foreach(CC_UnrolledList *list, void (*op) (void *))
+{
+    UNode  *node;
+    size_t  i;
+
+    for (node = list->head; node; node = node->next) {
+        for (i = 0; i < node->count; i++)
+            op(node->data[i]);
+    }
+}
+
+/**
+ * Initializes the iterator.
+ *
+ * @param[in] iter the iterator that is being initialized
+ * @param[in] list the list over whose elements the iterator is going to
+ *                 iterate
+ */
+void cc_unrolled_list_iter_init(CC_UnrolledListIter *iter, CC_UnrolledList *list)
+{
+    iter->list         = list;
+    iter->node         = list->head;
+    iter->pos          = 0;
+    iter->index        = 0;
+    iter->last_removed = true;
+}
+
+/**
+ * Advances the iterator and sets the out parameter to the value of the
+ * next element in the sequence.
+ *
+ * @param[in] iter the iterator that is being advanced
+ * @param[out] out pointer to where the next element is set
+ *
+ * @return CC_OK if the iterator was advanced, or CC_ITER_END if the
+ * end of the CC_UnrolledList has been reached.
+ */
+enum cc_stat cc_unrolled_list_iter_next(CC_UnrolledListIter *iter, void **out)
+{
+    if (iter->index >= iter->list->size)
+        return CC_ITER_END;
+
+    UNode *node = iter->node;
+
+    if (iter->pos >= node->count) {
+        node       = node->next;
+        iter->node = node;
+        iter->pos  = 0;
+    }
+    *out = node->data[iter->pos];
+
+    iter->pos++;
+    iter->index++;
+    iter->last_removed = false;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the last returned element by <code>cc_unrolled_list_iter_next()
+ * </code> function without invalidating the iterator and optionally sets the
+ * out parameter to the value of the removed element.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_unrolled_list_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[out] out pointer to where the removed element is stored, or NULL
+ *                 if it is to be ignored
+ *
+ * @return CC_OK if the element was successfully removed, or
+ * CC_ERR_VALUE_NOT_FOUND.
+ */
+enum cc_stat cc_unrolled_list_iter_remove(CC_UnrolledListIter *iter, void **out)
+{
+    if (iter->last_removed)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    UNode *node = iter->node;
+
+    if (out)
+        *out = node->data[iter->pos - 1];
+
+    remove_slot(iter->list, node, iter->pos - 1, (UNode**) &iter->node, &iter->pos);
+
+    iter->index--;
+    iter->last_removed = true;
+
+    return CC_OK;
+}
+
+/**
+ * Adds a new element to the CC_UnrolledList after the last returned element
+ * by <code>cc_unrolled_list_iter_next()</code> function without invalidating
+ * the iterator. The new element is not returned by the iterator.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_unrolled_list_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the element being added
+ *
+ * @return CC_OK if the element was successfully added, or CC_ERR_ALLOC if the
+ * memory allocation for the new node failed.
+ */
+enum cc_stat cc_unrolled_list_iter_add(CC_UnrolledListIter *iter, void *element)
+{
+    CC_UnrolledList *list = iter->list;
+
+    UNode  *node = iter->node;
+    size_t  pos  = iter->pos;
+
+    if (!node) {
+        node = list->tail;
+        pos  = node ? node->count : 0;
+    }
+
+    enum cc_stat status = insert_slot(list, node, pos, element, &node, &pos);
+
+    if (status == CC_OK) {
+        iter->node         = node;
+        iter->pos          = pos + 1;
+        iter->index++;
+        iter->last_removed = false;
+    }
+    return status;
+}
+
+/**
+ * Replaces the last returned element by <code>cc_unrolled_list_iter_next()
+ * </code> with the specified element and optionally sets the out parameter to
+ * the value of the replaced element.
+ *
+ * @note This function should only ever be called after a call to <code>
+ * cc_unrolled_list_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ * @param[in] element the replacement element
+ * @param[out] out pointer to where the replaced element is stored, or NULL
+ *                if it is to be ignored
+ *
+ * @return CC_OK if the element was replaced successfully, or
+ * CC_ERR_VALUE_NOT_FOUND.
+ */
+enum cc_stat cc_unrolled_list_iter_replace(CC_UnrolledListIter *iter, void *element, void **out)
+{
+    if (iter->last_removed)
+        return CC_ERR_VALUE_NOT_FOUND;
+
+    UNode *node = iter->node;
+
+    if (out)
+        *out = node->data[iter->pos - 1];
+
+    node->data[iter->pos - 1] = element;
+    return CC_OK;
+}
+
+/**
+ * Returns the index of the last returned element by <code>
+ * cc_unrolled_list_iter_next()</code>.
+ *
+ * @note
+ * This function should not be called before a call to <code>
+ * cc_unrolled_list_iter_next()</code>.
+ *
+ * @param[in] iter the iterator on which this operation is being performed
+ *
+ * @return the index.
+ */
+size_t cc_unrolled_list_iter_index(CC_UnrolledListIter *iter)
+{
+    return iter->index - 1;
+}
+
+size_t cc_unrolled_list_struct_size()
+{
+    return sizeof(CC_UnrolledList);
+}
+
+/**
+ * Allocates a new empty node.
+ *
+ * @param[in] list the list for which the node is allocated
+ *
+ * @return the new node, or NULL if the allocation failed.
+ */
+static UNode *node_new(CC_UnrolledList *list)
+{
+    UNode *node = list->mem_alloc(sizeof(UNode) + list->node_capacity * sizeof(void*));
+
+    if (!node)
+        return NULL;
+
+    node->next  = NULL;
+    node->prev  = NULL;
+    node->count = 0;
+
+    return node;
+}
+
+/**
+ * Links the node into the list right after the base node, or at the front
+ * of the list if the base is NULL.
+ *
+ * @param[in] list the list into which the node is being linked
+ * @param[in] base the node after which the new node is linked, or NULL
+ * @param[in] node the node that is being linked
+ */
+static void link_after(CC_UnrolledList *list, UNode *base, UNode *node)
+{
+    UNode *next = base ? base->next : list->head;
+
+    node->prev = base;
+    node->next = next;
+
+    if (base)
+        base->next = node;
+    else
+        list->head = node;
+
+    if (next)
+        next->prev = node;
+    else
+        list->tail = node;
+
+    list->nodes++;
+}
+
+/**
+ * Unlinks the node from the list and releases it. The elements that the
+ * node still holds are not accounted for.
+ *
+ * @param[in] list the list from which the node is being unlinked
+ * @param[in] node the node that is being unlinked
+ */
+static void unlink_node(CC_UnrolledList *list, UNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        list->head = node->next;
+
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        list->tail = node->prev;
+
+    list->nodes--;
+    list->mem_free(node);
+}
+
+/**
+ * Finds the node holding the element at the specified index by walking the
+ * nodes from whichever end of the list is closer. The index must be within
+ * the bounds of the list.
+ *
+ * @param[in] list the list that is being searched
+ * @param[in] index the index of the element
+ * @param[out] pos the position of the element within the returned node
+ *
+ * @return the node holding the element.
+ */
+static UNode *locate(CC_UnrolledList *list, size_t index, size_t *pos)
+{
+    UNode *node;
+
+    if (index < list->size / 2) {
+        node = list->head;
+        while (index >= node->count) {
+            index -= node->count;
+            node   = node->next;
+        }
+        *pos = index;
+    } else {
+        size_t r = list->size - 1 - index;
+
+        node = list->tail;
+        while (r >= node->count) {
+            r   -= node->count;
+            node = node->prev;
+        }
+        *pos = node->count - 1 - r;
+    }
+    return node;
+}
+
+/**
+ * Inserts the element at the position pos within the node, which may be
+ * equal to the node count. A full node is split in half, except when the
+ * element is appended to the tail node or prepended to the head node, in
+ * which case a new node is started so that lists that are built from either
+ * end keep their nodes full.
+ *
+ * @param[in] list the list into which the element is being inserted
+ * @param[in] node the node into which the element is inserted, or NULL if
+ *                 the list is empty
+ * @param[in] pos the position within the node
+ * @param[in] element the element that is being inserted
+ * @param[out] in_node where the node that ended up holding the element is
+ *                     stored, or NULL
+ * @param[out] in_pos where the position of the element within that node is
+ *                    stored, or NULL
+ *
+ * @return CC_OK if the element was inserted, or CC_ERR_ALLOC if the memory
+ * allocation for a new node failed.
+ */
+static enum cc_stat insert_slot(CC_UnrolledList *list, UNode *node, size_t pos, void *element,
+                                UNode **in_node, size_t *in_pos)
+{
+    size_t cap = list->node_capacity;
+
+    if (!node) {
+        node = node_new(list);
+        if (!node)
+            return CC_ERR_ALLOC;
+        link_after(list, NULL, node);
+        pos = 0;
+    } else if (node->count == cap) {
+        UNode *fresh = node_new(list);
+        if (!fresh)
+            return CC_ERR_ALLOC;
+
+        if (pos == cap && node == list->tail) {
+            link_after(list, node, fresh);
+            node = fresh;
+            pos  = 0;
+        } else if (pos == 0 && node == list->head) {
+            link_after(list, NULL, fresh);
+            node = fresh;
+        } else {
+            size_t half = cap / 2;
+
+            fresh->count = cap - half;
+            memcpy(fresh->data, &node->data[half], fresh->count * sizeof(void*));
+            node->count = half;
+            link_after(list, node, fresh);
+
+            if (pos > half) {
+                node = fresh;
+                pos -= half;
+            }
+        }
+    }
+
+    memmove(&node->data[pos + 1], &node->data[pos], (node->count - pos) * sizeof(void*));
+    node->data[pos] = element;
+    node->count++;
+    list->size++;
+
+    if (in_node) {
+        *in_node = node;
+        *in_pos  = pos;
+    }
+    return CC_OK;
+}
+
+/**
+ * Removes the element at the position pos within the node. A node that
+ * becomes empty is released, and a node that drops to a quarter of its
+ * capacity absorbs its successor (or is absorbed by its predecessor if it
+ * is the tail) when the elements of both fit into a single node.
+ *
+ * The optional it_node and it_pos parameters receive the location of the
+ * element that followed the removed one, which is what iterators need in
+ * order to remain valid across the node merges.
+ *
+ * @param[in] list the list from which the element is being removed
+ * @param[in] node the node holding the element
+ * @param[in] pos the position of the element within the node
+ * @param[out] it_node where the node of the following element is stored, or
+ *                     NULL
+ * @param[out] it_pos where the position of the following element is stored,
+ *                    or NULL
+ */
+static void remove_slot(CC_UnrolledList *list, UNode *node, size_t pos,
+                        UNode **it_node, size_t *it_pos)
+{
+    size_t cap = list->node_capacity;
+
+    memmove(&node->data[pos], &node->data[pos + 1], (node->count - pos - 1) * sizeof(void*));
+    node->count--;
+    list->size--;
+
+    UNode *next = node->next;
+    UNode *prev = node->prev;
+
+    if (node->count == 0) {
+        if (it_node) {
+            *it_node = next;
+            *it_pos  = 0;
+        }
+        unlink_node(list, node);
+        return;
+    }
+
+    if (it_node) {
+        *it_node = node;
+        *it_pos  = pos;
+    }
+
+    if (node->count > cap / 4)
+        return;
+
+    if (next && node->count + next->count <= cap) {
+        memcpy(&node->data[node->count], next->data, next->count * sizeof(void*));
+        node->count += next->count;
+        unlink_node(list, next);
+    } else if (!next && prev && prev->count + node->count <= cap) {
+        memcpy(&prev->data[prev->count], node->data, node->count * sizeof(void*));
+        if (it_node) {
+            *it_node = prev;
+            *it_pos  = prev->count + pos;
+        }
+        prev->count += node->count;
+        unlink_node(list, node);
+    }
+}
+
+/**
+ * Releases all the nodes of the list, optionally invoking the callback on
+ * every element first.
+ *
+ * @param[in] list the list whose nodes are being released
+ * @param[in] cb the destructor function invoked on each element, or NULL
+ */
+static void free_nodes(CC_UnrolledList *list, void (*cb) (void*))
+{
+    UNode  *node = list->head;
+    size_t  i;
+
+    while (node) {
+        UNode *next = node->next;
+
+        if (cb) {
+            for (i = 0; i < node->count; i++)
+                cb(node->data[i]);
+        }
+        list->mem_free(node);
+        node = next;
+    }
+    list->head  = NULL;
+    list->tail  = NULL;
+    list->size  = 0;
+    list->nodes = 0;
+}
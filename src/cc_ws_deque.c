@@ -0,0 +1,355 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "cc_ws_deque.h"
+
+#define DEFAULT_CAPACITY 64
+
+/*
+ * The circular storage of the deque. When the owner grows the deque,
+ * thieves may still be reading the old storage, so it is not freed but
+ * linked into a list of retired storages that is freed along with the
+ * deque. Since the capacity doubles each time, the retired storages take
+ * up less memory than the current one.
+ */
+struct ws_storage {
+    size_t               mask;
+    struct ws_storage   *retired;
+    _Atomic(void*)       slots[];
+};
+
+/*
+ * top is only advanced, by thieves and by the owner taking the last
+ * element, with a compare-and-swap. bottom is only written by the owner.
+ * They are signed because a pop temporarily moves bottom below top.
+ */
+struct cc_ws_deque_s {
+    _Atomic ptrdiff_t            top;
+    char                         top_pad[CC_CACHE_LINE_SIZE - sizeof(ptrdiff_t)];
+
+    _Atomic ptrdiff_t            bottom;
+    _Atomic(struct ws_storage*)  storage;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+};
+
+
+static struct ws_storage *storage_new  (CC_WSDeque *deque, size_t capacity);
+static struct ws_storage *storage_grow (CC_WSDeque *deque, struct ws_storage *old,
+                                        ptrdiff_t top, ptrdiff_t bottom);
+static size_t             upper_pow_two(size_t n);
+
+
+/**
+ * Initializes the fields of the CC_WSDequeConf struct to default values.
+ *
+ * @param[in, out] conf the configuration struct that is being initialized
+ */
+void cc_ws_deque_conf_init(CC_WSDequeConf *conf)
+{
+    conf->capacity   = DEFAULT_CAPACITY;
+    conf->mem_alloc  = malloc;
+    conf->mem_calloc = calloc;
+    conf->mem_free   = free;
+}
+
+/**
+ * Creates a new empty CC_WSDeque and returns a status code.
+ *
+ * @param[out] out pointer to where the newly created CC_WSDeque is to be stored
+ *
+ * @return CC_OK if the creation was successful, or CC_ERR_ALLOC if the
+ * memory allocation for the new CC_WSDeque structure failed.
+ */
+enum cc_stat cc_ws_deque_new(CC_WSDeque **out)
+{
+    CC_WSDequeConf conf;
+    cc_ws_deque_conf_init(&conf);
+    return cc_ws_deque_new_conf(&conf, out);
+}
+
+/**
+ * Creates a new empty CC_WSDeque based on the specified CC_WSDequeConf
+ * struct and returns a status code.
+ *
+ * @param[in] conf CC_WSDeque configuration struct. All fields must be
+ *                 initialized.
+ * @param[out] out pointer to where the newly created CC_WSDeque is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * the capacity is larger than the largest power of two, or CC_ERR_ALLOC if
+ * the memory allocation for the new CC_WSDeque structure failed.
+ */
+enum cc_stat cc_ws_deque_new_conf(CC_WSDequeConf const * const conf, CC_WSDeque **out)
+{
+    if (conf->capacity > MAX_POW_TWO)
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_WSDeque *deque = conf->mem_calloc(1, sizeof(CC_WSDeque));
+
+    if (!deque)
+        return CC_ERR_ALLOC;
+
+    deque->mem_alloc  = conf->mem_alloc;
+    deque->mem_calloc = conf->mem_calloc;
+    deque->mem_free   = conf->mem_free;
+
+    struct ws_storage *storage = storage_new(deque, upper_pow_two(conf->capacity));
+
+    if (!storage) {
+        conf->mem_free(deque);
+        return CC_ERR_ALLOC;
+    }
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->storage, storage);
+
+    *out = deque;
+    return CC_OK;
+}
+
+/**
+ * Destroys the deque and its storage, but leaves the data it holds
+ * intact. No thread may be using the deque.
+ *
+ * @param[in] deque the deque that is to be destroyed
+ */
+void cc_ws_deque_destroy(CC_WSDeque *deque)
+{
+    struct ws_storage *storage = atomic_load_explicit(&deque->storage, memory_order_relaxed);
+
+    while (storage) {
+        struct ws_storage *retired = storage->retired;
+        deque->mem_free(storage);
+        storage = retired;
+    }
+    deque->mem_free(deque);
+}
+
+/**
+ * Returns the size of the CC_WSDeque structure.
+ */
+size_t cc_ws_deque_struct_size()
+{
+    return sizeof(CC_WSDeque);
+}
+
+/**
+ * Pushes an element onto the bottom of the deque. May only be called by
+ * the owner thread.
+ *
+ * @param[in] deque the deque onto which the element is being pushed
+ * @param[in] element the element that is being pushed
+ *
+ * @return CC_OK if the element was pushed, or CC_ERR_ALLOC if the deque
+ * had to grow and the allocation failed.
+ */
+enum cc_stat cc_ws_deque_push(CC_WSDeque *deque, void *element)
+{
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    ptrdiff_t top    = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    struct ws_storage *storage = atomic_load_explicit(&deque->storage, memory_order_relaxed);
+
+    if ((size_t) (bottom - top) > storage->mask) {
+        storage = storage_grow(deque, storage, top, bottom);
+        if (!storage)
+            return CC_ERR_ALLOC;
+    }
+    atomic_store_explicit(&storage->slots[bottom & storage->mask], element, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return CC_OK;
+}
+
+/**
+ * Pops the element at the bottom of the deque, which is the element that
+ * was pushed last. May only be called by the owner thread.
+ *
+ * @param[in] deque the deque from which the element is being popped
+ * @param[out] out pointer to where the popped element is stored
+ *
+ * @return CC_OK if an element was popped, or CC_ERR_OUT_OF_RANGE if the
+ * deque is empty.
+ */
+enum cc_stat cc_ws_deque_pop(CC_WSDeque *deque, void **out)
+{
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    struct ws_storage *storage = atomic_load_explicit(&deque->storage, memory_order_relaxed);
+
+    /* Claim the bottom slot before looking at top, so that a concurrent
+     * thief either sees the claim or is seen by the owner. */
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return CC_ERR_OUT_OF_RANGE;
+    }
+
+    void *element = atomic_load_explicit(&storage->slots[bottom & storage->mask], memory_order_relaxed);
+
+    if (top == bottom) {
+        /* The last element; race the thieves for it */
+        bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                           memory_order_seq_cst,
+                                                           memory_order_relaxed);
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        if (!won)
+            return CC_ERR_OUT_OF_RANGE;
+    }
+    *out = element;
+    return CC_OK;
+}
+
+/**
+ * Steals the element at the top of the deque, which is the oldest element
+ * in it. May be called by any thread.
+ *
+ * @param[in] deque the deque from which the element is being stolen
+ * @param[out] out pointer to where the stolen element is stored
+ *
+ * @return CC_OK if an element was stolen, or CC_ERR_OUT_OF_RANGE if the
+ * deque is empty.
+ */
+enum cc_stat cc_ws_deque_steal(CC_WSDeque *deque, void **out)
+{
+    for (;;) {
+        ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+        if (top >= bottom)
+            return CC_ERR_OUT_OF_RANGE;
+
+        struct ws_storage *storage = atomic_load_explicit(&deque->storage, memory_order_acquire);
+        void *element = atomic_load_explicit(&storage->slots[top & storage->mask], memory_order_relaxed);
+
+        /* Losing the race means another thief or the owner took the
+         * element; try the next one. */
+        if (atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                    memory_order_seq_cst,
+                                                    memory_order_relaxed)) {
+            *out = element;
+            return CC_OK;
+        }
+    }
+}
+
+/**
+ * Returns the number of elements in the deque. While other threads are
+ * using the deque, the value is only an approximation.
+ */
+size_t cc_ws_deque_size(CC_WSDeque *deque)
+{
+    ptrdiff_t top    = atomic_load_explicit(&deque->top, memory_order_acquire);
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    return bottom > top ? (size_t) (bottom - top) : 0;
+}
+
+/**
+ * Returns the number of elements the deque can hold before it has to grow.
+ */
+size_t cc_ws_deque_capacity(CC_WSDeque *deque)
+{
+    return atomic_load_explicit(&deque->storage, memory_order_relaxed)->mask + 1;
+}
+
+/**
+ * Allocates a storage of the given power of two capacity.
+ */
+static struct ws_storage *storage_new(CC_WSDeque *deque, size_t capacity)
+{
+    if (capacity > (CC_MAX_ELEMENTS - sizeof(struct ws_storage)) / sizeof(void*))
+        return NULL;
+
+    struct ws_storage *storage =
+        deque->mem_alloc(sizeof(struct ws_storage) + capacity * sizeof(void*));
+
+    if (!storage)
+        return NULL;
+
+    storage->mask    = capacity - 1;
+    storage->retired = NULL;
+
+    return storage;
+}
+
+/**
+ * Replaces the storage with one twice its size holding the same elements
+ * at the same logical positions, and returns the new storage.
+ */
+static struct ws_storage *storage_grow(CC_WSDeque *deque, struct ws_storage *old,
+                                       ptrdiff_t top, ptrdiff_t bottom)
+{
+    size_t capacity = old->mask + 1;
+
+    if (capacity >= MAX_POW_TWO)
+        return NULL;
+
+    struct ws_storage *storage = storage_new(deque, capacity << 1);
+
+    if (!storage)
+        return NULL;
+
+    for (ptrdiff_t i = top; i < bottom; i++) {
+        void *e = atomic_load_explicit(&old->slots[i & old->mask], memory_order_relaxed);
+        atomic_store_explicit(&storage->slots[i & storage->mask], e, memory_order_relaxed);
+    }
+    storage->retired = old;
+    atomic_store_explicit(&deque->storage, storage, memory_order_release);
+
+    return storage;
+}
+
+/**
+ * Rounds the integer to the nearest upper power of two.
+ */
+static size_t upper_pow_two(size_t n)
+{
+    if (n >= MAX_POW_TWO)
+        return MAX_POW_TWO;
+
+    if (n == 0)
+        return 1;
+
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+#ifdef ARCH_64
+    n |= n >> 32;
+#endif
+    n++;
+
+    return n;
+}
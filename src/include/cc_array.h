@@ -35,6 +35,9 @@ extern "C" {
  */
 typedef struct cc_array_s CC_Array;
 
+struct cc_list_s;
+struct cc_slist_s;
+
 /**
  * Array configuration structure. Used to initialize a new Array
  * with specific values.
@@ -48,6 +51,12 @@ typedef struct cc_array_conf_s {
      * The rate at which the buffer expands (capacity * exp_factor). */
     float  exp_factor;
 
+    /**
+     * The number of elements stored inline, in the same allocation as
+     * the Array structure. If set, it replaces the initial capacity and
+     * the buffer only moves to the heap once it is exceeded. */
+    size_t inline_capacity;
+
     /**
      * Memory allocators used to allocate the Array structure and the
      * underlying data buffers. */
@@ -92,17 +101,31 @@ typedef struct array_zip_iter_s {
 
 enum cc_stat  cc_array_new             (CC_Array **out);
 enum cc_stat  cc_array_new_conf        (CC_ArrayConf const * const conf, CC_Array **out);
+enum cc_stat  cc_array_from_buffer     (void **buffer, size_t size, size_t capacity, CC_Array **out);
+enum cc_stat  cc_array_from_buffer_conf(CC_ArrayConf const * const conf, void **buffer, size_t size, size_t capacity, CC_Array **out);
+enum cc_stat  cc_array_from_list       (struct cc_list_s *list, CC_Array **out);
+enum cc_stat  cc_array_from_list_conf  (CC_ArrayConf const * const conf, struct cc_list_s *list, CC_Array **out);
+enum cc_stat  cc_array_from_slist      (struct cc_slist_s *list, CC_Array **out);
+enum cc_stat  cc_array_from_slist_conf (CC_ArrayConf const * const conf, struct cc_slist_s *list, CC_Array **out);
 void          cc_array_conf_init       (CC_ArrayConf *conf);
 size_t        cc_array_struct_size     ();
 
 void          cc_array_destroy         (CC_Array *ar);
 void          cc_array_destroy_cb      (CC_Array *ar, void (*cb) (void*));
+enum cc_stat  cc_array_release_buffer  (CC_Array *ar, void ***out, size_t *size, size_t *capacity);
 
 enum cc_stat  cc_array_add             (CC_Array *ar, void *element);
 enum cc_stat  cc_array_add_at          (CC_Array *ar, void *element, size_t index);
 enum cc_stat  cc_array_replace_at      (CC_Array *ar, void *element, size_t index, void **out);
 enum cc_stat  cc_array_swap_at         (CC_Array *ar, size_t index1, size_t index2);
 
+enum cc_stat  cc_array_add_all         (CC_Array *ar, CC_Array *src);
+enum cc_stat  cc_array_add_range       (CC_Array *ar, CC_Array *src, size_t from, size_t to);
+enum cc_stat  cc_array_append_buffer   (CC_Array *ar, void * const *elements, size_t n);
+enum cc_stat  cc_array_insert_range    (CC_Array *ar, size_t index, void * const *elements, size_t n);
+enum cc_stat  cc_array_remove_range    (CC_Array *ar, size_t from, size_t to, void **out);
+enum cc_stat  cc_array_reserve         (CC_Array *ar, size_t capacity);
+
 enum cc_stat  cc_array_remove          (CC_Array *ar, void *element, void **out);
 enum cc_stat  cc_array_remove_at       (CC_Array *ar, size_t index, void **out);
 enum cc_stat  cc_array_remove_last     (CC_Array *ar, void **out);
@@ -0,0 +1,121 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_BLOCK_DEQUE_H
+#define COLLECTIONS_C_BLOCK_DEQUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A deque made out of fixed size blocks that are tracked by a map of block
+ * pointers. Adding an element at either end never moves the existing
+ * elements, so the cost of an insertion stays bounded regardless of the
+ * size of the deque, and element addresses remain stable for as long as
+ * the element is in the deque. Blocks are released one by one as the
+ * deque drains. Supports constant time insertion and removal at both ends
+ * and constant time access.
+ */
+typedef struct cc_block_deque_s CC_BlockDeque;
+
+/**
+ * CC_BlockDeque configuration structure. Used to initialize a new
+ * CC_BlockDeque with specific values.
+ */
+typedef struct cc_block_deque_conf_s {
+    /**
+     * The number of elements in a block. Must be a power of two; if a
+     * non power of two is passed, it will be rounded to the closest
+     * upper power of two */
+    size_t block_size;
+
+    /**
+     * Memory allocators used to allocate the CC_BlockDeque structure, the
+     * block map and the blocks. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_BlockDequeConf;
+
+/**
+ * CC_BlockDeque iterator structure. Used to iterate over the elements of
+ * the deque from the first to the last element.
+ */
+typedef struct cc_block_deque_iter_s {
+    /**
+     * The deque associated with this iterator */
+    CC_BlockDeque *deque;
+
+    /**
+     * The current position of the iterator. */
+    size_t index;
+} CC_BlockDequeIter;
+
+
+enum cc_stat  cc_block_deque_new             (CC_BlockDeque **out);
+enum cc_stat  cc_block_deque_new_conf        (CC_BlockDequeConf const * const conf, CC_BlockDeque **out);
+void          cc_block_deque_conf_init       (CC_BlockDequeConf *conf);
+size_t        cc_block_deque_struct_size     ();
+
+void          cc_block_deque_destroy         (CC_BlockDeque *deque);
+void          cc_block_deque_destroy_cb      (CC_BlockDeque *deque, void (*cb) (void*));
+
+enum cc_stat  cc_block_deque_add_first       (CC_BlockDeque *deque, void *element);
+enum cc_stat  cc_block_deque_add_last        (CC_BlockDeque *deque, void *element);
+enum cc_stat  cc_block_deque_replace_at      (CC_BlockDeque *deque, void *element, size_t index, void **out);
+
+enum cc_stat  cc_block_deque_remove_first    (CC_BlockDeque *deque, void **out);
+enum cc_stat  cc_block_deque_remove_last     (CC_BlockDeque *deque, void **out);
+void          cc_block_deque_remove_all      (CC_BlockDeque *deque);
+
+enum cc_stat  cc_block_deque_get_at          (CC_BlockDeque const * const deque, size_t index, void **out);
+enum cc_stat  cc_block_deque_get_first       (CC_BlockDeque const * const deque, void **out);
+enum cc_stat  cc_block_deque_get_last        (CC_BlockDeque const * const deque, void **out);
+enum cc_stat  cc_block_deque_peek            (CC_BlockDeque *deque, size_t index, void ***out);
+
+enum cc_stat  cc_block_deque_trim_capacity   (CC_BlockDeque *deque);
+
+size_t        cc_block_deque_size            (CC_BlockDeque const * const deque);
+size_t        cc_block_deque_capacity        (CC_BlockDeque const * const deque);
+
+void          cc_block_deque_foreach         (CC_BlockDeque *deque, void (*fn) (void*));
+
+void          cc_block_deque_iter_init       (CC_BlockDequeIter *iter, CC_BlockDeque *deque);
+enum cc_stat  cc_block_deque_iter_next       (CC_BlockDequeIter *iter, void **out);
+enum cc_stat  cc_block_deque_iter_replace    (CC_BlockDequeIter *iter, void *element, void **out);
+
+
+#define CC_BLOCK_DEQUE_FOREACH(val, deque, body)                        \
+    {                                                                   \
+        CC_BlockDequeIter cc_block_deque_iter_3e9a51c07d24b86f;         \
+        cc_block_deque_iter_init(&cc_block_deque_iter_3e9a51c07d24b86f, deque); \
+        void *val;                                                      \
+        while (cc_block_deque_iter_next(&cc_block_deque_iter_3e9a51c07d24b86f, &val) != CC_ITER_END) \
+            body                                                        \
+                }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_BLOCK_DEQUE_H */
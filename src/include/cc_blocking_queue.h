@@ -0,0 +1,88 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_BLOCKING_QUEUE_H
+#define COLLECTIONS_C_BLOCKING_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A thread safe FIFO queue whose poll operation waits for an element
+ * and, if the queue is bounded, whose enqueue operation waits for free
+ * room. Waiting threads are parked on a futex (WaitOnAddress on Windows)
+ * and are only woken when there is something for them to do. Threads
+ * never make a system call while the queue has elements for them and
+ * nobody is waiting.
+ *
+ * A closed queue accepts no new elements, but the elements that are
+ * already in it can still be polled.
+ */
+typedef struct cc_blocking_queue_s CC_BlockingQueue;
+
+/**
+ * CC_BlockingQueue configuration structure. Used to initialize a new
+ * queue with specific values.
+ */
+typedef struct cc_blocking_queue_conf_s {
+    /**
+     * The maximum number of elements the queue can hold. Enqueuing into
+     * a full queue waits until an element is polled. 0 makes the queue
+     * unbounded. */
+    size_t capacity;
+
+    /**
+     * Memory allocators used to allocate the queue structure and its
+     * storage. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_BlockingQueueConf;
+
+
+void          cc_blocking_queue_conf_init     (CC_BlockingQueueConf *conf);
+enum cc_stat  cc_blocking_queue_new           (CC_BlockingQueue **out);
+enum cc_stat  cc_blocking_queue_new_conf      (CC_BlockingQueueConf const * const conf, CC_BlockingQueue **out);
+void          cc_blocking_queue_destroy       (CC_BlockingQueue *queue);
+void          cc_blocking_queue_destroy_cb    (CC_BlockingQueue *queue, void (*cb) (void*));
+size_t        cc_blocking_queue_struct_size   ();
+
+enum cc_stat  cc_blocking_queue_enqueue       (CC_BlockingQueue *queue, void *element);
+enum cc_stat  cc_blocking_queue_try_enqueue   (CC_BlockingQueue *queue, void *element);
+enum cc_stat  cc_blocking_queue_enqueue_timed (CC_BlockingQueue *queue, void *element, uint64_t timeout_ms);
+
+enum cc_stat  cc_blocking_queue_poll          (CC_BlockingQueue *queue, void **out);
+enum cc_stat  cc_blocking_queue_try_poll      (CC_BlockingQueue *queue, void **out);
+enum cc_stat  cc_blocking_queue_poll_timed    (CC_BlockingQueue *queue, void **out, uint64_t timeout_ms);
+size_t        cc_blocking_queue_drain         (CC_BlockingQueue *queue, void **out, size_t n);
+
+void          cc_blocking_queue_close         (CC_BlockingQueue *queue);
+bool          cc_blocking_queue_is_closed     (CC_BlockingQueue *queue);
+size_t        cc_blocking_queue_size          (CC_BlockingQueue *queue);
+size_t        cc_blocking_queue_capacity      (CC_BlockingQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_BLOCKING_QUEUE_H */
@@ -0,0 +1,84 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_BYTE_RING_BUFFER_H
+#define COLLECTIONS_C_BYTE_RING_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A ring buffer of bytes whose storage is mapped twice, back to back, in
+ * virtual memory. Bytes written past the end of the first mapping land
+ * at the start of the buffer, so every readable and every writable
+ * region is contiguous, even when it wraps around. Producers can fill
+ * the buffer in place and consumers can parse directly out of it,
+ * without copying.
+ *
+ * One producer thread and one consumer thread may use the buffer
+ * concurrently without external locking.
+ */
+typedef struct cc_byte_rbuf_s CC_ByteRbuf;
+
+/**
+ * CC_ByteRbuf configuration structure. Used to initialize a new buffer
+ * with specific values.
+ */
+typedef struct cc_byte_rbuf_conf_s {
+    /**
+     * Capacity of the buffer in bytes. It is rounded up to a power of two
+     * that is a multiple of the system's page (or allocation) size. */
+    size_t capacity;
+
+    /**
+     * Memory allocators used to allocate the CC_ByteRbuf structure. The
+     * storage itself is always mapped directly from the system. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_ByteRbufConf;
+
+
+void          cc_byte_rbuf_conf_init     (CC_ByteRbufConf *conf);
+enum cc_stat  cc_byte_rbuf_new           (CC_ByteRbuf **out);
+enum cc_stat  cc_byte_rbuf_new_conf      (CC_ByteRbufConf const * const conf, CC_ByteRbuf **out);
+void          cc_byte_rbuf_destroy       (CC_ByteRbuf *rbuf);
+size_t        cc_byte_rbuf_struct_size   ();
+
+enum cc_stat  cc_byte_rbuf_reserve       (CC_ByteRbuf *rbuf, size_t n, void **out);
+enum cc_stat  cc_byte_rbuf_commit        (CC_ByteRbuf *rbuf, size_t n);
+size_t        cc_byte_rbuf_peek          (CC_ByteRbuf *rbuf, void **out);
+enum cc_stat  cc_byte_rbuf_consume       (CC_ByteRbuf *rbuf, size_t n);
+
+size_t        cc_byte_rbuf_write         (CC_ByteRbuf *rbuf, const void *data, size_t n);
+size_t        cc_byte_rbuf_read          (CC_ByteRbuf *rbuf, void *out, size_t n);
+
+size_t        cc_byte_rbuf_size          (CC_ByteRbuf *rbuf);
+size_t        cc_byte_rbuf_free_space    (CC_ByteRbuf *rbuf);
+size_t        cc_byte_rbuf_capacity      (CC_ByteRbuf *rbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_BYTE_RING_BUFFER_H */
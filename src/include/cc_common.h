@@ -49,10 +49,19 @@ enum cc_stat {
     CC_ERR_OUT_OF_RANGE     = 8,
 
     CC_ITER_END             = 9,
+
+    CC_ERR_TIMEOUT          = 10,
+    CC_ERR_CLOSED           = 11,
+    CC_ERR_DUPLICATE        = 12,
 };
 
 #define CC_MAX_ELEMENTS ((size_t) - 2)
 
+/**
+ * Assumed size of a cache line. Fields written by different threads are
+ * kept at least this far apart to avoid false sharing. */
+#define CC_CACHE_LINE_SIZE 64
+
 #if defined(_MSC_VER)
 
 #define       INLINE __inline
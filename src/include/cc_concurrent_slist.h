@@ -0,0 +1,115 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_CONCURRENT_SLIST_H
+#define COLLECTIONS_C_CONCURRENT_SLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A lock-free ordered singly linked list that holds every element at most
+ * once (a Harris-Michael list). Any number of threads can add, remove,
+ * look up and iterate over elements concurrently. Removal first marks the
+ * node as deleted and then unlinks it, and threads that come across a
+ * marked node help to unlink it.
+ *
+ * Unlinked nodes are reclaimed with epochs: every operation announces
+ * itself in the current epoch, and a node is only freed once every
+ * operation that could still have been holding it has finished. A thread
+ * that stalls inside an operation delays the reclamation of nodes but
+ * never blocks other threads.
+ */
+typedef struct cc_concurrent_slist_s CC_ConcurrentSList;
+
+/**
+ * CC_ConcurrentSList configuration structure. Used to initialize a new
+ * list with specific values.
+ */
+typedef struct cc_concurrent_slist_conf_s {
+    /**
+     * The comparator that orders the elements. It is passed the elements
+     * themselves and must be thread safe. */
+    int (*cmp) (const void *e1, const void *e2);
+
+    /**
+     * Memory allocators used to allocate the list structure and its
+     * nodes. They are called concurrently and must be thread safe. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_ConcurrentSListConf;
+
+/**
+ * CC_ConcurrentSList iterator structure. Used to iterate over the elements
+ * of the list in ascending order. The iteration is weakly consistent: it
+ * returns every element that is in the list for the whole iteration, and
+ * may or may not return the elements that are added or removed meanwhile.
+ *
+ * An iterator delays the reclamation of removed nodes for as long as it
+ * is active, so an iteration that is abandoned before reaching the end
+ * must be finished with <code>cc_concurrent_slist_iter_done()</code>.
+ */
+typedef struct cc_concurrent_slist_iter_s {
+    /**
+     * The list associated with this iterator */
+    CC_ConcurrentSList *list;
+
+    /**
+     * The node whose successor is returned next */
+    void *node;
+
+    /**
+     * The epoch in which the iterator is active */
+    unsigned epoch;
+
+    /**
+     * Set once the iterator is no longer active */
+    bool done;
+} CC_ConcurrentSListIter;
+
+
+void          cc_concurrent_slist_conf_init     (CC_ConcurrentSListConf *conf);
+enum cc_stat  cc_concurrent_slist_new           (int (*cmp) (const void*, const void*), CC_ConcurrentSList **out);
+enum cc_stat  cc_concurrent_slist_new_conf      (CC_ConcurrentSListConf const * const conf, CC_ConcurrentSList **out);
+void          cc_concurrent_slist_destroy       (CC_ConcurrentSList *list);
+void          cc_concurrent_slist_destroy_cb    (CC_ConcurrentSList *list, void (*cb) (void*));
+size_t        cc_concurrent_slist_struct_size   ();
+
+enum cc_stat  cc_concurrent_slist_add           (CC_ConcurrentSList *list, void *element);
+enum cc_stat  cc_concurrent_slist_remove        (CC_ConcurrentSList *list, void *element, void **out);
+bool          cc_concurrent_slist_contains      (CC_ConcurrentSList *list, void *element);
+enum cc_stat  cc_concurrent_slist_get           (CC_ConcurrentSList *list, void *element, void **out);
+size_t        cc_concurrent_slist_size          (CC_ConcurrentSList *list);
+
+void          cc_concurrent_slist_foreach       (CC_ConcurrentSList *list, void (*op) (void*));
+
+void          cc_concurrent_slist_iter_init     (CC_ConcurrentSListIter *iter, CC_ConcurrentSList *list);
+enum cc_stat  cc_concurrent_slist_iter_next     (CC_ConcurrentSListIter *iter, void **out);
+void          cc_concurrent_slist_iter_done     (CC_ConcurrentSListIter *iter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_CONCURRENT_SLIST_H */
@@ -0,0 +1,78 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_CONCURRENT_STACK_H
+#define COLLECTIONS_C_CONCURRENT_STACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A lock-free LIFO stack that any number of threads can push to and pop
+ * from concurrently (a Treiber stack). Nodes are referenced through
+ * 32 bit indices tagged with a 32 bit version number, which protects
+ * the compare-and-swap operations from the ABA problem without double
+ * width atomics. Nodes are recycled through an internal free list and
+ * only returned to the allocator when the stack is destroyed.
+ *
+ * Under high contention pushes and pops that fail their compare-and-swap
+ * can optionally meet in an elimination array, where a push hands its
+ * element directly to a pop without touching the top of the stack.
+ */
+typedef struct cc_concurrent_stack_s CC_ConcurrentStack;
+
+/**
+ * CC_ConcurrentStack configuration structure. Used to initialize a new
+ * stack with specific values.
+ */
+typedef struct cc_concurrent_stack_conf_s {
+    /**
+     * Number of slots in the elimination array. 0 disables elimination,
+     * which is best unless many threads use the stack at the same time. */
+    size_t elimination_slots;
+
+    /**
+     * Memory allocators used to allocate the stack structure and its
+     * nodes. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_ConcurrentStackConf;
+
+
+void          cc_concurrent_stack_conf_init     (CC_ConcurrentStackConf *conf);
+enum cc_stat  cc_concurrent_stack_new           (CC_ConcurrentStack **out);
+enum cc_stat  cc_concurrent_stack_new_conf      (CC_ConcurrentStackConf const * const conf, CC_ConcurrentStack **out);
+void          cc_concurrent_stack_destroy       (CC_ConcurrentStack *stack);
+size_t        cc_concurrent_stack_struct_size   ();
+
+enum cc_stat  cc_concurrent_stack_push          (CC_ConcurrentStack *stack, void *element);
+enum cc_stat  cc_concurrent_stack_push_n        (CC_ConcurrentStack *stack, void * const *elements, size_t n);
+enum cc_stat  cc_concurrent_stack_pop           (CC_ConcurrentStack *stack, void **out);
+bool          cc_concurrent_stack_is_empty      (CC_ConcurrentStack *stack);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_CONCURRENT_STACK_H */
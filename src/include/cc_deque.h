@@ -33,6 +33,9 @@ extern "C" {
  */
 typedef struct cc_deque_s CC_Deque;
 
+struct cc_list_s;
+struct cc_slist_s;
+
 /**
  * CC_Deque configuration structure. Used to initialize a new CC_Deque
  * with specific values.
@@ -86,15 +89,24 @@ typedef struct cc_deque_zip_iter_s {
 
 enum cc_stat  cc_deque_new             (CC_Deque **deque);
 enum cc_stat  cc_deque_new_conf        (CC_DequeConf const * const conf, CC_Deque **deque);
+enum cc_stat  cc_deque_from_buffer     (void **buffer, size_t size, size_t capacity, CC_Deque **out);
+enum cc_stat  cc_deque_from_buffer_conf(CC_DequeConf const * const conf, void **buffer, size_t size, size_t capacity, CC_Deque **out);
+enum cc_stat  cc_deque_from_list       (struct cc_list_s *list, CC_Deque **out);
+enum cc_stat  cc_deque_from_list_conf  (CC_DequeConf const * const conf, struct cc_list_s *list, CC_Deque **out);
+enum cc_stat  cc_deque_from_slist      (struct cc_slist_s *list, CC_Deque **out);
+enum cc_stat  cc_deque_from_slist_conf (CC_DequeConf const * const conf, struct cc_slist_s *list, CC_Deque **out);
 void          cc_deque_conf_init       (CC_DequeConf *conf);
 size_t        cc_deque_struct_size     ();
 
 void          cc_deque_destroy         (CC_Deque *deque);
 void          cc_deque_destroy_cb      (CC_Deque *deque, void (*cb) (void*));
+void          cc_deque_release_buffer  (CC_Deque *deque, void ***out, size_t *size, size_t *capacity);
 
 enum cc_stat  cc_deque_add             (CC_Deque *deque, void *element);
 enum cc_stat  cc_deque_add_first       (CC_Deque *deque, void *element);
 enum cc_stat  cc_deque_add_last        (CC_Deque *deque, void *element);
+enum cc_stat  cc_deque_add_all         (CC_Deque *deque, void * const *elements, size_t n);
+enum cc_stat  cc_deque_add_all_first   (CC_Deque *deque, void * const *elements, size_t n);
 enum cc_stat  cc_deque_add_at          (CC_Deque *deque, void *element, size_t index);
 enum cc_stat  cc_deque_replace_at      (CC_Deque *deque, void *element, size_t index, void **out);
 
@@ -102,6 +114,9 @@ enum cc_stat  cc_deque_remove          (CC_Deque *deque, void *element, void **o
 enum cc_stat  cc_deque_remove_at       (CC_Deque *deque, size_t index, void **out);
 enum cc_stat  cc_deque_remove_first    (CC_Deque *deque, void **out);
 enum cc_stat  cc_deque_remove_last     (CC_Deque *deque, void **out);
+size_t        cc_deque_remove_first_n  (CC_Deque *deque, void **out, size_t n);
+size_t        cc_deque_remove_last_n   (CC_Deque *deque, void **out, size_t n);
+enum cc_stat  cc_deque_drain_to_array  (CC_Deque *deque, void ***out);
 void          cc_deque_remove_all      (CC_Deque *deque);
 void          cc_deque_remove_all_cb   (CC_Deque *deque, void (*cb) (void*));
 
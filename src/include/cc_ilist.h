@@ -0,0 +1,156 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_ILIST_H
+#define COLLECTIONS_C_ILIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * An intrusive doubly linked list. Instead of allocating a node for every
+ * element, the list links the elements through a CC_IListLink that is
+ * embedded in the element itself. The list is configured with the offset
+ * of the link within the element, so the elements are still passed to and
+ * returned from the list as plain pointers to the user objects. An object
+ * can be on as many lists at the same time as it has links.
+ *
+ * Since the links live in the elements, adding and removing elements never
+ * allocates, and removing a known element takes constant time.
+ */
+typedef struct cc_ilist_s CC_IList;
+
+/**
+ * The link that is embedded in the elements of a CC_IList. A link must be
+ * zero initialized before the element is first added to a list, and is
+ * reset to zero whenever the element is removed from the list.
+ */
+typedef struct cc_ilist_link_s {
+    struct cc_ilist_link_s *next;
+    struct cc_ilist_link_s *prev;
+} CC_IListLink;
+
+/**
+ * IList configuration structure. Used to initialize a new IList with
+ * specific values.
+ */
+typedef struct cc_ilist_conf_s {
+    /**
+     * Offset of the CC_IListLink within the elements, as returned by
+     * <code>offsetof()</code>. */
+    size_t link_offset;
+
+    /**
+     * Memory allocators used to allocate the IList structure. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_IListConf;
+
+/**
+ * IList iterator structure. Used to iterate over the elements of the list
+ * in an ascending order. The iterator also supports operations for safely
+ * adding and removing elements during iteration.
+ */
+typedef struct cc_ilist_iter_s {
+    /**
+     * The list associated with this iterator */
+    CC_IList *list;
+
+    /**
+     * The link of the last returned element, or NULL if there is none. */
+    CC_IListLink *last;
+
+    /**
+     * The link of the element that is returned next. */
+    CC_IListLink *next;
+
+    /**
+     * The index of the element that is returned next. */
+    size_t index;
+} CC_IListIter;
+
+
+enum cc_stat  cc_ilist_new            (size_t link_offset, CC_IList **out);
+enum cc_stat  cc_ilist_new_conf       (CC_IListConf const * const conf, CC_IList **out);
+void          cc_ilist_conf_init      (CC_IListConf *conf);
+size_t        cc_ilist_struct_size    ();
+
+void          cc_ilist_destroy        (CC_IList *list);
+void          cc_ilist_destroy_cb     (CC_IList *list, void (*cb) (void*));
+
+enum cc_stat  cc_ilist_add            (CC_IList *list, void *element);
+enum cc_stat  cc_ilist_add_first      (CC_IList *list, void *element);
+enum cc_stat  cc_ilist_add_last       (CC_IList *list, void *element);
+enum cc_stat  cc_ilist_add_at         (CC_IList *list, void *element, size_t index);
+enum cc_stat  cc_ilist_add_after      (CC_IList *list, void *base, void *element);
+enum cc_stat  cc_ilist_add_before     (CC_IList *list, void *base, void *element);
+
+enum cc_stat  cc_ilist_splice         (CC_IList *list1, CC_IList *list2);
+enum cc_stat  cc_ilist_splice_at      (CC_IList *list1, CC_IList *list2, size_t index);
+
+enum cc_stat  cc_ilist_remove         (CC_IList *list, void *element);
+enum cc_stat  cc_ilist_remove_first   (CC_IList *list, void **out);
+enum cc_stat  cc_ilist_remove_last    (CC_IList *list, void **out);
+enum cc_stat  cc_ilist_remove_at      (CC_IList *list, size_t index, void **out);
+enum cc_stat  cc_ilist_remove_all     (CC_IList *list);
+enum cc_stat  cc_ilist_remove_all_cb  (CC_IList *list, void (*cb) (void*));
+
+enum cc_stat  cc_ilist_get_first      (CC_IList *list, void **out);
+enum cc_stat  cc_ilist_get_last       (CC_IList *list, void **out);
+enum cc_stat  cc_ilist_get_at         (CC_IList *list, size_t index, void **out);
+enum cc_stat  cc_ilist_get_next       (CC_IList *list, void *element, void **out);
+enum cc_stat  cc_ilist_get_prev       (CC_IList *list, void *element, void **out);
+
+bool          cc_ilist_is_linked      (CC_IList *list, void *element);
+size_t        cc_ilist_contains       (CC_IList *list, void *element);
+enum cc_stat  cc_ilist_index_of       (CC_IList *list, void *element, size_t *index);
+size_t        cc_ilist_size           (CC_IList *list);
+
+void          cc_ilist_reverse        (CC_IList *list);
+void          cc_ilist_foreach        (CC_IList *list, void (*op) (void *));
+enum cc_stat  cc_ilist_filter_mut     (CC_IList *list, bool (*pred) (const void*));
+enum cc_stat  cc_ilist_filter_mut_cb  (CC_IList *list, bool (*pred) (const void*), void (*cb) (void*));
+
+void          cc_ilist_iter_init      (CC_IListIter *iter, CC_IList *list);
+enum cc_stat  cc_ilist_iter_next      (CC_IListIter *iter, void **out);
+enum cc_stat  cc_ilist_iter_remove    (CC_IListIter *iter, void **out);
+enum cc_stat  cc_ilist_iter_add       (CC_IListIter *iter, void *element);
+enum cc_stat  cc_ilist_iter_replace   (CC_IListIter *iter, void *element, void **out);
+size_t        cc_ilist_iter_index     (CC_IListIter *iter);
+
+
+#define CC_ILIST_FOREACH(val, ilist, body)                              \
+    {                                                                   \
+        CC_IListIter cc_ilist_iter_2b8d4e61f07a93c5;                    \
+        cc_ilist_iter_init(&cc_ilist_iter_2b8d4e61f07a93c5, ilist);     \
+        void *val;                                                      \
+        while (cc_ilist_iter_next(&cc_ilist_iter_2b8d4e61f07a93c5, &val) != CC_ITER_END) \
+            body                                                        \
+                }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_ILIST_H */
@@ -0,0 +1,155 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_ISLIST_H
+#define COLLECTIONS_C_ISLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * An intrusive singly linked list. The elements are linked through a
+ * CC_ISListLink that is embedded in the element itself, at an offset that
+ * the list is configured with, so adding and removing elements never
+ * allocates. Compared to CC_IList the link is half the size, at the cost
+ * of linear time removal of arbitrary elements.
+ */
+typedef struct cc_islist_s CC_ISList;
+
+/**
+ * The link that is embedded in the elements of a CC_ISList.
+ */
+typedef struct cc_islist_link_s {
+    struct cc_islist_link_s *next;
+} CC_ISListLink;
+
+/**
+ * ISList configuration structure. Used to initialize a new ISList with
+ * specific values.
+ */
+typedef struct cc_islist_conf_s {
+    /**
+     * Offset of the CC_ISListLink within the elements, as returned by
+     * <code>offsetof()</code>. */
+    size_t link_offset;
+
+    /**
+     * Memory allocators used to allocate the ISList structure. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_ISListConf;
+
+/**
+ * ISList iterator structure. Used to iterate over the elements of the list
+ * in an ascending order. The iterator also supports operations for safely
+ * adding and removing elements during iteration.
+ */
+typedef struct cc_islist_iter_s {
+    /**
+     * The list associated with this iterator */
+    CC_ISList *list;
+
+    /**
+     * The link of the last returned element, or NULL if there is none. */
+    CC_ISListLink *last;
+
+    /**
+     * The link that precedes the last returned element. */
+    CC_ISListLink *last_prev;
+
+    /**
+     * The link that precedes the element that is returned next. */
+    CC_ISListLink *prev;
+
+    /**
+     * The link of the element that is returned next. */
+    CC_ISListLink *next;
+
+    /**
+     * The index of the element that is returned next. */
+    size_t index;
+} CC_ISListIter;
+
+
+enum cc_stat  cc_islist_new            (size_t link_offset, CC_ISList **out);
+enum cc_stat  cc_islist_new_conf       (CC_ISListConf const * const conf, CC_ISList **out);
+void          cc_islist_conf_init      (CC_ISListConf *conf);
+size_t        cc_islist_struct_size    ();
+
+void          cc_islist_destroy        (CC_ISList *list);
+void          cc_islist_destroy_cb     (CC_ISList *list, void (*cb) (void*));
+
+enum cc_stat  cc_islist_add            (CC_ISList *list, void *element);
+enum cc_stat  cc_islist_add_first      (CC_ISList *list, void *element);
+enum cc_stat  cc_islist_add_last       (CC_ISList *list, void *element);
+enum cc_stat  cc_islist_add_at         (CC_ISList *list, void *element, size_t index);
+enum cc_stat  cc_islist_add_after      (CC_ISList *list, void *base, void *element);
+
+enum cc_stat  cc_islist_splice         (CC_ISList *list1, CC_ISList *list2);
+enum cc_stat  cc_islist_splice_at      (CC_ISList *list1, CC_ISList *list2, size_t index);
+
+enum cc_stat  cc_islist_remove         (CC_ISList *list, void *element);
+enum cc_stat  cc_islist_remove_first   (CC_ISList *list, void **out);
+enum cc_stat  cc_islist_remove_last    (CC_ISList *list, void **out);
+enum cc_stat  cc_islist_remove_at      (CC_ISList *list, size_t index, void **out);
+enum cc_stat  cc_islist_remove_all     (CC_ISList *list);
+enum cc_stat  cc_islist_remove_all_cb  (CC_ISList *list, void (*cb) (void*));
+
+enum cc_stat  cc_islist_get_first      (CC_ISList *list, void **out);
+enum cc_stat  cc_islist_get_last       (CC_ISList *list, void **out);
+enum cc_stat  cc_islist_get_at         (CC_ISList *list, size_t index, void **out);
+enum cc_stat  cc_islist_get_next       (CC_ISList *list, void *element, void **out);
+
+bool          cc_islist_is_linked      (CC_ISList *list, void *element);
+size_t        cc_islist_contains       (CC_ISList *list, void *element);
+enum cc_stat  cc_islist_index_of       (CC_ISList *list, void *element, size_t *index);
+size_t        cc_islist_size           (CC_ISList *list);
+
+void          cc_islist_reverse        (CC_ISList *list);
+void          cc_islist_foreach        (CC_ISList *list, void (*op) (void *));
+enum cc_stat  cc_islist_filter_mut     (CC_ISList *list, bool (*pred) (const void*));
+enum cc_stat  cc_islist_filter_mut_cb  (CC_ISList *list, bool (*pred) (const void*), void (*cb) (void*));
+
+void          cc_islist_iter_init      (CC_ISListIter *iter, CC_ISList *list);
+enum cc_stat  cc_islist_iter_next      (CC_ISListIter *iter, void **out);
+enum cc_stat  cc_islist_iter_remove    (CC_ISListIter *iter, void **out);
+enum cc_stat  cc_islist_iter_add       (CC_ISListIter *iter, void *element);
+enum cc_stat  cc_islist_iter_replace   (CC_ISListIter *iter, void *element, void **out);
+size_t        cc_islist_iter_index     (CC_ISListIter *iter);
+
+
+#define CC_ISLIST_FOREACH(val, islist, body)                            \
+    {                                                                   \
+        CC_ISListIter cc_islist_iter_7e05c9a3d41b826f;                  \
+        cc_islist_iter_init(&cc_islist_iter_7e05c9a3d41b826f, islist);  \
+        void *val;                                                      \
+        while (cc_islist_iter_next(&cc_islist_iter_7e05c9a3d41b826f, &val) != CC_ITER_END) \
+            body                                                        \
+                }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_ISLIST_H */
@@ -31,10 +31,12 @@ extern "C" {
  * A doubly linked list. CC_List is a sequential structure that
  * supports insertion, deletion and lookup from both ends in
  * constant time, while the worst case is O(n/2) at the middle
- * of the list.
+ * of the list, or O(log n) if the list is indexed.
  */
 typedef struct cc_list_s CC_List;
 
+struct cc_dynamic_pool_s;
+
 /**
  * CC_List node.
  *
@@ -91,6 +93,23 @@ typedef struct cc_list_zip_iter_s {
  * values.
  */
 typedef struct cc_list_conf_s {
+    /**
+     * Number of nodes that the list allocates at once and recycles through
+     * its own free list. Removed nodes are reused by later insertions and
+     * only released when the list is destroyed. If 0, every node is
+     * allocated and freed individually. */
+    size_t pool_chunk_size;
+
+    /**
+     * If true, the list maintains a rank index over its nodes that makes
+     * positional operations such as get_at, add_at, remove_at and
+     * splice_at O(log n) instead of O(n), at the cost of an extra
+     * allocation per node. */
+    bool indexed;
+
+    /**
+     * Memory allocators used to allocate the CC_List structure, its nodes,
+     * the node chunks and the rank index. */
     void  *(*mem_alloc)  (size_t size);
     void  *(*mem_calloc) (size_t blocks, size_t size);
     void   (*mem_free)   (void *block);
@@ -129,6 +148,7 @@ enum cc_stat  cc_list_get_last        (CC_List *list, void **out);
 enum cc_stat  cc_list_sublist         (CC_List *list, size_t from, size_t to, CC_List **out);
 enum cc_stat  cc_list_copy_shallow    (CC_List *list, CC_List **out);
 enum cc_stat  cc_list_copy_deep       (CC_List *list, void *(*cp) (void*), CC_List **out);
+enum cc_stat  cc_list_compact         (CC_List *list, struct cc_dynamic_pool_s *pool);
 
 enum cc_stat  cc_list_replace_at      (CC_List *list, void *element, size_t index, void **out);
 
@@ -140,6 +160,7 @@ enum cc_stat  cc_list_to_array        (CC_List *list, void ***out);
 void          cc_list_reverse         (CC_List *list);
 enum cc_stat  cc_list_sort            (CC_List *list, int (*cmp) (void const*, void const*));
 void          cc_list_sort_in_place   (CC_List *list, int (*cmp) (void const*, void const*));
+enum cc_stat  cc_list_sort_in_place_parallel (CC_List *list, int (*cmp) (void const*, void const*), size_t threads, size_t cutoff);
 size_t        cc_list_size            (CC_List *list);
 
 void          cc_list_foreach         (CC_List *list, void (*op) (void *));
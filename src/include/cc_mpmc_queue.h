@@ -0,0 +1,81 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_MPMC_QUEUE_H
+#define COLLECTIONS_C_MPMC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+#define DEFAULT_CC_MPMC_QUEUE_CAPACITY 1024
+
+/**
+ * A bounded FIFO queue that any number of threads can enqueue to and
+ * dequeue from concurrently. The queue is lock-free. Every slot holds a
+ * sequence number that tells the producers when the slot is free and
+ * tells the consumers when it holds an element, so each operation
+ * needs just one compare-and-swap on the shared position.
+ */
+typedef struct cc_mpmc_queue_s CC_MPMCQueue;
+
+/**
+ * CC_MPMCQueue configuration structure. Used to initialize a new queue
+ * with specific values.
+ */
+typedef struct cc_mpmc_queue_conf_s {
+    /**
+     * The maximum number of elements the queue can hold. Must be a power
+     * of two; if a non power of two is passed, it will be rounded to the
+     * closest upper power of two. */
+    size_t capacity;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_MPMCQueueConf;
+
+
+void          cc_mpmc_queue_conf_init       (CC_MPMCQueueConf *conf);
+enum cc_stat  cc_mpmc_queue_new             (CC_MPMCQueue **out);
+enum cc_stat  cc_mpmc_queue_new_conf        (CC_MPMCQueueConf const * const conf, CC_MPMCQueue **out);
+void          cc_mpmc_queue_destroy         (CC_MPMCQueue *queue);
+size_t        cc_mpmc_queue_struct_size     ();
+
+enum cc_stat  cc_mpmc_queue_try_enqueue     (CC_MPMCQueue *queue, void *element);
+enum cc_stat  cc_mpmc_queue_try_dequeue     (CC_MPMCQueue *queue, void **out);
+void          cc_mpmc_queue_enqueue         (CC_MPMCQueue *queue, void *element);
+void          cc_mpmc_queue_dequeue         (CC_MPMCQueue *queue, void **out);
+
+size_t        cc_mpmc_queue_try_enqueue_n   (CC_MPMCQueue *queue, void * const *elements, size_t n);
+size_t        cc_mpmc_queue_try_dequeue_n   (CC_MPMCQueue *queue, void **out, size_t n);
+void          cc_mpmc_queue_enqueue_n       (CC_MPMCQueue *queue, void * const *elements, size_t n);
+void          cc_mpmc_queue_dequeue_n       (CC_MPMCQueue *queue, void **out, size_t n);
+
+size_t        cc_mpmc_queue_size            (CC_MPMCQueue *queue);
+size_t        cc_mpmc_queue_capacity        (CC_MPMCQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_MPMC_QUEUE_H */
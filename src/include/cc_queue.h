@@ -68,6 +68,9 @@ size_t       cc_queue_struct_size     ();
 enum cc_stat cc_queue_peek            (CC_Queue const * const queue, void **out);
 enum cc_stat cc_queue_poll            (CC_Queue *queue, void **out);
 enum cc_stat cc_queue_enqueue         (CC_Queue *queue, void *element);
+enum cc_stat cc_queue_enqueue_all     (CC_Queue *queue, void * const *elements, size_t n);
+size_t       cc_queue_poll_n          (CC_Queue *queue, void **out, size_t n);
+enum cc_stat cc_queue_drain_to_array  (CC_Queue *queue, void ***out);
 
 size_t       cc_queue_size            (CC_Queue const * const queue);
 void         cc_queue_foreach         (CC_Queue *queue, void (*op) (void*));
@@ -17,20 +17,80 @@ extern "C" {
 
 #define DEFAULT_CC_RBUF_CAPACITY 10
 
-typedef struct ring_buffer_conf CC_RbufConf;
 typedef struct ring_buffer CC_Rbuf;
 
+/**
+ * Ring buffer configuration structure. Used to initialize a new ring
+ * buffer with specific values.
+ */
+typedef struct ring_buffer_conf {
+    /**
+     * The number of items the buffer can hold. */
+    size_t capacity;
+
+    /**
+     * Size of a single item in bytes. Defaults to sizeof(uint64_t).
+     * Buffers with a different item size are accessed through
+     * cc_rbuf_enqueue_n and cc_rbuf_dequeue_n, since the single item
+     * functions pass the items as uint64_t and reject such buffers
+     * with CC_ERR_INVALID_RANGE. */
+    size_t element_size;
+
+    /**
+     * If true (the default), enqueuing into a full buffer overwrites
+     * the oldest items. If false, the enqueue fails instead and reports
+     * that the buffer is full. */
+    bool overwrite;
+
+    /**
+     * If true, the buffer is created in the single producer, single
+     * consumer mode. In this mode one thread may enqueue while another
+     * thread dequeues without any external locking. The capacity is
+     * rounded up to the closest power of two and, since the producer
+     * may not touch the read position, the buffer never overwrites
+     * items regardless of the overwrite flag. */
+    bool spsc;
+
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_RbufConf;
+
+/**
+ * A contiguous run of items inside the ring buffer. A region of the
+ * buffer that wraps around its end is described by two spans.
+ */
+typedef struct ring_buffer_span {
+    /**
+     * Address of the first item of the span. */
+    void *data;
+
+    /**
+     * Number of items in the span. */
+    size_t count;
+} CC_RbufSpan;
+
 enum cc_stat  cc_rbuf_new           (CC_Rbuf **rbuf);
 void          cc_rbuf_conf_init     (CC_RbufConf *rconf);
 enum cc_stat  cc_rbuf_conf_new      (CC_RbufConf *rconf, CC_Rbuf **rbuf);
 size_t        cc_rbuf_struct_size   ();
 
-void          cc_rbuf_enqueue       (CC_Rbuf *rbuf, uint64_t item);
+enum cc_stat  cc_rbuf_enqueue       (CC_Rbuf *rbuf, uint64_t item);
 enum cc_stat  cc_rbuf_dequeue       (CC_Rbuf *rbuf, uint64_t *out);
+size_t        cc_rbuf_enqueue_n     (CC_Rbuf *rbuf, const void *items, size_t n);
+size_t        cc_rbuf_dequeue_n     (CC_Rbuf *rbuf, void *out, size_t n);
 bool          cc_rbuf_is_empty      (CC_Rbuf *rbuf);
 size_t        cc_rbuf_size          (CC_Rbuf *rbuf);
+size_t        cc_rbuf_capacity      (CC_Rbuf *rbuf);
+size_t        cc_rbuf_element_size  (CC_Rbuf *rbuf);
 void          cc_rbuf_destroy       (CC_Rbuf *rbuf);
 uint64_t      cc_rbuf_peek          (CC_Rbuf *rbuf, int index);
+enum cc_stat  cc_rbuf_peek_at       (CC_Rbuf *rbuf, size_t offset, void **out);
+
+enum cc_stat  cc_rbuf_reserve       (CC_Rbuf *rbuf, size_t n, CC_RbufSpan *first, CC_RbufSpan *second);
+enum cc_stat  cc_rbuf_commit        (CC_Rbuf *rbuf, size_t n);
+size_t        cc_rbuf_read_span     (CC_Rbuf *rbuf, CC_RbufSpan *first, CC_RbufSpan *second);
+enum cc_stat  cc_rbuf_release       (CC_Rbuf *rbuf, size_t n);
 
 #ifdef __cplusplus
 }
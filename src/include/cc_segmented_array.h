@@ -0,0 +1,130 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_SEGMENTED_ARRAY_H
+#define COLLECTIONS_C_SEGMENTED_ARRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A dynamic array made out of segments whose capacities grow
+ * geometrically. Growing the array allocates a new segment instead
+ * of moving the existing elements, so the address of every element
+ * slot remains stable for as long as the element is in the array.
+ * The array supports constant time access and constant time insertion
+ * and removal at the end of the array.
+ */
+typedef struct cc_segmented_array_s CC_SegmentedArray;
+
+/**
+ * SegmentedArray configuration structure. Used to initialize a new
+ * SegmentedArray with specific values.
+ */
+typedef struct cc_segmented_array_conf_s {
+    /**
+     * The capacity of the first segment. Every following segment is
+     * twice the size of the previous one. Must be a power of two; if
+     * a non power of two is passed, it will be rounded to the closest
+     * upper power of two */
+    size_t segment_capacity;
+
+    /**
+     * Memory allocators used to allocate the SegmentedArray structure
+     * and the segments. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_SegmentedArrayConf;
+
+/**
+ * SegmentedArray iterator structure. Used to iterate over the elements
+ * of the array in an ascending order. The iterator also supports
+ * operations for safely adding and removing elements during iteration.
+ */
+typedef struct cc_segmented_array_iter_s {
+    /**
+     * The array associated with this iterator */
+    CC_SegmentedArray *ar;
+
+    /**
+     * The current position of the iterator.*/
+    size_t index;
+
+    /**
+     * Set to true if the last returned element was removed. */
+    bool last_removed;
+} CC_SegmentedArrayIter;
+
+
+enum cc_stat  cc_segmented_array_new             (CC_SegmentedArray **out);
+enum cc_stat  cc_segmented_array_new_conf        (CC_SegmentedArrayConf const * const conf, CC_SegmentedArray **out);
+void          cc_segmented_array_conf_init       (CC_SegmentedArrayConf *conf);
+size_t        cc_segmented_array_struct_size     ();
+
+void          cc_segmented_array_destroy         (CC_SegmentedArray *ar);
+void          cc_segmented_array_destroy_cb      (CC_SegmentedArray *ar, void (*cb) (void*));
+
+enum cc_stat  cc_segmented_array_add             (CC_SegmentedArray *ar, void *element);
+enum cc_stat  cc_segmented_array_add_at          (CC_SegmentedArray *ar, void *element, size_t index);
+enum cc_stat  cc_segmented_array_replace_at      (CC_SegmentedArray *ar, void *element, size_t index, void **out);
+
+enum cc_stat  cc_segmented_array_remove_at       (CC_SegmentedArray *ar, size_t index, void **out);
+enum cc_stat  cc_segmented_array_remove_last     (CC_SegmentedArray *ar, void **out);
+void          cc_segmented_array_remove_all      (CC_SegmentedArray *ar);
+
+enum cc_stat  cc_segmented_array_get_at          (CC_SegmentedArray *ar, size_t index, void **out);
+enum cc_stat  cc_segmented_array_get_last        (CC_SegmentedArray *ar, void **out);
+enum cc_stat  cc_segmented_array_peek            (CC_SegmentedArray *ar, size_t index, void ***out);
+
+enum cc_stat  cc_segmented_array_trim_capacity   (CC_SegmentedArray *ar);
+
+size_t        cc_segmented_array_contains        (CC_SegmentedArray *ar, void *element);
+size_t        cc_segmented_array_size            (CC_SegmentedArray *ar);
+size_t        cc_segmented_array_capacity        (CC_SegmentedArray *ar);
+enum cc_stat  cc_segmented_array_index_of        (CC_SegmentedArray *ar, void *element, size_t *index);
+
+void          cc_segmented_array_map             (CC_SegmentedArray *ar, void (*fn) (void*));
+
+void          cc_segmented_array_iter_init       (CC_SegmentedArrayIter *iter, CC_SegmentedArray *ar);
+enum cc_stat  cc_segmented_array_iter_next       (CC_SegmentedArrayIter *iter, void **out);
+enum cc_stat  cc_segmented_array_iter_remove     (CC_SegmentedArrayIter *iter, void **out);
+enum cc_stat  cc_segmented_array_iter_add        (CC_SegmentedArrayIter *iter, void *element);
+enum cc_stat  cc_segmented_array_iter_replace    (CC_SegmentedArrayIter *iter, void *element, void **out);
+size_t        cc_segmented_array_iter_index      (CC_SegmentedArrayIter *iter);
+
+
+#define CC_SEGMENTED_ARRAY_FOREACH(val, array, body)                    \
+    {                                                                   \
+        CC_SegmentedArrayIter cc_segmented_array_iter_8c1f0a47e2b6d953; \
+        cc_segmented_array_iter_init(&cc_segmented_array_iter_8c1f0a47e2b6d953, array); \
+        void *val;                                                      \
+        while (cc_segmented_array_iter_next(&cc_segmented_array_iter_8c1f0a47e2b6d953, &val) != CC_ITER_END) \
+            body                                                        \
+                }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_SEGMENTED_ARRAY_H */
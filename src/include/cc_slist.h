@@ -35,6 +35,8 @@ extern "C" {
  */
 typedef struct cc_slist_s CC_SList;
 
+struct cc_dynamic_pool_s;
+
 /**
  * CC_SList node.
  *
@@ -82,6 +84,16 @@ typedef struct cc_slist_zip_iter_s {
  * specific values.
  */
 typedef struct cc_slist_conf_s {
+    /**
+     * Number of nodes that the list allocates at once and recycles through
+     * its own free list. Removed nodes are reused by later insertions and
+     * only released when the list is destroyed. If 0, every node is
+     * allocated and freed individually. */
+    size_t pool_chunk_size;
+
+    /**
+     * Memory allocators used to allocate the CC_SList structure, its nodes
+     * and the node chunks. */
     void  *(*mem_alloc)  (size_t size);
     void  *(*mem_calloc) (size_t blocks, size_t size);
     void   (*mem_free)   (void *block);
@@ -120,6 +132,7 @@ enum cc_stat  cc_slist_get_last        (CC_SList *list, void **out);
 enum cc_stat  cc_slist_sublist         (CC_SList *list, size_t from, size_t to, CC_SList **out);
 enum cc_stat  cc_slist_copy_shallow    (CC_SList *list, CC_SList **out);
 enum cc_stat  cc_slist_copy_deep       (CC_SList *list, void *(*cp) (void*), CC_SList **out);
+enum cc_stat  cc_slist_compact         (CC_SList *list, struct cc_dynamic_pool_s *pool);
 
 enum cc_stat  cc_slist_replace_at      (CC_SList *list, void *element, size_t index, void **out);
 
@@ -130,6 +143,7 @@ enum cc_stat  cc_slist_to_array        (CC_SList *list, void ***out);
 
 void          cc_slist_reverse         (CC_SList *list);
 enum cc_stat  cc_slist_sort            (CC_SList *list, int (*cmp) (void const*, void const*));
+void          cc_slist_sort_in_place   (CC_SList *list, int (*cmp) (void const*, void const*));
 size_t        cc_slist_size            (CC_SList *list);
 
 void          cc_slist_foreach         (CC_SList *list, void (*op) (void *));
@@ -69,8 +69,11 @@ void          cc_stack_destroy_cb      (CC_Stack *stack, void (*cb) (void*));
 size_t        cc_stack_struct_size     ();
 
 enum cc_stat  cc_stack_push            (CC_Stack *stack, void *element);
+enum cc_stat  cc_stack_push_all        (CC_Stack *stack, void * const *elements, size_t n);
 enum cc_stat  cc_stack_peek            (CC_Stack *stack, void **out);
 enum cc_stat  cc_stack_pop             (CC_Stack *stack, void **out);
+size_t        cc_stack_pop_n           (CC_Stack *stack, void **out, size_t n);
+enum cc_stat  cc_stack_drain_to_array  (CC_Stack *stack, void ***out);
 
 size_t        cc_stack_size            (CC_Stack *stack);
 void          cc_stack_map             (CC_Stack *stack, void (*fn) (void *));
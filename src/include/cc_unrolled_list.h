@@ -0,0 +1,145 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_UNROLLED_LIST_H
+#define COLLECTIONS_C_UNROLLED_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A doubly linked list whose nodes each hold a small array of elements
+ * instead of a single one. Sequential traversal touches one node per
+ * <code>node_capacity</code> elements, which makes it considerably more
+ * cache friendly than CC_List, while insertion and removal at an iterator
+ * position remain cheap since they only ever shift elements within a
+ * single node. Full nodes are split in half on insertion and sparse nodes
+ * are merged with their neighbour on removal.
+ */
+typedef struct cc_unrolled_list_s CC_UnrolledList;
+
+/**
+ * UnrolledList configuration structure. Used to initialize a new
+ * UnrolledList with specific values.
+ */
+typedef struct cc_unrolled_list_conf_s {
+    /**
+     * The maximum number of elements stored in a single node. Must be
+     * at least 2. */
+    size_t node_capacity;
+
+    /**
+     * Memory allocators used to allocate the UnrolledList structure
+     * and its nodes. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_UnrolledListConf;
+
+/**
+ * UnrolledList iterator structure. Used to iterate over the elements
+ * of the list in an ascending order. The iterator also supports
+ * operations for safely adding and removing elements during iteration.
+ */
+typedef struct cc_unrolled_list_iter_s {
+    /**
+     * The list associated with this iterator */
+    CC_UnrolledList *list;
+
+    /**
+     * The node and the position within that node of the element that
+     * is returned by the next call to <code>cc_unrolled_list_iter_next()
+     * </code>. */
+    void   *node;
+    size_t  pos;
+
+    /**
+     * The index of the element that is returned next. */
+    size_t index;
+
+    /**
+     * Set to true if there is no last returned element, either because
+     * the iteration hasn't started yet or because it was removed. */
+    bool last_removed;
+} CC_UnrolledListIter;
+
+
+enum cc_stat  cc_unrolled_list_new             (CC_UnrolledList **out);
+enum cc_stat  cc_unrolled_list_new_conf        (CC_UnrolledListConf const * const conf, CC_UnrolledList **out);
+void          cc_unrolled_list_conf_init       (CC_UnrolledListConf *conf);
+size_t        cc_unrolled_list_struct_size     ();
+
+void          cc_unrolled_list_destroy         (CC_UnrolledList *list);
+void          cc_unrolled_list_destroy_cb      (CC_UnrolledList *list, void (*cb) (void*));
+
+enum cc_stat  cc_unrolled_list_add             (CC_UnrolledList *list, void *element);
+enum cc_stat  cc_unrolled_list_add_first       (CC_UnrolledList *list, void *element);
+enum cc_stat  cc_unrolled_list_add_last        (CC_UnrolledList *list, void *element);
+enum cc_stat  cc_unrolled_list_add_at          (CC_UnrolledList *list, void *element, size_t index);
+enum cc_stat  cc_unrolled_list_replace_at      (CC_UnrolledList *list, void *element, size_t index, void **out);
+
+enum cc_stat  cc_unrolled_list_splice          (CC_UnrolledList *list1, CC_UnrolledList *list2);
+enum cc_stat  cc_unrolled_list_splice_at       (CC_UnrolledList *list1, CC_UnrolledList *list2, size_t index);
+
+enum cc_stat  cc_unrolled_list_remove          (CC_UnrolledList *list, void *element, void **out);
+enum cc_stat  cc_unrolled_list_remove_first    (CC_UnrolledList *list, void **out);
+enum cc_stat  cc_unrolled_list_remove_last     (CC_UnrolledList *list, void **out);
+enum cc_stat  cc_unrolled_list_remove_at       (CC_UnrolledList *list, size_t index, void **out);
+void          cc_unrolled_list_remove_all      (CC_UnrolledList *list);
+void          cc_unrolled_list_remove_all_cb   (CC_UnrolledList *list, void (*cb) (void*));
+
+enum cc_stat  cc_unrolled_list_get_at          (CC_UnrolledList *list, size_t index, void **out);
+enum cc_stat  cc_unrolled_list_get_first       (CC_UnrolledList *list, void **out);
+enum cc_stat  cc_unrolled_list_get_last        (CC_UnrolledList *list, void **out);
+
+size_t        cc_unrolled_list_contains        (CC_UnrolledList *list, void *element);
+enum cc_stat  cc_unrolled_list_index_of        (CC_UnrolledList *list, void *element, int (*cmp) (const void*, const void*), size_t *index);
+enum cc_stat  cc_unrolled_list_to_array        (CC_UnrolledList *list, void ***out);
+
+size_t        cc_unrolled_list_size            (CC_UnrolledList *list);
+size_t        cc_unrolled_list_node_count      (CC_UnrolledList *list);
+
+void          cc_unrolled_list_foreach         (CC_UnrolledList *list, void (*op) (void *));
+
+void          cc_unrolled_list_iter_init       (CC_UnrolledListIter *iter, CC_UnrolledList *list);
+enum cc_stat  cc_unrolled_list_iter_next       (CC_UnrolledListIter *iter, void **out);
+enum cc_stat  cc_unrolled_list_iter_remove     (CC_UnrolledListIter *iter, void **out);
+enum cc_stat  cc_unrolled_list_iter_add        (CC_UnrolledListIter *iter, void *element);
+enum cc_stat  cc_unrolled_list_iter_replace    (CC_UnrolledListIter *iter, void *element, void **out);
+size_t        cc_unrolled_list_iter_index      (CC_UnrolledListIter *iter);
+
+
+#define CC_UNROLLED_LIST_FOREACH(val, list, body)                       \
+    {                                                                   \
+        CC_UnrolledListIter cc_unrolled_list_iter_5d07b2e9a41c63f8;     \
+        cc_unrolled_list_iter_init(&cc_unrolled_list_iter_5d07b2e9a41c63f8, list); \
+        void *val;                                                      \
+        while (cc_unrolled_list_iter_next(&cc_unrolled_list_iter_5d07b2e9a41c63f8, &val) != CC_ITER_END) \
+            body                                                        \
+                }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_UNROLLED_LIST_H */
@@ -0,0 +1,79 @@
+/*
+ * Collections-C
+ * Copyright (C) 2013-2024 Srđan Panić <srdja.panic@gmail.com>
+ *
+ * This file is part of Collections-C.
+ *
+ * Collections-C is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Collections-C is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Collections-C.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLLECTIONS_C_WS_DEQUE_H
+#define COLLECTIONS_C_WS_DEQUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cc_common.h"
+
+/**
+ * A work-stealing deque (Chase-Lev). The thread that owns the deque
+ * pushes and pops elements at the bottom without locking, while any
+ * number of other threads may steal elements from the top. Owner
+ * operations only synchronize with thieves when the deque holds a
+ * single element. The storage is circular and grows as needed.
+ *
+ * cc_ws_deque_push and cc_ws_deque_pop may only be called by the
+ * owner thread; cc_ws_deque_steal may be called by any thread.
+ */
+typedef struct cc_ws_deque_s CC_WSDeque;
+
+/**
+ * CC_WSDeque configuration structure. Used to initialize a new deque
+ * with specific values.
+ */
+typedef struct cc_ws_deque_conf_s {
+    /**
+     * The initial capacity of the deque. Must be a power of two; if a
+     * non power of two is passed, it will be rounded to the closest
+     * upper power of two. */
+    size_t capacity;
+
+    /**
+     * Memory allocators used to allocate the deque structure and its
+     * storage. */
+    void *(*mem_alloc)  (size_t size);
+    void *(*mem_calloc) (size_t blocks, size_t size);
+    void  (*mem_free)   (void *block);
+} CC_WSDequeConf;
+
+
+void          cc_ws_deque_conf_init     (CC_WSDequeConf *conf);
+enum cc_stat  cc_ws_deque_new           (CC_WSDeque **out);
+enum cc_stat  cc_ws_deque_new_conf      (CC_WSDequeConf const * const conf, CC_WSDeque **out);
+void          cc_ws_deque_destroy       (CC_WSDeque *deque);
+size_t        cc_ws_deque_struct_size   ();
+
+enum cc_stat  cc_ws_deque_push          (CC_WSDeque *deque, void *element);
+enum cc_stat  cc_ws_deque_pop           (CC_WSDeque *deque, void **out);
+enum cc_stat  cc_ws_deque_steal         (CC_WSDeque *deque, void **out);
+
+size_t        cc_ws_deque_size          (CC_WSDeque *deque);
+size_t        cc_ws_deque_capacity      (CC_WSDeque *deque);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLLECTIONS_C_WS_DEQUE_H */
@@ -48,6 +48,19 @@ typedef struct cc_array_sized_conf_s {
      * The rate at which the buffer expands (capacity * exp_factor). */
     float  exp_factor;
 
+    /**
+     * The number of elements stored inline, in the same allocation as
+     * the ArraySized structure. If set, it replaces the initial capacity
+     * and the buffer only moves to the heap once it is exceeded. */
+    size_t inline_capacity;
+
+    /**
+     * The maximum number of elements for which address space is reserved
+     * up front. If set, the buffer is never moved: pages are committed as
+     * the array grows, so element addresses remain stable. The array
+     * cannot grow past this number of elements. */
+    size_t reserved_capacity;
+
     /**
      * Memory allocators used to allocate the Array structure and the
      * underlying data buffers. */
@@ -103,6 +116,13 @@ enum cc_stat  cc_array_sized_add_at          (CC_ArraySized *ar, uint8_t *elemen
 enum cc_stat  cc_array_sized_replace_at      (CC_ArraySized *ar, uint8_t *element, size_t index, uint8_t *out);
 enum cc_stat  cc_array_sized_swap_at         (CC_ArraySized *ar, size_t index1, size_t index2);
 
+enum cc_stat  cc_array_sized_add_all         (CC_ArraySized *ar, CC_ArraySized *src);
+enum cc_stat  cc_array_sized_add_range       (CC_ArraySized *ar, CC_ArraySized *src, size_t from, size_t to);
+enum cc_stat  cc_array_sized_append_buffer   (CC_ArraySized *ar, const uint8_t *elements, size_t n);
+enum cc_stat  cc_array_sized_insert_range    (CC_ArraySized *ar, size_t index, const uint8_t *elements, size_t n);
+enum cc_stat  cc_array_sized_remove_range    (CC_ArraySized *ar, size_t from, size_t to, uint8_t *out);
+enum cc_stat  cc_array_sized_reserve         (CC_ArraySized *ar, size_t capacity);
+
 enum cc_stat  cc_array_sized_remove          (CC_ArraySized *ar, uint8_t *element);
 enum cc_stat  cc_array_sized_remove_at       (CC_ArraySized *ar, size_t index, uint8_t *out);
 enum cc_stat  cc_array_sized_remove_last     (CC_ArraySized *ar, uint8_t *out);
@@ -126,6 +146,14 @@ size_t        cc_array_sized_capacity        (CC_ArraySized *ar);
 enum cc_stat  cc_array_sized_index_of        (CC_ArraySized *ar, uint8_t *element, size_t *index);
 void          cc_array_sized_sort            (CC_ArraySized* ar, int (*cmp) (const void*, const void*));
 
+size_t        cc_array_sized_lower_bound     (CC_ArraySized *ar, const uint8_t *element, int (*cmp) (const void*, const void*));
+size_t        cc_array_sized_upper_bound     (CC_ArraySized *ar, const uint8_t *element, int (*cmp) (const void*, const void*));
+enum cc_stat  cc_array_sized_equal_range     (CC_ArraySized *ar, const uint8_t *element, int (*cmp) (const void*, const void*), size_t *from, size_t *to);
+enum cc_stat  cc_array_sized_add_sorted      (CC_ArraySized *ar, uint8_t *element, int (*cmp) (const void*, const void*));
+enum cc_stat  cc_array_sized_add_all_sorted  (CC_ArraySized *ar, const uint8_t *elements, size_t n, int (*cmp) (const void*, const void*));
+enum cc_stat  cc_array_sized_merge           (CC_ArraySized *ar1, CC_ArraySized *ar2, int (*cmp) (const void*, const void*), CC_ArraySized **out);
+enum cc_stat  cc_array_sized_intersect       (CC_ArraySized *ar1, CC_ArraySized *ar2, int (*cmp) (const void*, const void*), CC_ArraySized **out);
+
 void          cc_array_sized_map             (CC_ArraySized* ar, void (*fn) (uint8_t*));
 void          cc_array_sized_reduce          (CC_ArraySized *ar, void (*fn) (uint8_t*, uint8_t*, uint8_t*), uint8_t *result);
 
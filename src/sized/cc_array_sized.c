@@ -21,6 +21,15 @@
 
 #include "sized/cc_array_sized.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#define CC_VM_AVAILABLE
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CC_VM_AVAILABLE
+#endif
+
 #define DEFAULT_CAPACITY 8
 #define DEFAULT_EXPANSION_FACTOR 2
 
@@ -35,12 +44,34 @@ struct cc_array_sized_s {
     float    exp_factor;
     uint8_t *buffer;
 
+    /* Storage allocated along with the structure, or NULL */
+    uint8_t *inline_buffer;
+    size_t   inline_capacity;
+
+    /* Reserved address space in elements and the number of bytes of it
+     * that are currently committed, or zero if the buffer is allocated
+     * with mem_alloc */
+    size_t   reserved_capacity;
+    size_t   committed_bytes;
+
     void *(*mem_alloc)  (size_t size);
     void *(*mem_calloc) (size_t blocks, size_t size);
     void  (*mem_free)   (void *block);
 };
 
 static enum cc_stat expand_capacity(CC_ArraySized *ar);
+static enum cc_stat expand_capacity_to(CC_ArraySized *ar, size_t min_capacity);
+static enum cc_stat expand_reserved(CC_ArraySized *ar, size_t min_capacity);
+static void         free_buffer    (CC_ArraySized *ar);
+static enum cc_stat new_like       (CC_ArraySized *ar, size_t capacity, CC_ArraySized **out);
+static size_t       search_bound   (CC_ArraySized *ar, const uint8_t *element,
+                                    int (*cmp) (const void*, const void*), bool upper);
+
+static size_t       vm_page_size   (void);
+static uint8_t*     vm_reserve     (size_t bytes);
+static bool         vm_commit      (uint8_t *addr, size_t bytes);
+static void         vm_decommit    (uint8_t *addr, size_t bytes);
+static void         vm_release     (uint8_t *addr, size_t bytes);
 
 
 /**
@@ -59,6 +90,32 @@ enum cc_stat cc_array_sized_new(size_t element_size, CC_ArraySized **out)
     return cc_array_sized_new_conf(element_size, &c, out);
 }
 
+/**
+ * Creates a new empty array that reserves address space for
+ * <code>n_reserved</code> elements up front. The buffer is never moved
+ * as the array grows, so pointers returned by <code>cc_array_sized_peek()
+ * </code> remain valid for the lifetime of the elements.
+ *
+ * @param[in] element_size size of the array element in bytes
+ * @param[in] n_reserved the maximum number of elements the array can hold
+ * @param[out] out pointer to where the newly created CC_ArraySized is to be stored
+ *
+ * @return CC_OK if the creation was successful, CC_ERR_INVALID_CAPACITY if
+ * n_reserved is zero, or CC_ERR_ALLOC if the address space could not be
+ * reserved.
+ */
+enum cc_stat cc_array_sized_new_reserved(size_t element_size, size_t n_reserved, CC_ArraySized **out)
+{
+    if (!n_reserved)
+        return CC_ERR_INVALID_CAPACITY;
+
+    CC_ArraySizedConf c;
+    cc_array_sized_conf_init(&c);
+    c.reserved_capacity = n_reserved;
+
+    return cc_array_sized_new_conf(element_size, &c, out);
+}
+
 /**
  * Creates a new empty CC_ArraySized based on the specified CC_ArraySizedConf struct 
  * and returns a status code.
@@ -68,6 +125,15 @@ enum cc_stat cc_array_sized_new(size_t element_size, CC_ArraySized **out)
  * fail if the values of exp_factor and capacity in the CC_ArraySizedConf do not meet
  * the following condition: <code>exp_factor < (CC_MAX_ELEMENTS / capacity)</code>.
  *
+ * If <code>inline_capacity</code> is set, the structure and the first
+ * <code>inline_capacity</code> elements are allocated as a single block, so
+ * small arrays cost a single allocation. The buffer is moved to the heap
+ * once the inline storage is exhausted.
+ *
+ * If <code>reserved_capacity</code> is set, address space for that many
+ * elements is reserved instead and pages are committed as the array grows.
+ * This mode cannot be combined with inline storage.
+ *
  * @param[in] element_size the size of the data being stored in bytes
  * @param[in] conf array configuration structure
  * @param[out] out pointer to where the newly created CC_ArraySized is to be stored
@@ -90,27 +156,75 @@ enum cc_stat cc_array_sized_new_conf(
     else
         ex = conf->exp_factor;
 
+    size_t inline_cap = conf->inline_capacity;
+    size_t capacity   = inline_cap ? inline_cap : conf->capacity;
+
     /* Needed to avoid an integer overflow on the first resize and
      * to easily check for any future overflows. */
-    if (!conf->capacity || ex >= CC_MAX_ELEMENTS / conf->capacity)
+    if (!capacity || ex >= CC_MAX_ELEMENTS / capacity)
+        return CC_ERR_INVALID_CAPACITY;
+
+    if (conf->reserved_capacity) {
+        if (inline_cap || !element_size ||
+            conf->reserved_capacity > CC_MAX_ELEMENTS / element_size)
+            return CC_ERR_INVALID_CAPACITY;
+
+        if (capacity > conf->reserved_capacity)
+            capacity = conf->reserved_capacity;
+    }
+
+    if (element_size && inline_cap > (CC_MAX_ELEMENTS - sizeof(CC_ArraySized)) / element_size)
         return CC_ERR_INVALID_CAPACITY;
 
-    CC_ArraySized *ar = conf->mem_calloc(1, sizeof(CC_ArraySized));
+    CC_ArraySized *ar = conf->mem_calloc(1, sizeof(CC_ArraySized) + inline_cap * element_size);
 
     if (!ar)
         return CC_ERR_ALLOC;
 
-    uint8_t *buff = conf->mem_alloc(conf->capacity * element_size);
+    uint8_t *buff;
 
-    if (!buff) {
-        conf->mem_free(ar);
-        return CC_ERR_ALLOC;
+    if (conf->reserved_capacity) {
+        size_t page     = vm_page_size();
+        size_t reserved = conf->reserved_capacity * element_size;
+        size_t commit   = ((capacity * element_size + page - 1) / page) * page;
+
+        buff = vm_reserve(reserved);
+
+        if (!buff) {
+            conf->mem_free(ar);
+            return CC_ERR_ALLOC;
+        }
+        if (commit > reserved)
+            commit = reserved;
+
+        if (!vm_commit(buff, commit)) {
+            vm_release(buff, reserved);
+            conf->mem_free(ar);
+            return CC_ERR_ALLOC;
+        }
+        ar->reserved_capacity = conf->reserved_capacity;
+        ar->committed_bytes   = commit;
+
+        /* Use up the whole committed region */
+        capacity = commit / element_size;
+    } else if (inline_cap) {
+        /* The inline elements directly follow the structure */
+        buff = (uint8_t*) (ar + 1);
+        ar->inline_buffer   = buff;
+        ar->inline_capacity = inline_cap;
+    } else {
+        buff = conf->mem_alloc(capacity * element_size);
+
+        if (!buff) {
+            conf->mem_free(ar);
+            return CC_ERR_ALLOC;
+        }
     }
 
     ar->data_length = element_size;
     ar->buffer      = buff;
     ar->exp_factor  = ex;
-    ar->capacity    = conf->capacity;
+    ar->capacity    = capacity;
     ar->mem_alloc   = conf->mem_alloc;
     ar->mem_calloc  = conf->mem_calloc;
     ar->mem_free    = conf->mem_free;
@@ -128,6 +242,8 @@ void cc_array_sized_conf_init(CC_ArraySizedConf *conf)
 {
     conf->exp_factor = DEFAULT_EXPANSION_FACTOR;
     conf->capacity   = DEFAULT_CAPACITY;
+    conf->inline_capacity = 0;
+    conf->reserved_capacity = 0;
     conf->mem_alloc  = malloc;
     conf->mem_calloc = calloc;
     conf->mem_free   = free;
@@ -140,7 +256,7 @@ void cc_array_sized_conf_init(CC_ArraySizedConf *conf)
  */
 void cc_array_sized_destroy(CC_ArraySized *ar)
 {
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
     ar->mem_free(ar);
 }
 
@@ -263,6 +379,182 @@ enum cc_stat cc_array_sized_swap_at(CC_ArraySized *ar, size_t index1, size_t ind
     return CC_OK;
 }
 
+/**
+ * Appends all elements of the source array to the end of the array. The
+ * buffer is expanded at most once and the elements are copied in a single
+ * block. The source array may be the array itself.
+ *
+ * @param[in] ar  the array to which the elements are being added
+ * @param[in] src the array whose elements are being added. Must have the
+ *                same element size as the array
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_INVALID_RANGE
+ * if the element sizes do not match, CC_ERR_ALLOC if the memory allocation
+ * for the new buffer failed, or CC_ERR_MAX_CAPACITY if the array cannot hold
+ * all of the elements.
+ */
+enum cc_stat cc_array_sized_add_all(CC_ArraySized *ar, CC_ArraySized *src)
+{
+    if (src->size == 0) {
+        return CC_OK;
+    }
+    return cc_array_sized_add_range(ar, src, 0, src->size - 1);
+}
+
+/**
+ * Appends the elements of the source array ranging from <code>from</code>
+ * index (inclusive) to <code>to</code> index (inclusive) to the end of the
+ * array. The source array may be the array itself.
+ *
+ * @param[in] ar   the array to which the elements are being added
+ * @param[in] src  the array whose elements are being added. Must have the
+ *                 same element size as the array
+ * @param[in] from the index of the first element that is being added
+ * @param[in] to   the index of the last element that is being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_INVALID_RANGE
+ * if the specified index range is invalid or the element sizes do not match,
+ * CC_ERR_ALLOC if the memory allocation for the new buffer failed, or
+ * CC_ERR_MAX_CAPACITY if the array cannot hold all of the elements.
+ */
+enum cc_stat cc_array_sized_add_range(CC_ArraySized *ar, CC_ArraySized *src, size_t from, size_t to)
+{
+    if (from > to || to >= src->size || src->data_length != ar->data_length) {
+        return CC_ERR_INVALID_RANGE;
+    }
+    size_t n = to - from + 1;
+
+    if (n > CC_MAX_ELEMENTS - ar->size) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    /* Expand first, since the source might be this very buffer */
+    enum cc_stat status = expand_capacity_to(ar, ar->size + n);
+    if (status != CC_OK) {
+        return status;
+    }
+    memcpy(BUF_ADDR(ar, ar->size),
+           BUF_ADDR(src, from),
+           n * ar->data_length);
+
+    ar->size += n;
+
+    return CC_OK;
+}
+
+/**
+ * Appends <code>n</code> elements from a contiguous buffer to the end of
+ * the array.
+ *
+ * @param[in] ar       the array to which the elements are being added
+ * @param[in] elements buffer holding <code>n</code> elements of the array's
+ *                     element size
+ * @param[in] n        the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * array cannot hold all of the elements.
+ */
+enum cc_stat cc_array_sized_append_buffer(CC_ArraySized *ar, const uint8_t *elements, size_t n)
+{
+    return cc_array_sized_insert_range(ar, ar->size, elements, n);
+}
+
+/**
+ * Inserts <code>n</code> elements from a contiguous buffer at the specified
+ * position by shifting all subsequent elements by <code>n</code> in a single
+ * move. The index must be within the bounds of the array or equal to its size.
+ *
+ * @note The elements must not point into the array's own buffer.
+ *
+ * @param[in] ar       the array to which the elements are being added
+ * @param[in] index    the position at which the first element is inserted
+ * @param[in] elements buffer holding <code>n</code> elements of the array's
+ *                     element size
+ * @param[in] n        the number of elements that are being added
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_OUT_OF_RANGE if
+ * the specified index was not in range, CC_ERR_ALLOC if the memory allocation
+ * for the new buffer failed, or CC_ERR_MAX_CAPACITY if the array cannot hold
+ * all of the elements.
+ */
+enum cc_stat cc_array_sized_insert_range(CC_ArraySized *ar, size_t index, const uint8_t *elements, size_t n)
+{
+    if (index > ar->size) {
+        return CC_ERR_OUT_OF_RANGE;
+    }
+    if (n == 0) {
+        return CC_OK;
+    }
+    if (n > CC_MAX_ELEMENTS - ar->size) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    enum cc_stat status = expand_capacity_to(ar, ar->size + n);
+    if (status != CC_OK) {
+        return status;
+    }
+    if (index < ar->size) {
+        memmove(BUF_ADDR(ar, (index + n)),
+                BUF_ADDR(ar, index),
+                (ar->size - index) * ar->data_length);
+    }
+    memcpy(BUF_ADDR(ar, index), elements, n * ar->data_length);
+
+    ar->size += n;
+
+    return CC_OK;
+}
+
+/**
+ * Removes the elements ranging from <code>from</code> index (inclusive) to
+ * <code>to</code> index (inclusive) by shifting all subsequent elements in a
+ * single move and optionally copies the removed elements to <code>out</code>.
+ *
+ * @param[in]  ar   the array from which the elements are being removed
+ * @param[in]  from the index of the first element that is being removed
+ * @param[in]  to   the index of the last element that is being removed
+ * @param[out] out  buffer large enough to hold the removed elements, or NULL
+ *                  if they are to be ignored
+ *
+ * @return CC_OK if the elements were successfully removed, or
+ * CC_ERR_INVALID_RANGE if the specified index range is invalid.
+ */
+enum cc_stat cc_array_sized_remove_range(CC_ArraySized *ar, size_t from, size_t to, uint8_t *out)
+{
+    if (from > to || to >= ar->size) {
+        return CC_ERR_INVALID_RANGE;
+    }
+    size_t n = to - from + 1;
+
+    if (out) {
+        memcpy(out, BUF_ADDR(ar, from), n * ar->data_length);
+    }
+    if (to != ar->size - 1) {
+        memmove(BUF_ADDR(ar, from),
+                BUF_ADDR(ar, (to + 1)),
+                (ar->size - 1 - to) * ar->data_length);
+    }
+    ar->size -= n;
+
+    return CC_OK;
+}
+
+/**
+ * Expands the array so that it can hold at least <code>capacity</code>
+ * elements without any further allocations. Does nothing if the array
+ * is already large enough.
+ *
+ * @param[in] ar       the array whose capacity is being reserved
+ * @param[in] capacity the minimum capacity of the array
+ *
+ * @return CC_OK if the capacity was reserved, CC_ERR_ALLOC if the memory
+ * allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * requested capacity exceeds the maximum capacity.
+ */
+enum cc_stat cc_array_sized_reserve(CC_ArraySized *ar, size_t capacity)
+{
+    return expand_capacity_to(ar, capacity);
+}
+
 /**
  * Removes the specified element from the CC_ArraySized if such element exists and
  * optionally sets the out parameter to the value of the removed element.
@@ -531,6 +823,10 @@ enum cc_stat cc_array_sized_copy(CC_ArraySized *ar, CC_ArraySized **out)
     copy->exp_factor  = ar->exp_factor;
     copy->size        = ar->size;
     copy->capacity    = ar->capacity;
+    copy->inline_buffer   = NULL;
+    copy->inline_capacity = 0;
+    copy->reserved_capacity = 0;
+    copy->committed_bytes   = 0;
     copy->mem_alloc   = ar->mem_alloc;
     copy->mem_calloc  = ar->mem_calloc;
     copy->mem_free    = ar->mem_free;
@@ -626,6 +922,10 @@ enum cc_stat cc_array_sized_filter(CC_ArraySized *ar, bool (*pred) (const uint8_
     filtered->exp_factor  = ar->exp_factor;
     filtered->size        = 0;
     filtered->capacity    = ar->capacity;
+    filtered->inline_buffer   = NULL;
+    filtered->inline_capacity = 0;
+    filtered->reserved_capacity = 0;
+    filtered->committed_bytes   = 0;
     filtered->mem_alloc   = ar->mem_alloc;
     filtered->mem_calloc  = ar->mem_calloc;
     filtered->mem_free    = ar->mem_free;
@@ -668,6 +968,10 @@ void cc_array_sized_reverse(CC_ArraySized *ar, uint8_t *tmp)
  * the number of elements in the CC_ArraySized, however the capacity will never shrink
  * below 1.
  *
+ * @note If the array was created with reserved address space, the pages past
+ * the last element are decommitted instead and the capacity is rounded up to
+ * a whole page.
+ *
  * @param[in] ar array whose capacity is being trimmed
  *
  * @return CC_OK if the capacity was trimmed successfully, or CC_ERR_ALLOC if
@@ -675,7 +979,29 @@ void cc_array_sized_reverse(CC_ArraySized *ar, uint8_t *tmp)
  */
 enum cc_stat cc_array_sized_trim_capacity(CC_ArraySized *ar)
 {
-    if (ar->size == ar->capacity) {
+    if (ar->size == ar->capacity || ar->buffer == ar->inline_buffer) {
+        return CC_OK;
+    }
+    if (ar->reserved_capacity) {
+        size_t page   = vm_page_size();
+        size_t needed = ar->size ? ar->size * ar->data_length : 1;
+        size_t keep   = ((needed + page - 1) / page) * page;
+
+        if (keep < ar->committed_bytes) {
+            vm_decommit(ar->buffer + keep, ar->committed_bytes - keep);
+            ar->committed_bytes = keep;
+            ar->capacity        = keep / ar->data_length;
+        }
+        return CC_OK;
+    }
+    /* Move the elements back into the inline storage if they fit */
+    if (ar->inline_buffer && ar->size <= ar->inline_capacity) {
+        memcpy(ar->inline_buffer, ar->buffer, ar->size * ar->data_length);
+        ar->mem_free(ar->buffer);
+
+        ar->buffer   = ar->inline_buffer;
+        ar->capacity = ar->inline_capacity;
+
         return CC_OK;
     }
     uint8_t *new_buff = ar->mem_calloc(ar->size, ar->data_length);
@@ -686,7 +1012,7 @@ enum cc_stat cc_array_sized_trim_capacity(CC_ArraySized *ar)
     size_t size = ar->size < 1 ? 1 : ar->size;
 
     memcpy(new_buff, ar->buffer, size * ar->data_length);
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
 
     ar->buffer   = new_buff;
     ar->capacity = ar->size;
@@ -782,6 +1108,274 @@ void cc_array_sized_sort(CC_ArraySized *ar, int (*cmp) (const void*, const void*
     qsort(ar->buffer, ar->size, ar->data_length, cmp);
 }
 
+/**
+ * Returns the index of the first element in a sorted array that does not
+ * go before the specified element, or the size of the array if there is
+ * no such element.
+ *
+ * @note The array must be sorted according to <code>cmp</code>.
+ *
+ * @param[in] ar      sorted array that is being searched
+ * @param[in] element the element that is being searched for
+ * @param[in] cmp     the comparator function used to sort the array. It is
+ *                    passed pointers to the elements, same as with
+ *                    <code>cc_array_sized_sort()</code>
+ *
+ * @return the lower bound index.
+ */
+size_t cc_array_sized_lower_bound(CC_ArraySized *ar, const uint8_t *element,
+                                  int (*cmp) (const void*, const void*))
+{
+    return search_bound(ar, element, cmp, false);
+}
+
+/**
+ * Returns the index of the first element in a sorted array that goes after
+ * the specified element, or the size of the array if there is no such
+ * element.
+ *
+ * @note The array must be sorted according to <code>cmp</code>.
+ *
+ * @param[in] ar      sorted array that is being searched
+ * @param[in] element the element that is being searched for
+ * @param[in] cmp     the comparator function used to sort the array
+ *
+ * @return the upper bound index.
+ */
+size_t cc_array_sized_upper_bound(CC_ArraySized *ar, const uint8_t *element,
+                                  int (*cmp) (const void*, const void*))
+{
+    return search_bound(ar, element, cmp, true);
+}
+
+/**
+ * Finds the range of elements in a sorted array that are equal to the
+ * specified element. The range starts at <code>from</code> (inclusive) and
+ * ends at <code>to</code> (exclusive).
+ *
+ * @note The array must be sorted according to <code>cmp</code>.
+ *
+ * @param[in]  ar      sorted array that is being searched
+ * @param[in]  element the element that is being searched for
+ * @param[in]  cmp     the comparator function used to sort the array
+ * @param[out] from    pointer to where the first index of the range is stored
+ * @param[out] to      pointer to where the index past the end of the range
+ *                     is stored
+ *
+ * @return CC_OK if at least one equal element was found, or
+ * CC_ERR_VALUE_NOT_FOUND if the range is empty, in which case both indices
+ * are set to the position at which the element would be inserted.
+ */
+enum cc_stat cc_array_sized_equal_range(CC_ArraySized *ar, const uint8_t *element,
+                                        int (*cmp) (const void*, const void*),
+                                        size_t *from, size_t *to)
+{
+    size_t lo = search_bound(ar, element, cmp, false);
+    size_t hi = lo;
+
+    if (lo < ar->size && cmp(BUF_ADDR(ar, lo), element) == 0) {
+        hi = search_bound(ar, element, cmp, true);
+    }
+    *from = lo;
+    *to   = hi;
+
+    return lo == hi ? CC_ERR_VALUE_NOT_FOUND : CC_OK;
+}
+
+/**
+ * Adds the element to a sorted array, keeping the array sorted. The element
+ * is placed after any elements that are equal to it.
+ *
+ * @note The array must be sorted according to <code>cmp</code>.
+ *
+ * @param[in] ar      sorted array to which the element is being added
+ * @param[in] element the element that is being added
+ * @param[in] cmp     the comparator function used to sort the array
+ *
+ * @return CC_OK if the element was successfully added, CC_ERR_ALLOC if the
+ * memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY if the
+ * array is already at maximum capacity.
+ */
+enum cc_stat cc_array_sized_add_sorted(CC_ArraySized *ar, uint8_t *element,
+                                       int (*cmp) (const void*, const void*))
+{
+    return cc_array_sized_add_at(ar, element, search_bound(ar, element, cmp, true));
+}
+
+/**
+ * Adds <code>n</code> elements to a sorted array, keeping the array sorted.
+ * Instead of inserting the elements one by one, the new elements are sorted
+ * on their own and then merged into the array in a single backwards pass,
+ * so every existing element is moved at most once. The elements are copied
+ * before the array is expanded, so they may be taken from the array itself.
+ *
+ * @note The array must be sorted according to <code>cmp</code>.
+ *
+ * @param[in] ar       sorted array to which the elements are being added
+ * @param[in] elements buffer holding <code>n</code> elements in any order
+ * @param[in] n        the number of elements that are being added
+ * @param[in] cmp      the comparator function used to sort the array
+ *
+ * @return CC_OK if the elements were successfully added, CC_ERR_ALLOC if a
+ * memory allocation failed, or CC_ERR_MAX_CAPACITY if the array cannot hold
+ * all of the elements.
+ */
+enum cc_stat cc_array_sized_add_all_sorted(CC_ArraySized *ar, const uint8_t *elements, size_t n,
+                                           int (*cmp) (const void*, const void*))
+{
+    if (n == 0) {
+        return CC_OK;
+    }
+    if (n > CC_MAX_ELEMENTS - ar->size) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    /* Copy first, since the elements might be in this very buffer */
+    uint8_t *tmp = ar->mem_alloc(n * ar->data_length);
+
+    if (!tmp) {
+        return CC_ERR_ALLOC;
+    }
+    memcpy(tmp, elements, n * ar->data_length);
+
+    enum cc_stat status = expand_capacity_to(ar, ar->size + n);
+    if (status != CC_OK) {
+        ar->mem_free(tmp);
+        return status;
+    }
+    qsort(tmp, n, ar->data_length, cmp);
+
+    /* Merge from the back so that nothing is overwritten before it is
+     * moved. Existing elements go before equal new ones. */
+    size_t i = ar->size;
+    size_t j = n;
+    size_t k = ar->size + n;
+
+    while (j > 0) {
+        k--;
+        if (i > 0 && cmp(BUF_ADDR(ar, (i - 1)), &tmp[(j - 1) * ar->data_length]) > 0) {
+            i--;
+            memcpy(BUF_ADDR(ar, k), BUF_ADDR(ar, i), ar->data_length);
+        } else {
+            j--;
+            memcpy(BUF_ADDR(ar, k), &tmp[j * ar->data_length], ar->data_length);
+        }
+    }
+    ar->size += n;
+    ar->mem_free(tmp);
+
+    return CC_OK;
+}
+
+/**
+ * Merges two sorted arrays into a new sorted array that holds all elements
+ * of both arrays. Elements of the first array go before equal elements of
+ * the second.
+ *
+ * @note The new CC_ArraySized is allocated using the first array's allocators
+ *       and it also inherits its configuration.
+ *
+ * @param[in]  ar1 first sorted array
+ * @param[in]  ar2 second sorted array with the same element size
+ * @param[in]  cmp the comparator function used to sort both arrays
+ * @param[out] out pointer to where the merged array is stored
+ *
+ * @return CC_OK if the arrays were merged successfully, CC_ERR_INVALID_RANGE
+ * if the element sizes do not match, CC_ERR_ALLOC if the memory allocation
+ * for the new array failed, or CC_ERR_MAX_CAPACITY if the new array cannot
+ * hold all of the elements.
+ */
+enum cc_stat cc_array_sized_merge(CC_ArraySized *ar1, CC_ArraySized *ar2,
+                                  int (*cmp) (const void*, const void*),
+                                  CC_ArraySized **out)
+{
+    if (ar1->data_length != ar2->data_length) {
+        return CC_ERR_INVALID_RANGE;
+    }
+    if (ar2->size > CC_MAX_ELEMENTS - ar1->size) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    CC_ArraySized *merged;
+    enum cc_stat status = new_like(ar1, ar1->size + ar2->size, &merged);
+    if (status != CC_OK) {
+        return status;
+    }
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+
+    while (i < ar1->size && j < ar2->size) {
+        if (cmp(BUF_ADDR(ar2, j), BUF_ADDR(ar1, i)) < 0) {
+            memcpy(BUF_ADDR(merged, k++), BUF_ADDR(ar2, j++), ar1->data_length);
+        } else {
+            memcpy(BUF_ADDR(merged, k++), BUF_ADDR(ar1, i++), ar1->data_length);
+        }
+    }
+    /* At most one of the arrays has a remaining run */
+    memcpy(BUF_ADDR(merged, k), BUF_ADDR(ar1, i), (ar1->size - i) * ar1->data_length);
+    k += ar1->size - i;
+    memcpy(BUF_ADDR(merged, k), BUF_ADDR(ar2, j), (ar2->size - j) * ar1->data_length);
+    k += ar2->size - j;
+
+    merged->size = k;
+    *out = merged;
+
+    return CC_OK;
+}
+
+/**
+ * Creates a new sorted array that holds the elements that are present in
+ * both sorted arrays. An element that occurs several times is kept as many
+ * times as it occurs in the array where it occurs the least.
+ *
+ * @note The new CC_ArraySized is allocated using the first array's allocators
+ *       and it also inherits its configuration.
+ *
+ * @param[in]  ar1 first sorted array
+ * @param[in]  ar2 second sorted array with the same element size
+ * @param[in]  cmp the comparator function used to sort both arrays
+ * @param[out] out pointer to where the new array is stored
+ *
+ * @return CC_OK if the intersection was created successfully,
+ * CC_ERR_INVALID_RANGE if the element sizes do not match, CC_ERR_ALLOC if
+ * the memory allocation for the new array failed, or CC_ERR_MAX_CAPACITY if
+ * the new array cannot hold all of the elements.
+ */
+enum cc_stat cc_array_sized_intersect(CC_ArraySized *ar1, CC_ArraySized *ar2,
+                                      int (*cmp) (const void*, const void*),
+                                      CC_ArraySized **out)
+{
+    if (ar1->data_length != ar2->data_length) {
+        return CC_ERR_INVALID_RANGE;
+    }
+    size_t capacity = ar1->size < ar2->size ? ar1->size : ar2->size;
+
+    CC_ArraySized *common;
+    enum cc_stat status = new_like(ar1, capacity, &common);
+    if (status != CC_OK) {
+        return status;
+    }
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < ar1->size && j < ar2->size) {
+        int c = cmp(BUF_ADDR(ar1, i), BUF_ADDR(ar2, j));
+
+        if (c < 0) {
+            i++;
+        } else if (c > 0) {
+            j++;
+        } else {
+            memcpy(BUF_ADDR(common, common->size), BUF_ADDR(ar1, i), ar1->data_length);
+            common->size++;
+            i++;
+            j++;
+        }
+    }
+    *out = common;
+
+    return CC_OK;
+}
+
 /**
  * Expands the CC_ArraySized capacity. This might fail if the the new buffer
  * cannot be allocated. In case the expansion would overflow the index
@@ -796,6 +1390,9 @@ void cc_array_sized_sort(CC_ArraySized *ar, int (*cmp) (const void*, const void*
  */
 static enum cc_stat expand_capacity(CC_ArraySized *ar)
 {
+    if (ar->reserved_capacity) {
+        return expand_reserved(ar, ar->capacity + 1);
+    }
     if (ar->capacity == CC_MAX_ELEMENTS) {
         return CC_ERR_MAX_CAPACITY;
     }
@@ -816,12 +1413,274 @@ static enum cc_stat expand_capacity(CC_ArraySized *ar)
     }
     memcpy(new_buff, ar->buffer, ar->size * ar->data_length);
 
-    ar->mem_free(ar->buffer);
+    free_buffer(ar);
     ar->buffer = new_buff;
 
     return CC_OK;
 }
 
+/**
+ * Expands the CC_ArraySized capacity to at least <code>min_capacity</code>
+ * with a single reallocation. The capacity keeps growing by the expansion
+ * factor until it is large enough, so repeated bulk insertions stay amortized.
+ *
+ * @param[in] ar array whose capacity is being expanded
+ * @param[in] min_capacity the number of elements the array must be able to hold
+ *
+ * @return CC_OK if the buffer was expanded successfully, CC_ERR_ALLOC if
+ * the memory allocation for the new buffer failed, or CC_ERR_MAX_CAPACITY
+ * if the requested capacity exceeds the maximum capacity.
+ */
+static enum cc_stat expand_capacity_to(CC_ArraySized *ar, size_t min_capacity)
+{
+    if (min_capacity <= ar->capacity) {
+        return CC_OK;
+    }
+    if (ar->reserved_capacity) {
+        return expand_reserved(ar, min_capacity);
+    }
+    size_t max_capacity = ar->data_length ? CC_MAX_ELEMENTS / ar->data_length : CC_MAX_ELEMENTS;
+
+    if (min_capacity > max_capacity) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    size_t new_capacity = ar->capacity ? ar->capacity : 1;
+
+    while (new_capacity < min_capacity) {
+        float  next_f = new_capacity * ar->exp_factor;
+        size_t next   = next_f >= (float) max_capacity ? max_capacity : (size_t) next_f;
+
+        new_capacity = next > new_capacity ? next : new_capacity + 1;
+    }
+    uint8_t *new_buff = ar->mem_alloc(new_capacity * ar->data_length);
+
+    if (!new_buff) {
+        return CC_ERR_ALLOC;
+    }
+    memcpy(new_buff, ar->buffer, ar->size * ar->data_length);
+
+    free_buffer(ar);
+    ar->buffer   = new_buff;
+    ar->capacity = new_capacity;
+
+    return CC_OK;
+}
+
+/**
+ * Expands the capacity of a CC_ArraySized that was created with reserved
+ * address space to at least <code>min_capacity</code> by committing more of
+ * the reserved pages. The buffer is never moved.
+ *
+ * @param[in] ar array whose capacity is being expanded
+ * @param[in] min_capacity the number of elements the array must be able to hold
+ *
+ * @return CC_OK if the buffer was expanded successfully, CC_ERR_ALLOC if
+ * the pages could not be committed, or CC_ERR_MAX_CAPACITY if the reserved
+ * range is too small.
+ */
+static enum cc_stat expand_reserved(CC_ArraySized *ar, size_t min_capacity)
+{
+    if (min_capacity > ar->reserved_capacity) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    size_t page     = vm_page_size();
+    size_t reserved = ar->reserved_capacity * ar->data_length;
+    size_t new_capacity = (size_t) (ar->capacity * ar->exp_factor);
+
+    if (new_capacity <= ar->capacity || new_capacity > ar->reserved_capacity) {
+        new_capacity = ar->reserved_capacity;
+    }
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+    size_t commit = ((new_capacity * ar->data_length + page - 1) / page) * page;
+
+    if (commit > reserved) {
+        commit = reserved;
+    }
+    if (!vm_commit(ar->buffer + ar->committed_bytes, commit - ar->committed_bytes)) {
+        return CC_ERR_ALLOC;
+    }
+    ar->committed_bytes = commit;
+    ar->capacity        = commit / ar->data_length;
+
+    return CC_OK;
+}
+
+/**
+ * Binary search for the lower or upper bound of an element. The loop always
+ * runs log2(n) times and only selects the next base, so the compiler can
+ * turn the selection into a conditional move instead of an unpredictable
+ * branch.
+ *
+ * @param[in] ar      sorted array that is being searched
+ * @param[in] element the element that is being searched for
+ * @param[in] cmp     the comparator function used to sort the array
+ * @param[in] upper   true if the upper bound is being searched for
+ *
+ * @return the bound index.
+ */
+static size_t search_bound(CC_ArraySized *ar, const uint8_t *element,
+                           int (*cmp) (const void*, const void*), bool upper)
+{
+    if (ar->size == 0) {
+        return 0;
+    }
+    /* For the upper bound, equal elements are also skipped */
+    int    limit = upper ? 1 : 0;
+    size_t base  = 0;
+    size_t n     = ar->size;
+
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (cmp(BUF_ADDR(ar, (base + half)), element) < limit) ? base + half : base;
+        n -= half;
+    }
+    return base + (cmp(BUF_ADDR(ar, base), element) < limit);
+}
+
+/**
+ * Creates a new empty CC_ArraySized with the specified capacity that inherits
+ * the element size, configuration and allocators of an existing array.
+ *
+ * @param[in]  ar       the array whose configuration is copied
+ * @param[in]  capacity the capacity of the new array
+ * @param[out] out      pointer to where the new array is stored
+ *
+ * @return CC_OK if the array was created, CC_ERR_ALLOC if the memory
+ * allocation failed, or CC_ERR_MAX_CAPACITY if the buffer size would exceed
+ * the maximum capacity.
+ */
+static enum cc_stat new_like(CC_ArraySized *ar, size_t capacity, CC_ArraySized **out)
+{
+    if (ar->data_length && capacity > CC_MAX_ELEMENTS / ar->data_length) {
+        return CC_ERR_MAX_CAPACITY;
+    }
+    CC_ArraySized *new_ar = ar->mem_calloc(1, sizeof(CC_ArraySized));
+
+    if (!new_ar) {
+        return CC_ERR_ALLOC;
+    }
+    capacity = capacity ? capacity : 1;
+
+    if (!(new_ar->buffer = ar->mem_alloc(capacity * ar->data_length))) {
+        ar->mem_free(new_ar);
+        return CC_ERR_ALLOC;
+    }
+    new_ar->data_length = ar->data_length;
+    new_ar->exp_factor  = ar->exp_factor;
+    new_ar->capacity    = capacity;
+    new_ar->mem_alloc   = ar->mem_alloc;
+    new_ar->mem_calloc  = ar->mem_calloc;
+    new_ar->mem_free    = ar->mem_free;
+
+    *out = new_ar;
+    return CC_OK;
+}
+
+/**
+ * Frees the CC_ArraySized buffer unless it is the inline storage that was
+ * allocated along with the structure.
+ *
+ * @param[in] ar array whose buffer is being freed
+ */
+static void free_buffer(CC_ArraySized *ar)
+{
+    if (ar->reserved_capacity) {
+        vm_release(ar->buffer, ar->reserved_capacity * ar->data_length);
+    } else if (ar->buffer != ar->inline_buffer) {
+        ar->mem_free(ar->buffer);
+    }
+}
+
+/**
+ * Returns the granularity in which reserved address space is committed.
+ */
+static size_t vm_page_size(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#elif defined(CC_VM_AVAILABLE)
+    return (size_t) sysconf(_SC_PAGESIZE);
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Reserves a range of address space without backing it with memory.
+ *
+ * @param[in] bytes size of the range in bytes
+ *
+ * @return the start of the range, or NULL if it could not be reserved.
+ */
+static uint8_t *vm_reserve(size_t bytes)
+{
+#if defined(_WIN32)
+    return VirtualAlloc(NULL, bytes, MEM_RESERVE, PAGE_NOACCESS);
+#elif defined(CC_VM_AVAILABLE)
+    void *addr = mmap(NULL, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return addr == MAP_FAILED ? NULL : addr;
+#else
+    (void) bytes;
+    return NULL;
+#endif
+}
+
+/**
+ * Backs a page aligned part of a reserved range with readable and
+ * writable memory.
+ */
+static bool vm_commit(uint8_t *addr, size_t bytes)
+{
+    if (!bytes) {
+        return true;
+    }
+#if defined(_WIN32)
+    return VirtualAlloc(addr, bytes, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#elif defined(CC_VM_AVAILABLE)
+    return mprotect(addr, bytes, PROT_READ | PROT_WRITE) == 0;
+#else
+    (void) addr;
+    return false;
+#endif
+}
+
+/**
+ * Returns the memory behind a page aligned part of a reserved range to the
+ * system while keeping the range itself reserved.
+ */
+static void vm_decommit(uint8_t *addr, size_t bytes)
+{
+#if defined(_WIN32)
+    VirtualFree(addr, bytes, MEM_DECOMMIT);
+#elif defined(CC_VM_AVAILABLE)
+    madvise(addr, bytes, MADV_DONTNEED);
+    mprotect(addr, bytes, PROT_NONE);
+#else
+    (void) addr;
+    (void) bytes;
+#endif
+}
+
+/**
+ * Releases a range previously reserved with <code>vm_reserve()</code>.
+ */
+static void vm_release(uint8_t *addr, size_t bytes)
+{
+#if defined(_WIN32)
+    (void) bytes;
+    VirtualFree(addr, 0, MEM_RELEASE);
+#elif defined(CC_VM_AVAILABLE)
+    munmap(addr, bytes);
+#else
+    (void) addr;
+    (void) bytes;
+#endif
+}
+
 /**
  * Applies the function fn to each element of the CC_Array.
  *
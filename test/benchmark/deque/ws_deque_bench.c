@@ -0,0 +1,170 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "cc_deque.h"
+#include "cc_ws_deque.h"
+
+/*
+ * Fork-join workload: every task of depth d > 0 forks two tasks of depth
+ * d - 1 onto the deque of the worker that runs it, leaf tasks do a small
+ * amount of work. Workers take tasks from their own deque and steal from
+ * a random victim when it is empty. The run joins once every task of the
+ * tree has completed.
+ */
+
+#define TREE_DEPTH  20
+#define LEAF_WORK   50
+#define MAX_WORKERS 64
+
+struct locked_deque {
+    pthread_mutex_t  lock;
+    CC_Deque        *d;
+};
+
+static CC_WSDeque          *ws_deques[MAX_WORKERS];
+static struct locked_deque  locked_deques[MAX_WORKERS];
+static int                  workers;
+static atomic_long          remaining;
+static volatile unsigned    sink;
+
+static void ws_push(int self, void *task)
+{
+    cc_ws_deque_push(ws_deques[self], task);
+}
+
+static bool ws_take(int self, void **task)
+{
+    return cc_ws_deque_pop(ws_deques[self], task) == CC_OK;
+}
+
+static bool ws_steal(int victim, void **task)
+{
+    return cc_ws_deque_steal(ws_deques[victim], task) == CC_OK;
+}
+
+static void locked_push(int self, void *task)
+{
+    pthread_mutex_lock(&locked_deques[self].lock);
+    cc_deque_add_last(locked_deques[self].d, task);
+    pthread_mutex_unlock(&locked_deques[self].lock);
+}
+
+static bool locked_take(int self, void **task)
+{
+    pthread_mutex_lock(&locked_deques[self].lock);
+    bool ok = cc_deque_remove_last(locked_deques[self].d, task) == CC_OK;
+    pthread_mutex_unlock(&locked_deques[self].lock);
+    return ok;
+}
+
+static bool locked_steal(int victim, void **task)
+{
+    pthread_mutex_lock(&locked_deques[victim].lock);
+    bool ok = cc_deque_remove_first(locked_deques[victim].d, task) == CC_OK;
+    pthread_mutex_unlock(&locked_deques[victim].lock);
+    return ok;
+}
+
+struct scheduler {
+    void (*push)  (int self, void *task);
+    bool (*take)  (int self, void **task);
+    bool (*steal) (int victim, void **task);
+};
+
+struct worker_arg {
+    struct scheduler *s;
+    int               self;
+};
+
+static void *worker(void *p)
+{
+    struct worker_arg *arg = p;
+    struct scheduler *s = arg->s;
+    unsigned seed = arg->self * 7919 + 1;
+    void *task;
+
+    while (atomic_load_explicit(&remaining, memory_order_relaxed) > 0) {
+        if (!s->take(arg->self, &task)) {
+            seed = seed * 1103515245 + 12345;
+            int victim = (seed >> 16) % workers;
+            if (victim == arg->self || !s->steal(victim, &task)) {
+                sched_yield();
+                continue;
+            }
+        }
+        uintptr_t depth = (uintptr_t) task - 1;
+        if (depth > 0) {
+            s->push(arg->self, (void*) depth);
+            s->push(arg->self, (void*) depth);
+        } else {
+            unsigned x = 0;
+            for (int i = 0; i < LEAF_WORK; i++)
+                x += i * i;
+            sink = x;
+        }
+        atomic_fetch_sub_explicit(&remaining, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(struct scheduler *s, int n)
+{
+    pthread_t tids[MAX_WORKERS];
+    struct worker_arg args[MAX_WORKERS];
+
+    workers = n;
+    atomic_store(&remaining, (2L << TREE_DEPTH) - 1);
+
+    /* Tasks are encoded as depth + 1 so that no task is NULL */
+    s->push(0, (void*) (uintptr_t) (TREE_DEPTH + 1));
+
+    double start = now();
+    for (int i = 0; i < n; i++) {
+        args[i].s = s;
+        args[i].self = i;
+        pthread_create(&tids[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < n; i++)
+        pthread_join(tids[i], NULL);
+
+    return now() - start;
+}
+
+int main()
+{
+    struct scheduler ws     = {ws_push, ws_take, ws_steal};
+    struct scheduler locked = {locked_push, locked_take, locked_steal};
+
+    for (int i = 0; i < MAX_WORKERS; i++) {
+        cc_ws_deque_new(&ws_deques[i]);
+        pthread_mutex_init(&locked_deques[i].lock, NULL);
+        cc_deque_new(&locked_deques[i].d);
+    }
+
+    printf("Fork-join tree of depth %d, %ld tasks (seconds)\n\n", TREE_DEPTH, (2L << TREE_DEPTH) - 1);
+    printf("%8s %14s %14s\n", "workers", "locked deque", "ws deque");
+
+    for (int n = 1; n <= MAX_WORKERS; n *= 2) {
+        double t_locked = run(&locked, n);
+        double t_ws     = run(&ws, n);
+
+        printf("%8d %14.3f %14.3f\n", n, t_locked, t_ws);
+    }
+
+    for (int i = 0; i < MAX_WORKERS; i++) {
+        cc_ws_deque_destroy(ws_deques[i]);
+        cc_deque_destroy(locked_deques[i].d);
+        pthread_mutex_destroy(&locked_deques[i].lock);
+    }
+    return 0;
+}
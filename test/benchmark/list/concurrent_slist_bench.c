@@ -0,0 +1,133 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include "cc_treeset.h"
+#include "cc_concurrent_slist.h"
+
+/*
+ * Read mostly workload on a set of small integer keys: every operation
+ * looks up a random key, except for ADD_PERCENT of the operations that
+ * add one and the same share that remove one. The lock-free list is
+ * compared with a CC_TreeSet behind a readers-writer lock.
+ */
+
+#define KEY_RANGE     512
+#define OPS_PER_THREAD 400000
+#define ADD_PERCENT   5
+#define MAX_THREADS   32
+
+static CC_ConcurrentSList *csl;
+static CC_TreeSet         *tree;
+static pthread_rwlock_t    tree_lock;
+static atomic_long         hits;
+
+static int cmp_key(const void *e1, const void *e2)
+{
+    uintptr_t a = (uintptr_t) e1;
+    uintptr_t b = (uintptr_t) e2;
+    return (a > b) - (a < b);
+}
+
+static bool csl_op(int op, void *key)
+{
+    if (op < ADD_PERCENT)
+        return cc_concurrent_slist_add(csl, key) == CC_OK;
+    if (op < 2 * ADD_PERCENT)
+        return cc_concurrent_slist_remove(csl, key, NULL) == CC_OK;
+    return cc_concurrent_slist_contains(csl, key);
+}
+
+static bool tree_op(int op, void *key)
+{
+    bool ok;
+
+    if (op < 2 * ADD_PERCENT) {
+        pthread_rwlock_wrlock(&tree_lock);
+        if (op < ADD_PERCENT)
+            ok = cc_treeset_add(tree, key) == CC_OK;
+        else
+            ok = cc_treeset_remove(tree, key, NULL) == CC_OK;
+        pthread_rwlock_unlock(&tree_lock);
+    } else {
+        pthread_rwlock_rdlock(&tree_lock);
+        ok = cc_treeset_contains(tree, key);
+        pthread_rwlock_unlock(&tree_lock);
+    }
+    return ok;
+}
+
+struct worker_arg {
+    bool (*op) (int op, void *key);
+    unsigned seed;
+};
+
+static void *worker(void *p)
+{
+    struct worker_arg *arg = p;
+    unsigned seed = arg->seed;
+    long ok = 0;
+
+    for (long i = 0; i < OPS_PER_THREAD; i++) {
+        seed = seed * 1103515245 + 12345;
+        int       op  = (seed >> 8) % 100;
+        uintptr_t key = (seed >> 16) % KEY_RANGE + 1;
+        ok += arg->op(op, (void*) key);
+    }
+    atomic_fetch_add(&hits, ok);
+    return NULL;
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(bool (*op) (int, void*), int n)
+{
+    pthread_t tids[MAX_THREADS];
+    struct worker_arg args[MAX_THREADS];
+
+    double start = now();
+    for (int i = 0; i < n; i++) {
+        args[i].op   = op;
+        args[i].seed = i * 7919 + 1;
+        pthread_create(&tids[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < n; i++)
+        pthread_join(tids[i], NULL);
+
+    return n * (double) OPS_PER_THREAD / (now() - start) / 1e6;
+}
+
+int main()
+{
+    cc_concurrent_slist_new(cmp_key, &csl);
+    cc_treeset_new(cmp_key, &tree);
+    pthread_rwlock_init(&tree_lock, NULL);
+
+    /* Start half full, which is where the adds and removes balance out */
+    for (uintptr_t k = 1; k <= KEY_RANGE; k += 2) {
+        cc_concurrent_slist_add(csl, (void*) k);
+        cc_treeset_add(tree, (void*) k);
+    }
+
+    printf("%d keys, %d%% adds, %d%% removes, the rest lookups (million ops per second)\n\n",
+           KEY_RANGE, ADD_PERCENT, ADD_PERCENT);
+    printf("%8s %16s %16s\n", "threads", "rwlock treeset", "lock-free list");
+
+    for (int n = 1; n <= MAX_THREADS; n *= 2) {
+        double t_tree = run(tree_op, n);
+        double t_csl  = run(csl_op, n);
+
+        printf("%8d %16.2f %16.2f\n", n, t_tree, t_csl);
+    }
+
+    cc_concurrent_slist_destroy(csl);
+    cc_treeset_destroy(tree);
+    pthread_rwlock_destroy(&tree_lock);
+    return 0;
+}
@@ -39,6 +39,42 @@ void bench_malloc()
     printf("done in %Lf sec.\n\n", t_delta);
 }
 
+void bench_node_pool()
+{
+    int val = 100;
+
+    printf("Runing list node pool test...\n");
+    printf("Populating list... ");
+    clock_t t_start = clock();
+
+    CC_SList* list;
+    CC_SListConf conf;
+    cc_slist_conf_init(&conf);
+    conf.pool_chunk_size = 4096;
+    cc_slist_new_conf(&conf, &list);
+
+    for (int i = 0; i < 10000000; i++) {
+        cc_slist_add(list, (void*) & val);
+    }
+    clock_t t_end = clock();
+    double t_delta = (double)(t_end - t_start)/CLOCKS_PER_SEC;
+    printf("done in %f sec.\n", t_delta);
+
+    /* Queue-like usage: every removed node is reused by the next insertion */
+    printf("Cycling list... ");
+    t_start = clock();
+
+    for (int i = 0; i < 10000000; i++) {
+        cc_slist_remove_first(list, NULL);
+        cc_slist_add(list, (void*) & val);
+    }
+    t_end = clock();
+    t_delta = (double)(t_end - t_start)/CLOCKS_PER_SEC;
+
+    cc_slist_destroy(list);
+    printf("done in %f sec.\n\n", t_delta);
+}
+
 CC_DynamicPool* pool;
 
 
@@ -69,6 +105,7 @@ void bench_pool_packed()
 
     CC_SList* list;
     CC_SListConf conf;
+    cc_slist_conf_init(&conf);
     conf.mem_alloc = pool_malloc;
     conf.mem_calloc = pool_calloc;
     conf.mem_free = pool_free;
@@ -111,6 +148,7 @@ void bench_pool_aligned()
 
     CC_SList* list;
     CC_SListConf conf;
+    cc_slist_conf_init(&conf);
     conf.mem_alloc = pool_malloc;
     conf.mem_calloc = pool_calloc;
     conf.mem_free = pool_free;
@@ -146,6 +184,7 @@ int main(int argc, char** argv)
     bench_pool_aligned();
     bench_pool_packed();
     bench_malloc();
+    bench_node_pool();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include "cc_queue.h"
+#include "cc_mpmc_queue.h"
+
+/* Total number of enqueue/dequeue pairs per run, split between threads */
+#define OPERATIONS 4000000
+#define BATCH      16
+#define MAX_THREADS 64
+
+/*
+ * Every thread alternates between enqueuing and dequeuing, so all
+ * threads act as both producers and consumers and the queue never holds
+ * more than one element (or one batch) per thread.
+ */
+
+static CC_Queue        *locked_queue;
+static pthread_mutex_t  queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static CC_MPMCQueue    *mpmc_queue;
+static size_t           ops_per_thread;
+
+static void *locked_worker(void *arg)
+{
+    void *out;
+
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        pthread_mutex_lock(&queue_lock);
+        cc_queue_enqueue(locked_queue, arg);
+        pthread_mutex_unlock(&queue_lock);
+
+        pthread_mutex_lock(&queue_lock);
+        cc_queue_poll(locked_queue, &out);
+        pthread_mutex_unlock(&queue_lock);
+    }
+    return NULL;
+}
+
+static void *mpmc_worker(void *arg)
+{
+    void *out;
+
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        cc_mpmc_queue_enqueue(mpmc_queue, arg);
+        cc_mpmc_queue_dequeue(mpmc_queue, &out);
+    }
+    return NULL;
+}
+
+static void *mpmc_batch_worker(void *arg)
+{
+    void *in[BATCH];
+    void *out[BATCH];
+
+    for (int i = 0; i < BATCH; i++)
+        in[i] = arg;
+
+    for (size_t i = 0; i < ops_per_thread; i += BATCH) {
+        cc_mpmc_queue_enqueue_n(mpmc_queue, in, BATCH);
+        cc_mpmc_queue_dequeue_n(mpmc_queue, out, BATCH);
+    }
+    return NULL;
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(void *(*worker) (void*), int threads)
+{
+    pthread_t tids[MAX_THREADS];
+    static int tokens[MAX_THREADS];
+
+    ops_per_thread = OPERATIONS / threads;
+
+    double start = now();
+    for (int i = 0; i < threads; i++)
+        pthread_create(&tids[i], NULL, worker, &tokens[i]);
+    for (int i = 0; i < threads; i++)
+        pthread_join(tids[i], NULL);
+
+    return now() - start;
+}
+
+int main()
+{
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    conf.capacity = MAX_THREADS * BATCH;
+
+    cc_queue_new(&locked_queue);
+    cc_mpmc_queue_new_conf(&conf, &mpmc_queue);
+
+    printf("%d enqueue/dequeue pairs per run (Mops/s)\n\n", OPERATIONS);
+    printf("%8s %14s %14s %14s\n", "threads", "mutex queue", "mpmc", "mpmc batch");
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double locked = run(locked_worker, threads);
+        double mpmc   = run(mpmc_worker, threads);
+        double batch  = run(mpmc_batch_worker, threads);
+
+        printf("%8d %14.2f %14.2f %14.2f\n", threads,
+               OPERATIONS / locked / 1e6,
+               OPERATIONS / mpmc / 1e6,
+               OPERATIONS / batch / 1e6);
+    }
+
+    cc_mpmc_queue_destroy(mpmc_queue);
+    cc_queue_destroy(locked_queue);
+    return 0;
+}
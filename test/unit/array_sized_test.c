@@ -414,6 +414,133 @@ static MunitResult test_sort(const MunitParameter p[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_bounds(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* array;
+    cc_array_sized_new(sizeof(int), &array);
+
+    int values[] = { 1, 3, 3, 3, 5, 8, 8, 13 };
+    cc_array_sized_append_buffer(array, (uint8_t*)values, 8);
+
+    int key = 3;
+    munit_assert_size(1, == , cc_array_sized_lower_bound(array, (uint8_t*)&key, comp));
+    munit_assert_size(4, == , cc_array_sized_upper_bound(array, (uint8_t*)&key, comp));
+
+    size_t from;
+    size_t to;
+    munit_assert_int(CC_OK, ==, cc_array_sized_equal_range(array, (uint8_t*)&key, comp, &from, &to));
+    munit_assert_size(1, == , from);
+    munit_assert_size(4, == , to);
+
+    key = 6;
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_array_sized_equal_range(array, (uint8_t*)&key, comp, &from, &to));
+    munit_assert_size(5, == , from);
+    munit_assert_size(5, == , to);
+
+    key = 0;
+    munit_assert_size(0, == , cc_array_sized_lower_bound(array, (uint8_t*)&key, comp));
+    key = 20;
+    munit_assert_size(8, == , cc_array_sized_lower_bound(array, (uint8_t*)&key, comp));
+
+    key = 4;
+    cc_array_sized_add_sorted(array, (uint8_t*)&key, comp);
+
+    int e;
+    cc_array_sized_get_at(array, 4, (uint8_t*)&e);
+    munit_assert_int(4, == , e);
+
+    cc_array_sized_destroy(array);
+    return MUNIT_OK;
+}
+
+static MunitResult test_add_all_sorted(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* array;
+    cc_array_sized_new(sizeof(int), &array);
+
+    int values[100];
+    for (int i = 0; i < 100; i++) {
+        values[i] = munit_rand_int_range(0, 50);
+    }
+    cc_array_sized_add_all_sorted(array, (uint8_t*)values, 50, comp);
+    cc_array_sized_add_all_sorted(array, (uint8_t*)&values[50], 50, comp);
+    munit_assert_size(100, == , cc_array_sized_size(array));
+
+    int prev;
+    cc_array_sized_get_at(array, 0, (uint8_t*)&prev);
+    for (int i = 1; i < 100; i++) {
+        int e;
+        cc_array_sized_get_at(array, i, (uint8_t*)&e);
+        munit_assert_int(prev, <=, e);
+        prev = e;
+    }
+
+    /* The array's own elements may be added while its buffer grows */
+    const uint8_t *own = (const uint8_t*) cc_array_sized_get_buffer(array);
+    munit_assert_int(CC_OK, == , cc_array_sized_add_all_sorted(array, own, 100, comp));
+    munit_assert_size(200, == , cc_array_sized_size(array));
+
+    cc_array_sized_get_at(array, 0, (uint8_t*)&prev);
+    for (int i = 1; i < 200; i++) {
+        int e;
+        cc_array_sized_get_at(array, i, (uint8_t*)&e);
+        munit_assert_int(prev, <=, e);
+        prev = e;
+    }
+    cc_array_sized_destroy(array);
+    return MUNIT_OK;
+}
+
+static MunitResult test_merge_intersect(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* a1;
+    CC_ArraySized* a2;
+    cc_array_sized_new(sizeof(int), &a1);
+    cc_array_sized_new(sizeof(int), &a2);
+
+    int v1[] = { 1, 2, 2, 4, 7, 9 };
+    int v2[] = { 2, 2, 2, 3, 7, 10, 11 };
+    cc_array_sized_append_buffer(a1, (uint8_t*)v1, 6);
+    cc_array_sized_append_buffer(a2, (uint8_t*)v2, 7);
+
+    CC_ArraySized* merged;
+    munit_assert_int(CC_OK, ==, cc_array_sized_merge(a1, a2, comp, &merged));
+
+    int expected_merge[] = { 1, 2, 2, 2, 2, 2, 3, 4, 7, 7, 9, 10, 11 };
+    munit_assert_size(13, == , cc_array_sized_size(merged));
+    for (int i = 0; i < 13; i++) {
+        int e;
+        cc_array_sized_get_at(merged, i, (uint8_t*)&e);
+        munit_assert_int(expected_merge[i], == , e);
+    }
+
+    CC_ArraySized* common;
+    munit_assert_int(CC_OK, ==, cc_array_sized_intersect(a1, a2, comp, &common));
+
+    int expected_common[] = { 2, 2, 7 };
+    munit_assert_size(3, == , cc_array_sized_size(common));
+    for (int i = 0; i < 3; i++) {
+        int e;
+        cc_array_sized_get_at(common, i, (uint8_t*)&e);
+        munit_assert_int(expected_common[i], == , e);
+    }
+
+    cc_array_sized_destroy(a1);
+    cc_array_sized_destroy(a2);
+    cc_array_sized_destroy(merged);
+    cc_array_sized_destroy(common);
+    return MUNIT_OK;
+}
+
 static MunitResult test_iter_remove(const MunitParameter p[], void* fixture)
 {
     (void)p;
@@ -873,6 +1000,167 @@ static MunitResult test_trim_capacity(const MunitParameter p[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_inline_capacity(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySizedConf conf;
+    cc_array_sized_conf_init(&conf);
+    conf.inline_capacity = 4;
+
+    CC_ArraySized* array;
+    munit_assert_int(CC_OK, ==, cc_array_sized_new_conf(sizeof(int), &conf, &array));
+    munit_assert_size(4, == , cc_array_sized_capacity(array));
+
+    for (int i = 0; i < 10; i++) {
+        cc_array_sized_add(array, (uint8_t*)&i);
+    }
+    munit_assert_size(10, == , cc_array_sized_size(array));
+    munit_assert_size(4, < , cc_array_sized_capacity(array));
+
+    for (int i = 0; i < 10; i++) {
+        int e;
+        cc_array_sized_get_at(array, i, (uint8_t*)&e);
+        munit_assert_int(i, == , e);
+    }
+
+    for (int i = 0; i < 7; i++) {
+        cc_array_sized_remove_last(array, NULL);
+    }
+    cc_array_sized_trim_capacity(array);
+    munit_assert_size(4, == , cc_array_sized_capacity(array));
+
+    int e;
+    cc_array_sized_get_at(array, 2, (uint8_t*)&e);
+    munit_assert_int(2, == , e);
+
+    cc_array_sized_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_new_reserved(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* array;
+    munit_assert_int(CC_OK, ==, cc_array_sized_new_reserved(sizeof(int), 100000, &array));
+
+    int v = 0;
+    cc_array_sized_add(array, (uint8_t*)&v);
+
+    uint8_t* first;
+    cc_array_sized_peek(array, 0, &first);
+
+    for (int i = 1; i < 100000; i++) {
+        munit_assert_int(CC_OK, ==, cc_array_sized_add(array, (uint8_t*)&i));
+    }
+    munit_assert_size(100000, == , cc_array_sized_size(array));
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_array_sized_add(array, (uint8_t*)&v));
+
+    /* The buffer never moves */
+    uint8_t* again;
+    cc_array_sized_peek(array, 0, &again);
+    munit_assert_ptr_equal(first, again);
+
+    for (int i = 0; i < 100000; i += 997) {
+        int e;
+        cc_array_sized_get_at(array, i, (uint8_t*)&e);
+        munit_assert_int(i, == , e);
+    }
+
+    for (int i = 0; i < 99990; i++) {
+        cc_array_sized_remove_last(array, NULL);
+    }
+    cc_array_sized_trim_capacity(array);
+    munit_assert_size(100000, > , cc_array_sized_capacity(array));
+    munit_assert_size(10, <= , cc_array_sized_capacity(array));
+
+    int e;
+    cc_array_sized_get_at(array, 9, (uint8_t*)&e);
+    munit_assert_int(9, == , e);
+
+    cc_array_sized_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_add_all(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* a1;
+    CC_ArraySized* a2;
+    cc_array_sized_new(sizeof(int), &a1);
+    cc_array_sized_new(sizeof(int), &a2);
+
+    for (int i = 0; i < 20; i++) {
+        cc_array_sized_add(i < 5 ? a1 : a2, (uint8_t*)&i);
+    }
+    munit_assert_int(CC_OK, ==, cc_array_sized_add_all(a1, a2));
+    munit_assert_size(20, == , cc_array_sized_size(a1));
+
+    for (int i = 0; i < 20; i++) {
+        int e;
+        cc_array_sized_get_at(a1, i, (uint8_t*)&e);
+        munit_assert_int(i, == , e);
+    }
+    /* Appending a range of the array to itself */
+    munit_assert_int(CC_OK, ==, cc_array_sized_add_range(a1, a1, 2, 4));
+    munit_assert_size(23, == , cc_array_sized_size(a1));
+
+    int e;
+    cc_array_sized_get_at(a1, 22, (uint8_t*)&e);
+    munit_assert_int(4, == , e);
+
+    cc_array_sized_destroy(a1);
+    cc_array_sized_destroy(a2);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_insert_remove_range(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArraySized* array;
+    cc_array_sized_new(sizeof(int), &array);
+
+    int head[] = { 0, 1, 9 };
+    int mid[]  = { 2, 3, 4, 5, 6, 7, 8 };
+
+    cc_array_sized_append_buffer(array, (uint8_t*)head, 3);
+    munit_assert_int(CC_OK, ==, cc_array_sized_insert_range(array, 2, (uint8_t*)mid, 7));
+    munit_assert_size(10, == , cc_array_sized_size(array));
+
+    for (int i = 0; i < 10; i++) {
+        int e;
+        cc_array_sized_get_at(array, i, (uint8_t*)&e);
+        munit_assert_int(i, == , e);
+    }
+
+    int out[4];
+    munit_assert_int(CC_OK, ==, cc_array_sized_remove_range(array, 1, 4, (uint8_t*)out));
+    munit_assert_int(1, == , out[0]);
+    munit_assert_int(4, == , out[3]);
+    munit_assert_size(6, == , cc_array_sized_size(array));
+
+    int e;
+    cc_array_sized_get_at(array, 1, (uint8_t*)&e);
+    munit_assert_int(5, == , e);
+
+    munit_assert_int(CC_OK, ==, cc_array_sized_reserve(array, 1000));
+    munit_assert_size(1000, <= , cc_array_sized_capacity(array));
+
+    cc_array_sized_destroy(array);
+
+    return MUNIT_OK;
+}
+
 bool pred1(const uint8_t* e)
 {
     return *(int*)e == 0;
@@ -1063,6 +1351,9 @@ static MunitTest test_suite_tests[] = {
     {(char*)"/array_sized/test_reverse", test_reverse, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_contains", test_contains, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_sort", test_sort, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_bounds", test_bounds, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_add_all_sorted", test_add_all_sorted, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_merge_intersect", test_merge_intersect, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_iter_remove", test_iter_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_iter_add", test_iter_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_iter_replace", test_iter_replace, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -1073,6 +1364,10 @@ static MunitTest test_suite_tests[] = {
     {(char*)"/array_sized/test_reduce", test_reduce, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_add_at", test_add_at, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_trim_capacity", test_trim_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_inline_capacity", test_inline_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_new_reserved", test_new_reserved, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_add_all", test_add_all, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array_sized/test_insert_remove_range", test_insert_remove_range, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_filter_mut1", test_filter_mut1, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_filter_mut2", test_filter_mut2, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array_sized/test_filter1", test_filter1, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
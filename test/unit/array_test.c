@@ -1,5 +1,7 @@
 #include "munit.h"
 #include "cc_array.h"
+#include "cc_list.h"
+#include "cc_slist.h"
 #include <stdlib.h>
 
 
@@ -894,6 +896,180 @@ static MunitResult test_trim_capacity(const MunitParameter p[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_inline_capacity(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ArrayConf conf;
+    cc_array_conf_init(&conf);
+    conf.inline_capacity = 4;
+
+    CC_Array* array;
+    munit_assert_int(CC_OK, ==, cc_array_new_conf(&conf, &array));
+    munit_assert_size(4, == , cc_array_capacity(array));
+
+    int v[10];
+    for (int i = 0; i < 10; i++) {
+        v[i] = i;
+        cc_array_add(array, &v[i]);
+    }
+    munit_assert_size(10, == , cc_array_size(array));
+    munit_assert_size(4, < , cc_array_capacity(array));
+
+    for (int i = 0; i < 10; i++) {
+        int* e;
+        cc_array_get_at(array, i, (void*)&e);
+        munit_assert_int(i, == , *e);
+    }
+
+    for (int i = 0; i < 7; i++)
+        cc_array_remove_last(array, NULL);
+
+    cc_array_trim_capacity(array);
+    munit_assert_size(4, == , cc_array_capacity(array));
+
+    int* e;
+    cc_array_get_at(array, 2, (void*)&e);
+    munit_assert_int(2, == , *e);
+
+    cc_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_add_all(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_Array* a1;
+    CC_Array* a2;
+    cc_array_new(&a1);
+    cc_array_new(&a2);
+
+    int v[20];
+    for (int i = 0; i < 20; i++) {
+        v[i] = i;
+        cc_array_add(i < 5 ? a1 : a2, &v[i]);
+    }
+
+    munit_assert_int(CC_OK, ==, cc_array_add_all(a1, a2));
+    munit_assert_size(20, == , cc_array_size(a1));
+
+    for (int i = 0; i < 20; i++) {
+        int* e;
+        cc_array_get_at(a1, i, (void*)&e);
+        munit_assert_int(i, == , *e);
+    }
+
+    /* Appending a range of the array to itself */
+    munit_assert_int(CC_OK, ==, cc_array_add_range(a1, a1, 2, 4));
+    munit_assert_size(23, == , cc_array_size(a1));
+
+    int* e;
+    cc_array_get_at(a1, 22, (void*)&e);
+    munit_assert_int(4, == , *e);
+
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_array_add_range(a1, a2, 3, 30));
+
+    cc_array_destroy(a1);
+    cc_array_destroy(a2);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_insert_range(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_Array* array;
+    cc_array_new(&array);
+
+    int v[12];
+    void* buf[8];
+    for (int i = 0; i < 12; i++) {
+        v[i] = i;
+        if (i >= 2 && i < 10)
+            buf[i - 2] = &v[i];
+    }
+    cc_array_add(array, &v[0]);
+    cc_array_add(array, &v[1]);
+    cc_array_add(array, &v[11]);
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_array_insert_range(array, 4, buf, 8));
+    munit_assert_int(CC_OK, ==, cc_array_insert_range(array, 2, buf, 8));
+    munit_assert_int(CC_OK, ==, cc_array_append_buffer(array, buf, 0));
+
+    void* tail[1] = { &v[10] };
+    cc_array_insert_range(array, 10, tail, 1);
+
+    munit_assert_size(12, == , cc_array_size(array));
+    for (int i = 0; i < 12; i++) {
+        int* e;
+        cc_array_get_at(array, i, (void*)&e);
+        munit_assert_int(i, == , *e);
+    }
+
+    cc_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_remove_range(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_Array* array;
+    cc_array_new(&array);
+
+    int v[10];
+    for (int i = 0; i < 10; i++) {
+        v[i] = i;
+        cc_array_add(array, &v[i]);
+    }
+
+    void* out[3];
+    munit_assert_int(CC_OK, ==, cc_array_remove_range(array, 3, 5, out));
+    munit_assert_int(3, == , *(int*)out[0]);
+    munit_assert_int(5, == , *(int*)out[2]);
+    munit_assert_size(7, == , cc_array_size(array));
+
+    int* e;
+    cc_array_get_at(array, 3, (void*)&e);
+    munit_assert_int(6, == , *e);
+
+    munit_assert_int(CC_OK, ==, cc_array_remove_range(array, 5, 6, NULL));
+    munit_assert_size(5, == , cc_array_size(array));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_array_remove_range(array, 2, 5, NULL));
+
+    cc_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_reserve(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_Array* array;
+    cc_array_new(&array);
+
+    munit_assert_int(CC_OK, ==, cc_array_reserve(array, 100));
+    munit_assert_size(100, <= , cc_array_capacity(array));
+
+    size_t capacity = cc_array_capacity(array);
+    munit_assert_int(CC_OK, ==, cc_array_reserve(array, 10));
+    munit_assert_size(capacity, == , cc_array_capacity(array));
+
+    cc_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_capacity(const MunitParameter p[], void* fixture)
 {
     (void)p;
@@ -1089,6 +1265,120 @@ static MunitResult test_map(const MunitParameter p[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_from_buffer(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    int v[10];
+
+    /* The array of a list becomes the storage of the array */
+    CC_SList* list;
+    cc_slist_new(&list);
+    for (int i = 0; i < 5; i++)
+        cc_slist_add(list, &v[i]);
+
+    void** buffer;
+    cc_slist_to_array(list, &buffer);
+
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_array_from_buffer(buffer, 5, 0, NULL));
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_array_from_buffer(buffer, 6, 5, NULL));
+
+    CC_Array* ar;
+    munit_assert_int(CC_OK, ==, cc_array_from_buffer(buffer, 5, 5, &ar));
+    cc_slist_destroy(list);
+
+    munit_assert_size(5, ==, cc_array_size(ar));
+    munit_assert_size(5, ==, cc_array_capacity(ar));
+
+    for (int i = 5; i < 10; i++)
+        cc_array_add(ar, &v[i]);
+
+    void* e;
+    for (int i = 0; i < 10; i++) {
+        cc_array_get_at(ar, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+
+    size_t size;
+    size_t capacity;
+    munit_assert_int(CC_OK, ==, cc_array_release_buffer(ar, &buffer, &size, &capacity));
+    munit_assert_size(10, ==, size);
+    munit_assert_size(10, ==, capacity);
+    munit_assert_ptr_equal(&v[9], buffer[9]);
+    free(buffer);
+
+    /* Inline elements are moved into a buffer of their own */
+    CC_ArrayConf conf;
+    cc_array_conf_init(&conf);
+    conf.inline_capacity = 4;
+    cc_array_new_conf(&conf, &ar);
+    cc_array_add(ar, &v[0]);
+    cc_array_add(ar, &v[1]);
+
+    munit_assert_int(CC_OK, ==, cc_array_release_buffer(ar, &buffer, &size, &capacity));
+    munit_assert_size(2, ==, size);
+    munit_assert_size(4, ==, capacity);
+    munit_assert_ptr_equal(&v[1], buffer[1]);
+    free(buffer);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_from_list(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    int v[20];
+
+    CC_List* list;
+    CC_SList* slist;
+    cc_list_new(&list);
+    cc_slist_new(&slist);
+    for (int i = 0; i < 10; i++) {
+        cc_list_add(list, &v[i]);
+        cc_slist_add(slist, &v[10 + i]);
+    }
+
+    /* The elements move over and the lists are left empty */
+    CC_Array* ar1;
+    CC_Array* ar2;
+    munit_assert_int(CC_OK, ==, cc_array_from_list(list, &ar1));
+    munit_assert_int(CC_OK, ==, cc_array_from_slist(slist, &ar2));
+    munit_assert_size(0, ==, cc_list_size(list));
+    munit_assert_size(0, ==, cc_slist_size(slist));
+    munit_assert_size(10, ==, cc_array_size(ar1));
+    munit_assert_size(10, ==, cc_array_size(ar2));
+
+    void* e;
+    for (int i = 0; i < 10; i++) {
+        cc_array_get_at(ar1, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+        cc_array_get_at(ar2, i, &e);
+        munit_assert_ptr_equal(&v[10 + i], e);
+    }
+    cc_array_add(ar1, &v[10]);
+    munit_assert_size(11, ==, cc_array_size(ar1));
+
+    /* An empty list still gets the configured capacity */
+    CC_ArrayConf conf;
+    cc_array_conf_init(&conf);
+    conf.capacity = 16;
+
+    CC_Array* ar3;
+    munit_assert_int(CC_OK, ==, cc_array_from_list_conf(&conf, list, &ar3));
+    munit_assert_size(0, ==, cc_array_size(ar3));
+    munit_assert_size(16, ==, cc_array_capacity(ar3));
+
+    cc_array_destroy(ar1);
+    cc_array_destroy(ar2);
+    cc_array_destroy(ar3);
+    cc_list_destroy(list);
+    cc_slist_destroy(slist);
+    return MUNIT_OK;
+}
+
 static MunitTest test_suite_tests[] = {
 	{(char*)"/array/test_add", test_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_add_out_of_range", test_add_out_of_range, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -1114,6 +1404,13 @@ static MunitTest test_suite_tests[] = {
     {(char*)"/array/test_reduce", test_reduce, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_trim_capacity", test_trim_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_capacity", test_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_inline_capacity", test_inline_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_from_buffer", test_from_buffer, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_from_list", test_from_list, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_add_all", test_add_all, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_insert_range", test_insert_range, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_remove_range", test_remove_range, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/array/test_reserve", test_reserve, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_test_filter_mut1", test_filter_mut1, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_test_filter_mut2", test_filter_mut2, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/array/test_filter1", test_filter1, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -0,0 +1,197 @@
+#include "munit.h"
+#include "cc_block_deque.h"
+#include <stdlib.h>
+
+
+static CC_BlockDeque* new_deque(size_t block_size)
+{
+    CC_BlockDequeConf conf;
+    cc_block_deque_conf_init(&conf);
+    conf.block_size = block_size;
+
+    CC_BlockDeque* deque;
+    munit_assert_int(CC_OK, ==, cc_block_deque_new_conf(&conf, &deque));
+    return deque;
+}
+
+static MunitResult test_add_remove(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_BlockDeque* deque = new_deque(3);
+
+    int v[100];
+    void* e;
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_block_deque_remove_first(deque, &e));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_block_deque_get_last(deque, &e));
+
+    /* 50..99 at the back and 49..0 at the front */
+    for (int i = 0; i < 50; i++) {
+        munit_assert_int(CC_OK, ==, cc_block_deque_add_last(deque, &v[50 + i]));
+        munit_assert_int(CC_OK, ==, cc_block_deque_add_first(deque, &v[49 - i]));
+    }
+    munit_assert_size(100, ==, cc_block_deque_size(deque));
+
+    for (int i = 0; i < 100; i++) {
+        cc_block_deque_get_at(deque, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_block_deque_get_at(deque, 100, &e));
+
+    cc_block_deque_get_first(deque, &e);
+    munit_assert_ptr_equal(&v[0], e);
+    cc_block_deque_get_last(deque, &e);
+    munit_assert_ptr_equal(&v[99], e);
+
+    for (int i = 0; i < 50; i++) {
+        cc_block_deque_remove_first(deque, &e);
+        munit_assert_ptr_equal(&v[i], e);
+        cc_block_deque_remove_last(deque, &e);
+        munit_assert_ptr_equal(&v[99 - i], e);
+    }
+    munit_assert_size(0, ==, cc_block_deque_size(deque));
+    munit_assert_size(0, ==, cc_block_deque_capacity(deque));
+
+    /* The deque is usable again after draining */
+    cc_block_deque_add_first(deque, &v[1]);
+    cc_block_deque_add_last(deque, &v[2]);
+    cc_block_deque_add_first(deque, &v[0]);
+    for (int i = 0; i < 3; i++) {
+        cc_block_deque_remove_first(deque, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+
+    cc_block_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+static MunitResult test_stable_slots(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_BlockDeque* deque = new_deque(4);
+
+    int v[1000];
+    void** first;
+    void** last;
+
+    cc_block_deque_add_last(deque, &v[0]);
+    cc_block_deque_add_last(deque, &v[1]);
+    cc_block_deque_peek(deque, 0, &first);
+    cc_block_deque_peek(deque, 1, &last);
+
+    for (int i = 2; i < 1000; i++) {
+        if (i % 2)
+            cc_block_deque_add_last(deque, &v[i]);
+        else
+            cc_block_deque_add_first(deque, &v[i]);
+    }
+
+    /* Growing at either end never moves the existing elements */
+    munit_assert_ptr_equal(&v[0], *first);
+    munit_assert_ptr_equal(&v[1], *last);
+
+    void** s;
+    cc_block_deque_peek(deque, 499, &s);
+    munit_assert_ptr_equal(first, s);
+
+    cc_block_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+static MunitResult test_release_blocks(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_BlockDeque* deque = new_deque(4);
+
+    int v[40];
+    for (int i = 0; i < 40; i++)
+        cc_block_deque_add_last(deque, &v[i]);
+    munit_assert_size(40, ==, cc_block_deque_capacity(deque));
+
+    /* Blocks are released one by one as the deque drains */
+    for (int i = 0; i < 8; i++)
+        cc_block_deque_remove_first(deque, NULL);
+    munit_assert_size(32, ==, cc_block_deque_capacity(deque));
+
+    for (int i = 0; i < 9; i++)
+        cc_block_deque_remove_last(deque, NULL);
+    munit_assert_size(24, ==, cc_block_deque_capacity(deque));
+    munit_assert_size(23, ==, cc_block_deque_size(deque));
+
+    munit_assert_int(CC_OK, ==, cc_block_deque_trim_capacity(deque));
+
+    void* e;
+    cc_block_deque_get_first(deque, &e);
+    munit_assert_ptr_equal(&v[8], e);
+    cc_block_deque_get_last(deque, &e);
+    munit_assert_ptr_equal(&v[30], e);
+
+    cc_block_deque_remove_all(deque);
+    munit_assert_size(0, ==, cc_block_deque_size(deque));
+    munit_assert_size(0, ==, cc_block_deque_capacity(deque));
+
+    cc_block_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+static MunitResult test_iter(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_BlockDeque* deque = new_deque(2);
+
+    int v[7];
+    for (int i = 3; i < 7; i++)
+        cc_block_deque_add_last(deque, &v[i]);
+    for (int i = 2; i >= 0; i--)
+        cc_block_deque_add_first(deque, &v[i]);
+
+    int i = 0;
+    CC_BLOCK_DEQUE_FOREACH(e, deque, {
+        munit_assert_ptr_equal(&v[i], e);
+        i++;
+    })
+    munit_assert_int(7, ==, i);
+
+    CC_BlockDequeIter iter;
+    cc_block_deque_iter_init(&iter, deque);
+
+    void* e;
+    void* out;
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_block_deque_iter_replace(&iter, &v[0], &out));
+    cc_block_deque_iter_next(&iter, &e);
+    cc_block_deque_iter_next(&iter, &e);
+    munit_assert_int(CC_OK, ==, cc_block_deque_iter_replace(&iter, &v[6], &out));
+    munit_assert_ptr_equal(&v[1], out);
+
+    cc_block_deque_get_at(deque, 1, &e);
+    munit_assert_ptr_equal(&v[6], e);
+
+    cc_block_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/block_deque/test_add_remove", test_add_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/block_deque/test_stable_slots", test_stable_slots, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/block_deque/test_release_blocks", test_release_blocks, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/block_deque/test_iter", test_iter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
@@ -0,0 +1,204 @@
+#include "munit.h"
+#include "cc_blocking_queue.h"
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define BQ_TEST_THREADS
+#endif
+
+
+static MunitResult test_try_operations(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_BlockingQueueConf conf;
+    cc_blocking_queue_conf_init(&conf);
+    conf.capacity = 3;
+
+    CC_BlockingQueue *q;
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_new_conf(&conf, &q));
+
+    int a, b, c, d;
+    void *out;
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_blocking_queue_try_poll(q, &out));
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_try_enqueue(q, &a));
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_enqueue(q, &b));
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_enqueue_timed(q, &c, 10));
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_blocking_queue_try_enqueue(q, &d));
+    munit_assert_int(CC_ERR_TIMEOUT, ==, cc_blocking_queue_enqueue_timed(q, &d, 10));
+    munit_assert_size(3, ==, cc_blocking_queue_size(q));
+
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_poll(q, &out));
+    munit_assert_ptr_equal(&a, out);
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_poll_timed(q, &out, 10));
+    munit_assert_ptr_equal(&b, out);
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_try_poll(q, &out));
+    munit_assert_ptr_equal(&c, out);
+    munit_assert_int(CC_ERR_TIMEOUT, ==, cc_blocking_queue_poll_timed(q, &out, 10));
+
+    cc_blocking_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+static MunitResult test_close_drain(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_BlockingQueue *q;
+    cc_blocking_queue_new(&q);
+
+    int v[5];
+    void *out[5];
+
+    for (int i = 0; i < 5; i++)
+        cc_blocking_queue_enqueue(q, &v[i]);
+
+    cc_blocking_queue_close(q);
+    munit_assert_true(cc_blocking_queue_is_closed(q));
+    munit_assert_int(CC_ERR_CLOSED, ==, cc_blocking_queue_enqueue(q, &v[0]));
+
+    /* Elements enqueued before closing can still be taken */
+    munit_assert_int(CC_OK, ==, cc_blocking_queue_poll(q, &out[0]));
+    munit_assert_ptr_equal(&v[0], out[0]);
+
+    munit_assert_size(4, ==, cc_blocking_queue_drain(q, out, 5));
+    for (int i = 0; i < 4; i++)
+        munit_assert_ptr_equal(&v[i + 1], out[i]);
+
+    munit_assert_int(CC_ERR_CLOSED, ==, cc_blocking_queue_poll(q, &out[0]));
+    munit_assert_int(CC_ERR_CLOSED, ==, cc_blocking_queue_try_poll(q, &out[0]));
+
+    cc_blocking_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+#ifdef BQ_TEST_THREADS
+
+#define PRODUCERS 3
+#define CONSUMERS 3
+#define ITEMS_PER_PRODUCER 20000
+
+struct consumer_state {
+    CC_BlockingQueue *q;
+    uintptr_t         sum;
+    size_t            count;
+};
+
+static void *producer(void *arg)
+{
+    CC_BlockingQueue *q = arg;
+
+    for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++)
+        cc_blocking_queue_enqueue(q, (void*) i);
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    struct consumer_state *s = arg;
+    void *out;
+
+    while (cc_blocking_queue_poll(s->q, &out) == CC_OK) {
+        s->sum += (uintptr_t) out;
+        s->count++;
+    }
+    return NULL;
+}
+
+static MunitResult test_producers_consumers(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_BlockingQueueConf conf;
+    cc_blocking_queue_conf_init(&conf);
+    conf.capacity = 16;
+
+    CC_BlockingQueue *q;
+    cc_blocking_queue_new_conf(&conf, &q);
+
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    struct consumer_state states[CONSUMERS];
+
+    for (int i = 0; i < CONSUMERS; i++) {
+        states[i].q = q;
+        states[i].sum = 0;
+        states[i].count = 0;
+        pthread_create(&consumers[i], NULL, consumer, &states[i]);
+    }
+    for (int i = 0; i < PRODUCERS; i++)
+        pthread_create(&producers[i], NULL, producer, q);
+
+    for (int i = 0; i < PRODUCERS; i++)
+        pthread_join(producers[i], NULL);
+
+    /* Consumers exit once the closed queue is empty */
+    cc_blocking_queue_close(q);
+    for (int i = 0; i < CONSUMERS; i++)
+        pthread_join(consumers[i], NULL);
+
+    uintptr_t sum = 0;
+    size_t count = 0;
+    for (int i = 0; i < CONSUMERS; i++) {
+        sum += states[i].sum;
+        count += states[i].count;
+    }
+    munit_assert_size(PRODUCERS * ITEMS_PER_PRODUCER, ==, count);
+    munit_assert_size((uintptr_t) PRODUCERS * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2, ==, sum);
+
+    cc_blocking_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+static void *close_later(void *arg)
+{
+    struct timespec ts = {0, 20000000};
+    nanosleep(&ts, NULL);
+    cc_blocking_queue_close(arg);
+    return NULL;
+}
+
+static MunitResult test_close_wakes_waiters(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_BlockingQueue *q;
+    cc_blocking_queue_new(&q);
+
+    pthread_t closer;
+    pthread_create(&closer, NULL, close_later, q);
+
+    void *out;
+    munit_assert_int(CC_ERR_CLOSED, ==, cc_blocking_queue_poll(q, &out));
+
+    pthread_join(closer, NULL);
+    cc_blocking_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+#endif
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/blocking_queue/test_try_operations", test_try_operations, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/blocking_queue/test_close_drain", test_close_drain, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef BQ_TEST_THREADS
+    {(char*)"/blocking_queue/test_producers_consumers", test_producers_consumers, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/blocking_queue/test_close_wakes_waiters", test_close_wakes_waiters, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
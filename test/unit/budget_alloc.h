@@ -0,0 +1,22 @@
+#ifndef COLLECTIONS_C_TEST_BUDGET_ALLOC_H
+#define COLLECTIONS_C_TEST_BUDGET_ALLOC_H
+
+#include <stdlib.h>
+
+/*
+ * Allocators that fail once a budget of allocations runs out. Set
+ * alloc_budget to the number of allocations that may still succeed.
+ */
+static int alloc_budget;
+
+static void* budget_alloc(size_t size)
+{
+    return alloc_budget-- > 0 ? malloc(size) : NULL;
+}
+
+static void* budget_calloc(size_t blocks, size_t size)
+{
+    return alloc_budget-- > 0 ? calloc(blocks, size) : NULL;
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "munit.h"
+#include "cc_byte_ring_buffer.h"
+#include <stdlib.h>
+
+
+static MunitResult test_new(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ByteRbufConf conf;
+    cc_byte_rbuf_conf_init(&conf);
+    conf.capacity = 1000;
+
+    CC_ByteRbuf *rbuf;
+    munit_assert_int(CC_OK, ==, cc_byte_rbuf_new_conf(&conf, &rbuf));
+
+    size_t capacity = cc_byte_rbuf_capacity(rbuf);
+    munit_assert_size(capacity, >=, 1000);
+    munit_assert_size(0, ==, capacity & (capacity - 1));
+    munit_assert_size(capacity, ==, cc_byte_rbuf_free_space(rbuf));
+    munit_assert_size(0, ==, cc_byte_rbuf_size(rbuf));
+
+    cc_byte_rbuf_destroy(rbuf);
+
+    conf.capacity = 0;
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_byte_rbuf_new_conf(&conf, &rbuf));
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_reserve_commit(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ByteRbuf *rbuf;
+    cc_byte_rbuf_new(&rbuf);
+
+    size_t capacity = cc_byte_rbuf_capacity(rbuf);
+    void *w;
+    void *r;
+
+    munit_assert_int(CC_OK, ==, cc_byte_rbuf_reserve(rbuf, capacity, &w));
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_byte_rbuf_reserve(rbuf, capacity + 1, &w));
+
+    memset(w, 'a', 100);
+    munit_assert_size(0, ==, cc_byte_rbuf_size(rbuf));
+    munit_assert_int(CC_OK, ==, cc_byte_rbuf_commit(rbuf, 100));
+    munit_assert_size(100, ==, cc_byte_rbuf_size(rbuf));
+
+    munit_assert_size(100, ==, cc_byte_rbuf_peek(rbuf, &r));
+    munit_assert_ptr_equal(w, r);
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_byte_rbuf_consume(rbuf, 101));
+    munit_assert_int(CC_OK, ==, cc_byte_rbuf_consume(rbuf, 60));
+    munit_assert_size(40, ==, cc_byte_rbuf_peek(rbuf, &r));
+    munit_assert_ptr_equal((char*) w + 60, r);
+
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_byte_rbuf_reserve(rbuf, capacity - 39, &w));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_byte_rbuf_commit(rbuf, capacity - 39));
+
+    cc_byte_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_contiguous_wrap(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ByteRbuf *rbuf;
+    cc_byte_rbuf_new(&rbuf);
+
+    size_t capacity = cc_byte_rbuf_capacity(rbuf);
+    size_t offset   = capacity - 10;
+    char  *fill     = malloc(offset);
+    char  *w;
+    char  *r;
+
+    /* Move the read and write positions close to the end */
+    memset(fill, 'x', offset);
+    munit_assert_size(offset, ==, cc_byte_rbuf_write(rbuf, fill, offset));
+    munit_assert_size(offset, ==, cc_byte_rbuf_read(rbuf, fill, offset));
+
+    /* A region that wraps around is still contiguous */
+    munit_assert_int(CC_OK, ==, cc_byte_rbuf_reserve(rbuf, 64, (void**) &w));
+    for (int i = 0; i < 64; i++)
+        w[i] = (char) i;
+    cc_byte_rbuf_commit(rbuf, 64);
+
+    munit_assert_size(64, ==, cc_byte_rbuf_peek(rbuf, (void**) &r));
+    for (int i = 0; i < 64; i++)
+        munit_assert_char((char) i, ==, r[i]);
+
+    cc_byte_rbuf_consume(rbuf, 10);
+    munit_assert_size(54, ==, cc_byte_rbuf_peek(rbuf, (void**) &r));
+    munit_assert_char(10, ==, r[0]);
+
+    char out[54];
+    munit_assert_size(54, ==, cc_byte_rbuf_read(rbuf, out, 100));
+    munit_assert_char(63, ==, out[53]);
+    munit_assert_size(0, ==, cc_byte_rbuf_read(rbuf, out, 1));
+
+    free(fill);
+    cc_byte_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/byte_ring_buffer/test_new", test_new, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/byte_ring_buffer/test_reserve_commit", test_reserve_commit, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/byte_ring_buffer/test_contiguous_wrap", test_contiguous_wrap, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
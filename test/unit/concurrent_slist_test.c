@@ -0,0 +1,276 @@
+#include "munit.h"
+#include "cc_concurrent_slist.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#define CSL_TEST_THREADS
+#endif
+
+
+static int cmp_key(const void *e1, const void *e2)
+{
+    uintptr_t a = (uintptr_t) e1;
+    uintptr_t b = (uintptr_t) e2;
+    return (a > b) - (a < b);
+}
+
+#define KEY(k) ((void*) (uintptr_t) (k))
+
+static MunitResult test_add_remove(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentSList *list;
+    munit_assert_int(CC_OK, ==, cc_concurrent_slist_new(cmp_key, &list));
+
+    void *out;
+
+    munit_assert_size(0, ==, cc_concurrent_slist_size(list));
+    munit_assert_false(cc_concurrent_slist_contains(list, KEY(1)));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_concurrent_slist_remove(list, KEY(1), &out));
+
+    /* Odd keys ascending, even keys descending */
+    for (int i = 1; i < 100; i += 2)
+        munit_assert_int(CC_OK, ==, cc_concurrent_slist_add(list, KEY(i)));
+    for (int i = 100; i > 0; i -= 2)
+        munit_assert_int(CC_OK, ==, cc_concurrent_slist_add(list, KEY(i)));
+
+    munit_assert_int(CC_ERR_DUPLICATE, ==, cc_concurrent_slist_add(list, KEY(50)));
+    munit_assert_size(100, ==, cc_concurrent_slist_size(list));
+
+    for (int i = 1; i <= 100; i++)
+        munit_assert_true(cc_concurrent_slist_contains(list, KEY(i)));
+    munit_assert_false(cc_concurrent_slist_contains(list, KEY(101)));
+
+    munit_assert_int(CC_OK, ==, cc_concurrent_slist_get(list, KEY(7), &out));
+    munit_assert_ptr_equal(KEY(7), out);
+
+    for (int i = 1; i <= 100; i += 3) {
+        munit_assert_int(CC_OK, ==, cc_concurrent_slist_remove(list, KEY(i), &out));
+        munit_assert_ptr_equal(KEY(i), out);
+        munit_assert_false(cc_concurrent_slist_contains(list, KEY(i)));
+        munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_concurrent_slist_remove(list, KEY(i), NULL));
+    }
+    munit_assert_size(66, ==, cc_concurrent_slist_size(list));
+
+    /* Removed keys can be added again */
+    munit_assert_int(CC_OK, ==, cc_concurrent_slist_add(list, KEY(1)));
+    munit_assert_true(cc_concurrent_slist_contains(list, KEY(1)));
+
+    cc_concurrent_slist_destroy(list);
+    return MUNIT_OK;
+}
+
+static size_t visited;
+
+static void count_visit(void *e)
+{
+    (void)e;
+    visited++;
+}
+
+static MunitResult test_iter(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentSList *list;
+    cc_concurrent_slist_new(cmp_key, &list);
+
+    for (int i = 0; i < 50; i++)
+        cc_concurrent_slist_add(list, KEY(munit_rand_int_range(1, 1000)));
+
+    size_t n = cc_concurrent_slist_size(list);
+    CC_ConcurrentSListIter iter;
+    cc_concurrent_slist_iter_init(&iter, list);
+
+    uintptr_t prev = 0;
+    size_t count = 0;
+    void *e;
+    while (cc_concurrent_slist_iter_next(&iter, &e) != CC_ITER_END) {
+        munit_assert_uint64(prev, <, (uintptr_t) e);
+        prev = (uintptr_t) e;
+        count++;
+
+        /* Removing the current element does not disturb the iteration */
+        if (count % 5 == 0)
+            cc_concurrent_slist_remove(list, e, NULL);
+    }
+    munit_assert_size(n, ==, count);
+    munit_assert_int(CC_ITER_END, ==, cc_concurrent_slist_iter_next(&iter, &e));
+
+    /* An abandoned iteration */
+    cc_concurrent_slist_iter_init(&iter, list);
+    cc_concurrent_slist_iter_next(&iter, &e);
+    cc_concurrent_slist_iter_done(&iter);
+    cc_concurrent_slist_iter_done(&iter);
+
+    visited = 0;
+    cc_concurrent_slist_foreach(list, count_visit);
+    munit_assert_size(n - n / 5, ==, visited);
+
+    cc_concurrent_slist_destroy(list);
+    return MUNIT_OK;
+}
+
+static int freed;
+
+static void free_element(void *e)
+{
+    freed++;
+    free(e);
+}
+
+static int cmp_int(const void *e1, const void *e2)
+{
+    return *((const int*) e1) - *((const int*) e2);
+}
+
+static MunitResult test_destroy_cb(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentSList *list;
+    cc_concurrent_slist_new(cmp_int, &list);
+
+    for (int i = 0; i < 10; i++) {
+        int *v = malloc(sizeof(int));
+        *v = i;
+        cc_concurrent_slist_add(list, v);
+    }
+
+    void *out;
+    int key = 3;
+    cc_concurrent_slist_remove(list, &key, &out);
+    free(out);
+
+    freed = 0;
+    cc_concurrent_slist_destroy_cb(list, free_element);
+    munit_assert_int(9, ==, freed);
+
+    return MUNIT_OK;
+}
+
+#ifdef CSL_TEST_THREADS
+
+#define THREADS 4
+#define KEYS    2000
+#define ROUNDS  4
+
+static CC_ConcurrentSList *shared;
+static atomic_int          wins[KEYS + 1];
+static atomic_bool         running;
+
+/* Every thread adds and removes the same keys, so that every add and
+ * remove races with the others. Exactly one thread wins each race. */
+static void *racer(void *arg)
+{
+    uintptr_t id = (uintptr_t) arg;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uintptr_t k = 1; k <= KEYS; k++) {
+            uintptr_t key = (k * 7 + id * 13) % KEYS + 1;
+            if (cc_concurrent_slist_add(shared, KEY(key)) == CC_OK)
+                atomic_fetch_add(&wins[key], 1);
+        }
+        for (uintptr_t k = KEYS; k > 0; k--) {
+            uintptr_t key = (k * 11 + id * 3) % KEYS + 1;
+            if (cc_concurrent_slist_remove(shared, KEY(key), NULL) == CC_OK)
+                atomic_fetch_sub(&wins[key], 1);
+        }
+        sched_yield();
+    }
+    return NULL;
+}
+
+/* Iterates while the racers run and checks that the order holds */
+static void *reader(void *arg)
+{
+    (void)arg;
+    size_t errors = 0;
+
+    while (atomic_load(&running)) {
+        CC_ConcurrentSListIter iter;
+        uintptr_t prev = 0;
+        void *e;
+
+        cc_concurrent_slist_iter_init(&iter, shared);
+        while (cc_concurrent_slist_iter_next(&iter, &e) != CC_ITER_END) {
+            if ((uintptr_t) e <= prev)
+                errors++;
+            prev = (uintptr_t) e;
+        }
+        cc_concurrent_slist_contains(shared, KEY(KEYS / 2));
+    }
+    return (void*) errors;
+}
+
+static MunitResult test_concurrent(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    munit_assert_int(CC_OK, ==, cc_concurrent_slist_new(cmp_key, &shared));
+
+    for (int i = 0; i <= KEYS; i++)
+        atomic_init(&wins[i], 0);
+    atomic_store(&running, true);
+
+    pthread_t readers[2];
+    pthread_t racers[THREADS];
+    for (uintptr_t i = 0; i < 2; i++)
+        pthread_create(&readers[i], NULL, reader, NULL);
+    for (uintptr_t i = 0; i < THREADS; i++)
+        pthread_create(&racers[i], NULL, racer, (void*) i);
+
+    for (int i = 0; i < THREADS; i++)
+        pthread_join(racers[i], NULL);
+
+    atomic_store(&running, false);
+    for (int i = 0; i < 2; i++) {
+        void *errors;
+        pthread_join(readers[i], &errors);
+        munit_assert_ptr_equal(NULL, errors);
+    }
+
+    /* Every key that is left was added once more than it was removed */
+    size_t left = 0;
+    for (uintptr_t k = 1; k <= KEYS; k++) {
+        int w = atomic_load(&wins[k]);
+        munit_assert_int(w, >=, 0);
+        munit_assert_int(w, <=, 1);
+        munit_assert_int(w == 1, ==, cc_concurrent_slist_contains(shared, KEY(k)));
+        left += w;
+    }
+    munit_assert_size(left, ==, cc_concurrent_slist_size(shared));
+
+    cc_concurrent_slist_destroy(shared);
+    return MUNIT_OK;
+}
+
+#endif
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/concurrent_slist/test_add_remove", test_add_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/concurrent_slist/test_iter", test_iter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/concurrent_slist/test_destroy_cb", test_destroy_cb, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef CSL_TEST_THREADS
+    {(char*)"/concurrent_slist/test_concurrent", test_concurrent, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
@@ -0,0 +1,217 @@
+#include "munit.h"
+#include "cc_concurrent_stack.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#define CS_TEST_THREADS
+#endif
+
+
+static MunitResult test_push_pop(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentStack *s;
+    munit_assert_int(CC_OK, ==, cc_concurrent_stack_new(&s));
+
+    int v[200];
+    void *out;
+
+    munit_assert_true(cc_concurrent_stack_is_empty(s));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_concurrent_stack_pop(s, &out));
+
+    /* Enough elements to span several node segments */
+    for (int i = 0; i < 200; i++)
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_push(s, &v[i]));
+    munit_assert_false(cc_concurrent_stack_is_empty(s));
+
+    for (int i = 199; i >= 0; i--) {
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_pop(s, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    munit_assert_true(cc_concurrent_stack_is_empty(s));
+
+    /* Recycled nodes */
+    for (int i = 0; i < 3; i++)
+        cc_concurrent_stack_push(s, &v[i]);
+    for (int i = 2; i >= 0; i--) {
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_pop(s, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+
+    cc_concurrent_stack_destroy(s);
+    return MUNIT_OK;
+}
+
+static MunitResult test_push_n(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentStack *s;
+    cc_concurrent_stack_new(&s);
+
+    int v[5];
+    void *els[4] = {&v[1], &v[2], &v[3], &v[4]};
+    void *out;
+
+    munit_assert_int(CC_OK, ==, cc_concurrent_stack_push_n(s, els, 0));
+    munit_assert_true(cc_concurrent_stack_is_empty(s));
+
+    cc_concurrent_stack_push(s, &v[0]);
+    munit_assert_int(CC_OK, ==, cc_concurrent_stack_push_n(s, els, 4));
+
+    for (int i = 4; i >= 0; i--) {
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_pop(s, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_concurrent_stack_pop(s, &out));
+
+    cc_concurrent_stack_destroy(s);
+    return MUNIT_OK;
+}
+
+#ifdef CS_TEST_THREADS
+
+#define THREADS 4
+#define ITEMS   20000
+
+static CC_ConcurrentStack *shared;
+static unsigned char taken[THREADS * ITEMS];
+static size_t counts[THREADS];
+
+static void *worker(void *arg)
+{
+    uintptr_t id = (uintptr_t) arg;
+    void *out;
+
+    /* Every thread pushes its own range and pops whatever it finds */
+    for (uintptr_t i = 0; i < ITEMS; i++) {
+        if (i % 4 == 3) {
+            void *batch[2] = {(void*) (id * ITEMS + i), (void*) (id * ITEMS + i - 1)};
+            cc_concurrent_stack_push_n(shared, batch, 2);
+        } else if (i % 4 != 2) {
+            cc_concurrent_stack_push(shared, (void*) (id * ITEMS + i));
+        }
+        if (i % 2 && cc_concurrent_stack_pop(shared, &out) == CC_OK) {
+            taken[(uintptr_t) out]++;
+            counts[id]++;
+        }
+        if (i % 64 == 0)
+            sched_yield();
+    }
+    return NULL;
+}
+
+static MunitResult test_concurrent(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentStackConf conf;
+    cc_concurrent_stack_conf_init(&conf);
+    conf.elimination_slots = 4;
+    munit_assert_int(CC_OK, ==, cc_concurrent_stack_new_conf(&conf, &shared));
+
+    memset(taken, 0, sizeof(taken));
+    memset(counts, 0, sizeof(counts));
+
+    pthread_t threads[THREADS];
+    for (uintptr_t i = 0; i < THREADS; i++)
+        pthread_create(&threads[i], NULL, worker, (void*) i);
+
+    size_t popped = 0;
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        popped += counts[i];
+    }
+
+    void *out;
+    while (cc_concurrent_stack_pop(shared, &out) == CC_OK) {
+        taken[(uintptr_t) out]++;
+        popped++;
+    }
+
+    munit_assert_size(THREADS * ITEMS, ==, popped);
+    for (size_t i = 0; i < THREADS * ITEMS; i++)
+        munit_assert_uint8(1, ==, taken[i]);
+
+    cc_concurrent_stack_destroy(shared);
+    return MUNIT_OK;
+}
+
+#endif
+
+static int segment_allocs;
+static bool fail_allocs;
+
+static void* counting_calloc(size_t blocks, size_t size)
+{
+    if (fail_allocs)
+        return NULL;
+    segment_allocs++;
+    return calloc(blocks, size);
+}
+
+static MunitResult test_alloc_failure(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_ConcurrentStackConf conf;
+    cc_concurrent_stack_conf_init(&conf);
+    conf.mem_calloc = counting_calloc;
+
+    CC_ConcurrentStack *s;
+    fail_allocs = false;
+    munit_assert_int(CC_OK, ==, cc_concurrent_stack_new_conf(&conf, &s));
+
+    int v[192];
+    void *out;
+
+    /* Fill the first segment of 64 nodes */
+    for (int i = 0; i < 64; i++)
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_push(s, &v[i]));
+
+    fail_allocs = true;
+    munit_assert_int(CC_ERR_ALLOC, ==, cc_concurrent_stack_push(s, &v[64]));
+    fail_allocs = false;
+
+    /* The failed push gave up no node, so the next 128 pushes fit exactly
+     * into the second segment */
+    segment_allocs = 0;
+    for (int i = 64; i < 192; i++)
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_push(s, &v[i]));
+    munit_assert_int(1, ==, segment_allocs);
+
+    for (int i = 191; i >= 0; i--) {
+        munit_assert_int(CC_OK, ==, cc_concurrent_stack_pop(s, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+
+    cc_concurrent_stack_destroy(s);
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/concurrent_stack/test_push_pop", test_push_pop, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/concurrent_stack/test_push_n", test_push_n, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/concurrent_stack/test_alloc_failure", test_alloc_failure, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef CS_TEST_THREADS
+    {(char*)"/concurrent_stack/test_concurrent", test_concurrent, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
@@ -1,5 +1,8 @@
 #include "munit.h"
 #include "cc_deque.h"
+#include "cc_array.h"
+#include "cc_list.h"
+#include "cc_slist.h"
 #include <stdlib.h>
 
 
@@ -99,6 +102,96 @@ static MunitResult test_add_last(const MunitParameter params[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_add_all(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_DequeConf conf;
+    cc_deque_conf_init(&conf);
+    conf.capacity = 4;
+
+    CC_Deque* deque;
+    cc_deque_new_conf(&conf, &deque);
+
+    int v[10];
+    void* els[10];
+    for (int i = 0; i < 10; i++)
+        els[i] = &v[i];
+
+    /* Move the first index so the added elements wrap around */
+    cc_deque_add_last(deque, els[0]);
+    cc_deque_add_last(deque, els[0]);
+    cc_deque_add_last(deque, els[0]);
+    cc_deque_remove_first_n(deque, NULL, 3);
+
+    munit_assert_int(CC_OK, ==, cc_deque_add_all(deque, &els[4], 3));
+    munit_assert_int(CC_OK, ==, cc_deque_add_all_first(deque, els, 4));
+    munit_assert_int(CC_OK, ==, cc_deque_add_all(deque, &els[7], 3));
+    munit_assert_size(10, ==, cc_deque_size(deque));
+
+    /* add_all_first behaves like repeated add_first */
+    int order[10] = {3, 2, 1, 0, 4, 5, 6, 7, 8, 9};
+    void* e;
+    for (int i = 0; i < 10; i++) {
+        cc_deque_get_at(deque, i, &e);
+        munit_assert_ptr_equal(&v[order[i]], e);
+    }
+
+    cc_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+static MunitResult test_remove_n(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_DequeConf conf;
+    cc_deque_conf_init(&conf);
+    conf.capacity = 8;
+
+    CC_Deque* deque;
+    cc_deque_new_conf(&conf, &deque);
+
+    int v[8];
+    void* els[8];
+    for (int i = 0; i < 8; i++)
+        els[i] = &v[i];
+
+    cc_deque_add_all(deque, els, 6);
+    cc_deque_remove_first_n(deque, NULL, 5);
+    cc_deque_add_all(deque, &els[1], 7);
+
+    void* out[8];
+    munit_assert_size(3, ==, cc_deque_remove_first_n(deque, out, 3));
+    munit_assert_ptr_equal(&v[5], out[0]);
+    munit_assert_ptr_equal(&v[1], out[1]);
+    munit_assert_ptr_equal(&v[2], out[2]);
+
+    munit_assert_size(2, ==, cc_deque_remove_last_n(deque, out, 2));
+    munit_assert_ptr_equal(&v[7], out[0]);
+    munit_assert_ptr_equal(&v[6], out[1]);
+
+    munit_assert_size(3, ==, cc_deque_remove_last_n(deque, out, 8));
+    munit_assert_ptr_equal(&v[5], out[0]);
+    munit_assert_ptr_equal(&v[3], out[2]);
+    munit_assert_size(0, ==, cc_deque_remove_first_n(deque, out, 1));
+
+    void** array;
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_deque_drain_to_array(deque, &array));
+
+    cc_deque_add_all(deque, els, 3);
+    munit_assert_int(CC_OK, ==, cc_deque_drain_to_array(deque, &array));
+    munit_assert_size(0, ==, cc_deque_size(deque));
+    for (int i = 0; i < 3; i++)
+        munit_assert_ptr_equal(&v[i], array[i]);
+
+    free(array);
+    cc_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
 static MunitResult test_add_at1(const MunitParameter params[], void* fixture)
 {
     (void)params;
@@ -1372,11 +1465,124 @@ static MunitResult test_filter_mut3(const MunitParameter params[], void* fixture
     return MUNIT_OK;
 }
 
+static MunitResult test_release_buffer(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[12];
+    void** buffer = malloc(6 * sizeof(void*));
+
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_deque_from_buffer(buffer, 4, 6, NULL));
+    buffer = realloc(buffer, 8 * sizeof(void*));
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_deque_from_buffer(buffer, 9, 8, NULL));
+
+    for (int i = 0; i < 8; i++)
+        buffer[i] = &v[i + 2];
+
+    /* A full buffer is taken over as is */
+    CC_Deque* deque;
+    munit_assert_int(CC_OK, ==, cc_deque_from_buffer(buffer, 8, 8, &deque));
+    munit_assert_size(8, ==, cc_deque_capacity(deque));
+
+    void* e;
+    cc_deque_get_last(deque, &e);
+    munit_assert_ptr_equal(&v[9], e);
+
+    /* Wrap the elements around the end of the ring */
+    cc_deque_remove_last(deque, &e);
+    cc_deque_remove_last(deque, &e);
+    cc_deque_add_first(deque, &v[1]);
+    cc_deque_add_first(deque, &v[0]);
+    munit_assert_size(8, ==, cc_deque_capacity(deque));
+
+    size_t size;
+    size_t capacity;
+    cc_deque_release_buffer(deque, &buffer, &size, &capacity);
+    munit_assert_size(8, ==, size);
+    munit_assert_size(8, ==, capacity);
+
+    for (size_t i = 0; i < size; i++)
+        munit_assert_ptr_equal(&v[i], buffer[i]);
+
+    /* The released buffer makes an array without another copy */
+    CC_Array* ar;
+    munit_assert_int(CC_OK, ==, cc_array_from_buffer(buffer, size, capacity, &ar));
+    cc_array_add(ar, &v[8]);
+    cc_array_get_at(ar, 7, &e);
+    munit_assert_ptr_equal(&v[7], e);
+
+    cc_array_remove_last(ar, &e);
+    cc_array_release_buffer(ar, &buffer, &size, &capacity);
+    munit_assert_size(8, ==, size);
+    munit_assert_size(16, ==, capacity);
+
+    munit_assert_int(CC_OK, ==, cc_deque_from_buffer(buffer, size, capacity, &deque));
+    cc_deque_get_at(deque, 5, &e);
+    munit_assert_ptr_equal(&v[5], e);
+    cc_deque_add_last(deque, &v[8]);
+    munit_assert_size(9, ==, cc_deque_size(deque));
+
+    cc_deque_destroy(deque);
+    return MUNIT_OK;
+}
+
+static MunitResult test_from_list(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[20];
+
+    CC_List* list;
+    CC_SList* slist;
+    cc_list_new(&list);
+    cc_slist_new(&slist);
+    for (int i = 0; i < 10; i++) {
+        cc_list_add(list, &v[i]);
+        cc_slist_add(slist, &v[10 + i]);
+    }
+
+    /* The buffer is rounded up to a power of two */
+    CC_Deque* d1;
+    CC_Deque* d2;
+    munit_assert_int(CC_OK, ==, cc_deque_from_list(list, &d1));
+    munit_assert_int(CC_OK, ==, cc_deque_from_slist(slist, &d2));
+    munit_assert_size(0, ==, cc_list_size(list));
+    munit_assert_size(0, ==, cc_slist_size(slist));
+    munit_assert_size(10, ==, cc_deque_size(d1));
+    munit_assert_size(16, ==, cc_deque_capacity(d1));
+
+    void* e;
+    for (int i = 0; i < 10; i++) {
+        cc_deque_get_at(d1, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+        cc_deque_get_at(d2, i, &e);
+        munit_assert_ptr_equal(&v[10 + i], e);
+    }
+
+    /* Both ends work on the adopted buffer */
+    cc_deque_add_first(d1, &v[19]);
+    cc_deque_add_last(d1, &v[18]);
+    cc_deque_get_first(d1, &e);
+    munit_assert_ptr_equal(&v[19], e);
+    cc_deque_get_last(d1, &e);
+    munit_assert_ptr_equal(&v[18], e);
+
+    cc_deque_destroy(d1);
+    cc_deque_destroy(d2);
+    cc_list_destroy(list);
+    cc_slist_destroy(slist);
+    return MUNIT_OK;
+}
+
 static MunitTest test_suite_tests[] = {
     {(char*)"/deque/test_add_first", test_add_first, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_last", test_add_last, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_at1", test_add_at1, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_at2", test_add_at2, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/deque/test_add_all", test_add_all, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/deque/test_remove_n", test_remove_n, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_at3", test_add_at3, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_at4", test_add_at4, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_add_at5", test_add_at5, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -1392,6 +1598,8 @@ static MunitTest test_suite_tests[] = {
     {(char*)"/deque/test_size", test_size, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_capacity", test_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_trim_capacity", test_trim_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/deque/test_release_buffer", test_release_buffer, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/deque/test_from_list", test_from_list, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_reverse", test_reverse, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_iterator_add", test_iterator_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/deque/test_iterator_remove", test_iterator_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -0,0 +1,338 @@
+#include "munit.h"
+#include "cc_ilist.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+typedef struct item_s {
+    int          value;
+    CC_IListLink by_order;
+    CC_IListLink by_parity;
+} Item;
+
+static CC_IList* new_list(size_t offset)
+{
+    CC_IList* list;
+    munit_assert_int(CC_OK, ==, cc_ilist_new(offset, &list));
+    return list;
+}
+
+static void assert_values(CC_IList* list, int* expected, size_t n)
+{
+    munit_assert_size(n, ==, cc_ilist_size(list));
+
+    size_t i = 0;
+    CC_ILIST_FOREACH(e, list, {
+        munit_assert_int(expected[i], ==, ((Item*) e)->value);
+        i++;
+    })
+    munit_assert_size(n, ==, i);
+}
+
+static bool is_even(const void* e)
+{
+    return ((const Item*) e)->value % 2 == 0;
+}
+
+static int freed;
+
+static void free_item(void* e)
+{
+    freed++;
+    free(e);
+}
+
+static MunitResult test_add_remove(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* list = new_list(offsetof(Item, by_order));
+    Item items[10] = {0};
+    void* e;
+
+    for (int i = 0; i < 10; i++)
+        items[i].value = i;
+
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_remove_first(list, &e));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_remove(list, &items[0]));
+
+    cc_ilist_add(list, &items[2]);
+    cc_ilist_add_first(list, &items[0]);
+    cc_ilist_add_last(list, &items[4]);
+    cc_ilist_add_at(list, &items[1], 1);
+    cc_ilist_add_at(list, &items[3], 3);
+    cc_ilist_add_after(list, &items[4], &items[6]);
+    cc_ilist_add_before(list, &items[6], &items[5]);
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ilist_add_at(list, &items[9], 9));
+
+    int expected[] = {0, 1, 2, 3, 4, 5, 6};
+    assert_values(list, expected, 7);
+
+    munit_assert_true(cc_ilist_is_linked(list, &items[3]));
+    munit_assert_false(cc_ilist_is_linked(list, &items[9]));
+    munit_assert_size(1, ==, cc_ilist_contains(list, &items[3]));
+    munit_assert_size(0, ==, cc_ilist_contains(list, &items[9]));
+
+    size_t index;
+    munit_assert_int(CC_OK, ==, cc_ilist_index_of(list, &items[5], &index));
+    munit_assert_size(5, ==, index);
+
+    cc_ilist_get_at(list, 4, &e);
+    munit_assert_ptr_equal(&items[4], e);
+    cc_ilist_get_next(list, &items[4], &e);
+    munit_assert_ptr_equal(&items[5], e);
+    cc_ilist_get_prev(list, &items[4], &e);
+    munit_assert_ptr_equal(&items[3], e);
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_get_next(list, &items[6], &e));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_get_prev(list, &items[0], &e));
+
+    munit_assert_int(CC_OK, ==, cc_ilist_remove(list, &items[3]));
+    munit_assert_false(cc_ilist_is_linked(list, &items[3]));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_remove(list, &items[3]));
+
+    cc_ilist_remove_first(list, &e);
+    munit_assert_ptr_equal(&items[0], e);
+    cc_ilist_remove_last(list, &e);
+    munit_assert_ptr_equal(&items[6], e);
+    cc_ilist_remove_at(list, 1, &e);
+    munit_assert_ptr_equal(&items[2], e);
+
+    int remaining[] = {1, 4, 5};
+    assert_values(list, remaining, 3);
+
+    cc_ilist_reverse(list);
+    int reversed[] = {5, 4, 1};
+    assert_values(list, reversed, 3);
+
+    cc_ilist_get_first(list, &e);
+    munit_assert_ptr_equal(&items[5], e);
+    cc_ilist_get_last(list, &e);
+    munit_assert_ptr_equal(&items[1], e);
+
+    /* Removed elements can be linked again */
+    cc_ilist_add(list, &items[0]);
+    cc_ilist_remove_all(list);
+    munit_assert_size(0, ==, cc_ilist_size(list));
+    munit_assert_false(cc_ilist_is_linked(list, &items[5]));
+
+    cc_ilist_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_two_lists(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* order  = new_list(offsetof(Item, by_order));
+    CC_IList* parity = new_list(offsetof(Item, by_parity));
+
+    for (int i = 0; i < 10; i++) {
+        Item* item = calloc(1, sizeof(Item));
+        item->value = i;
+        cc_ilist_add(order, item);
+        if (i % 2 == 0)
+            cc_ilist_add(parity, item);
+    }
+
+    int evens[] = {0, 2, 4, 6, 8};
+    assert_values(parity, evens, 5);
+
+    /* Removing from one list leaves the other one intact */
+    void* e;
+    cc_ilist_get_at(parity, 2, &e);
+    cc_ilist_remove(order, e);
+    munit_assert_size(9, ==, cc_ilist_size(order));
+    assert_values(parity, evens, 5);
+
+    cc_ilist_remove_all(parity);
+    cc_ilist_add(order, e);
+
+    freed = 0;
+    cc_ilist_destroy(parity);
+    cc_ilist_destroy_cb(order, free_item);
+    munit_assert_int(10, ==, freed);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_iter(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* list = new_list(offsetof(Item, by_order));
+    Item items[20] = {0};
+
+    for (int i = 0; i < 20; i++)
+        items[i].value = i;
+    for (int i = 0; i < 10; i++)
+        cc_ilist_add(list, &items[i]);
+
+    CC_IListIter iter;
+    cc_ilist_iter_init(&iter, list);
+
+    void* e;
+    while (cc_ilist_iter_next(&iter, &e) != CC_ITER_END) {
+        int v = ((Item*) e)->value;
+        munit_assert_size(v, ==, cc_ilist_iter_index(&iter));
+
+        if (v == 2) {
+            void* out;
+            munit_assert_int(CC_OK, ==, cc_ilist_iter_remove(&iter, &out));
+            munit_assert_ptr_equal(e, out);
+            munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_ilist_iter_remove(&iter, NULL));
+            cc_ilist_iter_add(&iter, &items[12]);
+        } else if (v == 5) {
+            void* out;
+            cc_ilist_iter_replace(&iter, &items[15], &out);
+            munit_assert_ptr_equal(&items[5], out);
+            munit_assert_false(cc_ilist_is_linked(list, &items[5]));
+        } else if (v == 9) {
+            cc_ilist_iter_add(&iter, &items[19]);
+        }
+    }
+
+    int expected[] = {0, 1, 12, 3, 4, 15, 6, 7, 8, 9, 19};
+    assert_values(list, expected, 11);
+
+    cc_ilist_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_splice(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* list1 = new_list(offsetof(Item, by_order));
+    CC_IList* list2 = new_list(offsetof(Item, by_order));
+    Item items[12] = {0};
+
+    for (int i = 0; i < 12; i++)
+        items[i].value = i;
+    for (int i = 0; i < 4; i++)
+        cc_ilist_add(list1, &items[i]);
+    for (int i = 8; i < 12; i++)
+        cc_ilist_add(list2, &items[i]);
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ilist_splice_at(list1, list2, 5));
+
+    cc_ilist_splice(list1, list2);
+    munit_assert_size(0, ==, cc_ilist_size(list2));
+
+    for (int i = 4; i < 8; i++)
+        cc_ilist_add(list2, &items[i]);
+
+    cc_ilist_splice_at(list1, list2, 4);
+
+    int expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    assert_values(list1, expected, 12);
+    munit_assert_size(0, ==, cc_ilist_size(list2));
+
+    /* The spliced list remains usable */
+    void* e;
+    cc_ilist_remove_first(list1, &e);
+    cc_ilist_add(list2, e);
+    int rest[] = {0};
+    assert_values(list2, rest, 1);
+
+    cc_ilist_destroy(list1);
+    cc_ilist_destroy(list2);
+    return MUNIT_OK;
+}
+
+static MunitResult test_filter_mut(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* list = new_list(offsetof(Item, by_parity));
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ilist_filter_mut(list, is_even));
+
+    for (int i = 0; i < 10; i++) {
+        Item* item = calloc(1, sizeof(Item));
+        item->value = i;
+        cc_ilist_add(list, item);
+    }
+
+    freed = 0;
+    munit_assert_int(CC_OK, ==, cc_ilist_filter_mut_cb(list, is_even, free_item));
+    munit_assert_int(5, ==, freed);
+
+    int expected[] = {0, 2, 4, 6, 8};
+    assert_values(list, expected, 5);
+
+    cc_ilist_destroy_cb(list, free);
+    return MUNIT_OK;
+}
+
+
+static MunitResult test_add_linked(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_IList* list1 = new_list(offsetof(Item, by_order));
+    CC_IList* list2 = new_list(offsetof(Item, by_order));
+    Item items[4] = {0};
+
+    for (int i = 0; i < 4; i++)
+        items[i].value = i;
+
+    cc_ilist_add(list1, &items[0]);
+    cc_ilist_add(list1, &items[1]);
+    cc_ilist_add(list2, &items[2]);
+
+    /* An element that is already linked is rejected by every list */
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add(list1, &items[1]));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add_first(list1, &items[1]));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add_last(list2, &items[0]));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add_at(list1, &items[2], 1));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add_after(list1, &items[0], &items[1]));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_add_before(list1, &items[0], &items[1]));
+
+    CC_IListIter iter;
+    void* e;
+    cc_ilist_iter_init(&iter, list1);
+    cc_ilist_iter_next(&iter, &e);
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_iter_add(&iter, &items[2]));
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_ilist_iter_replace(&iter, &items[1], &e));
+
+    int expected1[] = {0, 1};
+    int expected2[] = {2};
+    assert_values(list1, expected1, 2);
+    assert_values(list2, expected2, 1);
+
+    /* Once unlinked, the element can be added again */
+    cc_ilist_remove(list2, &items[2]);
+    munit_assert_int(CC_OK, ==, cc_ilist_iter_add(&iter, &items[2]));
+    munit_assert_int(CC_OK, ==, cc_ilist_add(list2, &items[3]));
+
+    int expected3[] = {0, 2, 1};
+    assert_values(list1, expected3, 3);
+
+    cc_ilist_destroy(list1);
+    cc_ilist_destroy(list2);
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/ilist/test_add_remove", test_add_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ilist/test_two_lists", test_two_lists, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ilist/test_iter", test_iter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ilist/test_splice", test_splice, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ilist/test_filter_mut", test_filter_mut, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ilist/test_add_linked", test_add_linked, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
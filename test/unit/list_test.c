@@ -1,5 +1,7 @@
 #include "munit.h"
 #include "cc_list.h"
+#include "budget_alloc.h"
+#include "memory/cc_dynamic_pool.h"
 #include <stdlib.h>
 #include <stdbool.h>
 
@@ -1215,14 +1217,621 @@ static MunitResult test_reduce2(const MunitParameter params[], void* fixture)
 }
 
 
+static MunitResult test_node_pool(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_ListConf conf;
+    cc_list_conf_init(&conf);
+    conf.pool_chunk_size = 4;
+
+    CC_List* list1;
+    CC_List* list2;
+    CC_List* plain;
+    munit_assert_int(CC_OK, ==, cc_list_new_conf(&conf, &list1));
+    munit_assert_int(CC_OK, ==, cc_list_new_conf(&conf, &list2));
+    cc_list_new(&plain);
+
+    int v[20];
+    void* e;
+
+    /* Nodes are recycled across chunk boundaries */
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10; i++)
+            munit_assert_int(CC_OK, ==, cc_list_add_last(list1, &v[i]));
+        for (int i = 0; i < 7; i++) {
+            cc_list_remove_first(list1, &e);
+            munit_assert_ptr_equal(&v[i], e);
+        }
+        cc_list_remove_all(list1);
+    }
+
+    for (int i = 0; i < 5; i++) {
+        cc_list_add(list1, &v[i]);
+        cc_list_add(list2, &v[5 + i]);
+        cc_list_add(plain, &v[10 + i]);
+    }
+
+    /* Both pooled: list2's chunks are handed over */
+    munit_assert_int(CC_OK, ==, cc_list_splice(list1, list2));
+    munit_assert_size(0, ==, cc_list_size(list2));
+
+    /* Mixed: the elements are copied instead of moved */
+    munit_assert_int(CC_OK, ==, cc_list_splice(list1, plain));
+    munit_assert_size(0, ==, cc_list_size(plain));
+    munit_assert_size(15, ==, cc_list_size(list1));
+
+    for (int i = 0; i < 15; i++) {
+        cc_list_get_at(list1, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+
+    cc_list_add(list2, &v[0]);
+    cc_list_add(plain, &v[1]);
+    munit_assert_int(CC_OK, ==, cc_list_splice(plain, list2));
+    cc_list_get_last(plain, &e);
+    munit_assert_ptr_equal(&v[0], e);
+
+    cc_list_destroy(list2);
+    cc_list_destroy(plain);
+
+    for (int i = 0; i < 10; i++)
+        cc_list_remove_last(list1, NULL);
+    cc_list_get_last(list1, &e);
+    munit_assert_ptr_equal(&v[4], e);
+
+    cc_list_destroy(list1);
+    return MUNIT_OK;
+}
+
+static void assert_indexed_contents(CC_List* list, void** model, size_t n)
+{
+    munit_assert_size(n, ==, cc_list_size(list));
+
+    size_t i = 0;
+    CC_LIST_FOREACH(e, list, {
+        munit_assert_ptr_equal(model[i], e);
+        i++;
+    })
+    for (i = 0; i < n; i++) {
+        void* e;
+        munit_assert_int(CC_OK, ==, cc_list_get_at(list, i, &e));
+        munit_assert_ptr_equal(model[i], e);
+    }
+}
+
+static int cmp_addr(void const* e1, void const* e2)
+{
+    return ((char*) e1 > (char*) e2) - ((char*) e1 < (char*) e2);
+}
+
+static int cmp_addr_ptr(void const* e1, void const* e2)
+{
+    return cmp_addr(*((void**) e1), *((void**) e2));
+}
+
+static MunitResult test_indexed(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_ListConf conf;
+    cc_list_conf_init(&conf);
+    conf.indexed = true;
+
+    CC_List* list;
+    CC_List* other;
+    CC_List* plain;
+    munit_assert_int(CC_OK, ==, cc_list_new_conf(&conf, &list));
+    conf.pool_chunk_size = 8;
+    munit_assert_int(CC_OK, ==, cc_list_new_conf(&conf, &other));
+    cc_list_new(&plain);
+
+    int v[600];
+    void* model[600];
+    size_t n = 0;
+    void* e;
+
+    /* Random positional edits checked against a plain array */
+    for (int i = 0; i < 300; i++) {
+        size_t index = n ? (size_t) munit_rand_int_range(0, (int) n) : 0;
+
+        if (index == n)
+            munit_assert_int(CC_OK, ==, cc_list_add_last(list, &v[i]));
+        else if (index == 0 && i % 2)
+            munit_assert_int(CC_OK, ==, cc_list_add_first(list, &v[i]));
+        else
+            munit_assert_int(CC_OK, ==, cc_list_add_at(list, &v[i], index));
+
+        memmove(&model[index + 1], &model[index], (n - index) * sizeof(void*));
+        model[index] = &v[i];
+        n++;
+
+        if (i % 4 == 3) {
+            index = (size_t) munit_rand_int_range(0, (int) n - 1);
+            munit_assert_int(CC_OK, ==, cc_list_remove_at(list, index, &e));
+            munit_assert_ptr_equal(model[index], e);
+            memmove(&model[index], &model[index + 1], (n - index - 1) * sizeof(void*));
+            n--;
+        }
+    }
+    assert_indexed_contents(list, model, n);
+
+    /* Iterator edits keep the index in sync */
+    CC_ListIter iter;
+    cc_list_iter_init(&iter, list);
+    size_t m = 0;
+    size_t k = 0;
+    while (cc_list_iter_next(&iter, &e) != CC_ITER_END) {
+        if (k++ % 3 == 0) {
+            cc_list_iter_remove(&iter, NULL);
+            memmove(&model[m], &model[m + 1], (n - m - 1) * sizeof(void*));
+            n--;
+        } else {
+            cc_list_iter_add(&iter, &v[300 + k]);
+            memmove(&model[m + 2], &model[m + 1], (n - m - 1) * sizeof(void*));
+            model[m + 1] = &v[300 + k];
+            n++;
+            m += 2;
+        }
+    }
+    assert_indexed_contents(list, model, n);
+
+    /* Splicing an indexed list moves its index along */
+    for (int i = 0; i < 20; i++)
+        cc_list_add(other, &v[580 + i]);
+    cc_list_get_at(other, 10, &e);
+
+    munit_assert_int(CC_OK, ==, cc_list_splice_at(list, other, 7));
+    memmove(&model[27], &model[7], (n - 7) * sizeof(void*));
+    for (int i = 0; i < 20; i++)
+        model[7 + i] = &v[580 + i];
+    n += 20;
+    assert_indexed_contents(list, model, n);
+
+    /* An unindexed list is indexed as it is spliced in */
+    for (int i = 0; i < 5; i++)
+        cc_list_add(plain, &v[i]);
+    munit_assert_int(CC_OK, ==, cc_list_splice_at(list, plain, n));
+    for (int i = 0; i < 5; i++)
+        model[n++] = &v[i];
+    assert_indexed_contents(list, model, n);
+
+    /* Operations that relink the whole list rebuild the index lazily */
+    cc_list_reverse(list);
+    for (size_t i = 0; i < n / 2; i++) {
+        void* tmp = model[i];
+        model[i] = model[n - 1 - i];
+        model[n - 1 - i] = tmp;
+    }
+    assert_indexed_contents(list, model, n);
+
+    cc_list_sort_in_place(list, cmp_addr);
+    qsort(model, n, sizeof(void*), cmp_addr_ptr);
+    assert_indexed_contents(list, model, n);
+
+    CC_List* sub;
+    munit_assert_int(CC_OK, ==, cc_list_sublist(list, 10, 19, &sub));
+    assert_indexed_contents(sub, &model[10], 10);
+
+    munit_assert_int(CC_OK, ==, cc_list_add_all_at(list, sub, 3));
+    memmove(&model[13], &model[3], (n - 3) * sizeof(void*));
+    memcpy(&model[3], &model[20], 10 * sizeof(void*));
+    n += 10;
+    assert_indexed_contents(list, model, n);
+
+    while (n > 0) {
+        cc_list_remove_first(list, &e);
+        munit_assert_ptr_equal(model[0], e);
+        memmove(&model[0], &model[1], (n - 1) * sizeof(void*));
+        n--;
+        if (n > 0) {
+            cc_list_remove_last(list, NULL);
+            n--;
+        }
+        if (n > 0) {
+            cc_list_get_at(list, n / 2, &e);
+            munit_assert_ptr_equal(model[n / 2], e);
+        }
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_list_get_at(list, 0, &e));
+
+    cc_list_destroy(sub);
+    cc_list_destroy(plain);
+    cc_list_destroy(other);
+    cc_list_destroy(list);
+    return MUNIT_OK;
+}
+
+struct sort_item {
+    int key;
+    int seq;
+};
+
+static int cmp_item(void const* e1, void const* e2)
+{
+    return ((struct sort_item*) e1)->key - ((struct sort_item*) e2)->key;
+}
+
+static int cmp_item_ptr(void const* e1, void const* e2)
+{
+    return cmp_item(*((void**) e1), *((void**) e2));
+}
+
+static void assert_sorted(CC_List* list, bool ascending_seq, size_t size)
+{
+    struct sort_item* prev = NULL;
+    size_t n = 0;
+
+    CC_LIST_FOREACH(e, list, {
+        struct sort_item* it = e;
+        if (prev) {
+            munit_assert_int(prev->key, <=, it->key);
+            if (prev->key == it->key && ascending_seq)
+                munit_assert_int(prev->seq, <, it->seq);
+            if (prev->key == it->key && !ascending_seq)
+                munit_assert_int(prev->seq, >, it->seq);
+        }
+        prev = it;
+        n++;
+    })
+    munit_assert_size(size, ==, n);
+}
+
+static MunitResult test_sort_stable(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_List* list;
+    cc_list_new(&list);
+
+    /* An ascending run with equal keys, a strictly descending run and a
+     * random tail with many equal keys */
+    struct sort_item items[200];
+    for (int i = 0; i < 200; i++) {
+        if (i < 50)
+            items[i].key = i / 5;
+        else if (i < 100)
+            items[i].key = 99 - i;
+        else
+            items[i].key = munit_rand_int_range(0, 29);
+        items[i].seq = i;
+        cc_list_add(list, &items[i]);
+    }
+
+    cc_list_sort_in_place(list, cmp_item);
+    assert_sorted(list, true, 200);
+
+    /* Equal keys keep their reversed order */
+    cc_list_reverse(list);
+    cc_list_sort_in_place(list, cmp_item);
+    assert_sorted(list, false, 200);
+
+    /* The array sort only orders the keys */
+    cc_list_reverse(list);
+    munit_assert_int(CC_OK, ==, cc_list_sort(list, cmp_item_ptr));
+
+    /* The prev links and the tail are rebuilt as well */
+    void* last = NULL;
+    CC_LIST_FOREACH(e, list, {
+        last = e;
+    })
+    void* e;
+    cc_list_get_last(list, &e);
+    munit_assert_ptr_equal(last, e);
+
+    CC_ListIter iter;
+    cc_list_diter_init(&iter, list);
+    size_t n = 0;
+    struct sort_item* prev = NULL;
+    while (cc_list_diter_next(&iter, &e) != CC_ITER_END) {
+        struct sort_item* it = e;
+        if (prev)
+            munit_assert_int(it->key, <=, prev->key);
+        prev = it;
+        n++;
+    }
+    munit_assert_size(200, ==, n);
+
+    cc_list_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_sort_parallel(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_List* list;
+    cc_list_new(&list);
+
+    size_t n = 20011;
+    struct sort_item* items = malloc(n * sizeof(struct sort_item));
+    for (size_t i = 0; i < n; i++) {
+        items[i].key = munit_rand_int_range(0, 999);
+        items[i].seq = i;
+        cc_list_add(list, &items[i]);
+    }
+
+    /* Seven uneven sublists and an odd number of chains to merge */
+    munit_assert_int(CC_OK, ==, cc_list_sort_in_place_parallel(list, cmp_item, 7, 1000));
+    munit_assert_size(n, ==, cc_list_size(list));
+    assert_sorted(list, true, n);
+
+    /* Walking backwards visits every node in descending order */
+    CC_ListIter iter;
+    cc_list_diter_init(&iter, list);
+    size_t count = 0;
+    void* e;
+    struct sort_item* prev = NULL;
+    while (cc_list_diter_next(&iter, &e) != CC_ITER_END) {
+        struct sort_item* it = e;
+        if (prev)
+            munit_assert_int(it->key, <=, prev->key);
+        prev = it;
+        count++;
+    }
+    munit_assert_size(n, ==, count);
+
+    /* A cutoff above the list size sorts on the calling thread */
+    cc_list_reverse(list);
+    munit_assert_int(CC_OK, ==, cc_list_sort_in_place_parallel(list, cmp_item, 4, n + 1));
+    assert_sorted(list, false, n);
+
+    cc_list_destroy(list);
+    free(items);
+    return MUNIT_OK;
+}
+
+static void assert_range(CC_List* list, int* v, size_t b, size_t n)
+{
+    munit_assert_size(n, ==, cc_list_size(list));
+
+    size_t i = b;
+    CC_LIST_FOREACH(e, list, {
+        munit_assert_ptr_equal(&v[i], e);
+        i++;
+    })
+
+    /* The prev links must match the next links */
+    CC_ListIter iter;
+    cc_list_diter_init(&iter, list);
+    void* e;
+    while (cc_list_diter_next(&iter, &e) != CC_ITER_END)
+        munit_assert_ptr_equal(&v[--i], e);
+    munit_assert_size(b, ==, i);
+}
+
+static MunitResult test_copy_bulk(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[100];
+
+    /* Once without a node pool, where the copies live in blocks, and once
+     * with a pool that has a few free nodes to reuse */
+    for (int pooled = 0; pooled < 2; pooled++) {
+        CC_ListConf conf;
+        cc_list_conf_init(&conf);
+        conf.pool_chunk_size = pooled ? 8 : 0;
+
+        CC_List* list;
+        cc_list_new_conf(&conf, &list);
+        for (int i = 0; i < 100; i++)
+            cc_list_add(list, &v[i]);
+
+        void* e;
+        for (int i = 0; i < 3; i++)
+            cc_list_remove_last(list, &e);
+        for (int i = 97; i < 100; i++)
+            cc_list_add(list, &v[i]);
+
+        CC_List* copy;
+        CC_List* sub;
+        munit_assert_int(CC_OK, ==, cc_list_copy_shallow(list, &copy));
+        munit_assert_int(CC_OK, ==, cc_list_sublist(list, 10, 59, &sub));
+        assert_range(copy, v, 0, 100);
+        assert_range(sub, v, 10, 50);
+
+        /* Nodes of a block can be removed in any order */
+        for (int i = 0; i < 10; i++)
+            cc_list_remove_first(copy, &e);
+        for (int i = 0; i < 40; i++)
+            cc_list_remove_last(copy, &e);
+        assert_range(copy, v, 10, 50);
+
+        cc_list_remove_at(copy, 25, &e);
+        munit_assert_ptr_equal(&v[35], e);
+        cc_list_add_at(copy, e, 25);
+
+        /* Splicing hands the blocks of one list over to the other */
+        munit_assert_int(CC_OK, ==, cc_list_splice(sub, copy));
+        munit_assert_size(0, ==, cc_list_size(copy));
+        munit_assert_size(100, ==, cc_list_size(sub));
+
+        cc_list_remove_all(sub);
+        munit_assert_int(CC_OK, ==, cc_list_add_all(sub, list));
+        munit_assert_int(CC_OK, ==, cc_list_add_all(copy, list));
+        munit_assert_int(CC_OK, ==, cc_list_add_all_at(copy, sub, 50));
+        munit_assert_size(200, ==, cc_list_size(copy));
+
+        cc_list_get_at(copy, 49, &e);
+        munit_assert_ptr_equal(&v[49], e);
+        cc_list_get_at(copy, 50, &e);
+        munit_assert_ptr_equal(&v[0], e);
+        cc_list_get_at(copy, 150, &e);
+        munit_assert_ptr_equal(&v[50], e);
+
+        cc_list_destroy(sub);
+        cc_list_destroy(copy);
+        cc_list_destroy(list);
+    }
+    return MUNIT_OK;
+}
+
+static void assert_compact(CC_List* list, int* v, size_t n)
+{
+    munit_assert_size(n, ==, cc_list_size(list));
+
+    CC_ListIter iter;
+    cc_list_iter_init(&iter, list);
+
+    /* Indexed lists use larger nodes, so only the stride is fixed */
+    void* e;
+    char* prev = NULL;
+    size_t stride = 0;
+    size_t i = 0;
+    while (cc_list_iter_next(&iter, &e) != CC_ITER_END) {
+        munit_assert_ptr_equal(&v[i], e);
+        if (prev && !stride)
+            stride = (size_t) ((char*) iter.last - prev);
+        if (prev) {
+            munit_assert_size(stride, >=, sizeof(Node));
+            munit_assert_ptr_equal(prev + stride, iter.last);
+        }
+        prev = (char*) iter.last;
+        i++;
+    }
+    munit_assert_size(n, ==, i);
+
+    cc_list_get_last(list, &e);
+    munit_assert_ptr_equal(&v[n - 1], e);
+}
+
+static MunitResult test_compact(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[100];
+
+    /* A plain list, a pooled list and an indexed list */
+    for (int config = 0; config < 3; config++) {
+        CC_ListConf conf;
+        cc_list_conf_init(&conf);
+        conf.pool_chunk_size = config == 1 ? 8 : 0;
+        conf.indexed = config == 2;
+
+        CC_List* list;
+        cc_list_new_conf(&conf, &list);
+        munit_assert_int(CC_OK, ==, cc_list_compact(list, NULL));
+
+        /* Scatter the nodes by building the list from both ends */
+        void* e;
+        for (int i = 0; i < 50; i++) {
+            cc_list_add_first(list, &v[49 - i]);
+            cc_list_add_last(list, &v[50 + i]);
+            cc_list_add_first(list, &v[i]);
+            cc_list_remove_first(list, &e);
+        }
+        cc_list_compact(list, NULL);
+        assert_compact(list, v, 100);
+
+        cc_list_get_at(list, 70, &e);
+        munit_assert_ptr_equal(&v[70], e);
+
+        cc_list_remove_last(list, &e);
+        cc_list_remove_at(list, 40, &e);
+        cc_list_add_at(list, e, 40);
+        cc_list_add(list, &v[99]);
+
+        /* Compacting into a dynamic pool leaves the nodes to the pool */
+        CC_DynamicPool* pool;
+        cc_dynamic_pool_new(4096, &pool);
+
+        munit_assert_int(CC_OK, ==, cc_list_compact(list, pool));
+        assert_compact(list, v, 100);
+
+        cc_list_remove_at(list, 30, &e);
+        munit_assert_ptr_equal(&v[30], e);
+        cc_list_add_at(list, e, 30);
+        cc_list_get_at(list, 30, &e);
+        munit_assert_ptr_equal(&v[30], e);
+
+        cc_list_destroy(list);
+        cc_dynamic_pool_destroy(pool);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult test_splice_blocks(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[50];
+
+    CC_ListConf conf;
+    cc_list_conf_init(&conf);
+    conf.mem_alloc = budget_alloc;
+    conf.mem_calloc = budget_calloc;
+    alloc_budget = 1000;
+
+    CC_List* all;
+    CC_List* list1;
+    cc_list_new_conf(&conf, &all);
+    cc_list_new_conf(&conf, &list1);
+    for (int i = 0; i < 50; i++)
+        cc_list_add(all, &v[i]);
+
+    /* Fill the block table of the first list to its capacity */
+    for (int i = 0; i < 4; i++) {
+        CC_List* part;
+        cc_list_sublist(all, i * 10, i * 10 + 9, &part);
+        munit_assert_int(CC_OK, ==, cc_list_splice(list1, part));
+        cc_list_destroy(part);
+    }
+    CC_List* list2;
+    CC_List* list3;
+    cc_list_sublist(all, 40, 44, &list2);
+    cc_list_sublist(all, 45, 49, &list3);
+
+    /* Splicing must not allocate even when the block table is full */
+    alloc_budget = 0;
+    munit_assert_int(CC_OK, ==, cc_list_splice(list1, list2));
+    munit_assert_int(CC_OK, ==, cc_list_splice(list1, list3));
+    munit_assert_size(0, ==, cc_list_size(list2));
+    munit_assert_size(0, ==, cc_list_size(list3));
+    assert_range(list1, v, 0, 50);
+
+    void* e;
+    for (int i = 0; i < 5; i++) {
+        cc_list_remove_at(list1, 45, &e);
+        munit_assert_ptr_equal(&v[45 + i], e);
+    }
+    for (int i = 0; i < 10; i++)
+        cc_list_remove_first(list1, &e);
+    assert_range(list1, v, 10, 35);
+
+    alloc_budget = 1000;
+    munit_assert_int(CC_OK, ==, cc_list_add_all(list1, all));
+    munit_assert_size(85, ==, cc_list_size(list1));
+
+    cc_list_destroy(list1);
+    cc_list_destroy(list2);
+    cc_list_destroy(list3);
+    cc_list_destroy(all);
+    return MUNIT_OK;
+}
+
 static MunitTest test_suite_tests[] = {
     {(char*)"/list/test_new", test_new, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add", test_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_node_pool", test_node_pool, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_indexed", test_indexed, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add_last", test_add_last, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add_first", test_add_first, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_contains", test_contains, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_index_of", test_index_of, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_sort", test_sort, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_sort_stable", test_sort_stable, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_sort_parallel", test_sort_parallel, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_copy_bulk", test_copy_bulk, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_splice_blocks", test_splice_blocks, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_compact", test_compact, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_zip_iter_next", test_zip_iter_next, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_zip_iter_add", test_zip_iter_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_zip_iter_remove", test_zip_iter_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
@@ -0,0 +1,232 @@
+#include "munit.h"
+#include "cc_mpmc_queue.h"
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define MPMC_TEST_THREADS
+#endif
+
+
+static MunitResult test_capacity(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    conf.capacity = 5;
+
+    CC_MPMCQueue *q;
+    munit_assert_int(CC_OK, ==, cc_mpmc_queue_new_conf(&conf, &q));
+    munit_assert_size(8, ==, cc_mpmc_queue_capacity(q));
+    cc_mpmc_queue_destroy(q);
+
+    conf.capacity = 0;
+    munit_assert_int(CC_ERR_INVALID_CAPACITY, ==, cc_mpmc_queue_new_conf(&conf, &q));
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_try_enqueue_dequeue(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    conf.capacity = 4;
+
+    CC_MPMCQueue *q;
+    cc_mpmc_queue_new_conf(&conf, &q);
+
+    int v[10];
+    void *out;
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_mpmc_queue_try_dequeue(q, &out));
+
+    for (int i = 0; i < 4; i++)
+        munit_assert_int(CC_OK, ==, cc_mpmc_queue_try_enqueue(q, &v[i]));
+
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_mpmc_queue_try_enqueue(q, &v[4]));
+    munit_assert_size(4, ==, cc_mpmc_queue_size(q));
+
+    /* Go around the slot array a few times */
+    for (int i = 0; i < 6; i++) {
+        munit_assert_int(CC_OK, ==, cc_mpmc_queue_try_dequeue(q, &out));
+        munit_assert_ptr_equal(&v[i], out);
+        munit_assert_int(CC_OK, ==, cc_mpmc_queue_try_enqueue(q, &v[i + 4]));
+    }
+    for (int i = 6; i < 10; i++) {
+        cc_mpmc_queue_dequeue(q, &out);
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    munit_assert_size(0, ==, cc_mpmc_queue_size(q));
+
+    cc_mpmc_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+static MunitResult test_batch(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    conf.capacity = 8;
+
+    CC_MPMCQueue *q;
+    cc_mpmc_queue_new_conf(&conf, &q);
+
+    int v[12];
+    void *in[12];
+    void *out[12];
+
+    for (int i = 0; i < 12; i++)
+        in[i] = &v[i];
+
+    munit_assert_size(5, ==, cc_mpmc_queue_try_enqueue_n(q, in, 5));
+    munit_assert_size(3, ==, cc_mpmc_queue_try_enqueue_n(q, in + 5, 7));
+    munit_assert_size(0, ==, cc_mpmc_queue_try_enqueue_n(q, in + 8, 4));
+
+    munit_assert_size(6, ==, cc_mpmc_queue_try_dequeue_n(q, out, 6));
+    for (int i = 0; i < 6; i++)
+        munit_assert_ptr_equal(in[i], out[i]);
+
+    cc_mpmc_queue_enqueue_n(q, in + 8, 4);
+    munit_assert_size(6, ==, cc_mpmc_queue_size(q));
+
+    cc_mpmc_queue_dequeue_n(q, out, 6);
+    for (int i = 0; i < 6; i++)
+        munit_assert_ptr_equal(in[i + 6], out[i]);
+
+    munit_assert_size(0, ==, cc_mpmc_queue_try_dequeue_n(q, out, 12));
+
+    cc_mpmc_queue_destroy(q);
+    return MUNIT_OK;
+}
+
+#ifdef MPMC_TEST_THREADS
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define ITEMS_PER_PRODUCER 20000
+
+struct consumer_result {
+    CC_MPMCQueue *q;
+    uintptr_t     sum;
+    uintptr_t     last[PRODUCERS];
+    bool          ordered;
+};
+
+static CC_MPMCQueue *shared_queue;
+
+static void *producer(void *arg)
+{
+    uintptr_t id = (uintptr_t) arg;
+    void *batch[3];
+
+    /* Every element encodes its producer and a per-producer sequence
+     * number starting at 1. */
+    for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER;) {
+        if (i % 7 == 0 && i + 3 <= ITEMS_PER_PRODUCER + 1) {
+            for (int j = 0; j < 3; j++)
+                batch[j] = (void*) ((i + j) * PRODUCERS + id);
+            cc_mpmc_queue_enqueue_n(shared_queue, batch, 3);
+            i += 3;
+        } else {
+            cc_mpmc_queue_enqueue(shared_queue, (void*) (i * PRODUCERS + id));
+            i++;
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    struct consumer_result *r = arg;
+    size_t n = ITEMS_PER_PRODUCER * PRODUCERS / CONSUMERS;
+    void *out;
+
+    while (n > 0) {
+        cc_mpmc_queue_dequeue(r->q, &out);
+        uintptr_t e   = (uintptr_t) out;
+        uintptr_t id  = e % PRODUCERS;
+        uintptr_t seq = e / PRODUCERS;
+
+        if (seq <= r->last[id])
+            r->ordered = false;
+        r->last[id] = seq;
+        r->sum += e;
+        n--;
+    }
+    return NULL;
+}
+
+static MunitResult test_threads(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_MPMCQueueConf conf;
+    cc_mpmc_queue_conf_init(&conf);
+    conf.capacity = 64;
+    cc_mpmc_queue_new_conf(&conf, &shared_queue);
+
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    struct consumer_result results[CONSUMERS];
+
+    for (int i = 0; i < CONSUMERS; i++) {
+        memset(&results[i], 0, sizeof(results[i]));
+        results[i].q = shared_queue;
+        results[i].ordered = true;
+        pthread_create(&consumers[i], NULL, consumer, &results[i]);
+    }
+    for (uintptr_t i = 0; i < PRODUCERS; i++)
+        pthread_create(&producers[i], NULL, producer, (void*) i);
+
+    for (int i = 0; i < PRODUCERS; i++)
+        pthread_join(producers[i], NULL);
+    for (int i = 0; i < CONSUMERS; i++)
+        pthread_join(consumers[i], NULL);
+
+    uintptr_t expected = 0;
+    for (uintptr_t id = 0; id < PRODUCERS; id++) {
+        for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++)
+            expected += i * PRODUCERS + id;
+    }
+
+    uintptr_t sum = 0;
+    for (int i = 0; i < CONSUMERS; i++) {
+        munit_assert_true(results[i].ordered);
+        sum += results[i].sum;
+    }
+    munit_assert_size(expected, ==, sum);
+    munit_assert_size(0, ==, cc_mpmc_queue_size(shared_queue));
+
+    cc_mpmc_queue_destroy(shared_queue);
+    return MUNIT_OK;
+}
+
+#endif
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/mpmc_queue/test_capacity", test_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/mpmc_queue/test_try_enqueue_dequeue", test_try_enqueue_dequeue, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/mpmc_queue/test_batch", test_batch, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef MPMC_TEST_THREADS
+    {(char*)"/mpmc_queue/test_threads", test_threads, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
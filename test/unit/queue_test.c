@@ -83,6 +83,42 @@ static MunitResult test_poll(const MunitParameter params[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_enqueue_all_poll_n(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    struct queues* q = (struct queues*)fixture;
+
+    int v[6];
+    void* els[6];
+    for (int i = 0; i < 6; i++)
+        els[i] = &v[i];
+
+    cc_queue_enqueue(q->q1, els[0]);
+    munit_assert_int(CC_OK, ==, cc_queue_enqueue_all(q->q1, &els[1], 5));
+    munit_assert_size(6, ==, cc_queue_size(q->q1));
+
+    void* out[6];
+    munit_assert_size(2, ==, cc_queue_poll_n(q->q1, out, 2));
+    munit_assert_ptr_equal(&v[0], out[0]);
+    munit_assert_ptr_equal(&v[1], out[1]);
+
+    void* e;
+    cc_queue_poll(q->q1, &e);
+    munit_assert_ptr_equal(&v[2], e);
+
+    void** array;
+    munit_assert_int(CC_OK, ==, cc_queue_drain_to_array(q->q1, &array));
+    munit_assert_size(0, ==, cc_queue_size(q->q1));
+    for (int i = 0; i < 3; i++)
+        munit_assert_ptr_equal(&v[i + 3], array[i]);
+    free(array);
+
+    munit_assert_size(0, ==, cc_queue_poll_n(q->q1, out, 2));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_queue_drain_to_array(q->q1, &array));
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_iter(const MunitParameter params[], void* fixture)
 {
     (void)params;
@@ -161,6 +197,7 @@ static MunitResult test_zip_iter_next(const MunitParameter params[], void* fixtu
 static MunitTest test_suite_tests[] = {
     { (char*)"/queue/test_enqueue", test_enqueue, default_queue, default_queue_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/queue/test_poll", test_poll, default_queue, default_queue_teardown, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/queue/test_enqueue_all_poll_n", test_enqueue_all_poll_n, default_queue, default_queue_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/queue/test_iter", test_iter, default_queue, default_queue_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/queue/test_zip_iter_next", test_zip_iter_next, default_queue, default_queue_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
@@ -2,6 +2,12 @@
 #include "cc_ring_buffer.h"
 #include <stdlib.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#define RBUF_TEST_THREADS
+#endif
+
 
 static MunitResult test_enqueue(const MunitParameter params[], void* fixture)
 {
@@ -96,10 +102,372 @@ static MunitResult test_enqueue_past_capacity(const MunitParameter params[], voi
     return MUNIT_OK;
 }
 
+static MunitResult test_spsc_capacity(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_RbufConf conf;
+    cc_rbuf_conf_init(&conf);
+    conf.spsc = true;
+
+    CC_Rbuf* rbuf;
+    munit_assert_int(CC_OK, ==, cc_rbuf_conf_new(&conf, &rbuf));
+    munit_assert_size(16, ==, cc_rbuf_capacity(rbuf));
+
+    for (uint64_t i = 0; i < 16; i++)
+        munit_assert_int(CC_OK, ==, cc_rbuf_enqueue(rbuf, i));
+
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_rbuf_enqueue(rbuf, 100));
+    munit_assert_size(16, ==, cc_rbuf_size(rbuf));
+
+    uint64_t out;
+    for (uint64_t i = 0; i < 40; i++) {
+        munit_assert_int(CC_OK, ==, cc_rbuf_dequeue(rbuf, &out));
+        munit_assert_uint64(i, ==, out);
+        munit_assert_int(CC_OK, ==, cc_rbuf_enqueue(rbuf, i + 16));
+    }
+    munit_assert_size(16, ==, cc_rbuf_size(rbuf));
+
+    for (uint64_t i = 40; i < 56; i++) {
+        munit_assert_int(CC_OK, ==, cc_rbuf_dequeue(rbuf, &out));
+        munit_assert_uint64(i, ==, out);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_rbuf_dequeue(rbuf, &out));
+    munit_assert_true(cc_rbuf_is_empty(rbuf));
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+struct packet {
+    uint64_t id;
+    uint64_t payload[3];
+};
+
+static MunitResult test_element_size_n(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_RbufConf conf;
+    cc_rbuf_conf_init(&conf);
+    conf.capacity = 7;
+    conf.element_size = sizeof(struct packet);
+    conf.overwrite = false;
+
+    CC_Rbuf* rbuf;
+    munit_assert_int(CC_OK, ==, cc_rbuf_conf_new(&conf, &rbuf));
+    munit_assert_size(sizeof(struct packet), ==, cc_rbuf_element_size(rbuf));
+
+    struct packet in[10];
+    struct packet out[10];
+    for (int i = 0; i < 10; i++) {
+        in[i].id = i;
+        in[i].payload[0] = in[i].payload[1] = in[i].payload[2] = i * 3;
+    }
+
+    munit_assert_size(5, ==, cc_rbuf_enqueue_n(rbuf, in, 5));
+    munit_assert_size(3, ==, cc_rbuf_dequeue_n(rbuf, out, 3));
+    munit_assert_memory_equal(3 * sizeof(struct packet), in, out);
+
+    /* Wraps around the end of the buffer and stops when full */
+    munit_assert_size(5, ==, cc_rbuf_enqueue_n(rbuf, in + 5, 5));
+    munit_assert_size(7, ==, cc_rbuf_size(rbuf));
+    munit_assert_size(0, ==, cc_rbuf_enqueue_n(rbuf, in, 1));
+
+    munit_assert_size(7, ==, cc_rbuf_dequeue_n(rbuf, out, 10));
+    munit_assert_memory_equal(7 * sizeof(struct packet), in + 3, out);
+    munit_assert_size(0, ==, cc_rbuf_dequeue_n(rbuf, out, 1));
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_single_item_size(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    /* Items smaller and larger than a uint64_t, plain and SPSC */
+    size_t sizes[] = {4, 4, 12, 12};
+
+    for (int i = 0; i < 4; i++) {
+        CC_RbufConf conf;
+        cc_rbuf_conf_init(&conf);
+        conf.capacity = 3;
+        conf.element_size = sizes[i];
+        conf.spsc = i % 2 == 1;
+
+        CC_Rbuf* rbuf;
+        munit_assert_int(CC_OK, ==, cc_rbuf_conf_new(&conf, &rbuf));
+
+        uint64_t item = 0;
+        munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_rbuf_enqueue(rbuf, 1));
+        munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_rbuf_dequeue(rbuf, &item));
+        munit_assert_size(0, ==, cc_rbuf_size(rbuf));
+
+        uint8_t in[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        uint8_t out[12];
+        munit_assert_size(1, ==, cc_rbuf_enqueue_n(rbuf, in, 1));
+        munit_assert_uint64(0, ==, cc_rbuf_peek(rbuf, 0));
+        munit_assert_size(1, ==, cc_rbuf_dequeue_n(rbuf, out, 1));
+        munit_assert_memory_equal(sizes[i], in, out);
+
+        cc_rbuf_destroy(rbuf);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult test_overwrite_n(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_new(&rbuf);
+
+    uint64_t in[25];
+    uint64_t out[10];
+    for (int i = 0; i < 25; i++)
+        in[i] = i;
+
+    munit_assert_size(8, ==, cc_rbuf_enqueue_n(rbuf, in, 8));
+    munit_assert_size(4, ==, cc_rbuf_enqueue_n(rbuf, in + 8, 4));
+    munit_assert_size(10, ==, cc_rbuf_size(rbuf));
+
+    munit_assert_size(10, ==, cc_rbuf_dequeue_n(rbuf, out, 10));
+    for (int i = 0; i < 10; i++)
+        munit_assert_uint64(i + 2, ==, out[i]);
+
+    /* Only the last capacity items of a larger batch are kept */
+    munit_assert_size(25, ==, cc_rbuf_enqueue_n(rbuf, in, 25));
+    munit_assert_size(10, ==, cc_rbuf_dequeue_n(rbuf, out, 10));
+    for (int i = 0; i < 10; i++)
+        munit_assert_uint64(i + 15, ==, out[i]);
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_no_overwrite(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_RbufConf conf;
+    cc_rbuf_conf_init(&conf);
+    conf.capacity = 3;
+    conf.overwrite = false;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_conf_new(&conf, &rbuf);
+
+    munit_assert_int(CC_OK, ==, cc_rbuf_enqueue(rbuf, 1));
+    munit_assert_int(CC_OK, ==, cc_rbuf_enqueue(rbuf, 2));
+    munit_assert_int(CC_OK, ==, cc_rbuf_enqueue(rbuf, 3));
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_rbuf_enqueue(rbuf, 4));
+
+    uint64_t out;
+    cc_rbuf_dequeue(rbuf, &out);
+    munit_assert_uint64(1, ==, out);
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_peek_at(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_new(&rbuf);
+
+    for (uint64_t i = 0; i < 13; i++)
+        cc_rbuf_enqueue(rbuf, i);
+
+    void *item;
+    for (size_t i = 0; i < 10; i++) {
+        munit_assert_int(CC_OK, ==, cc_rbuf_peek_at(rbuf, i, &item));
+        munit_assert_uint64(i + 3, ==, *(uint64_t*) item);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_rbuf_peek_at(rbuf, 10, &item));
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_reserve_commit(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_RbufConf conf;
+    cc_rbuf_conf_init(&conf);
+    conf.capacity = 8;
+    conf.spsc = true;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_conf_new(&conf, &rbuf);
+
+    CC_RbufSpan first;
+    CC_RbufSpan second;
+
+    uint64_t drain[6];
+    for (uint64_t i = 0; i < 6; i++)
+        cc_rbuf_enqueue(rbuf, i);
+    munit_assert_size(6, ==, cc_rbuf_dequeue_n(rbuf, drain, 6));
+
+    munit_assert_int(CC_ERR_MAX_CAPACITY, ==, cc_rbuf_reserve(rbuf, 9, &first, &second));
+    munit_assert_int(CC_OK, ==, cc_rbuf_reserve(rbuf, 5, &first, &second));
+    munit_assert_size(2, ==, first.count);
+    munit_assert_size(3, ==, second.count);
+
+    uint64_t v = 100;
+    for (size_t i = 0; i < first.count; i++)
+        ((uint64_t*) first.data)[i] = v++;
+    for (size_t i = 0; i < second.count; i++)
+        ((uint64_t*) second.data)[i] = v++;
+
+    munit_assert_true(cc_rbuf_is_empty(rbuf));
+    munit_assert_int(CC_OK, ==, cc_rbuf_commit(rbuf, 5));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_rbuf_commit(rbuf, 4));
+    munit_assert_size(5, ==, cc_rbuf_size(rbuf));
+
+    uint64_t out;
+    for (uint64_t i = 100; i < 105; i++) {
+        cc_rbuf_dequeue(rbuf, &out);
+        munit_assert_uint64(i, ==, out);
+    }
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+static MunitResult test_read_span_release(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_new(&rbuf);
+
+    CC_RbufSpan first;
+    CC_RbufSpan second;
+
+    munit_assert_size(0, ==, cc_rbuf_read_span(rbuf, &first, &second));
+    munit_assert_size(0, ==, first.count + second.count);
+
+    for (uint64_t i = 0; i < 14; i++)
+        cc_rbuf_enqueue(rbuf, i);
+
+    munit_assert_size(10, ==, cc_rbuf_read_span(rbuf, &first, &second));
+    munit_assert_size(6, ==, first.count);
+    munit_assert_size(4, ==, second.count);
+    munit_assert_uint64(4, ==, ((uint64_t*) first.data)[0]);
+    munit_assert_uint64(9, ==, ((uint64_t*) first.data)[5]);
+    munit_assert_uint64(10, ==, ((uint64_t*) second.data)[0]);
+    munit_assert_uint64(13, ==, ((uint64_t*) second.data)[3]);
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_rbuf_release(rbuf, 11));
+    munit_assert_int(CC_OK, ==, cc_rbuf_release(rbuf, 7));
+
+    munit_assert_size(3, ==, cc_rbuf_read_span(rbuf, &first, &second));
+    munit_assert_size(3, ==, first.count);
+    munit_assert_size(0, ==, second.count);
+    munit_assert_uint64(11, ==, ((uint64_t*) first.data)[0]);
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+#ifdef RBUF_TEST_THREADS
+
+#define SPSC_ITEMS 200000
+
+static void *spsc_producer(void *arg)
+{
+    CC_Rbuf *rbuf = arg;
+
+    uint64_t batch[5];
+
+    for (uint64_t i = 1; i <= SPSC_ITEMS;) {
+        if (i % 3 == 0 && i + 5 <= SPSC_ITEMS + 1) {
+            for (int j = 0; j < 5; j++)
+                batch[j] = i + j;
+            size_t n = cc_rbuf_enqueue_n(rbuf, batch, 5);
+            i += n;
+            if (n == 0)
+                sched_yield();
+            continue;
+        }
+        while (cc_rbuf_enqueue(rbuf, i) != CC_OK)
+            sched_yield();
+        i++;
+    }
+    return NULL;
+}
+
+static MunitResult test_spsc_threads(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_RbufConf conf;
+    cc_rbuf_conf_init(&conf);
+    conf.capacity = 64;
+    conf.spsc = true;
+
+    CC_Rbuf* rbuf;
+    cc_rbuf_conf_new(&conf, &rbuf);
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, spsc_producer, rbuf);
+
+    uint64_t expected = 1;
+    uint64_t out[4];
+    while (expected <= SPSC_ITEMS) {
+        size_t n;
+        if (expected % 2)
+            n = cc_rbuf_dequeue_n(rbuf, out, 4);
+        else
+            n = cc_rbuf_dequeue(rbuf, out) == CC_OK;
+
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; i++) {
+            munit_assert_uint64(expected, ==, out[i]);
+            expected++;
+        }
+    }
+    pthread_join(producer, NULL);
+
+    munit_assert_true(cc_rbuf_is_empty(rbuf));
+
+    cc_rbuf_destroy(rbuf);
+    return MUNIT_OK;
+}
+
+#endif
+
 static MunitTest test_suite_tests[] = {
     { (char*)"/ring_buffer/test_enqueue", test_enqueue, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/ring_buffer/test_dequeue", test_dequeue, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/ring_buffer/test_enqueue_past_capacity", test_enqueue_past_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_spsc_capacity", test_spsc_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_element_size_n", test_element_size_n, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_single_item_size", test_single_item_size, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_overwrite_n", test_overwrite_n, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_no_overwrite", test_no_overwrite, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_peek_at", test_peek_at, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_reserve_commit", test_reserve_commit, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/ring_buffer/test_read_span_release", test_read_span_release, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef RBUF_TEST_THREADS
+    { (char*)"/ring_buffer/test_spsc_threads", test_spsc_threads, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
 
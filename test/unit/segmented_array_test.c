@@ -0,0 +1,251 @@
+#include "munit.h"
+#include "cc_segmented_array.h"
+#include <stdlib.h>
+
+
+/*****************************
+ * TESTS
+ *****************************/
+static MunitResult test_add(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int a = 5;
+    int b = 12;
+    int c = 848;
+
+    cc_segmented_array_add(array, &a);
+    cc_segmented_array_add(array, &b);
+    cc_segmented_array_add(array, &c);
+
+    int* ar;
+    int* br;
+    int* cr;
+
+    cc_segmented_array_get_at(array, 0, (void*)&ar);
+    cc_segmented_array_get_at(array, 1, (void*)&br);
+    cc_segmented_array_get_at(array, 2, (void*)&cr);
+
+    munit_assert_int(a, == , *ar);
+    munit_assert_int(b, == , *br);
+    munit_assert_int(c, == , *cr);
+    munit_assert_size(3, == , cc_segmented_array_size(array));
+
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_stable_slots(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArrayConf conf;
+    cc_segmented_array_conf_init(&conf);
+    conf.segment_capacity = 3;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new_conf(&conf, &array);
+
+    /* Rounded up to the closest power of two */
+    munit_assert_size(4, == , cc_segmented_array_capacity(array));
+
+    int v[1000];
+    v[0] = 0;
+    cc_segmented_array_add(array, &v[0]);
+
+    void **first;
+    cc_segmented_array_peek(array, 0, &first);
+
+    for (int i = 1; i < 1000; i++) {
+        v[i] = i;
+        munit_assert_int(CC_OK, ==, cc_segmented_array_add(array, &v[i]));
+    }
+
+    void **again;
+    cc_segmented_array_peek(array, 0, &again);
+    munit_assert_ptr_equal(first, again);
+
+    for (int i = 0; i < 1000; i++) {
+        int *e;
+        cc_segmented_array_get_at(array, i, (void*)&e);
+        munit_assert_int(i, == , *e);
+    }
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_add_at(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int v[20];
+    for (int i = 0; i < 20; i++) {
+        v[i] = i;
+        if (i != 5)
+            cc_segmented_array_add(array, &v[i]);
+    }
+    munit_assert_int(CC_OK, ==, cc_segmented_array_add_at(array, &v[5], 5));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_segmented_array_add_at(array, &v[5], 25));
+
+    for (int i = 0; i < 20; i++) {
+        int *e;
+        cc_segmented_array_get_at(array, i, (void*)&e);
+        munit_assert_int(i, == , *e);
+    }
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_remove_at(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int v[30];
+    for (int i = 0; i < 30; i++) {
+        v[i] = i;
+        cc_segmented_array_add(array, &v[i]);
+    }
+
+    int *out;
+    cc_segmented_array_remove_at(array, 3, (void*)&out);
+    munit_assert_int(3, == , *out);
+    munit_assert_size(29, == , cc_segmented_array_size(array));
+
+    cc_segmented_array_get_at(array, 3, (void*)&out);
+    munit_assert_int(4, == , *out);
+
+    cc_segmented_array_remove_last(array, (void*)&out);
+    munit_assert_int(29, == , *out);
+
+    cc_segmented_array_get_last(array, (void*)&out);
+    munit_assert_int(28, == , *out);
+
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_trim_capacity(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int v[100];
+    for (int i = 0; i < 100; i++)
+        cc_segmented_array_add(array, &v[i]);
+
+    /* 8 + 16 + 32 + 64 */
+    munit_assert_size(120, == , cc_segmented_array_capacity(array));
+
+    for (int i = 0; i < 90; i++)
+        cc_segmented_array_remove_last(array, NULL);
+
+    cc_segmented_array_trim_capacity(array);
+    munit_assert_size(24, == , cc_segmented_array_capacity(array));
+
+    cc_segmented_array_remove_all(array);
+    cc_segmented_array_trim_capacity(array);
+    munit_assert_size(8, == , cc_segmented_array_capacity(array));
+
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_iter(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int v[40];
+    for (int i = 0; i < 40; i++) {
+        v[i] = i;
+        cc_segmented_array_add(array, &v[i]);
+    }
+
+    CC_SegmentedArrayIter iter;
+    cc_segmented_array_iter_init(&iter, array);
+
+    void *e;
+    while (cc_segmented_array_iter_next(&iter, &e) != CC_ITER_END) {
+        if (*(int*)e % 2)
+            cc_segmented_array_iter_remove(&iter, NULL);
+    }
+    munit_assert_size(20, == , cc_segmented_array_size(array));
+
+    int i = 0;
+    CC_SEGMENTED_ARRAY_FOREACH(val, array, {
+        munit_assert_int(i, == , *(int*)val);
+        i += 2;
+    });
+
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_index_of(const MunitParameter p[], void* f)
+{
+    (void)p;
+    (void)f;
+
+    CC_SegmentedArray *array;
+    cc_segmented_array_new(&array);
+
+    int v[20];
+    for (int i = 0; i < 20; i++)
+        cc_segmented_array_add(array, &v[i]);
+
+    cc_segmented_array_add(array, &v[12]);
+
+    size_t index;
+    munit_assert_int(CC_OK, ==, cc_segmented_array_index_of(array, &v[12], &index));
+    munit_assert_size(12, == , index);
+    munit_assert_size(2, == , cc_segmented_array_contains(array, &v[12]));
+
+    cc_segmented_array_destroy(array);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/segmented_array/test_add", test_add, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_stable_slots", test_stable_slots, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_add_at", test_add_at, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_remove_at", test_remove_at, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_trim_capacity", test_trim_capacity, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_iter", test_iter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/segmented_array/test_index_of", test_index_of, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char*) "", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+	return munit_suite_main(&test_suite, (void*)"test", argc, argv );
+}
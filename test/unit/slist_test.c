@@ -1,5 +1,7 @@
 #include "munit.h"
 #include "cc_slist.h"
+#include "budget_alloc.h"
+#include "memory/cc_dynamic_pool.h"
 #include <stdlib.h>
 
 
@@ -1110,8 +1112,385 @@ static MunitResult test_filter_mut3(const MunitParameter params[], void* fixture
     return MUNIT_OK;
 }
 
+static MunitResult test_node_pool(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_SListConf conf;
+    cc_slist_conf_init(&conf);
+    conf.pool_chunk_size = 4;
+
+    CC_SList* list1;
+    CC_SList* list2;
+    CC_SList* plain;
+    munit_assert_int(CC_OK, ==, cc_slist_new_conf(&conf, &list1));
+    munit_assert_int(CC_OK, ==, cc_slist_new_conf(&conf, &list2));
+    cc_slist_new(&plain);
+
+    int v[20];
+    void* e;
+
+    /* Nodes are recycled across chunk boundaries */
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10; i++)
+            munit_assert_int(CC_OK, ==, cc_slist_add_last(list1, &v[i]));
+        for (int i = 0; i < 7; i++) {
+            cc_slist_remove_first(list1, &e);
+            munit_assert_ptr_equal(&v[i], e);
+        }
+        cc_slist_remove_all(list1);
+    }
+
+    for (int i = 0; i < 5; i++) {
+        cc_slist_add(list1, &v[i]);
+        cc_slist_add(list2, &v[5 + i]);
+        cc_slist_add(plain, &v[10 + i]);
+    }
+
+    /* Both pooled: list2's chunks are handed over */
+    munit_assert_int(CC_OK, ==, cc_slist_splice(list1, list2));
+    munit_assert_size(0, ==, cc_slist_size(list2));
+
+    /* Mixed: the elements are copied instead of moved */
+    munit_assert_int(CC_OK, ==, cc_slist_splice(list1, plain));
+    munit_assert_size(0, ==, cc_slist_size(plain));
+    munit_assert_size(15, ==, cc_slist_size(list1));
+
+    for (int i = 0; i < 15; i++) {
+        cc_slist_get_at(list1, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+
+    cc_slist_add(list2, &v[0]);
+    cc_slist_add(plain, &v[1]);
+    munit_assert_int(CC_OK, ==, cc_slist_splice(plain, list2));
+    cc_slist_get_last(plain, &e);
+    munit_assert_ptr_equal(&v[0], e);
+
+    cc_slist_destroy(list2);
+    cc_slist_destroy(plain);
+
+    for (int i = 0; i < 10; i++)
+        cc_slist_remove_last(list1, NULL);
+    cc_slist_get_last(list1, &e);
+    munit_assert_ptr_equal(&v[4], e);
+
+    cc_slist_destroy(list1);
+    return MUNIT_OK;
+}
+
+struct sort_item {
+    int key;
+    int seq;
+};
+
+static int cmp_item(void const* e1, void const* e2)
+{
+    return ((struct sort_item*) e1)->key - ((struct sort_item*) e2)->key;
+}
+
+static int cmp_item_ptr(void const* e1, void const* e2)
+{
+    return cmp_item(*((void**) e1), *((void**) e2));
+}
+
+static void assert_sorted(CC_SList* list, bool ascending_seq)
+{
+    struct sort_item* prev = NULL;
+    size_t n = 0;
+
+    CC_SLIST_FOREACH(e, list, {
+        struct sort_item* it = e;
+        if (prev) {
+            munit_assert_int(prev->key, <=, it->key);
+            if (prev->key == it->key && ascending_seq)
+                munit_assert_int(prev->seq, <, it->seq);
+            if (prev->key == it->key && !ascending_seq)
+                munit_assert_int(prev->seq, >, it->seq);
+        }
+        prev = it;
+        n++;
+    })
+    munit_assert_size(200, ==, n);
+}
+
+static MunitResult test_sort_stable(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_SList* list;
+    cc_slist_new(&list);
+
+    /* An ascending run with equal keys, a strictly descending run and a
+     * random tail with many equal keys */
+    struct sort_item items[200];
+    for (int i = 0; i < 200; i++) {
+        if (i < 50)
+            items[i].key = i / 5;
+        else if (i < 100)
+            items[i].key = 99 - i;
+        else
+            items[i].key = munit_rand_int_range(0, 29);
+        items[i].seq = i;
+        cc_slist_add(list, &items[i]);
+    }
+
+    cc_slist_sort_in_place(list, cmp_item);
+    assert_sorted(list, true);
+
+    /* Equal keys keep their reversed order */
+    cc_slist_reverse(list);
+    cc_slist_sort_in_place(list, cmp_item);
+    assert_sorted(list, false);
+
+    /* The array sort only orders the keys */
+    cc_slist_reverse(list);
+    munit_assert_int(CC_OK, ==, cc_slist_sort(list, cmp_item_ptr));
+
+    struct sort_item* prev = NULL;
+    CC_SLIST_FOREACH(e, list, {
+        if (prev)
+            munit_assert_int(prev->key, <=, ((struct sort_item*) e)->key);
+        prev = e;
+    })
+
+    void* last = NULL;
+    CC_SLIST_FOREACH(e, list, {
+        last = e;
+    })
+    void* e;
+    cc_slist_get_last(list, &e);
+    munit_assert_ptr_equal(last, e);
+
+    cc_slist_destroy(list);
+    return MUNIT_OK;
+}
+
+static void assert_range(CC_SList* list, int* v, size_t b, size_t n)
+{
+    munit_assert_size(n, ==, cc_slist_size(list));
+
+    size_t i = b;
+    CC_SLIST_FOREACH(e, list, {
+        munit_assert_ptr_equal(&v[i], e);
+        i++;
+    })
+    munit_assert_size(b + n, ==, i);
+
+    void* e;
+    if (n > 0) {
+        cc_slist_get_last(list, &e);
+        munit_assert_ptr_equal(&v[b + n - 1], e);
+    }
+}
+
+static MunitResult test_copy_bulk(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[100];
+
+    /* Once without a node pool, where the copies live in blocks, and once
+     * with a pool that has a few free nodes to reuse */
+    for (int pooled = 0; pooled < 2; pooled++) {
+        CC_SListConf conf;
+        cc_slist_conf_init(&conf);
+        conf.pool_chunk_size = pooled ? 8 : 0;
+
+        CC_SList* list;
+        cc_slist_new_conf(&conf, &list);
+        for (int i = 0; i < 100; i++)
+            cc_slist_add(list, &v[i]);
+
+        void* e;
+        for (int i = 0; i < 3; i++)
+            cc_slist_remove_last(list, &e);
+        for (int i = 97; i < 100; i++)
+            cc_slist_add(list, &v[i]);
+
+        CC_SList* copy;
+        CC_SList* sub;
+        munit_assert_int(CC_OK, ==, cc_slist_copy_shallow(list, &copy));
+        munit_assert_int(CC_OK, ==, cc_slist_sublist(list, 10, 59, &sub));
+        assert_range(copy, v, 0, 100);
+        assert_range(sub, v, 10, 50);
+
+        /* Nodes of a block can be removed in any order */
+        for (int i = 0; i < 10; i++)
+            cc_slist_remove_first(copy, &e);
+        for (int i = 0; i < 40; i++)
+            cc_slist_remove_last(copy, &e);
+        assert_range(copy, v, 10, 50);
+
+        cc_slist_remove_at(copy, 25, &e);
+        munit_assert_ptr_equal(&v[35], e);
+        cc_slist_add_at(copy, e, 25);
+
+        /* Splicing hands the blocks of one list over to the other */
+        munit_assert_int(CC_OK, ==, cc_slist_splice(sub, copy));
+        munit_assert_size(0, ==, cc_slist_size(copy));
+        munit_assert_size(100, ==, cc_slist_size(sub));
+
+        cc_slist_remove_all(sub);
+        munit_assert_int(CC_OK, ==, cc_slist_add_all(sub, list));
+        munit_assert_int(CC_OK, ==, cc_slist_add_all(copy, list));
+        munit_assert_int(CC_OK, ==, cc_slist_add_all_at(copy, sub, 50));
+        munit_assert_size(200, ==, cc_slist_size(copy));
+
+        cc_slist_get_at(copy, 49, &e);
+        munit_assert_ptr_equal(&v[49], e);
+        cc_slist_get_at(copy, 50, &e);
+        munit_assert_ptr_equal(&v[0], e);
+        cc_slist_get_at(copy, 150, &e);
+        munit_assert_ptr_equal(&v[50], e);
+
+        cc_slist_destroy(sub);
+        cc_slist_destroy(copy);
+        cc_slist_destroy(list);
+    }
+    return MUNIT_OK;
+}
+
+static void assert_compact(CC_SList* list, int* v, size_t n)
+{
+    munit_assert_size(n, ==, cc_slist_size(list));
+
+    CC_SListIter iter;
+    cc_slist_iter_init(&iter, list);
+
+    void* e;
+    SNode* prev = NULL;
+    size_t i = 0;
+    while (cc_slist_iter_next(&iter, &e) != CC_ITER_END) {
+        munit_assert_ptr_equal(&v[i], e);
+        if (prev)
+            munit_assert_ptr_equal(prev + 1, iter.current);
+        prev = iter.current;
+        i++;
+    }
+    munit_assert_size(n, ==, i);
+
+    cc_slist_get_last(list, &e);
+    munit_assert_ptr_equal(&v[n - 1], e);
+}
+
+static MunitResult test_compact(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[100];
+
+    for (int pooled = 0; pooled < 2; pooled++) {
+        CC_SListConf conf;
+        cc_slist_conf_init(&conf);
+        conf.pool_chunk_size = pooled ? 8 : 0;
+
+        CC_SList* list;
+        cc_slist_new_conf(&conf, &list);
+        munit_assert_int(CC_OK, ==, cc_slist_compact(list, NULL));
+
+        /* Scatter the nodes by building the list from both ends */
+        void* e;
+        for (int i = 0; i < 50; i++) {
+            cc_slist_add_first(list, &v[49 - i]);
+            cc_slist_add_last(list, &v[50 + i]);
+            cc_slist_add_first(list, &v[i]);
+            cc_slist_remove_first(list, &e);
+        }
+        cc_slist_compact(list, NULL);
+        assert_compact(list, v, 100);
+
+        cc_slist_remove_last(list, &e);
+        cc_slist_remove_at(list, 40, &e);
+        cc_slist_add_at(list, e, 40);
+        cc_slist_add(list, &v[99]);
+
+        /* Compacting into a dynamic pool leaves the nodes to the pool */
+        CC_DynamicPool* pool;
+        cc_dynamic_pool_new(4096, &pool);
+
+        munit_assert_int(CC_OK, ==, cc_slist_compact(list, pool));
+        assert_compact(list, v, 100);
+
+        cc_slist_remove_at(list, 30, &e);
+        munit_assert_ptr_equal(&v[30], e);
+        cc_slist_add_at(list, e, 30);
+        cc_slist_get_at(list, 30, &e);
+        munit_assert_ptr_equal(&v[30], e);
+
+        cc_slist_destroy(list);
+        cc_dynamic_pool_destroy(pool);
+    }
+    return MUNIT_OK;
+}
+
+static MunitResult test_splice_blocks(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    int v[50];
+
+    CC_SListConf conf;
+    cc_slist_conf_init(&conf);
+    conf.mem_alloc = budget_alloc;
+    conf.mem_calloc = budget_calloc;
+    alloc_budget = 1000;
+
+    CC_SList* all;
+    CC_SList* list1;
+    cc_slist_new_conf(&conf, &all);
+    cc_slist_new_conf(&conf, &list1);
+    for (int i = 0; i < 50; i++)
+        cc_slist_add(all, &v[i]);
+
+    /* Fill the block table of the first list to its capacity */
+    for (int i = 0; i < 4; i++) {
+        CC_SList* part;
+        cc_slist_sublist(all, i * 10, i * 10 + 9, &part);
+        munit_assert_int(CC_OK, ==, cc_slist_splice(list1, part));
+        cc_slist_destroy(part);
+    }
+    CC_SList* list2;
+    CC_SList* list3;
+    cc_slist_sublist(all, 40, 44, &list2);
+    cc_slist_sublist(all, 45, 49, &list3);
+
+    /* Splicing must not allocate even when the block table is full */
+    alloc_budget = 0;
+    munit_assert_int(CC_OK, ==, cc_slist_splice(list1, list2));
+    munit_assert_int(CC_OK, ==, cc_slist_splice(list1, list3));
+    munit_assert_size(0, ==, cc_slist_size(list2));
+    munit_assert_size(0, ==, cc_slist_size(list3));
+    assert_range(list1, v, 0, 50);
+
+    void* e;
+    for (int i = 0; i < 5; i++) {
+        cc_slist_remove_at(list1, 45, &e);
+        munit_assert_ptr_equal(&v[45 + i], e);
+    }
+    for (int i = 0; i < 10; i++)
+        cc_slist_remove_first(list1, &e);
+    assert_range(list1, v, 10, 35);
+
+    alloc_budget = 1000;
+    munit_assert_int(CC_OK, ==, cc_slist_add_all(list1, all));
+    munit_assert_size(85, ==, cc_slist_size(list1));
+
+    cc_slist_destroy(list1);
+    cc_slist_destroy(list2);
+    cc_slist_destroy(list3);
+    cc_slist_destroy(all);
+    return MUNIT_OK;
+}
+
 static MunitTest test_suite_tests[] = {
 	{(char*)"/list/test_new", test_new, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_node_pool", test_node_pool, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add_last", test_add_last, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add_first", test_add_first, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_add", test_add, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
@@ -1142,6 +1521,10 @@ static MunitTest test_suite_tests[] = {
     {(char*)"/list/test_zip_remove", test_zip_iter_remove, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_zip_replace", test_zip_iter_replace, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_sort", test_sort, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_sort_stable", test_sort_stable, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_copy_bulk", test_copy_bulk, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_splice_blocks", test_splice_blocks, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/list/test_compact", test_compact, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_reverse", test_reverse, default_lists, default_lists_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_filter1", test_filter1, pre_filled_lists, pre_filled_teardown, MUNIT_TEST_OPTION_NONE, NULL},
     {(char*)"/list/test_filter2", test_filter2, pre_filled_lists, pre_filled_teardown, MUNIT_TEST_OPTION_NONE, NULL},
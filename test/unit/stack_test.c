@@ -72,6 +72,41 @@ static MunitResult test_pop(const MunitParameter params[], void* fixture)
     return MUNIT_OK;
 }
 
+static MunitResult test_push_all_pop_n(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_Stack* s;
+    cc_stack_new(&s);
+
+    int v[5];
+    void* els[5];
+    for (int i = 0; i < 5; i++)
+        els[i] = &v[i];
+
+    munit_assert_int(CC_OK, ==, cc_stack_push_all(s, els, 5));
+    munit_assert_size(5, ==, cc_stack_size(s));
+
+    void* out[5];
+    munit_assert_size(2, ==, cc_stack_pop_n(s, out, 2));
+    munit_assert_ptr_equal(&v[4], out[0]);
+    munit_assert_ptr_equal(&v[3], out[1]);
+
+    void** array;
+    munit_assert_int(CC_OK, ==, cc_stack_drain_to_array(s, &array));
+    munit_assert_size(0, ==, cc_stack_size(s));
+    munit_assert_ptr_equal(&v[2], array[0]);
+    munit_assert_ptr_equal(&v[0], array[2]);
+    free(array);
+
+    munit_assert_size(0, ==, cc_stack_pop_n(s, out, 2));
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_stack_drain_to_array(s, &array));
+
+    cc_stack_destroy(s);
+    return MUNIT_OK;
+}
+
 static MunitResult test_filter(const MunitParameter params[], void* fixture)
 {
     (void)params;
@@ -132,6 +167,7 @@ static MunitResult test_filter_mut(const MunitParameter params[], void* fixture)
 static MunitTest test_suite_tests[] = {
     { (char*)"/stack/test_push", test_push, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/stack/test_pop", test_pop, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    { (char*)"/stack/test_push_all_pop_n", test_push_all_pop_n, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/stack/test_filter", test_filter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { (char*)"/stack/test_filter_mut", test_filter_mut, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
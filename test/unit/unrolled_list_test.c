@@ -0,0 +1,330 @@
+#include "munit.h"
+#include "cc_unrolled_list.h"
+#include "budget_alloc.h"
+#include <stdlib.h>
+
+static CC_UnrolledList* new_list(size_t node_capacity)
+{
+    CC_UnrolledListConf conf;
+    cc_unrolled_list_conf_init(&conf);
+    conf.node_capacity = node_capacity;
+
+    CC_UnrolledList* list;
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_new_conf(&conf, &list));
+    return list;
+}
+
+static void assert_contents(CC_UnrolledList* list, void** expected, size_t n)
+{
+    munit_assert_size(n, ==, cc_unrolled_list_size(list));
+
+    size_t i = 0;
+    CC_UNROLLED_LIST_FOREACH(e, list, {
+        munit_assert_ptr_equal(expected[i], e);
+        i++;
+    })
+    munit_assert_size(n, ==, i);
+}
+
+static MunitResult test_add_remove(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledList* list = new_list(4);
+
+    int v[100];
+    void* e;
+
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_unrolled_list_remove_first(list, &e));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_unrolled_list_get_last(list, &e));
+
+    /* 50..99 at the back and 49..0 at the front */
+    for (int i = 0; i < 50; i++) {
+        munit_assert_int(CC_OK, ==, cc_unrolled_list_add_last(list, &v[50 + i]));
+        munit_assert_int(CC_OK, ==, cc_unrolled_list_add_first(list, &v[49 - i]));
+    }
+    munit_assert_size(100, ==, cc_unrolled_list_size(list));
+
+    /* Lists built from either end keep their nodes full */
+    munit_assert_size(25, ==, cc_unrolled_list_node_count(list));
+
+    for (int i = 0; i < 100; i++) {
+        cc_unrolled_list_get_at(list, i, &e);
+        munit_assert_ptr_equal(&v[i], e);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_unrolled_list_get_at(list, 100, &e));
+
+    for (int i = 0; i < 50; i++) {
+        cc_unrolled_list_remove_first(list, &e);
+        munit_assert_ptr_equal(&v[i], e);
+        cc_unrolled_list_remove_last(list, &e);
+        munit_assert_ptr_equal(&v[99 - i], e);
+    }
+    munit_assert_size(0, ==, cc_unrolled_list_size(list));
+    munit_assert_size(0, ==, cc_unrolled_list_node_count(list));
+
+    cc_unrolled_list_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_add_remove_at(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledList* list = new_list(5);
+
+    int v[400];
+    void* model[400];
+    size_t n = 0;
+    void* e;
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_unrolled_list_add_at(list, &v[0], 1));
+
+    /* Random inserts and removals checked against a plain array */
+    for (int i = 0; i < 400; i++) {
+        size_t index = n ? (size_t) munit_rand_int_range(0, (int) n) : 0;
+        munit_assert_int(CC_OK, ==, cc_unrolled_list_add_at(list, &v[i], index));
+        memmove(&model[index + 1], &model[index], (n - index) * sizeof(void*));
+        model[index] = &v[i];
+        n++;
+
+        if (i % 3 == 2) {
+            index = (size_t) munit_rand_int_range(0, (int) n - 1);
+            munit_assert_int(CC_OK, ==, cc_unrolled_list_remove_at(list, index, &e));
+            munit_assert_ptr_equal(model[index], e);
+            memmove(&model[index], &model[index + 1], (n - index - 1) * sizeof(void*));
+            n--;
+        }
+    }
+    assert_contents(list, model, n);
+
+    for (size_t i = 0; i < n; i++) {
+        cc_unrolled_list_get_at(list, i, &e);
+        munit_assert_ptr_equal(model[i], e);
+    }
+
+    /* Removing most of the elements merges the sparse nodes back */
+    while (n > 10) {
+        size_t index = (size_t) munit_rand_int_range(0, (int) n - 1);
+        cc_unrolled_list_remove(list, model[index], NULL);
+        memmove(&model[index], &model[index + 1], (n - index - 1) * sizeof(void*));
+        n--;
+    }
+    assert_contents(list, model, n);
+    munit_assert_size(10, >=, cc_unrolled_list_node_count(list));
+
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_replace_at(list, &v[0], 3, &e));
+    munit_assert_ptr_equal(model[3], e);
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_unrolled_list_remove_at(list, n, &e));
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_unrolled_list_remove(list, &n, NULL));
+
+    cc_unrolled_list_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_iter(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledList* list = new_list(4);
+
+    int v[60];
+    void* model[60];
+    size_t n = 0;
+
+    for (int i = 0; i < 20; i++)
+        cc_unrolled_list_add(list, &v[i]);
+
+    CC_UnrolledListIter iter;
+    cc_unrolled_list_iter_init(&iter, list);
+
+    void* e;
+    munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_unrolled_list_iter_remove(&iter, &e));
+
+    /* Drop every even element and insert a new one after every odd one */
+    while (cc_unrolled_list_iter_next(&iter, &e) != CC_ITER_END) {
+        int i = (int) ((int*) e - v);
+
+        if (i % 2 == 0) {
+            munit_assert_int(CC_OK, ==, cc_unrolled_list_iter_remove(&iter, NULL));
+            munit_assert_int(CC_ERR_VALUE_NOT_FOUND, ==, cc_unrolled_list_iter_remove(&iter, NULL));
+        } else {
+            munit_assert_size(n, ==, cc_unrolled_list_iter_index(&iter));
+            model[n++] = e;
+            munit_assert_int(CC_OK, ==, cc_unrolled_list_iter_add(&iter, &v[20 + i]));
+            model[n++] = &v[20 + i];
+        }
+    }
+    assert_contents(list, model, n);
+
+    /* Replace and remove everything through a second pass */
+    cc_unrolled_list_iter_init(&iter, list);
+    cc_unrolled_list_iter_next(&iter, &e);
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_iter_replace(&iter, &v[0], &e));
+    munit_assert_ptr_equal(model[0], e);
+    cc_unrolled_list_get_first(list, &e);
+    munit_assert_ptr_equal(&v[0], e);
+
+    cc_unrolled_list_iter_init(&iter, list);
+    while (cc_unrolled_list_iter_next(&iter, &e) != CC_ITER_END)
+        cc_unrolled_list_iter_remove(&iter, NULL);
+
+    munit_assert_size(0, ==, cc_unrolled_list_size(list));
+    munit_assert_size(0, ==, cc_unrolled_list_node_count(list));
+
+    cc_unrolled_list_destroy(list);
+    return MUNIT_OK;
+}
+
+static MunitResult test_splice(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledList* l1 = new_list(4);
+    CC_UnrolledList* l2 = new_list(4);
+    CC_UnrolledList* l3 = new_list(8);
+
+    int v[30];
+    void* model[30];
+
+    for (int i = 0; i < 10; i++) {
+        cc_unrolled_list_add(l1, &v[i]);
+        cc_unrolled_list_add(l2, &v[10 + i]);
+        cc_unrolled_list_add(l3, &v[20 + i]);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_unrolled_list_splice_at(l1, l2, 11));
+
+    /* Splicing into the middle of a node splits it */
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_splice_at(l1, l2, 5));
+    munit_assert_size(0, ==, cc_unrolled_list_size(l2));
+    munit_assert_size(0, ==, cc_unrolled_list_node_count(l2));
+
+    /* Lists with different node capacities are copied */
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_splice_at(l1, l3, 0));
+    munit_assert_size(0, ==, cc_unrolled_list_size(l3));
+
+    size_t n = 0;
+    for (int i = 0; i < 10; i++)
+        model[n++] = &v[20 + i];
+    for (int i = 0; i < 5; i++)
+        model[n++] = &v[i];
+    for (int i = 0; i < 10; i++)
+        model[n++] = &v[10 + i];
+    for (int i = 5; i < 10; i++)
+        model[n++] = &v[i];
+
+    assert_contents(l1, model, n);
+
+    for (size_t i = 0; i < n; i++) {
+        void* e;
+        cc_unrolled_list_get_at(l1, i, &e);
+        munit_assert_ptr_equal(model[i], e);
+    }
+
+    cc_unrolled_list_add(l2, &v[0]);
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_splice(l2, l1));
+    munit_assert_size(31, ==, cc_unrolled_list_size(l2));
+
+    void* e;
+    cc_unrolled_list_get_last(l2, &e);
+    munit_assert_ptr_equal(&v[9], e);
+
+    cc_unrolled_list_destroy(l1);
+    cc_unrolled_list_destroy(l2);
+    cc_unrolled_list_destroy(l3);
+    return MUNIT_OK;
+}
+
+static MunitResult test_to_array(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledList* list = new_list(3);
+
+    void** array;
+    munit_assert_int(CC_ERR_INVALID_RANGE, ==, cc_unrolled_list_to_array(list, &array));
+
+    for (int i = 0; i < 10; i++) {
+        int* p = malloc(sizeof(int));
+        *p = i;
+        cc_unrolled_list_add(list, p);
+    }
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_to_array(list, &array));
+
+    for (int i = 0; i < 10; i++)
+        munit_assert_int(i, ==, *((int*) array[i]));
+
+    munit_assert_size(1, ==, cc_unrolled_list_contains(list, array[4]));
+    free(array);
+
+    cc_unrolled_list_destroy_cb(list, free);
+    return MUNIT_OK;
+}
+
+
+static MunitResult test_splice_alloc_failure(const MunitParameter params[], void* fixture)
+{
+    (void)params;
+    (void)fixture;
+
+    CC_UnrolledListConf conf;
+    cc_unrolled_list_conf_init(&conf);
+    conf.node_capacity = 4;
+    conf.mem_alloc = budget_alloc;
+    conf.mem_calloc = budget_calloc;
+
+    alloc_budget = 100;
+    CC_UnrolledList* l1;
+    cc_unrolled_list_new_conf(&conf, &l1);
+    CC_UnrolledList* l2 = new_list(8);
+
+    int v[20];
+    void* model[20];
+    for (int i = 0; i < 10; i++) {
+        cc_unrolled_list_add(l1, &v[i]);
+        cc_unrolled_list_add(l2, &v[10 + i]);
+        model[i] = &v[i];
+        model[10 + i] = &v[10 + i];
+    }
+
+    /* Running out of memory halfway through the copy changes neither list */
+    for (int budget = 0; budget < 5; budget++) {
+        alloc_budget = budget;
+        munit_assert_int(CC_ERR_ALLOC, ==, cc_unrolled_list_splice_at(l1, l2, 5));
+        assert_contents(l1, model, 10);
+        assert_contents(l2, model + 10, 10);
+    }
+
+    alloc_budget = 100;
+    munit_assert_int(CC_OK, ==, cc_unrolled_list_splice(l1, l2));
+    munit_assert_size(0, ==, cc_unrolled_list_size(l2));
+    assert_contents(l1, model, 20);
+
+    cc_unrolled_list_destroy(l1);
+    cc_unrolled_list_destroy(l2);
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/unrolled_list/test_add_remove", test_add_remove, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/unrolled_list/test_add_remove_at", test_add_remove_at, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/unrolled_list/test_iter", test_iter, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/unrolled_list/test_splice", test_splice, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/unrolled_list/test_splice_alloc_failure", test_splice_alloc_failure, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/unrolled_list/test_to_array", test_to_array, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}
@@ -0,0 +1,175 @@
+#include "munit.h"
+#include "cc_ws_deque.h"
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#define WS_TEST_THREADS
+#endif
+
+
+static MunitResult test_push_pop(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_WSDeque *d;
+    munit_assert_int(CC_OK, ==, cc_ws_deque_new(&d));
+
+    int v[5];
+    void *out;
+
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ws_deque_pop(d, &out));
+
+    for (int i = 0; i < 5; i++)
+        munit_assert_int(CC_OK, ==, cc_ws_deque_push(d, &v[i]));
+    munit_assert_size(5, ==, cc_ws_deque_size(d));
+
+    for (int i = 4; i >= 0; i--) {
+        munit_assert_int(CC_OK, ==, cc_ws_deque_pop(d, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ws_deque_pop(d, &out));
+    munit_assert_size(0, ==, cc_ws_deque_size(d));
+
+    cc_ws_deque_destroy(d);
+    return MUNIT_OK;
+}
+
+static MunitResult test_steal_grow(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_WSDequeConf conf;
+    cc_ws_deque_conf_init(&conf);
+    conf.capacity = 4;
+
+    CC_WSDeque *d;
+    cc_ws_deque_new_conf(&conf, &d);
+    munit_assert_size(4, ==, cc_ws_deque_capacity(d));
+
+    int v[20];
+    void *out;
+
+    /* Move the positions so that the elements wrap before growing */
+    cc_ws_deque_push(d, &v[0]);
+    cc_ws_deque_push(d, &v[0]);
+    cc_ws_deque_steal(d, &out);
+    cc_ws_deque_steal(d, &out);
+
+    for (int i = 0; i < 20; i++)
+        munit_assert_int(CC_OK, ==, cc_ws_deque_push(d, &v[i]));
+    munit_assert_size(32, ==, cc_ws_deque_capacity(d));
+
+    for (int i = 0; i < 10; i++) {
+        munit_assert_int(CC_OK, ==, cc_ws_deque_steal(d, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    for (int i = 19; i >= 10; i--) {
+        munit_assert_int(CC_OK, ==, cc_ws_deque_pop(d, &out));
+        munit_assert_ptr_equal(&v[i], out);
+    }
+    munit_assert_int(CC_ERR_OUT_OF_RANGE, ==, cc_ws_deque_steal(d, &out));
+
+    cc_ws_deque_destroy(d);
+    return MUNIT_OK;
+}
+
+#ifdef WS_TEST_THREADS
+
+#define THIEVES 3
+#define ITEMS 100000
+
+static CC_WSDeque    *shared;
+static unsigned char  taken[ITEMS];
+static _Atomic int    done;
+
+static void *thief(void *arg)
+{
+    size_t *count = arg;
+    void *out;
+
+    while (!done) {
+        if (cc_ws_deque_steal(shared, &out) == CC_OK) {
+            taken[(uintptr_t) out]++;
+            (*count)++;
+        } else {
+            sched_yield();
+        }
+    }
+    while (cc_ws_deque_steal(shared, &out) == CC_OK) {
+        taken[(uintptr_t) out]++;
+        (*count)++;
+    }
+    return NULL;
+}
+
+static MunitResult test_concurrent_steal(const MunitParameter p[], void* fixture)
+{
+    (void)p;
+    (void)fixture;
+
+    CC_WSDequeConf conf;
+    cc_ws_deque_conf_init(&conf);
+    conf.capacity = 2;
+    cc_ws_deque_new_conf(&conf, &shared);
+
+    memset(taken, 0, sizeof(taken));
+    done = 0;
+
+    pthread_t thieves[THIEVES];
+    size_t counts[THIEVES] = {0};
+
+    for (int i = 0; i < THIEVES; i++)
+        pthread_create(&thieves[i], NULL, thief, &counts[i]);
+
+    /* The owner pushes everything and pops every third element */
+    size_t popped = 0;
+    void *out;
+    for (uintptr_t i = 0; i < ITEMS; i++) {
+        cc_ws_deque_push(shared, (void*) i);
+        if (i % 3 == 0 && cc_ws_deque_pop(shared, &out) == CC_OK) {
+            taken[(uintptr_t) out]++;
+            popped++;
+        }
+    }
+    while (cc_ws_deque_pop(shared, &out) == CC_OK) {
+        taken[(uintptr_t) out]++;
+        popped++;
+    }
+    done = 1;
+
+    for (int i = 0; i < THIEVES; i++) {
+        pthread_join(thieves[i], NULL);
+        popped += counts[i];
+    }
+
+    munit_assert_size(ITEMS, ==, popped);
+    for (size_t i = 0; i < ITEMS; i++)
+        munit_assert_uint8(1, ==, taken[i]);
+
+    cc_ws_deque_destroy(shared);
+    return MUNIT_OK;
+}
+
+#endif
+
+static MunitTest test_suite_tests[] = {
+    {(char*)"/ws_deque/test_push_pop", test_push_pop, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+    {(char*)"/ws_deque/test_steal_grow", test_steal_grow, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#ifdef WS_TEST_THREADS
+    {(char*)"/ws_deque/test_concurrent_steal", test_concurrent_steal, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
+#endif
+    {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}
+};
+
+static const MunitSuite test_suite = {
+    (char*)"", test_suite_tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char* argv[MUNIT_ARRAY_PARAM(argc + 1)])
+{
+    return munit_suite_main(&test_suite, (void*)"test", argc, argv);
+}